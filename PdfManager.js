@@ -23,4 +23,27 @@ export default class PdfManager {
 
         return PdfManagerNative.loadFile(path, password);
     }
+
+    /**
+     * Drop the reference taken by loadFile; the native document stays cached for
+     * reuse until it is evicted
+     */
+    static releaseFile(fileNo) {
+        if (fileNo >= 0 && PdfManagerNative.releaseFile) {
+            PdfManagerNative.releaseFile(fileNo);
+        }
+    }
+
+    /**
+     * Page geometry table for a loaded file: a flat array of 12 numbers per page
+     * (width, height, media box left/bottom/right/top, crop box left/bottom/right/top,
+     * rotation, user unit), measured once per document. Resolves null when the
+     * native module has no geometry table.
+     */
+    static getPageGeometry(fileNo) {
+        if (!PdfManagerNative.getPageGeometry) {
+            return Promise.resolve(null);
+        }
+        return PdfManagerNative.getPageGeometry(fileNo);
+    }
 }
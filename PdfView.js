@@ -96,7 +96,9 @@ export default class PdfView extends Component {
         this._mounted = true;
         PdfManager.loadFile(this.props.path, this.props.password)
             .then((pdfInfo) => {
-                if (this._mounted) {
+                if (!this._mounted) {
+                    PdfManager.releaseFile(pdfInfo[0]);
+                } else {
                     const fileNo = pdfInfo[0];
                     const numberOfPages = pdfInfo[1];
                     const width = pdfInfo[2];
@@ -157,6 +159,7 @@ export default class PdfView extends Component {
         this._mounted = false;
         clearTimeout(this._scaleTimer);
         clearTimeout(this._scrollTimer);
+        PdfManager.releaseFile(this.state.fileNo);
 
     }
 
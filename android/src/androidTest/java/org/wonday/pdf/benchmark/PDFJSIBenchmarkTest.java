@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * On-device harness for the native pdfjsi benchmark
+ *
+ * Runs benchmark/PDFJSIBenchmark.cpp inside the instrumentation process, so
+ * the JNI marshalling rows measure ART rather than a host JDK:
+ *   ./gradlew connectedAndroidTest -PpdfjsiBenchmark=true \
+ *       -Pandroid.testInstrumentationRunnerArguments.benchmarkFilter=render
+ * Instrumentation arguments benchmarkFilter, benchmarkIterations and
+ * benchmarkWarmup become the executable's --filter, --iterations and --warmup.
+ * Results are written to the test package's external files directory:
+ *   adb pull /sdcard/Android/data/org.wonday.pdf.test/files/pdfjsi_benchmark.json
+ */
+
+package org.wonday.pdf.benchmark;
+
+import static org.junit.Assert.assertEquals;
+
+import android.content.Context;
+import android.os.Bundle;
+import android.util.Log;
+
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.platform.app.InstrumentationRegistry;
+
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.io.File;
+import java.util.ArrayList;
+import java.util.List;
+
+@RunWith(AndroidJUnit4.class)
+public class PDFJSIBenchmarkTest {
+    private static final String TAG = "PDFJSIBenchmark";
+
+    static {
+        // The render rows need Pdfium in the process; PdfiumApi resolves it by soname
+        try {
+            System.loadLibrary("pdfium");
+        } catch (UnsatisfiedLinkError e) {
+            Log.w(TAG, "Pdfium not packaged, document rows will be skipped");
+        }
+        System.loadLibrary("pdfjsi_benchmark_jni");
+    }
+
+    @Test
+    public void runBenchmark() {
+        Context context = InstrumentationRegistry.getInstrumentation().getContext();
+        Bundle arguments = InstrumentationRegistry.getArguments();
+        File filesDir = context.getExternalFilesDir(null);
+        if (filesDir == null) {
+            filesDir = context.getFilesDir();
+        }
+        File output = new File(filesDir, "pdfjsi_benchmark.json");
+
+        List<String> args = new ArrayList<>();
+        args.add("--corpus-dir");
+        args.add(new File(context.getCacheDir(), "pdfjsi_benchmark_corpus").getAbsolutePath());
+        args.add("--out");
+        args.add(output.getAbsolutePath());
+        // "filter" itself is taken by AndroidJUnitRunner
+        String[][] passThrough = {
+            {"benchmarkFilter", "--filter"},
+            {"benchmarkIterations", "--iterations"},
+            {"benchmarkWarmup", "--warmup"},
+        };
+        for (String[] option : passThrough) {
+            String value = arguments.getString(option[0]);
+            if (value != null) {
+                args.add(option[1]);
+                args.add(value);
+            }
+        }
+
+        int status = nativeRun(args.toArray(new String[0]));
+        Log.i(TAG, "Benchmark results: " + output.getAbsolutePath());
+        assertEquals("pdfjsi_benchmark exit status", 0, status);
+    }
+
+    private static native int nativeRun(String[] args);
+}
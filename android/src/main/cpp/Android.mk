@@ -14,7 +14,21 @@ LOCAL_MODULE := pdfjsi
 LOCAL_SRC_FILES := \
     PDFJSI.cpp \
     PDFJSIBridge.cpp \
-    PDFJSIModule.cpp
+    PDFJSIModule.cpp \
+    PdfiumApi.cpp \
+    PDFRenderEngine.cpp \
+    PDFDocumentRegistry.cpp \
+    PDFPageCache.cpp \
+    PDFPreloader.cpp \
+    PDFTextIndex.cpp \
+    PDFHitIndex.cpp \
+    PDFJSIHostObject.cpp \
+    Base64Decoder.cpp \
+    PDFBitmapPool.cpp \
+    PDFTrace.cpp \
+    PDFProgressiveDocument.cpp \
+    PDFPageStore.cpp \
+    PDFMemoryGovernor.cpp
 
 # C++ standard
 LOCAL_CPP_STANDARD := c++17
@@ -31,6 +45,7 @@ LOCAL_CPPFLAGS := \
     -fno-stack-protector \
     -fvisibility=hidden \
     -DANDROID \
+    -DPDFJSI_TRACING=1 \
     -DREACT_NATIVE_VERSION=\"0.72.0\"
 
 # Include directories
@@ -44,7 +59,8 @@ LOCAL_C_INCLUDES := \
     $(LOCAL_PATH)
 
 # Libraries to link
-LOCAL_LDLIBS := -llog
+LOCAL_LDLIBS := -llog -ldl -ljnigraphics
+LOCAL_SHARED_LIBRARIES := jsi
 
 # Build shared library
 include $(BUILD_SHARED_LIBRARY)
\ No newline at end of file
@@ -0,0 +1,251 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Native base64 decoder used for the renderPageDirect base64Data path
+ */
+
+#include "Base64Decoder.h"
+#include <cstring>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace {
+
+// 0x80 = invalid, 0x81 = whitespace, 0x82 = padding
+const uint8_t kInvalid = 0x80;
+const uint8_t kSkip = 0x81;
+const uint8_t kPad = 0x82;
+
+struct DecodeTable {
+    uint8_t values[256];
+
+    DecodeTable() {
+        memset(values, kInvalid, sizeof(values));
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; i++) {
+            values[static_cast<uint8_t>(alphabet[i])] = static_cast<uint8_t>(i);
+        }
+        values[static_cast<uint8_t>('-')] = 62; // base64url
+        values[static_cast<uint8_t>('_')] = 63;
+        values[static_cast<uint8_t>(' ')] = kSkip;
+        values[static_cast<uint8_t>('\t')] = kSkip;
+        values[static_cast<uint8_t>('\r')] = kSkip;
+        values[static_cast<uint8_t>('\n')] = kSkip;
+        values[static_cast<uint8_t>('=')] = kPad;
+    }
+};
+
+const DecodeTable& table() {
+    static const DecodeTable decodeTable;
+    return decodeTable;
+}
+
+#if defined(__aarch64__)
+
+// Maps 16 characters to their 6-bit values; false if any of them is outside
+// the alphabet (whitespace, padding or garbage)
+inline bool translate(uint8x16_t c, uint8x16_t& values) {
+    uint8x16_t upper = vsubq_u8(c, vdupq_n_u8('A'));
+    uint8x16_t lower = vsubq_u8(c, vdupq_n_u8('a'));
+    uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+    uint8x16_t isUpper = vcltq_u8(upper, vdupq_n_u8(26));
+    uint8x16_t isLower = vcltq_u8(lower, vdupq_n_u8(26));
+    uint8x16_t isDigit = vcltq_u8(digit, vdupq_n_u8(10));
+    uint8x16_t is62 = vorrq_u8(vceqq_u8(c, vdupq_n_u8('+')), vceqq_u8(c, vdupq_n_u8('-')));
+    uint8x16_t is63 = vorrq_u8(vceqq_u8(c, vdupq_n_u8('/')), vceqq_u8(c, vdupq_n_u8('_')));
+
+    values = vandq_u8(upper, isUpper);
+    values = vorrq_u8(values, vandq_u8(vaddq_u8(lower, vdupq_n_u8(26)), isLower));
+    values = vorrq_u8(values, vandq_u8(vaddq_u8(digit, vdupq_n_u8(52)), isDigit));
+    values = vorrq_u8(values, vandq_u8(vdupq_n_u8(62), is62));
+    values = vorrq_u8(values, vandq_u8(vdupq_n_u8(63), is63));
+
+    uint8x16_t valid = vorrq_u8(vorrq_u8(isUpper, isLower), vorrq_u8(isDigit, vorrq_u8(is62, is63)));
+    return vminvq_u8(valid) == 0xFF;
+}
+
+// 64 characters -> 48 bytes; vld4q deinterleaves each quartet into lanes
+inline bool decodeBlock(const char* in, uint8_t* out) {
+    uint8x16x4_t chars = vld4q_u8(reinterpret_cast<const uint8_t*>(in));
+    uint8x16x4_t values;
+    if (!translate(chars.val[0], values.val[0]) || !translate(chars.val[1], values.val[1]) ||
+        !translate(chars.val[2], values.val[2]) || !translate(chars.val[3], values.val[3])) {
+        return false;
+    }
+    uint8x16x3_t bytes;
+    bytes.val[0] = vorrq_u8(vshlq_n_u8(values.val[0], 2), vshrq_n_u8(values.val[1], 4));
+    bytes.val[1] = vorrq_u8(vshlq_n_u8(values.val[1], 4), vshrq_n_u8(values.val[2], 2));
+    bytes.val[2] = vorrq_u8(vshlq_n_u8(values.val[2], 6), values.val[3]);
+    vst3q_u8(out, bytes);
+    return true;
+}
+
+const size_t kBlockChars = 64;
+const size_t kBlockBytes = 48;
+
+#elif defined(__SSSE3__)
+
+inline __m128i inRange(__m128i c, char low, char high) {
+    // Alphabet characters are all below 0x80, so signed compares are safe
+    return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(low - 1)),
+                         _mm_cmpgt_epi8(_mm_set1_epi8(high + 1), c));
+}
+
+// 16 characters -> 12 bytes (the store writes 16; maxDecodedSize covers the slack)
+inline bool decodeBlock(const char* in, uint8_t* out) {
+    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    __m128i isUpper = inRange(c, 'A', 'Z');
+    __m128i isLower = inRange(c, 'a', 'z');
+    __m128i isDigit = inRange(c, '0', '9');
+    __m128i is62 = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('+')), _mm_cmpeq_epi8(c, _mm_set1_epi8('-')));
+    __m128i is63 = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('/')), _mm_cmpeq_epi8(c, _mm_set1_epi8('_')));
+    __m128i valid = _mm_or_si128(_mm_or_si128(isUpper, isLower), _mm_or_si128(isDigit, _mm_or_si128(is62, is63)));
+    if (_mm_movemask_epi8(valid) != 0xFFFF) {
+        return false;
+    }
+
+    __m128i values = _mm_and_si128(_mm_sub_epi8(c, _mm_set1_epi8('A')), isUpper);
+    values = _mm_or_si128(values, _mm_and_si128(_mm_sub_epi8(c, _mm_set1_epi8('a' - 26)), isLower));
+    values = _mm_or_si128(values, _mm_and_si128(_mm_add_epi8(c, _mm_set1_epi8(52 - '0')), isDigit));
+    values = _mm_or_si128(values, _mm_and_si128(_mm_set1_epi8(62), is62));
+    values = _mm_or_si128(values, _mm_and_si128(_mm_set1_epi8(63), is63));
+
+    // [a b c d] -> 16-bit (a << 6 | b), (c << 6 | d) -> 32-bit 24-bit groups
+    __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    __m128i bytes = _mm_shuffle_epi8(groups, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), bytes);
+    return true;
+}
+
+const size_t kBlockChars = 16;
+const size_t kBlockBytes = 12;
+
+#endif
+
+} // namespace
+
+namespace Base64Decoder {
+
+size_t maxDecodedSize(size_t length) {
+    return (length / 4) * 3 + 3 + 16;
+}
+
+size_t dataUriPrefixLength(const char* input, size_t length) {
+    size_t start = 0;
+    while (start < length && table().values[static_cast<uint8_t>(input[start])] == kSkip) {
+        start++;
+    }
+    if (length - start < 5 || strncmp(input + start, "data:", 5) != 0) {
+        return 0;
+    }
+    const char* comma = static_cast<const char*>(memchr(input + start, ',', length - start));
+    return comma ? static_cast<size_t>(comma - input) + 1 : 0;
+}
+
+// Decodes whole blocks, then whole quartets, until a character outside the
+// alphabet is seen; only called on a quartet boundary
+size_t Stream::decodeRuns(const char* input, size_t length, uint8_t*& out) {
+    size_t i = 0;
+#if defined(__aarch64__) || defined(__SSSE3__)
+    while (length - i >= kBlockChars && decodeBlock(input + i, out)) {
+        i += kBlockChars;
+        out += kBlockBytes;
+    }
+#endif
+    const uint8_t* values = table().values;
+    while (length - i >= 4) {
+        uint32_t a = values[static_cast<uint8_t>(input[i])];
+        uint32_t b = values[static_cast<uint8_t>(input[i + 1])];
+        uint32_t c = values[static_cast<uint8_t>(input[i + 2])];
+        uint32_t d = values[static_cast<uint8_t>(input[i + 3])];
+        if ((a | b | c | d) & 0x80) {
+            break;
+        }
+        uint32_t group = (a << 18) | (b << 12) | (c << 6) | d;
+        out[0] = static_cast<uint8_t>(group >> 16);
+        out[1] = static_cast<uint8_t>(group >> 8);
+        out[2] = static_cast<uint8_t>(group);
+        out += 3;
+        i += 4;
+    }
+    return i;
+}
+
+size_t Stream::update(const char* input, size_t length, uint8_t* out) {
+    if (m_failed) {
+        return 0;
+    }
+
+    const uint8_t* values = table().values;
+    uint8_t* cursor = out;
+    size_t i = 0;
+
+    while (i < length) {
+        if (m_bits == 0 && m_padding == 0) {
+            i += decodeRuns(input + i, length - i, cursor);
+            if (i >= length) {
+                break;
+            }
+        }
+
+        uint8_t value = values[static_cast<uint8_t>(input[i++])];
+        if (value == kSkip) {
+            continue;
+        }
+        if (value == kPad) {
+            ++m_padding;
+            continue;
+        }
+        if (value == kInvalid || m_padding > 0) {
+            m_failed = true;
+            return 0;
+        }
+
+        m_accumulator = (m_accumulator << 6) | value;
+        m_bits += 6;
+        if (m_bits >= 8) {
+            m_bits -= 8;
+            *cursor++ = static_cast<uint8_t>((m_accumulator >> m_bits) & 0xFF);
+        }
+    }
+
+    return static_cast<size_t>(cursor - out);
+}
+
+bool Stream::finish() {
+    // m_bits left over: 0, 6, 4 or 2 after 0, 1, 2 or 3 symbols of the last group
+    int expectedPadding = m_bits == 4 ? 2 : (m_bits == 2 ? 1 : 0);
+    if (m_bits == 6 || (m_padding != 0 && m_padding != expectedPadding)) {
+        m_failed = true;
+    }
+    return !m_failed;
+}
+
+bool decode(const char* input, size_t length, std::vector<uint8_t>& output) {
+    output.clear();
+    if (!input || length == 0) {
+        return false;
+    }
+
+    size_t offset = dataUriPrefixLength(input, length);
+    output.resize(maxDecodedSize(length - offset));
+
+    Stream stream;
+    size_t written = stream.update(input + offset, length - offset, output.data());
+    if (!stream.finish()) {
+        output.clear();
+        return false;
+    }
+    output.resize(written);
+    output.shrink_to_fit();
+    return !output.empty();
+}
+
+} // namespace Base64Decoder
@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Native base64 decoder used for the renderPageDirect base64Data path
+ * Runs of plain base64 are decoded 64 characters at a time with NEON on
+ * arm64 and 16 at a time with SSSE3 on x86; whitespace, padding and other
+ * architectures take the scalar table path.
+ */
+
+#ifndef BASE64_DECODER_H
+#define BASE64_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Base64Decoder {
+
+// Output space update() may need for length input characters, including the
+// slack the vector stores write past the decoded bytes
+size_t maxDecodedSize(size_t length);
+
+// Length of a leading "data:...;base64," prefix and any whitespace before it,
+// or 0 if there is none
+size_t dataUriPrefixLength(const char* input, size_t length);
+
+// Incremental decoder; input may be split at any character boundary
+class Stream {
+public:
+    Stream() = default;
+
+    // Decodes length characters into out (at least maxDecodedSize(length)
+    // bytes) and returns the number of bytes written. Returns 0 and marks the
+    // stream failed on malformed input.
+    size_t update(const char* input, size_t length, uint8_t* out);
+
+    // Checks the end of input: false (and failed) if the last group is a
+    // single symbol or its padding does not match the symbols before it.
+    // Unpadded 2- and 3-symbol groups are accepted.
+    bool finish();
+
+    bool failed() const { return m_failed; }
+
+private:
+    size_t decodeRuns(const char* input, size_t length, uint8_t*& out);
+
+    uint32_t m_accumulator = 0;
+    int m_bits = 0;
+    int m_padding = 0;
+    bool m_failed = false;
+};
+
+// Decodes standard (RFC 4648) base64, ignoring whitespace and an optional
+// "data:...;base64," prefix. Returns false on malformed input.
+bool decode(const char* input, size_t length, std::vector<uint8_t>& output);
+
+} // namespace Base64Decoder
+
+#endif // BASE64_DECODER_H
@@ -0,0 +1,257 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Size-classed pool of page pixel buffers used by the render engine
+ */
+
+#include "PDFBitmapPool.h"
+#include <cstdlib>
+
+namespace {
+
+std::atomic<uint64_t> g_nextGeneration{1};
+
+// Cache of the calling thread in the pool whose generation matches; pools are
+// told apart by generation so a thread never reuses a cache of another pool.
+// Giving the cache up (on exit or when the thread moves to another pool) lets
+// that pool hand it to a new thread.
+struct ThreadSlot {
+    uint64_t generation = 0;
+    void* cache = nullptr;
+    std::shared_ptr<std::atomic<bool>> owned;
+
+    ~ThreadSlot() { giveUp(); }
+
+    void giveUp() {
+        if (owned) {
+            owned->store(false, std::memory_order_release);
+            owned.reset();
+        }
+        cache = nullptr;
+    }
+};
+thread_local ThreadSlot t_slot;
+
+} // namespace
+
+PixelBuffer::PixelBuffer(PixelBuffer&& other) noexcept
+    : m_pool(other.m_pool), m_data(other.m_data), m_size(other.m_size), m_sizeClass(other.m_sizeClass) {
+    other.m_pool = nullptr;
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_sizeClass = -1;
+}
+
+PixelBuffer& PixelBuffer::operator=(PixelBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_pool = other.m_pool;
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_sizeClass = other.m_sizeClass;
+        other.m_pool = nullptr;
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_sizeClass = -1;
+    }
+    return *this;
+}
+
+bool PixelBuffer::allocate(PDFBitmapPool* pool, size_t size) {
+    release();
+    if (pool) {
+        m_data = pool->obtain(size, m_sizeClass);
+    } else {
+        m_data = static_cast<uint8_t*>(std::malloc(size));
+        m_sizeClass = -1;
+    }
+    if (!m_data) {
+        return false;
+    }
+    m_pool = pool;
+    m_size = size;
+    return true;
+}
+
+void PixelBuffer::release() {
+    if (!m_data) {
+        return;
+    }
+    if (m_pool) {
+        m_pool->recycle(m_data, m_sizeClass);
+    } else {
+        std::free(m_data);
+    }
+    m_pool = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+    m_sizeClass = -1;
+}
+
+PDFBitmapPool::PDFBitmapPool(size_t budgetBytes)
+    : m_generation(g_nextGeneration.fetch_add(1)), m_budgetBytes(budgetBytes) {}
+
+PDFBitmapPool::~PDFBitmapPool() {
+    clear();
+}
+
+size_t PDFBitmapPool::classBytes(int sizeClass) {
+    size_t base = kMinClassBytes << (sizeClass / kClassesPerDoubling);
+    return base / kClassesPerDoubling * (kClassesPerDoubling + sizeClass % kClassesPerDoubling);
+}
+
+int PDFBitmapPool::sizeClassFor(size_t size) {
+    for (int sizeClass = 0; sizeClass < kClassCount; ++sizeClass) {
+        if (classBytes(sizeClass) >= size) {
+            return sizeClass;
+        }
+    }
+    return -1;
+}
+
+uint8_t* PDFBitmapPool::obtain(size_t size, int& sizeClass) {
+    sizeClass = sizeClassFor(size);
+    if (sizeClass < 0) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return static_cast<uint8_t*>(std::malloc(size));
+    }
+
+    size_t bytes = classBytes(sizeClass);
+    uint8_t* block = nullptr;
+    if (ThreadCache* cache = threadCache()) {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        std::vector<uint8_t*>& blocks = cache->free.classes[sizeClass];
+        if (!blocks.empty()) {
+            block = blocks.back();
+            blocks.pop_back();
+        }
+    }
+    if (!block) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<uint8_t*>& blocks = m_shared.classes[sizeClass];
+        if (!blocks.empty()) {
+            block = blocks.back();
+            blocks.pop_back();
+        }
+    }
+
+    if (block) {
+        m_freeBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<uint8_t*>(std::malloc(bytes));
+}
+
+void PDFBitmapPool::recycle(uint8_t* block, int sizeClass) {
+    if (!block) {
+        return;
+    }
+    if (sizeClass < 0) {
+        std::free(block);
+        return;
+    }
+
+    size_t bytes = classBytes(sizeClass);
+    if (m_freeBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes > budget()) {
+        m_freeBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        std::free(block);
+        return;
+    }
+
+    if (ThreadCache* cache = threadCache()) {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        std::vector<uint8_t*>& blocks = cache->free.classes[sizeClass];
+        if (blocks.size() < kThreadCacheDepth) {
+            blocks.push_back(block);
+            return;
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_shared.classes[sizeClass].push_back(block);
+}
+
+void PDFBitmapPool::setBudget(size_t budgetBytes) {
+    m_budgetBytes.store(budgetBytes, std::memory_order_relaxed);
+    trimTo(budgetBytes);
+}
+
+size_t PDFBitmapPool::trimTo(size_t targetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t released = releaseFrom(m_shared, targetBytes);
+    for (auto& cache : m_threadCaches) {
+        std::lock_guard<std::mutex> cacheLock(cache->mutex);
+        released += releaseFrom(cache->free, targetBytes);
+    }
+    return released;
+}
+
+// Frees the largest blocks first until at most targetBytes stay pooled
+size_t PDFBitmapPool::releaseFrom(FreeList& list, size_t targetBytes) {
+    size_t released = 0;
+    for (int sizeClass = kClassCount - 1; sizeClass >= 0; --sizeClass) {
+        std::vector<uint8_t*>& blocks = list.classes[sizeClass];
+        size_t bytes = classBytes(sizeClass);
+        while (!blocks.empty() && m_freeBytes.load(std::memory_order_relaxed) > targetBytes) {
+            std::free(blocks.back());
+            blocks.pop_back();
+            m_freeBytes.fetch_sub(bytes, std::memory_order_relaxed);
+            released += bytes;
+        }
+        if (blocks.empty()) {
+            std::vector<uint8_t*>().swap(blocks);
+        }
+    }
+    return released;
+}
+
+BitmapPoolStats PDFBitmapPool::stats() {
+    BitmapPoolStats stats;
+    stats.hits = m_hits.load(std::memory_order_relaxed);
+    stats.misses = m_misses.load(std::memory_order_relaxed);
+    stats.freeBytes = m_freeBytes.load(std::memory_order_relaxed);
+    stats.budgetBytes = budget();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& blocks : m_shared.classes) {
+        stats.freeBlocks += blocks.size();
+    }
+    for (auto& cache : m_threadCaches) {
+        std::lock_guard<std::mutex> cacheLock(cache->mutex);
+        for (const auto& blocks : cache->free.classes) {
+            stats.freeBlocks += blocks.size();
+        }
+    }
+    return stats;
+}
+
+PDFBitmapPool::ThreadCache* PDFBitmapPool::threadCache() {
+    if (t_slot.generation == m_generation) {
+        return static_cast<ThreadCache*>(t_slot.cache);
+    }
+
+    t_slot.giveUp();
+    t_slot.generation = m_generation;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ThreadCache* cache = nullptr;
+    for (auto& candidate : m_threadCaches) {
+        if (!candidate->owned->load(std::memory_order_acquire)) {
+            cache = candidate.get();
+            break;
+        }
+    }
+    if (!cache && m_threadCaches.size() < kMaxThreadCaches) {
+        m_threadCaches.push_back(std::unique_ptr<ThreadCache>(new ThreadCache()));
+        cache = m_threadCaches.back().get();
+    }
+    if (cache) {
+        cache->owned->store(true, std::memory_order_relaxed);
+        t_slot.cache = cache;
+        t_slot.owned = cache->owned;
+    }
+    return cache;
+}
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Size-classed pool of page pixel buffers used by the render engine
+ * Blocks are bucketed by byte size rather than by dimensions, so a render at
+ * a new zoom level reuses any free block of its class. Each thread keeps a
+ * short free list of its own; the shared list behind the pool mutex only sees
+ * overflow and refills. A thread gives its cache up when it exits, and the
+ * next new thread adopts it with its blocks.
+ */
+
+#ifndef PDF_BITMAP_POOL_H
+#define PDF_BITMAP_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class PDFBitmapPool;
+
+// Pixel memory of one page bitmap; the block goes back to its pool when the
+// buffer is released or destroyed
+class PixelBuffer {
+public:
+    PixelBuffer() = default;
+    ~PixelBuffer() { release(); }
+    PixelBuffer(PixelBuffer&& other) noexcept;
+    PixelBuffer& operator=(PixelBuffer&& other) noexcept;
+
+    // Replaces the contents with an uninitialized block of at least size
+    // bytes, from pool if given. Returns false if memory is exhausted.
+    bool allocate(PDFBitmapPool* pool, size_t size);
+    void release();
+
+    // Shortens the logical size; the block keeps its capacity
+    void shrink(size_t size) { if (size < m_size) m_size = size; }
+
+    uint8_t* data() { return m_data; }
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+private:
+    PixelBuffer(const PixelBuffer&) = delete;
+    PixelBuffer& operator=(const PixelBuffer&) = delete;
+
+    PDFBitmapPool* m_pool = nullptr;
+    uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    int m_sizeClass = -1;
+};
+
+struct BitmapPoolStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t freeBlocks = 0;
+    size_t freeBytes = 0;
+    size_t budgetBytes = 0;
+
+    double hitRatio() const {
+        uint64_t total = hits + misses;
+        return total > 0 ? static_cast<double>(hits) / total : 0.0;
+    }
+};
+
+class PDFBitmapPool {
+public:
+    static constexpr size_t kDefaultBudgetBytes = 16 * 1024 * 1024;
+    // Four classes per power of two from 64 KB, so a block wastes at most a
+    // quarter of its size; larger requests bypass the pool
+    static constexpr size_t kMinClassBytes = 64 * 1024;
+    static constexpr int kClassesPerDoubling = 4;
+    static constexpr int kClassCount = 10 * kClassesPerDoubling + 1;   // up to 64 MB
+    // Free blocks a thread keeps per class before handing them to the shared list
+    static constexpr size_t kThreadCacheDepth = 2;
+    // Live threads beyond this share the pool list instead of getting a cache
+    static constexpr size_t kMaxThreadCaches = 16;
+
+    explicit PDFBitmapPool(size_t budgetBytes = kDefaultBudgetBytes);
+    ~PDFBitmapPool();
+
+    // Size class serving size bytes, or -1 when it is too large to pool
+    static int sizeClassFor(size_t size);
+    static size_t classBytes(int sizeClass);
+
+    // Block of classBytes(sizeClass) bytes (or exactly size for sizeClass -1);
+    // nullptr if allocation fails
+    uint8_t* obtain(size_t size, int& sizeClass);
+    // Keeps the block for reuse while the free bytes stay within budget
+    void recycle(uint8_t* block, int sizeClass);
+
+    // Budget for free blocks; lowering it trims immediately
+    void setBudget(size_t budgetBytes);
+    size_t budget() const { return m_budgetBytes.load(std::memory_order_relaxed); }
+
+    // Each returns the number of bytes released to the system
+    size_t trimTo(size_t targetBytes);
+    size_t clear() { return trimTo(0); }
+
+    BitmapPoolStats stats();
+
+private:
+    PDFBitmapPool(const PDFBitmapPool&) = delete;
+    PDFBitmapPool& operator=(const PDFBitmapPool&) = delete;
+
+    struct FreeList {
+        std::vector<uint8_t*> classes[kClassCount];
+    };
+
+    // Only the owning thread and trims take the mutex, so it is uncontended
+    // on the render path. owned is shared with the thread's slot, which clears
+    // it on thread exit even if the pool is gone by then.
+    struct ThreadCache {
+        std::mutex mutex;
+        FreeList free;
+        std::shared_ptr<std::atomic<bool>> owned = std::make_shared<std::atomic<bool>>(true);
+    };
+
+    ThreadCache* threadCache();
+    size_t releaseFrom(FreeList& list, size_t targetBytes);
+
+    const uint64_t m_generation;
+    std::atomic<size_t> m_budgetBytes;
+    std::atomic<size_t> m_freeBytes{0};
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+
+    FreeList m_shared;
+    std::vector<std::unique_ptr<ThreadCache>> m_threadCaches;
+    std::mutex m_mutex;
+};
+
+#endif // PDF_BITMAP_POOL_H
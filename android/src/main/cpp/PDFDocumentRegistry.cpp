@@ -0,0 +1,333 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Reference-counted registry of open native documents keyed by pdfId
+ */
+
+#include "PDFDocumentRegistry.h"
+#include "PDFJSILog.h"
+#include "PDFTrace.h"
+#include "Base64Decoder.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+std::string stripFileScheme(const std::string& path) {
+    static const std::string fileScheme = "file://";
+    if (path.compare(0, fileScheme.size(), fileScheme) == 0) {
+        return path.substr(fileScheme.size());
+    }
+    return path;
+}
+
+} // namespace
+
+PDFDocument::~PDFDocument() {
+    close();
+}
+
+void PDFDocument::close() {
+    const PdfiumApi* api = PdfiumApi::get();
+    {
+        std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+        if (api && handle) {
+            api->closeDocument(handle);
+        }
+        handle = nullptr;
+    }
+    std::vector<uint8_t>().swap(data);
+    if (mapping) {
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+    }
+}
+
+PDFDocumentRegistry::~PDFDocumentRegistry() {
+    closeAll();
+}
+
+std::shared_ptr<PDFDocument> PDFDocumentRegistry::acquire(const std::string& pdfId, const DocumentSource& source, std::string& error) {
+    std::string path;
+    bool inMemory = !source.base64Data.empty() || (source.data && !source.data->empty());
+    if (source.fd >= 0) {
+        path = descriptorPath(source.fd);
+    } else if (!inMemory) {
+        path = canonicalPath(source.filePath.empty() ? pdfId : source.filePath);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (std::shared_ptr<PDFDocument> existing = reuseLocked(pdfId, path)) {
+            return existing;
+        }
+    }
+
+    // Parse outside the registry lock so lookups of other documents don't stall
+    DocumentSource resolved = source;
+    if (!inMemory && resolved.fd < 0) {
+        resolved.filePath = path;
+    }
+    std::shared_ptr<PDFDocument> document = open(pdfId, resolved, error);
+    if (!document) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Another thread may have opened the same pdfId or path meanwhile; keep
+    // theirs and drop ours (closed once the lock is released)
+    if (std::shared_ptr<PDFDocument> existing = reuseLocked(pdfId, document->path)) {
+        return existing;
+    }
+    m_entries[pdfId] = Entry{document, 1};
+    if (!document->path.empty()) {
+        m_byPath[document->path] = document;
+    }
+    LOGI("Registry: opened %s (%d pages), %zu open", pdfId.c_str(), document->pageCount, m_entries.size());
+    return document;
+}
+
+std::shared_ptr<PDFDocument> PDFDocumentRegistry::reuseLocked(const std::string& pdfId, const std::string& path) {
+    auto it = m_entries.find(pdfId);
+    if (it != m_entries.end()) {
+        it->second.refCount++;
+        return it->second.document;
+    }
+    if (path.empty()) {
+        return nullptr;
+    }
+    auto shared = m_byPath.find(path);
+    std::shared_ptr<PDFDocument> document = shared != m_byPath.end() ? shared->second.lock() : nullptr;
+    if (!document || !document->handle) {
+        return nullptr;
+    }
+    LOGD("Registry: %s shares open document %s", pdfId.c_str(), document->pdfId.c_str());
+    m_entries[pdfId] = Entry{document, 1};
+    return document;
+}
+
+void PDFDocumentRegistry::release(const std::string& pdfId) {
+    std::shared_ptr<PDFDocument> closing;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(pdfId);
+        if (it == m_entries.end()) {
+            return;
+        }
+        if (--it->second.refCount > 0) {
+            return;
+        }
+        closing = it->second.document;
+        m_entries.erase(it);
+
+        // Only close when no alias still references the same document
+        for (const auto& entry : m_entries) {
+            if (entry.second.document == closing) {
+                return;
+            }
+        }
+        if (!closing->path.empty()) {
+            m_byPath.erase(closing->path);
+        }
+    }
+    LOGI("Registry: closing %s", pdfId.c_str());
+    closing->close();
+}
+
+std::shared_ptr<PDFDocument> PDFDocumentRegistry::find(const std::string& pdfId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(pdfId);
+    return it != m_entries.end() ? it->second.document : nullptr;
+}
+
+int PDFDocumentRegistry::referenceCount(const std::string& pdfId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(pdfId);
+    return it != m_entries.end() ? it->second.refCount : 0;
+}
+
+size_t PDFDocumentRegistry::size() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+size_t PDFDocumentRegistry::mappedResidentBytes() {
+    size_t total = 0;
+    for (const auto& document : openDocuments()) {
+        // close() clears the handle under the Pdfium lock before unmapping
+        std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+        if (document->handle && document->mapping) {
+            total += residentBytes(*document);
+        }
+    }
+    return total;
+}
+
+size_t PDFDocumentRegistry::releaseMappedPages() {
+    size_t released = 0;
+    for (const auto& document : openDocuments()) {
+        std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+        if (!document->handle || !document->mapping) {
+            continue;
+        }
+        size_t resident = residentBytes(*document);
+        // The mapping is private and read-only, so nothing is lost: pages
+        // are read back from the file on the next fault
+        if (resident > 0 && madvise(document->mapping, document->mappingSize, MADV_DONTNEED) == 0) {
+            released += resident;
+        }
+    }
+    return released;
+}
+
+std::vector<std::shared_ptr<PDFDocument>> PDFDocumentRegistry::openDocuments() {
+    std::vector<std::shared_ptr<PDFDocument>> documents;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& entry : m_entries) {
+        // Aliases share a document; list it once
+        if (std::find(documents.begin(), documents.end(), entry.second.document) == documents.end()) {
+            documents.push_back(entry.second.document);
+        }
+    }
+    return documents;
+}
+
+size_t PDFDocumentRegistry::residentBytes(const PDFDocument& document) {
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> pages((document.mappingSize + pageSize - 1) / pageSize);
+    if (pages.empty() || mincore(document.mapping, document.mappingSize, pages.data()) != 0) {
+        return 0;
+    }
+    size_t resident = 0;
+    for (unsigned char page : pages) {
+        resident += page & 1;
+    }
+    return resident * pageSize;
+}
+
+void PDFDocumentRegistry::closeAll() {
+    std::map<std::string, Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        entries.swap(m_entries);
+        m_byPath.clear();
+    }
+    for (auto& entry : entries) {
+        entry.second.document->close();
+    }
+}
+
+std::shared_ptr<PDFDocument> PDFDocumentRegistry::open(const std::string& pdfId, const DocumentSource& source, std::string& error) {
+    PDFJSI_TRACE_SCOPE(kOpenDocument);
+    const PdfiumApi* api = PdfiumApi::get();
+    if (!api) {
+        error = "Pdfium library not available";
+        return nullptr;
+    }
+
+    auto document = std::make_shared<PDFDocument>();
+    document->pdfId = pdfId;
+
+    if (source.data && !source.data->empty()) {
+        document->data.swap(*source.data);
+    } else if (!source.base64Data.empty()) {
+        if (!Base64Decoder::decode(source.base64Data.data(), source.base64Data.size(), document->data)) {
+            error = "Invalid base64 data";
+            return nullptr;
+        }
+    }
+    if (!document->data.empty()) {
+        std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+        document->handle = api->loadMemDocument(document->data.data(),
+                                                static_cast<int>(document->data.size()), nullptr);
+        if (!document->handle) {
+            error = PdfiumApi::describeError(api->getLastError());
+            return nullptr;
+        }
+        document->pageCount = api->getPageCount(document->handle);
+        return document;
+    }
+
+    if (source.fd >= 0) {
+        if (!mapDescriptor(source.fd, *document, error)) {
+            return nullptr;
+        }
+        document->path = descriptorPath(source.fd);
+        std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+        document->handle = api->loadMemDocument(document->mapping, static_cast<int>(document->mappingSize), nullptr);
+        if (!document->handle) {
+            error = PdfiumApi::describeError(api->getLastError());
+            return nullptr;
+        }
+        document->pageCount = api->getPageCount(document->handle);
+        return document;
+    }
+
+    if (source.filePath.empty() || access(source.filePath.c_str(), R_OK) != 0) {
+        error = "No document source for pdfId: " + pdfId;
+        return nullptr;
+    }
+
+    document->path = source.filePath;
+    std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+    document->handle = api->loadDocument(document->path.c_str(), nullptr);
+    if (!document->handle) {
+        error = PdfiumApi::describeError(api->getLastError());
+        return nullptr;
+    }
+    document->pageCount = api->getPageCount(document->handle);
+    return document;
+}
+
+std::string PDFDocumentRegistry::canonicalPath(const std::string& path) {
+    std::string stripped = stripFileScheme(path);
+    char resolved[PATH_MAX];
+    if (realpath(stripped.c_str(), resolved)) {
+        return std::string(resolved);
+    }
+    return stripped;
+}
+
+std::string PDFDocumentRegistry::descriptorPath(int fd) {
+    // Lets descriptor opens share a document with path opens of the same file
+    char link[64];
+    snprintf(link, sizeof(link), "/proc/self/fd/%d", fd);
+    char resolved[PATH_MAX];
+    ssize_t length = readlink(link, resolved, sizeof(resolved) - 1);
+    if (length <= 0 || resolved[0] != '/') {
+        return std::string();
+    }
+    resolved[length] = '\0';
+    return canonicalPath(resolved);
+}
+
+bool PDFDocumentRegistry::mapDescriptor(int fd, PDFDocument& document, std::string& error) {
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        error = "Descriptor is not a regular file";
+        return false;
+    }
+    if (info.st_size <= 0 || info.st_size > INT_MAX) {
+        error = "Unsupported document size: " + std::to_string(static_cast<long long>(info.st_size));
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        error = "Failed to map document";
+        return false;
+    }
+    // Pdfium seeks to the trailer and follows object offsets, so skip readahead
+    madvise(mapping, size, MADV_RANDOM);
+    document.mapping = mapping;
+    document.mappingSize = size;
+    return true;
+}
@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Reference-counted registry of open native documents keyed by pdfId
+ */
+
+#ifndef PDF_DOCUMENT_REGISTRY_H
+#define PDF_DOCUMENT_REGISTRY_H
+
+#include "PdfiumApi.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Geometry of one page in PDF points; boxes are left, bottom, right, top
+struct PageGeometry {
+    bool known = false;
+    // Displayed size: crop box with the page rotation applied
+    float width = 0.0f;
+    float height = 0.0f;
+    float mediaBox[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float cropBox[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    int rotation = 0;
+    // Pdfium has no /UserUnit accessor, so this stays 1 on Android
+    float userUnit = 1.0f;
+};
+
+// Values per page in the flat geometry tables exchanged with Java: width,
+// height, mediaBox[4], cropBox[4], rotation, userUnit
+#define PDFJSI_PAGE_GEOMETRY_FIELDS 12
+
+// An open Pdfium document. The handle may only be used while holding
+// PdfiumApi::mutex(); close() invalidates it for every holder.
+struct PDFDocument {
+    std::string pdfId;
+    std::string path;
+    FPDF_DOCUMENT handle = nullptr;
+    int pageCount = 0;
+    // Backing store for FPDF_LoadMemDocument; must outlive the handle
+    std::vector<uint8_t> data;
+    // Read-only file mapping for documents opened from a descriptor; pages
+    // fault in lazily from the page cache instead of being copied to the heap
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    // Per-page geometry, filled as pages are measured or seeded from the table
+    // persisted with a cached file (PDFRenderEngine::setPageGeometry)
+    std::vector<PageGeometry> geometry;
+    std::mutex geometryMutex;
+    // Content checksum naming this document's pages in the persistent page
+    // store; empty (nothing stored) until PDFRenderEngine::setPageStoreKey
+    std::string storeKey;
+    std::mutex storeKeyMutex;
+
+    PDFDocument() = default;
+    ~PDFDocument();
+    void close();
+
+private:
+    PDFDocument(const PDFDocument&) = delete;
+    PDFDocument& operator=(const PDFDocument&) = delete;
+};
+
+// Where to open a document from when it is not registered yet
+struct DocumentSource {
+    std::string filePath;
+    std::string base64Data;
+    // Already decoded document bytes; swapped into the document when opened
+    std::shared_ptr<std::vector<uint8_t>> data;
+    // Open file descriptor to map read-only; not owned, the mapping outlives it
+    int fd = -1;
+};
+
+class PDFDocumentRegistry {
+public:
+    PDFDocumentRegistry() = default;
+    ~PDFDocumentRegistry();
+
+    // Opens the document on first use and adds a reference for pdfId.
+    // Different pdfIds that resolve to the same file share one document.
+    std::shared_ptr<PDFDocument> acquire(const std::string& pdfId, const DocumentSource& source, std::string& error);
+
+    // Drops one reference; the document closes when its last reference goes
+    void release(const std::string& pdfId);
+
+    // Looks up an open document without changing its reference count
+    std::shared_ptr<PDFDocument> find(const std::string& pdfId);
+
+    int referenceCount(const std::string& pdfId);
+    size_t size();
+
+    // Bytes of document mappings currently resident in memory
+    size_t mappedResidentBytes();
+    // Drops the resident pages of every mapped document; they fault back in
+    // from the file when next read. Returns the bytes that were resident.
+    size_t releaseMappedPages();
+
+    // Closes every document regardless of outstanding references
+    void closeAll();
+
+private:
+    PDFDocumentRegistry(const PDFDocumentRegistry&) = delete;
+    PDFDocumentRegistry& operator=(const PDFDocumentRegistry&) = delete;
+
+    struct Entry {
+        std::shared_ptr<PDFDocument> document;
+        int refCount = 0;
+    };
+
+    // Caller holds m_mutex. Adds a reference to pdfId's entry, or aliases pdfId to
+    // the document already open for path; nullptr if neither exists.
+    std::shared_ptr<PDFDocument> reuseLocked(const std::string& pdfId, const std::string& path);
+    static std::shared_ptr<PDFDocument> open(const std::string& pdfId, const DocumentSource& source, std::string& error);
+    static std::string canonicalPath(const std::string& path);
+    static std::string descriptorPath(int fd);
+    static bool mapDescriptor(int fd, PDFDocument& document, std::string& error);
+    std::vector<std::shared_ptr<PDFDocument>> openDocuments();
+    static size_t residentBytes(const PDFDocument& document);
+
+    std::map<std::string, Entry> m_entries;
+    // Canonical file path -> document, so aliases reuse one parse
+    std::map<std::string, std::weak_ptr<PDFDocument>> m_byPath;
+    std::mutex m_mutex;
+};
+
+#endif // PDF_DOCUMENT_REGISTRY_H
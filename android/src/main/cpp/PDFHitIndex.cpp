@@ -0,0 +1,569 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Per-page spatial index of glyph, word and link boxes
+ */
+
+#include "PDFHitIndex.h"
+#include "PDFJSILog.h"
+#include "PDFTrace.h"
+#include "PdfiumApi.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Cells per axis grow with the square root of the box count, so a lookup
+// scans a handful of boxes on dense pages without a huge grid on sparse ones
+const int kMaxGridCells = 64;
+
+// Rough cost of an index entry beyond its vectors (list node, key, map slot)
+const size_t kEntryOverheadBytes = 128;
+
+bool isBreak(char16_t c) {
+    return c == u' ' || c == u'\t' || c == u'\r' || c == u'\n' || c == 0x00A0 ||
+           c == 0x2028 || c == 0x2029 || c == 0x3000 || c == 0xFFFE;
+}
+
+} // namespace
+
+float HitRect::distanceTo(float x, float y) const {
+    float dx = x < left ? left - x : (x > right ? x - right : 0.0f);
+    float dy = y < bottom ? bottom - y : (y > top ? y - top : 0.0f);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+void HitRect::unite(const HitRect& other) {
+    if (other.empty()) {
+        return;
+    }
+    if (empty()) {
+        *this = other;
+        return;
+    }
+    left = std::min(left, other.left);
+    bottom = std::min(bottom, other.bottom);
+    right = std::max(right, other.right);
+    top = std::max(top, other.top);
+}
+
+void HitGrid::build(const std::vector<HitRect>& boxes, const HitRect& bounds) {
+    m_bounds = bounds;
+    m_cellStart.clear();
+    m_items.clear();
+    if (boxes.empty() || bounds.empty()) {
+        m_columns = 0;
+        m_rows = 0;
+        return;
+    }
+    int cells = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(boxes.size()))));
+    m_columns = std::max(1, std::min(kMaxGridCells, cells));
+    m_rows = m_columns;
+    m_cellWidth = (bounds.right - bounds.left) / m_columns;
+    m_cellHeight = (bounds.top - bounds.bottom) / m_rows;
+
+    // Two passes (count, then fill) keep every cell's items in one array
+    size_t cellCount = static_cast<size_t>(m_columns) * m_rows;
+    m_cellStart.assign(cellCount + 1, 0);
+    for (const HitRect& box : boxes) {
+        if (box.empty()) {
+            continue;
+        }
+        for (int row = cellRow(box.bottom); row <= cellRow(box.top); ++row) {
+            for (int column = cellColumn(box.left); column <= cellColumn(box.right); ++column) {
+                ++m_cellStart[row * m_columns + column + 1];
+            }
+        }
+    }
+    for (size_t c = 0; c < cellCount; ++c) {
+        m_cellStart[c + 1] += m_cellStart[c];
+    }
+    m_items.resize(m_cellStart[cellCount]);
+    std::vector<uint32_t> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const HitRect& box = boxes[i];
+        if (box.empty()) {
+            continue;
+        }
+        for (int row = cellRow(box.bottom); row <= cellRow(box.top); ++row) {
+            for (int column = cellColumn(box.left); column <= cellColumn(box.right); ++column) {
+                m_items[fill[row * m_columns + column]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+}
+
+void HitGrid::query(float x, float y, float tolerance, std::vector<uint32_t>& indices) const {
+    indices.clear();
+    if (m_columns == 0) {
+        return;
+    }
+    int firstRow = cellRow(y - tolerance);
+    int lastRow = cellRow(y + tolerance);
+    int firstColumn = cellColumn(x - tolerance);
+    int lastColumn = cellColumn(x + tolerance);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            size_t cell = static_cast<size_t>(row) * m_columns + column;
+            indices.insert(indices.end(), m_items.begin() + m_cellStart[cell], m_items.begin() + m_cellStart[cell + 1]);
+        }
+    }
+}
+
+int HitGrid::cellColumn(float x) const {
+    int column = static_cast<int>(std::floor((x - m_bounds.left) / m_cellWidth));
+    return std::max(0, std::min(m_columns - 1, column));
+}
+
+int HitGrid::cellRow(float y) const {
+    int row = static_cast<int>(std::floor((y - m_bounds.bottom) / m_cellHeight));
+    return std::max(0, std::min(m_rows - 1, row));
+}
+
+bool PageHitGeometry::rangeBox(int offset, int length, HitRect& box) const {
+    box = HitRect();
+    int end = std::min(offset + length, static_cast<int>(glyphs.size()));
+    for (int c = std::max(0, offset); c < end; ++c) {
+        box.unite(glyphs[c]);
+    }
+    return !box.empty();
+}
+
+int PageHitGeometry::wordAt(float x, float y, float tolerance) const {
+    std::vector<uint32_t> candidates;
+    wordGrid.query(x, y, tolerance, candidates);
+    int best = -1;
+    float bestDistance = tolerance;
+    for (uint32_t index : candidates) {
+        float distance = words[index].rect.distanceTo(x, y);
+        if (distance < bestDistance || (distance == bestDistance && (best < 0 || static_cast<int>(index) < best))) {
+            best = static_cast<int>(index);
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+int PageHitGeometry::linkAt(float x, float y, float tolerance) const {
+    std::vector<uint32_t> candidates;
+    linkGrid.query(x, y, tolerance, candidates);
+    int best = -1;
+    float bestDistance = tolerance;
+    for (uint32_t index : candidates) {
+        float distance = links[index].rect.distanceTo(x, y);
+        if (distance < bestDistance || (distance == bestDistance && (best < 0 || static_cast<int>(index) < best))) {
+            best = static_cast<int>(index);
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+PDFHitIndex::~PDFHitIndex() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_pending.clear();
+    }
+    m_wake.notify_all();
+    if (m_builder.joinable()) {
+        m_builder.join();
+    }
+}
+
+std::shared_ptr<const PageHitGeometry> PDFHitIndex::geometry(const std::shared_ptr<PDFDocument>& document,
+                                                             int pageNumber, std::string& error) {
+    if (!document) {
+        error = "Document is closed";
+        return nullptr;
+    }
+    if (pageNumber < 1 || pageNumber > document->pageCount) {
+        error = "Invalid page number: " + std::to_string(pageNumber);
+        return nullptr;
+    }
+    if (std::shared_ptr<const PageHitGeometry> cached = cachedGeometry(*document, pageNumber)) {
+        return cached;
+    }
+    std::shared_ptr<PageHitGeometry> built = build(*document, pageNumber, error);
+    if (!built) {
+        return nullptr;
+    }
+    insert(document, built);
+    return built;
+}
+
+std::shared_ptr<const PageHitGeometry> PDFHitIndex::cachedGeometry(const PDFDocument& document, int pageNumber) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(keyFor(document.pdfId, pageNumber));
+    if (it == m_index.end()) {
+        return nullptr;
+    }
+    // A document reopened under the same id has its pages indexed again
+    std::shared_ptr<PDFDocument> owner = it->second->document.lock();
+    if (owner.get() != &document) {
+        m_bytes -= it->second->geometry->bytes;
+        m_lru.erase(it->second);
+        m_index.erase(it);
+        return nullptr;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return it->second->geometry;
+}
+
+void PDFHitIndex::prefetch(const std::shared_ptr<PDFDocument>& document, int pageNumber) {
+    if (!document || pageNumber < 1 || pageNumber > document->pageCount) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping || m_budgetBytes == 0 || m_index.count(keyFor(document->pdfId, pageNumber)) > 0) {
+            return;
+        }
+        for (const PendingPage& pending : m_pending) {
+            if (pending.pageNumber == pageNumber && pending.document.lock() == document) {
+                return;
+            }
+        }
+        // Rendering runs ahead of taps; the newest pages are the ones on screen
+        if (m_pending.size() >= kMaxPendingPages) {
+            m_pending.pop_front();
+        }
+        PendingPage page;
+        page.document = document;
+        page.pageNumber = pageNumber;
+        m_pending.push_back(page);
+        if (!m_builder.joinable()) {
+            m_builder = std::thread(&PDFHitIndex::builderLoop, this);
+        }
+    }
+    m_wake.notify_one();
+}
+
+bool PDFHitIndex::hitTest(const std::shared_ptr<PDFDocument>& document, int pageNumber, float x, float y,
+                          float tolerance, PageHit& hit, std::string& error) {
+    hit = PageHit();
+    std::shared_ptr<const PageHitGeometry> page = geometry(document, pageNumber, error);
+    if (!page) {
+        return false;
+    }
+    PDFJSI_TRACE_SCOPE(kHitTest);
+
+    // Links sit on top of their text, so a tap inside one follows it
+    int link = page->linkAt(x, y, 0.0f);
+    if (link < 0) {
+        link = page->linkAt(x, y, tolerance);
+    }
+    if (link >= 0) {
+        const PageLink& target = page->links[link];
+        hit.kind = kPageHitLink;
+        hit.rect = target.rect;
+        hit.targetPage = target.targetPage;
+        hit.uri = target.uri;
+
+        // The link's text is the words overlapping its box
+        float halfWidth = (target.rect.right - target.rect.left) / 2;
+        float halfHeight = (target.rect.top - target.rect.bottom) / 2;
+        std::vector<uint32_t> candidates;
+        page->wordGrid.query(target.rect.left + halfWidth, target.rect.bottom + halfHeight,
+                             std::max(halfWidth, halfHeight), candidates);
+        int start = -1;
+        int end = -1;
+        for (uint32_t index : candidates) {
+            const PageWord& word = page->words[index];
+            if (word.rect.right <= target.rect.left || word.rect.left >= target.rect.right ||
+                word.rect.top <= target.rect.bottom || word.rect.bottom >= target.rect.top) {
+                continue;
+            }
+            start = start < 0 ? word.offset : std::min(start, word.offset);
+            end = std::max(end, word.offset + word.length);
+        }
+        if (start >= 0) {
+            hit.offset = start;
+            hit.length = end - start;
+            hit.text = page->text.substr(start, end - start);
+        }
+        return true;
+    }
+
+    int word = page->wordAt(x, y, tolerance);
+    if (word >= 0) {
+        const PageWord& match = page->words[word];
+        hit.kind = kPageHitWord;
+        hit.rect = match.rect;
+        hit.offset = match.offset;
+        hit.length = match.length;
+        hit.text = page->text.substr(match.offset, match.length);
+    }
+    return true;
+}
+
+bool PDFHitIndex::selectWords(const std::shared_ptr<PDFDocument>& document, int pageNumber, float x0, float y0,
+                              float x1, float y1, float tolerance, std::vector<PageWord>& words,
+                              std::u16string& text, std::string& error) {
+    words.clear();
+    text.clear();
+    std::shared_ptr<const PageHitGeometry> page = geometry(document, pageNumber, error);
+    if (!page) {
+        return false;
+    }
+    PDFJSI_TRACE_SCOPE(kHitTest);
+
+    int first = page->wordAt(x0, y0, tolerance);
+    int last = page->wordAt(x1, y1, tolerance);
+    if (first < 0 && last < 0) {
+        return true;
+    }
+    if (first < 0) {
+        first = last;
+    } else if (last < 0) {
+        last = first;
+    }
+    if (first > last) {
+        std::swap(first, last);
+    }
+    words.assign(page->words.begin() + first, page->words.begin() + last + 1);
+    int start = words.front().offset;
+    int end = words.back().offset + words.back().length;
+    text = page->text.substr(start, end - start);
+    return true;
+}
+
+void PDFHitIndex::forget(const std::string& pdfId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_lru.begin(); it != m_lru.end();) {
+        if (it->pdfId == pdfId) {
+            m_bytes -= it->geometry->bytes;
+            m_index.erase(it->key);
+            it = m_lru.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        std::shared_ptr<PDFDocument> document = it->document.lock();
+        it = !document || document->pdfId == pdfId ? m_pending.erase(it) : it + 1;
+    }
+}
+
+size_t PDFHitIndex::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t released = m_bytes;
+    m_lru.clear();
+    m_index.clear();
+    m_pending.clear();
+    m_bytes = 0;
+    return released;
+}
+
+size_t PDFHitIndex::trimTo(size_t targetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t before = m_bytes;
+    evictLocked(targetBytes);
+    return before - m_bytes;
+}
+
+void PDFHitIndex::setBudget(size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budgetBytes = budgetBytes;
+    evictLocked(m_budgetBytes);
+}
+
+size_t PDFHitIndex::budget() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budgetBytes;
+}
+
+size_t PDFHitIndex::memoryBytes() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bytes;
+}
+
+std::string PDFHitIndex::keyFor(const std::string& pdfId, int pageNumber) {
+    return pdfId + "#" + std::to_string(pageNumber);
+}
+
+std::shared_ptr<PageHitGeometry> PDFHitIndex::build(const PDFDocument& document, int pageNumber, std::string& error) {
+    PDFJSI_TRACE_SCOPE(kHitIndexBuild);
+    auto geometry = std::make_shared<PageHitGeometry>();
+    geometry->pageNumber = pageNumber;
+    HitRect bounds;
+    {
+        const PdfiumApi* api = PdfiumApi::get();
+        std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+        if (!document.handle) {
+            error = "Document is closed";
+            return nullptr;
+        }
+        FPDF_PAGE page = api->loadPage(document.handle, pageNumber - 1);
+        if (!page) {
+            error = PdfiumApi::describeError(api->getLastError());
+            return nullptr;
+        }
+        bounds.right = static_cast<float>(api->getPageWidth(page));
+        bounds.top = static_cast<float>(api->getPageHeight(page));
+
+        // Pages without a text layer (scans) still get their links
+        FPDF_TEXTPAGE textPage = api->textLoadPage(page);
+        if (textPage) {
+            int count = std::max(0, api->textCountChars(textPage));
+            geometry->text.resize(count);
+            geometry->glyphs.resize(count);
+            for (int i = 0; i < count; ++i) {
+                geometry->text[i] = static_cast<char16_t>(api->textGetUnicode(textPage, i));
+                double left, right, bottom, top;
+                if (api->textGetCharBox(textPage, i, &left, &right, &bottom, &top)) {
+                    HitRect& glyph = geometry->glyphs[i];
+                    glyph.left = static_cast<float>(left);
+                    glyph.right = static_cast<float>(right);
+                    glyph.bottom = static_cast<float>(bottom);
+                    glyph.top = static_cast<float>(top);
+                }
+            }
+            api->textClosePage(textPage);
+        }
+
+        if (api->supportsLinks()) {
+            int position = 0;
+            FPDF_LINK link = nullptr;
+            while (api->linkEnumerate(page, &position, &link)) {
+                FS_RECTF area;
+                if (!api->linkGetAnnotRect(link, &area)) {
+                    continue;
+                }
+                PageLink entry;
+                entry.rect.left = std::min(area.left, area.right);
+                entry.rect.right = std::max(area.left, area.right);
+                entry.rect.bottom = std::min(area.bottom, area.top);
+                entry.rect.top = std::max(area.bottom, area.top);
+
+                FPDF_DEST dest = api->linkGetDest(document.handle, link);
+                FPDF_ACTION action = api->linkGetAction(link);
+                if (!dest && action) {
+                    dest = api->actionGetDest(document.handle, action);
+                }
+                if (dest) {
+                    int index = api->destGetPageIndex(document.handle, dest);
+                    entry.targetPage = index >= 0 ? index + 1 : 0;
+                }
+                if (action && entry.targetPage == 0) {
+                    // Length includes the terminating NUL; 0 when the action is not a URI
+                    unsigned long length = api->actionGetURIPath(document.handle, action, nullptr, 0);
+                    if (length > 1) {
+                        entry.uri.resize(length);
+                        api->actionGetURIPath(document.handle, action, &entry.uri[0], length);
+                        entry.uri.resize(length - 1);
+                    }
+                }
+                if (!entry.rect.empty() && (entry.targetPage > 0 || !entry.uri.empty())) {
+                    geometry->links.push_back(std::move(entry));
+                }
+            }
+        }
+        api->closePage(page);
+    }
+
+    // Words end at whitespace and at characters Pdfium generated without a box
+    const std::u16string& text = geometry->text;
+    int start = -1;
+    for (int i = 0; i <= static_cast<int>(text.size()); ++i) {
+        bool inWord = i < static_cast<int>(text.size()) && !isBreak(text[i]) && !geometry->glyphs[i].empty();
+        if (inWord && start < 0) {
+            start = i;
+        } else if (!inWord && start >= 0) {
+            PageWord word;
+            word.offset = start;
+            word.length = i - start;
+            geometry->rangeBox(start, i - start, word.rect);
+            geometry->words.push_back(word);
+            start = -1;
+        }
+    }
+
+    // Glyphs may overhang the page box (clipped text), so the grid spans both
+    std::vector<HitRect> boxes;
+    boxes.reserve(geometry->words.size());
+    for (const PageWord& word : geometry->words) {
+        boxes.push_back(word.rect);
+        bounds.unite(word.rect);
+    }
+    geometry->wordGrid.build(boxes, bounds);
+    boxes.clear();
+    for (const PageLink& link : geometry->links) {
+        boxes.push_back(link.rect);
+        bounds.unite(link.rect);
+    }
+    geometry->linkGrid.build(boxes, bounds);
+
+    size_t bytes = kEntryOverheadBytes + geometry->text.size() * sizeof(char16_t) +
+                   geometry->glyphs.size() * sizeof(HitRect) + geometry->words.size() * sizeof(PageWord) +
+                   geometry->wordGrid.byteSize() + geometry->linkGrid.byteSize();
+    for (const PageLink& link : geometry->links) {
+        bytes += sizeof(PageLink) + link.uri.size();
+    }
+    geometry->bytes = bytes;
+    return geometry;
+}
+
+void PDFHitIndex::insert(const std::shared_ptr<PDFDocument>& document, std::shared_ptr<const PageHitGeometry> geometry) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopping || geometry->bytes > m_budgetBytes) {
+        return;
+    }
+    std::string key = keyFor(document->pdfId, geometry->pageNumber);
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        // Built twice by concurrent lookups; the newer copy is equivalent
+        m_bytes -= it->second->geometry->bytes;
+        m_lru.erase(it->second);
+        m_index.erase(it);
+    }
+    Entry entry;
+    entry.key = key;
+    entry.pdfId = document->pdfId;
+    entry.document = document;
+    entry.geometry = std::move(geometry);
+    m_bytes += entry.geometry->bytes;
+    m_lru.push_front(std::move(entry));
+    m_index[key] = m_lru.begin();
+    evictLocked(m_budgetBytes);
+}
+
+void PDFHitIndex::evictLocked(size_t targetBytes) {
+    while (m_bytes > targetBytes && !m_lru.empty()) {
+        const Entry& oldest = m_lru.back();
+        m_bytes -= oldest.geometry->bytes;
+        m_index.erase(oldest.key);
+        m_lru.pop_back();
+    }
+}
+
+void PDFHitIndex::builderLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this] { return m_stopping || !m_pending.empty(); });
+        if (m_stopping) {
+            break;
+        }
+        // Newest first: it is the page the user is looking at
+        PendingPage pending = m_pending.back();
+        m_pending.pop_back();
+        std::shared_ptr<PDFDocument> document = pending.document.lock();
+        if (!document || m_index.count(keyFor(document->pdfId, pending.pageNumber)) > 0) {
+            continue;
+        }
+        lock.unlock();
+
+        std::string error;
+        std::shared_ptr<PageHitGeometry> built = build(*document, pending.pageNumber, error);
+        if (built) {
+            insert(document, built);
+        } else {
+            LOGW("Hit index for %s page %d not built: %s", document->pdfId.c_str(), pending.pageNumber, error.c_str());
+        }
+        document.reset();
+
+        lock.lock();
+    }
+}
@@ -0,0 +1,185 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Per-page spatial index of glyph, word and link boxes
+ * A page's boxes are read from Pdfium once, on a background thread after the
+ * page is first rendered (or on the first lookup), and bucketed into a uniform
+ * grid. Taps, long-press word selection and search highlighting then look up
+ * a few grid cells instead of reloading the page text.
+ */
+
+#ifndef PDF_HIT_INDEX_H
+#define PDF_HIT_INDEX_H
+
+#include "PDFDocumentRegistry.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Box in PDF page coordinates (points, origin bottom-left)
+struct HitRect {
+    float left = 0.0f;
+    float bottom = 0.0f;
+    float right = 0.0f;
+    float top = 0.0f;
+
+    bool empty() const { return right <= left || top <= bottom; }
+    // Distance from (x, y) to the box; 0 inside it
+    float distanceTo(float x, float y) const;
+    void unite(const HitRect& other);
+};
+
+// Whitespace-separated run of page characters [offset, offset + length)
+struct PageWord {
+    HitRect rect;
+    int offset = 0;
+    int length = 0;
+};
+
+struct PageLink {
+    HitRect rect;
+    // 1-based destination page, 0 for links leaving the document
+    int targetPage = 0;
+    std::string uri;
+};
+
+// Uniform grid over a page; each cell lists the boxes overlapping it
+class HitGrid {
+public:
+    void build(const std::vector<HitRect>& boxes, const HitRect& bounds);
+    // Indices of boxes in the cells within tolerance of (x, y); may repeat
+    void query(float x, float y, float tolerance, std::vector<uint32_t>& indices) const;
+    size_t byteSize() const { return (m_cellStart.size() + m_items.size()) * sizeof(uint32_t); }
+
+private:
+    int cellColumn(float x) const;
+    int cellRow(float y) const;
+
+    HitRect m_bounds;
+    int m_columns = 0;
+    int m_rows = 0;
+    float m_cellWidth = 1.0f;
+    float m_cellHeight = 1.0f;
+    // Items of cell c are m_items[m_cellStart[c] .. m_cellStart[c + 1])
+    std::vector<uint32_t> m_cellStart;
+    std::vector<uint32_t> m_items;
+};
+
+struct PageHitGeometry {
+    int pageNumber = 0;
+    // Page text as extracted (not case-folded); glyphs[i] is the box of text[i],
+    // empty for characters Pdfium generated without one (line breaks)
+    std::u16string text;
+    std::vector<HitRect> glyphs;
+    // In text order
+    std::vector<PageWord> words;
+    std::vector<PageLink> links;
+    HitGrid wordGrid;
+    HitGrid linkGrid;
+    size_t bytes = 0;
+
+    // Union of the glyph boxes of [offset, offset + length); false if none has a box
+    bool rangeBox(int offset, int length, HitRect& box) const;
+    // Word nearest to (x, y) within tolerance, -1 if none
+    int wordAt(float x, float y, float tolerance) const;
+    // Link containing (x, y) within tolerance, -1 if none
+    int linkAt(float x, float y, float tolerance) const;
+};
+
+enum PageHitKind {
+    kPageHitNone = 0,
+    kPageHitWord = 1,
+    kPageHitLink = 2
+};
+
+struct PageHit {
+    int kind = kPageHitNone;
+    HitRect rect;
+    // Word: its characters; link: the text it covers, if any
+    int offset = 0;
+    int length = 0;
+    std::u16string text;
+    int targetPage = 0;
+    std::string uri;
+};
+
+class PDFHitIndex {
+public:
+    static constexpr size_t kDefaultBudgetBytes = 4 * 1024 * 1024;
+    // Rendered pages waiting for their boxes; older requests are dropped
+    static constexpr size_t kMaxPendingPages = 4;
+
+    PDFHitIndex() = default;
+    ~PDFHitIndex();
+
+    // Boxes of a page, read from Pdfium on first use; nullptr on error
+    std::shared_ptr<const PageHitGeometry> geometry(const std::shared_ptr<PDFDocument>& document,
+                                                   int pageNumber, std::string& error);
+    // Boxes of a page only if already indexed (never touches Pdfium)
+    std::shared_ptr<const PageHitGeometry> cachedGeometry(const PDFDocument& document, int pageNumber);
+    // Indexes a freshly rendered page on the index's own thread
+    void prefetch(const std::shared_ptr<PDFDocument>& document, int pageNumber);
+
+    // Link under (x, y) if any, otherwise the nearest word within tolerance points
+    bool hitTest(const std::shared_ptr<PDFDocument>& document, int pageNumber, float x, float y,
+                 float tolerance, PageHit& hit, std::string& error);
+    // Words from the one nearest (x0, y0) to the one nearest (x1, y1) in text
+    // order, as a drag from a long press selects them; text is the covered span
+    bool selectWords(const std::shared_ptr<PDFDocument>& document, int pageNumber, float x0, float y0,
+                     float x1, float y1, float tolerance, std::vector<PageWord>& words,
+                     std::u16string& text, std::string& error);
+
+    void forget(const std::string& pdfId);
+
+    // Each returns the number of bytes released
+    size_t clear();
+    size_t trimTo(size_t targetBytes);
+    void setBudget(size_t budgetBytes);
+    size_t budget();
+    size_t memoryBytes();
+
+private:
+    PDFHitIndex(const PDFHitIndex&) = delete;
+    PDFHitIndex& operator=(const PDFHitIndex&) = delete;
+
+    struct Entry {
+        std::string key;
+        std::string pdfId;
+        std::weak_ptr<PDFDocument> document;
+        std::shared_ptr<const PageHitGeometry> geometry;
+    };
+    struct PendingPage {
+        std::weak_ptr<PDFDocument> document;
+        int pageNumber = 0;
+    };
+
+    static std::string keyFor(const std::string& pdfId, int pageNumber);
+    static std::shared_ptr<PageHitGeometry> build(const PDFDocument& document, int pageNumber, std::string& error);
+    void insert(const std::shared_ptr<PDFDocument>& document, std::shared_ptr<const PageHitGeometry> geometry);
+    void evictLocked(size_t targetBytes);
+    void builderLoop();
+
+    // Front is most recently used
+    std::list<Entry> m_lru;
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+    size_t m_bytes = 0;
+    size_t m_budgetBytes = kDefaultBudgetBytes;
+    std::mutex m_mutex;
+
+    std::deque<PendingPage> m_pending;
+    bool m_stopping = false;
+    std::thread m_builder;
+    std::condition_variable m_wake;
+};
+
+#endif // PDF_HIT_INDEX_H
@@ -1,36 +1,25 @@
  #include "PDFJSI.h"
 #include <jni.h>
 #include <android/log.h>
+#include <android/bitmap.h>
 #include <string>
  #include <sstream>
 #include <map>
 #include <mutex>
 #include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Base64Decoder.h"
+#include "PDFProgressiveDocument.h"
+#include "PDFTrace.h"
 
 #define LOG_TAG "PDFJSI"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 #define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
 #define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
 
-// Performance logging macros
-#define PERF_START(name) \
-    auto perf_start_##name = std::chrono::high_resolution_clock::now(); \
-    LOGI("[PERF] [%s] 🔵 ENTER", #name);
-
-#define PERF_CHECKPOINT(name, label) \
-    { \
-        auto perf_now = std::chrono::high_resolution_clock::now(); \
-        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(perf_now - perf_start_##name).count(); \
-        LOGI("[PERF] [%s]   Checkpoint: %s - %.2f ms", #name, label, elapsed / 1000.0); \
-    }
-
-#define PERF_END(name) \
-    { \
-        auto perf_end = std::chrono::high_resolution_clock::now(); \
-        auto total_time = std::chrono::duration_cast<std::chrono::microseconds>(perf_end - perf_start_##name).count(); \
-        LOGI("[PERF] [%s] 🔴 EXIT - Total: %.2f ms", #name, total_time / 1000.0); \
-    }
-
 PDFJSI& PDFJSI::getInstance() {
     static PDFJSI instance;
     return instance;
@@ -41,84 +30,286 @@ void PDFJSI::initialize() {
     LOGI("PDF JSI initialized successfully");
 }
 
+void PDFJSI::cleanup() {
+    m_preloader.cancelAll();
+    m_renderEngine.forgetAll();
+    m_bitmapPool.clear();
+    m_textIndex.clear();
+    m_documents.closeAll();
+    m_initialized = false;
+    LOGI("PDF JSI cleaned up");
+}
+
 bool PDFJSI::isInitialized() const {
     return m_initialized;
 }
 
 std::string PDFJSI::getJSIStats() {
-    PERF_START(getJSIStats);
-    
-    // Pre-allocated string buffer optimization: 60% faster string operations
     static const std::string template_str = 
         R"({"success":true,"version":"1.0.0","performanceLevel":"high",)"
         R"("directMemoryAccess":true,"bridgeOptimized":true,"initialized":)";
     
-    PERF_CHECKPOINT(getJSIStats, "Template loaded");
-    
     std::string result;
     result.reserve(256); // Pre-allocate to avoid reallocations
     result.append(template_str);
     result.append(m_initialized ? "true}" : "false}");
-    
-    PERF_END(getJSIStats);
     return result;
 }
 
 // Helper function to create a WritableMap from C++
-// Optimized with PushLocalFrame for bulk cleanup: 40% faster JNI calls
+// Class and method IDs are resolved once; PushLocalFrame releases the per-item locals in bulk
 jobject createWritableMap(JNIEnv* env, const std::map<std::string, std::string>& data) {
-    auto start = std::chrono::high_resolution_clock::now();
-    LOGI("[PERF] [createWritableMap] 🔵 ENTER - items: %zu", data.size());
-    
-    // Reserve capacity for local references (prevents overflow and improves performance)
-    auto frameStart = std::chrono::high_resolution_clock::now();
-    env->PushLocalFrame(data.size() * 2 + 10);
-    auto frameTime = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::high_resolution_clock::now() - frameStart).count();
-    LOGI("[PERF] [createWritableMap]   PushLocalFrame: %.2f ms", frameTime / 1000.0);
-    
-    auto classStart = std::chrono::high_resolution_clock::now();
-    jclass mapClass = env->FindClass("com/facebook/react/bridge/Arguments");
-    jmethodID createMapMethod = env->GetStaticMethodID(mapClass, "createMap", 
-        "()Lcom/facebook/react/bridge/WritableMap;");
-    jobject map = env->CallStaticObjectMethod(mapClass, createMapMethod);
-    auto classTime = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::high_resolution_clock::now() - classStart).count();
-    LOGI("[PERF] [createWritableMap]   Map creation: %.2f ms", classTime / 1000.0);
-    
-    // Cache method IDs as static (only lookup once) - significant performance gain
+    static jclass argumentsClass = nullptr;
+    static jmethodID createMapMethod = nullptr;
     static jmethodID putStringMethod = nullptr;
-    if (!putStringMethod) {
-        auto methodStart = std::chrono::high_resolution_clock::now();
+    static std::once_flag lookupOnce;
+    std::call_once(lookupOnce, [env] {
+        jclass localArguments = env->FindClass("com/facebook/react/bridge/Arguments");
+        argumentsClass = static_cast<jclass>(env->NewGlobalRef(localArguments));
+        createMapMethod = env->GetStaticMethodID(argumentsClass, "createMap",
+            "()Lcom/facebook/react/bridge/WritableMap;");
         jclass writableMapClass = env->FindClass("com/facebook/react/bridge/WritableMap");
-        putStringMethod = env->GetMethodID(writableMapClass, "putString", 
+        putStringMethod = env->GetMethodID(writableMapClass, "putString",
             "(Ljava/lang/String;Ljava/lang/String;)V");
-        auto methodTime = std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::high_resolution_clock::now() - methodStart).count();
-        LOGI("[PERF] [createWritableMap]   Method cache (first call): %.2f ms", methodTime / 1000.0);
-    }
+        env->DeleteLocalRef(localArguments);
+        env->DeleteLocalRef(writableMapClass);
+    });
     
-    // No manual cleanup needed - PopLocalFrame handles all local references
-    auto populateStart = std::chrono::high_resolution_clock::now();
+    // Reserve capacity for local references (prevents overflow)
+    env->PushLocalFrame(data.size() * 2 + 10);
+    jobject map = env->CallStaticObjectMethod(argumentsClass, createMapMethod);
     for (const auto& pair : data) {
         jstring key = env->NewStringUTF(pair.first.c_str());
         jstring value = env->NewStringUTF(pair.second.c_str());
         env->CallVoidMethod(map, putStringMethod, key, value);
     }
-    auto populateTime = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::high_resolution_clock::now() - populateStart).count();
-    LOGI("[PERF] [createWritableMap]   Data population: %.2f ms", populateTime / 1000.0);
-    
-    // Cleanup all locals except return value (O(1) cleanup vs O(n))
-    auto result = env->PopLocalFrame(map);
-    
-    auto totalTime = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::high_resolution_clock::now() - start).count();
-    LOGI("[PERF] [createWritableMap] 🔴 EXIT - Total: %.2f ms", totalTime / 1000.0);
     
+    // Cleanup all locals except return value
+    return env->PopLocalFrame(map);
+}
+
+// Copies a jstring into a std::string and releases the UTF chars
+static std::string jstringToString(JNIEnv* env, jstring value) {
+    if (!value) {
+        return std::string();
+    }
+    const char* chars = env->GetStringUTFChars(value, nullptr);
+    std::string result(chars ? chars : "");
+    env->ReleaseStringUTFChars(value, chars);
     return result;
 }
 
+// Copies a jstring as UTF-16 (no modified-UTF-8 round trip for search terms)
+static std::u16string jstringToUtf16(JNIEnv* env, jstring value) {
+    if (!value) {
+        return std::u16string();
+    }
+    jsize length = env->GetStringLength(value);
+    const jchar* chars = env->GetStringChars(value, nullptr);
+    std::u16string result(reinterpret_cast<const char16_t*>(chars), length);
+    env->ReleaseStringChars(value, chars);
+    return result;
+}
+
+// Copies a Java int[] of page numbers
+static std::vector<int> jintArrayToVector(JNIEnv* env, jintArray values) {
+    std::vector<int> result;
+    if (!values) {
+        return result;
+    }
+    jsize length = env->GetArrayLength(values);
+    result.resize(length);
+    static_assert(sizeof(jint) == sizeof(int), "jint must be int");
+    env->GetIntArrayRegion(values, 0, length, reinterpret_cast<jint*>(result.data()));
+    return result;
+}
+
+// Decodes a base64 jstring in fixed-size chunks, so the payload is never
+// copied whole into a std::string. sink(bytes, size, consumed) receives the
+// decoded output with the fraction of input read so far, and returns false to abort.
+template <typename Sink>
+static bool decodeBase64String(JNIEnv* env, jstring value, Sink&& sink) {
+    PDFJSI_TRACE_SCOPE(kBase64Decode);
+    static const jsize kChunkChars = 64 * 1024;
+    if (!value) {
+        return false;
+    }
+    jsize length = env->GetStringLength(value);
+    // Valid base64 is pure ASCII, where modified UTF-8 is one byte per char; checking
+    // once up front lets every chunk use count as its size (GetStringUTFRegion need
+    // not NUL-terminate, so the reused buffer may hold a longer previous chunk)
+    if (env->GetStringUTFLength(value) != length) {
+        LOGE("Base64 payload contains non-ASCII characters");
+        return false;
+    }
+    std::vector<char> chars(static_cast<size_t>(kChunkChars) + 1);
+    std::vector<uint8_t> bytes(Base64Decoder::maxDecodedSize(chars.size()));
+    Base64Decoder::Stream stream;
+    size_t total = 0;
+
+    for (jsize start = 0; start < length; start += kChunkChars) {
+        jsize count = std::min(kChunkChars, length - start);
+        env->GetStringUTFRegion(value, start, count, chars.data());
+        size_t size = static_cast<size_t>(count);
+        const char* input = chars.data();
+        if (start == 0) {
+            size_t prefix = Base64Decoder::dataUriPrefixLength(input, size);
+            input += prefix;
+            size -= prefix;
+        }
+        size_t written = stream.update(input, size, bytes.data());
+        float consumed = static_cast<float>(start + count) / static_cast<float>(length);
+        if (stream.failed() || !sink(bytes.data(), written, consumed)) {
+            return false;
+        }
+        total += written;
+    }
+    if (!stream.finish()) {
+        LOGE("Base64 payload ends with an incomplete group");
+        return false;
+    }
+    return total > 0;
+}
+
+// WritableArray of { page, offset, length, left, top, right, bottom } maps
+static jobject createSearchResultArray(JNIEnv* env, const std::vector<TextSearchHit>& hits) {
+    static jclass argumentsClass = nullptr;
+    static jmethodID createArrayMethod = nullptr;
+    static jmethodID createMapMethod = nullptr;
+    static jmethodID putIntMethod = nullptr;
+    static jmethodID putDoubleMethod = nullptr;
+    static jmethodID pushMapMethod = nullptr;
+    static std::once_flag lookupOnce;
+    std::call_once(lookupOnce, [env] {
+        jclass localArguments = env->FindClass("com/facebook/react/bridge/Arguments");
+        argumentsClass = static_cast<jclass>(env->NewGlobalRef(localArguments));
+        createArrayMethod = env->GetStaticMethodID(argumentsClass, "createArray",
+            "()Lcom/facebook/react/bridge/WritableArray;");
+        createMapMethod = env->GetStaticMethodID(argumentsClass, "createMap",
+            "()Lcom/facebook/react/bridge/WritableMap;");
+        jclass writableMapClass = env->FindClass("com/facebook/react/bridge/WritableMap");
+        putIntMethod = env->GetMethodID(writableMapClass, "putInt", "(Ljava/lang/String;I)V");
+        putDoubleMethod = env->GetMethodID(writableMapClass, "putDouble", "(Ljava/lang/String;D)V");
+        jclass writableArrayClass = env->FindClass("com/facebook/react/bridge/WritableArray");
+        pushMapMethod = env->GetMethodID(writableArrayClass, "pushMap",
+            "(Lcom/facebook/react/bridge/ReadableMap;)V");
+        env->DeleteLocalRef(localArguments);
+        env->DeleteLocalRef(writableMapClass);
+        env->DeleteLocalRef(writableArrayClass);
+    });
+    
+    jobject array = env->CallStaticObjectMethod(argumentsClass, createArrayMethod);
+    for (const TextSearchHit& hit : hits) {
+        // Per-hit frame keeps local references bounded for large result sets
+        env->PushLocalFrame(16);
+        jobject map = env->CallStaticObjectMethod(argumentsClass, createMapMethod);
+        env->CallVoidMethod(map, putIntMethod, env->NewStringUTF("page"), hit.pageNumber);
+        env->CallVoidMethod(map, putIntMethod, env->NewStringUTF("offset"), hit.offset);
+        env->CallVoidMethod(map, putIntMethod, env->NewStringUTF("length"), hit.length);
+        env->CallVoidMethod(map, putDoubleMethod, env->NewStringUTF("left"), hit.left);
+        env->CallVoidMethod(map, putDoubleMethod, env->NewStringUTF("top"), hit.top);
+        env->CallVoidMethod(map, putDoubleMethod, env->NewStringUTF("right"), hit.right);
+        env->CallVoidMethod(map, putDoubleMethod, env->NewStringUTF("bottom"), hit.bottom);
+        env->CallVoidMethod(array, pushMapMethod, map);
+        env->PopLocalFrame(nullptr);
+    }
+    return array;
+}
+
+// WritableMap/WritableArray methods used by the hit-test results
+struct HitResultMethods {
+    jclass argumentsClass = nullptr;
+    jmethodID createArray = nullptr;
+    jmethodID createMap = nullptr;
+    jmethodID putInt = nullptr;
+    jmethodID putDouble = nullptr;
+    jmethodID putString = nullptr;
+    jmethodID putArray = nullptr;
+    jmethodID pushMap = nullptr;
+};
+
+static const HitResultMethods& hitResultMethods(JNIEnv* env) {
+    static HitResultMethods methods;
+    static std::once_flag lookupOnce;
+    std::call_once(lookupOnce, [env] {
+        jclass localArguments = env->FindClass("com/facebook/react/bridge/Arguments");
+        methods.argumentsClass = static_cast<jclass>(env->NewGlobalRef(localArguments));
+        methods.createArray = env->GetStaticMethodID(methods.argumentsClass, "createArray",
+            "()Lcom/facebook/react/bridge/WritableArray;");
+        methods.createMap = env->GetStaticMethodID(methods.argumentsClass, "createMap",
+            "()Lcom/facebook/react/bridge/WritableMap;");
+        jclass writableMapClass = env->FindClass("com/facebook/react/bridge/WritableMap");
+        methods.putInt = env->GetMethodID(writableMapClass, "putInt", "(Ljava/lang/String;I)V");
+        methods.putDouble = env->GetMethodID(writableMapClass, "putDouble", "(Ljava/lang/String;D)V");
+        methods.putString = env->GetMethodID(writableMapClass, "putString",
+            "(Ljava/lang/String;Ljava/lang/String;)V");
+        methods.putArray = env->GetMethodID(writableMapClass, "putArray",
+            "(Ljava/lang/String;Lcom/facebook/react/bridge/ReadableArray;)V");
+        jclass writableArrayClass = env->FindClass("com/facebook/react/bridge/WritableArray");
+        methods.pushMap = env->GetMethodID(writableArrayClass, "pushMap",
+            "(Lcom/facebook/react/bridge/ReadableMap;)V");
+        env->DeleteLocalRef(localArguments);
+        env->DeleteLocalRef(writableMapClass);
+        env->DeleteLocalRef(writableArrayClass);
+    });
+    return methods;
+}
+
+// left/top/right/bottom in PDF points (origin bottom-left), as in search results
+static void putHitRect(JNIEnv* env, const HitResultMethods& methods, jobject map, const HitRect& rect) {
+    env->CallVoidMethod(map, methods.putDouble, env->NewStringUTF("left"), static_cast<double>(rect.left));
+    env->CallVoidMethod(map, methods.putDouble, env->NewStringUTF("top"), static_cast<double>(rect.top));
+    env->CallVoidMethod(map, methods.putDouble, env->NewStringUTF("right"), static_cast<double>(rect.right));
+    env->CallVoidMethod(map, methods.putDouble, env->NewStringUTF("bottom"), static_cast<double>(rect.bottom));
+}
+
+static jstring utf16ToJstring(JNIEnv* env, const std::u16string& text) {
+    return env->NewString(reinterpret_cast<const jchar*>(text.data()), static_cast<jsize>(text.size()));
+}
+
+// { type: "none" | "word" | "link", page, offset, length, text, rect, targetPage, uri }
+static jobject createHitResultMap(JNIEnv* env, int pageNumber, const PageHit& hit) {
+    const HitResultMethods& methods = hitResultMethods(env);
+    env->PushLocalFrame(32);
+    jobject map = env->CallStaticObjectMethod(methods.argumentsClass, methods.createMap);
+    const char* type = hit.kind == kPageHitLink ? "link" : (hit.kind == kPageHitWord ? "word" : "none");
+    env->CallVoidMethod(map, methods.putString, env->NewStringUTF("type"), env->NewStringUTF(type));
+    env->CallVoidMethod(map, methods.putInt, env->NewStringUTF("page"), pageNumber);
+    if (hit.kind != kPageHitNone) {
+        env->CallVoidMethod(map, methods.putInt, env->NewStringUTF("offset"), hit.offset);
+        env->CallVoidMethod(map, methods.putInt, env->NewStringUTF("length"), hit.length);
+        env->CallVoidMethod(map, methods.putString, env->NewStringUTF("text"), utf16ToJstring(env, hit.text));
+        putHitRect(env, methods, map, hit.rect);
+    }
+    if (hit.kind == kPageHitLink) {
+        env->CallVoidMethod(map, methods.putInt, env->NewStringUTF("targetPage"), hit.targetPage);
+        env->CallVoidMethod(map, methods.putString, env->NewStringUTF("uri"), env->NewStringUTF(hit.uri.c_str()));
+    }
+    return env->PopLocalFrame(map);
+}
+
+// { page, offset, length, text, rects: [{ left, top, right, bottom }] } with one rect per word
+static jobject createSelectionMap(JNIEnv* env, int pageNumber, const std::vector<PageWord>& words,
+                                  const std::u16string& text) {
+    const HitResultMethods& methods = hitResultMethods(env);
+    env->PushLocalFrame(32);
+    jobject map = env->CallStaticObjectMethod(methods.argumentsClass, methods.createMap);
+    env->CallVoidMethod(map, methods.putInt, env->NewStringUTF("page"), pageNumber);
+    env->CallVoidMethod(map, methods.putInt, env->NewStringUTF("offset"), words.empty() ? 0 : words.front().offset);
+    env->CallVoidMethod(map, methods.putInt, env->NewStringUTF("length"), static_cast<jint>(text.size()));
+    env->CallVoidMethod(map, methods.putString, env->NewStringUTF("text"), utf16ToJstring(env, text));
+    jobject rects = env->CallStaticObjectMethod(methods.argumentsClass, methods.createArray);
+    for (const PageWord& word : words) {
+        env->PushLocalFrame(8);
+        jobject rect = env->CallStaticObjectMethod(methods.argumentsClass, methods.createMap);
+        putHitRect(env, methods, rect, word.rect);
+        env->CallVoidMethod(rects, methods.pushMap, rect);
+        env->PopLocalFrame(nullptr);
+    }
+    env->CallVoidMethod(map, methods.putArray, env->NewStringUTF("rects"), rects);
+    return env->PopLocalFrame(map);
+}
+
 extern "C" {
     JNIEXPORT void JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeInitializeJSI(JNIEnv *env, jobject thiz, jobject callInvokerHolder) {
@@ -132,111 +323,385 @@ extern "C" {
     
     JNIEXPORT jobject JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeRenderPageDirect(JNIEnv *env, jobject thiz, jstring pdfId, jint pageNumber, jfloat scale, jstring base64Data) {
-        LOGD("Native renderPageDirect called for pdfId: %s, page: %d", 
-             env->GetStringUTFChars(pdfId, nullptr), pageNumber);
+        std::string id = jstringToString(env, pdfId);
+        LOGD("Native renderPageDirect called for pdfId: %s, page: %d", id.c_str(), pageNumber);
+        
+        PDFJSI& jsi = PDFJSI::getInstance();
+        
+        // Registered documents ignore base64Data, so only decode it on first use,
+        // chunk by chunk straight into the document buffer
+        if (base64Data && env->GetStringLength(base64Data) > 0 && !jsi.documents().find(id)) {
+            DocumentSource source;
+            source.data = std::make_shared<std::vector<uint8_t>>();
+            std::vector<uint8_t>& data = *source.data;
+            data.reserve(Base64Decoder::maxDecodedSize(env->GetStringLength(base64Data)));
+            bool decoded = decodeBase64String(env, base64Data, [&data](const uint8_t* bytes, size_t size, float) {
+                data.insert(data.end(), bytes, bytes + size);
+                return true;
+            });
+            std::string error = "Invalid base64 data";
+            if (!decoded || !jsi.renderEngine().resolveDocument(id, source, error)) {
+                LOGE("renderPageDirect could not open pdfId: %s: %s", id.c_str(), error.c_str());
+                std::map<std::string, std::string> result;
+                result["success"] = "false";
+                result["pageNumber"] = std::to_string(pageNumber);
+                result["scale"] = std::to_string(scale);
+                result["error"] = error;
+                return createWritableMap(env, result);
+            }
+        }
+        RenderResult render = jsi.renderEngine().renderPage(id, pageNumber, scale, std::string());
+        jsi.preloader().noteRender(id, scale, PDFJSI_QUALITY_DOCUMENT);
         
         std::map<std::string, std::string> result;
-        result["success"] = "true";
+        result["success"] = render.success ? "true" : "false";
         result["pageNumber"] = std::to_string(pageNumber);
-        result["width"] = "800";
-        result["height"] = "1200";
         result["scale"] = std::to_string(scale);
-        result["cached"] = "true";
-        result["renderTimeMs"] = "50";
+        if (render.success) {
+            result["width"] = std::to_string(render.width);
+            result["height"] = std::to_string(render.height);
+            result["cached"] = render.cached ? "true" : "false";
+            result["quality"] = std::to_string(render.quality);
+            result["renderTimeMs"] = std::to_string(render.renderTimeMs);
+        } else {
+            LOGE("renderPageDirect failed for pdfId: %s, page: %d: %s", id.c_str(), pageNumber, render.error.c_str());
+            result["error"] = render.error;
+        }
         
         return createWritableMap(env, result);
     }
     
+    JNIEXPORT jfloatArray JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeRenderPagesDirect(JNIEnv *env, jobject thiz, jstring pdfId, jintArray pages, jfloat scale, jint quality) {
+        std::string id = jstringToString(env, pdfId);
+        std::vector<int> pageNumbers = jintArrayToVector(env, pages);
+        LOGD("Native renderPagesDirect called for pdfId: %s, %zu pages", id.c_str(), pageNumbers.size());
+        
+        PDFJSI& jsi = PDFJSI::getInstance();
+        
+        // Struct of arrays, one row of pages.size() values per field:
+        // success, width, height, cached, quality, renderTimeMs
+        const size_t kFields = 6;
+        size_t count = pageNumbers.size();
+        std::vector<jfloat> values(count * kFields, 0.0f);
+        for (size_t i = 0; i < count; ++i) {
+            RenderResult render = jsi.renderEngine().renderPage(id, pageNumbers[i], scale, std::string(), quality);
+            if (!render.success) {
+                LOGE("renderPagesDirect failed for pdfId: %s, page: %d: %s", id.c_str(), pageNumbers[i], render.error.c_str());
+                continue;
+            }
+            values[i] = 1.0f;
+            values[count + i] = static_cast<jfloat>(render.width);
+            values[count * 2 + i] = static_cast<jfloat>(render.height);
+            values[count * 3 + i] = render.cached ? 1.0f : 0.0f;
+            values[count * 4 + i] = static_cast<jfloat>(render.quality);
+            values[count * 5 + i] = static_cast<jfloat>(render.renderTimeMs);
+        }
+        jsi.preloader().noteRender(id, scale, quality);
+        jfloatArray result = env->NewFloatArray(values.size());
+        env->SetFloatArrayRegion(result, 0, values.size(), values.data());
+        return result;
+    }
+    
     JNIEXPORT jobject JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeGetPageMetrics(JNIEnv *env, jobject thiz, jstring pdfId, jint pageNumber) {
-        LOGD("Native getPageMetrics called for pdfId: %s, page: %d", 
-             env->GetStringUTFChars(pdfId, nullptr), pageNumber);
+        std::string id = jstringToString(env, pdfId);
+        LOGD("Native getPageMetrics called for pdfId: %s, page: %d", id.c_str(), pageNumber);
         
+        PageSize size;
+        std::string error;
         std::map<std::string, std::string> result;
         result["pageNumber"] = std::to_string(pageNumber);
-        result["width"] = "800";
-        result["height"] = "1200";
-        result["rotation"] = "0";
-        result["scale"] = "1.0";
-        result["renderTimeMs"] = "50";
-        result["cacheSizeKb"] = "100";
+        if (!PDFJSI::getInstance().renderEngine().getPageSize(id, pageNumber, size, error)) {
+            LOGE("getPageMetrics failed for pdfId: %s, page: %d: %s", id.c_str(), pageNumber, error.c_str());
+            result["error"] = error;
+            return createWritableMap(env, result);
+        }
+        result["width"] = std::to_string(size.width);
+        result["height"] = std::to_string(size.height);
+        result["rotation"] = std::to_string(size.rotation);
         
         return createWritableMap(env, result);
     }
     
+    JNIEXPORT jfloatArray JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeGetPageMetricsBatch(JNIEnv *env, jobject thiz, jstring pdfId, jintArray pages) {
+        std::string id = jstringToString(env, pdfId);
+        std::vector<int> pageNumbers = jintArrayToVector(env, pages);
+        LOGD("Native getPageMetricsBatch called for pdfId: %s, %zu pages", id.c_str(), pageNumbers.size());
+        
+        std::vector<PageSize> sizes;
+        std::string error;
+        if (!PDFJSI::getInstance().renderEngine().getPageSizes(id, pageNumbers, sizes, error)) {
+            LOGE("getPageMetricsBatch failed for pdfId: %s: %s", id.c_str(), error.c_str());
+            return nullptr;
+        }
+        
+        // Struct of arrays: widths, then heights, then rotations
+        size_t count = sizes.size();
+        std::vector<jfloat> values(count * 3);
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = static_cast<jfloat>(sizes[i].width);
+            values[count + i] = static_cast<jfloat>(sizes[i].height);
+            values[count * 2 + i] = static_cast<jfloat>(sizes[i].rotation);
+        }
+        jfloatArray result = env->NewFloatArray(values.size());
+        env->SetFloatArrayRegion(result, 0, values.size(), values.data());
+        return result;
+    }
+    
     JNIEXPORT jboolean JNICALL
-    Java_org_wonday_pdf_PDFJSIManager_nativePreloadPagesDirect(JNIEnv *env, jobject thiz, jstring pdfId, jint startPage, jint endPage) {
-        LOGD("Native preloadPagesDirect called for pdfId: %s, pages %d-%d", 
-             env->GetStringUTFChars(pdfId, nullptr), startPage, endPage);
-        return JNI_TRUE;
+    Java_org_wonday_pdf_PDFJSIManager_nativePreloadPagesDirect(JNIEnv *env, jobject thiz, jstring pdfId, jint startPage, jint endPage, jint currentPage) {
+        std::string id = jstringToString(env, pdfId);
+        LOGD("Native preloadPagesDirect called for pdfId: %s, pages %d-%d around %d",
+             id.c_str(), startPage, endPage, currentPage);
+        
+        // Returns once the pages are queued; workers render them into the page cache
+        return PDFJSI::getInstance().preloader().schedule(id, startPage, endPage, currentPage) ? JNI_TRUE : JNI_FALSE;
     }
     
     JNIEXPORT jobject JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeGetCacheMetrics(JNIEnv *env, jobject thiz, jstring pdfId) {
-        LOGD("Native getCacheMetrics called for pdfId: %s", 
-             env->GetStringUTFChars(pdfId, nullptr));
+        std::string id = jstringToString(env, pdfId);
+        LOGD("Native getCacheMetrics called for pdfId: %s", id.c_str());
+        
+        PDFPageCache& cache = PDFJSI::getInstance().pageCache();
+        PageCacheStats total = cache.stats();
+        PageCacheStats document = id.empty() ? total : cache.documentStats(id);
         
         std::map<std::string, std::string> result;
-        result["pageCacheSize"] = "5";
-        result["totalCacheSizeKb"] = "500";
-        result["hitRatio"] = "0.85";
+        result["pageCacheSize"] = std::to_string(document.entries);
+        result["documentCacheSizeKb"] = std::to_string(document.bytes / 1024);
+        result["totalCacheSizeKb"] = std::to_string(total.bytes / 1024);
+        result["budgetKb"] = std::to_string(total.budgetBytes / 1024);
+        result["totalEntries"] = std::to_string(total.entries);
+        result["hits"] = std::to_string(document.hits);
+        result["misses"] = std::to_string(document.misses);
+        result["hitRatio"] = std::to_string(document.hitRatio());
+        result["totalHitRatio"] = std::to_string(total.hitRatio());
+        result["evictions"] = std::to_string(total.evictions);
+        
+        BitmapPoolStats pool = PDFJSI::getInstance().bitmapPool().stats();
+        result["bitmapPoolFreeKb"] = std::to_string(pool.freeBytes / 1024);
+        result["bitmapPoolFreeBlocks"] = std::to_string(pool.freeBlocks);
+        result["bitmapPoolHitRatio"] = std::to_string(pool.hitRatio());
+        
+        PageStoreStats store = PDFJSI::getInstance().pageStore().stats();
+        result["pageStoreEnabled"] = store.enabled ? "true" : "false";
+        result["pageStoreEntries"] = std::to_string(store.entries);
+        result["pageStoreSizeKb"] = std::to_string(store.bytes / 1024);
+        result["pageStoreBudgetKb"] = std::to_string(store.budgetBytes / 1024);
+        result["pageStoreHits"] = std::to_string(store.hits);
+        result["pageStoreMisses"] = std::to_string(store.misses);
+        result["pageStoreWrites"] = std::to_string(store.writes);
+        
+        MemoryGovernorStats memory = PDFJSI::getInstance().memoryGovernor().stats();
+        result["memoryBudgetKb"] = std::to_string(memory.budgetBytes / 1024);
+        result["textIndexSizeKb"] = std::to_string(memory.textIndexBytes / 1024);
+        result["textIndexBudgetKb"] = std::to_string(memory.textIndexBudget / 1024);
+        result["hitIndexSizeKb"] = std::to_string(memory.hitIndexBytes / 1024);
+        result["hitIndexBudgetKb"] = std::to_string(memory.hitIndexBudget / 1024);
+        result["mappedResidentKb"] = std::to_string(memory.mappedResidentBytes / 1024);
+        result["mappedBudgetKb"] = std::to_string(memory.mappedBudget / 1024);
+        result["memoryPressure"] = std::to_string(memory.lastPressure);
+        result["renderQualityCap"] = std::to_string(memory.qualityCap);
+        result["memorySheds"] = std::to_string(memory.sheds);
+        result["memoryReleasedKb"] = std::to_string(memory.releasedBytes / 1024);
         
         return createWritableMap(env, result);
     }
     
     JNIEXPORT jboolean JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeClearCacheDirect(JNIEnv *env, jobject thiz, jstring pdfId, jstring cacheType) {
-        LOGD("Native clearCacheDirect called for pdfId: %s, type: %s", 
-             env->GetStringUTFChars(pdfId, nullptr), 
-             env->GetStringUTFChars(cacheType, nullptr));
+        std::string id = jstringToString(env, pdfId);
+        std::string type = jstringToString(env, cacheType);
+        LOGD("Native clearCacheDirect called for pdfId: %s, type: %s", id.c_str(), type.c_str());
+        
+        // Rendered pages, in-memory text indexes and hit boxes are the native caches;
+        // other types live in Java/JS
+        bool all = type == "all" || type.empty();
+        if (all || type == "text") {
+            PDFTextIndex& textIndex = PDFJSI::getInstance().textIndex();
+            PDFHitIndex& hitIndex = PDFJSI::getInstance().hitIndex();
+            if (id.empty()) {
+                textIndex.clear();
+                hitIndex.clear();
+            } else {
+                textIndex.forget(id);
+                hitIndex.forget(id);
+            }
+        }
+        if (all || type == "pages") {
+            PDFPageCache& cache = PDFJSI::getInstance().pageCache();
+            size_t released = id.empty() ? cache.clear() : cache.clearDocument(id);
+            LOGI("Cleared %zu KB of cached pages", released / 1024);
+        }
+        // Persisted pages survive "all": they are cleared only when asked for by name
+        if (type == "stored") {
+            PDFJSI& jsi = PDFJSI::getInstance();
+            size_t removed = 0;
+            if (id.empty()) {
+                removed = jsi.pageStore().clear();
+            } else if (std::shared_ptr<PDFDocument> document = jsi.documents().find(id)) {
+                std::string key;
+                {
+                    std::lock_guard<std::mutex> lock(document->storeKeyMutex);
+                    key = document->storeKey;
+                }
+                removed = key.empty() ? 0 : jsi.pageStore().clearDocument(key);
+            }
+            LOGI("Cleared %zu KB of stored pages", removed / 1024);
+        }
         return JNI_TRUE;
     }
     
     JNIEXPORT jboolean JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeOptimizeMemory(JNIEnv *env, jobject thiz, jstring pdfId) {
-        LOGD("Native optimizeMemory called for pdfId: %s", 
-             env->GetStringUTFChars(pdfId, nullptr));
+        std::string id = jstringToString(env, pdfId);
+        LOGD("Native optimizeMemory called for pdfId: %s", id.c_str());
+        
+        // Same step as running low: the pages around the visible one stay cached
+        size_t released = PDFJSI::getInstance().memoryGovernor().shed(kMemoryPressureLow);
+        LOGI("optimizeMemory released %zu KB", released / 1024);
+        return JNI_TRUE;
+    }
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeSetMemoryBudget(JNIEnv *env, jobject thiz, jlong budgetBytes) {
+        if (budgetBytes <= 0) {
+            return;
+        }
+        PDFJSI::getInstance().memoryGovernor().setBudget(static_cast<size_t>(budgetBytes));
+    }
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeSetCacheBudget(JNIEnv *env, jobject thiz, jlong budgetBytes) {
+        size_t budget = budgetBytes > 0 ? static_cast<size_t>(budgetBytes) : 0;
+        PDFJSI::getInstance().memoryGovernor().setPageCacheBudget(budget);
+    }
+    
+    JNIEXPORT jboolean JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeConfigurePageStore(JNIEnv *env, jobject thiz, jstring directory, jlong budgetBytes) {
+        std::string path = jstringToString(env, directory);
+        size_t budget = budgetBytes > 0 ? static_cast<size_t>(budgetBytes) : 0;
+        std::string error;
+        if (!PDFJSI::getInstance().pageStore().configure(path, budget, error)) {
+            LOGE("configurePageStore failed: %s", error.c_str());
+            return JNI_FALSE;
+        }
         return JNI_TRUE;
     }
     
     JNIEXPORT jobject JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeSearchTextDirect(JNIEnv *env, jobject thiz, jstring pdfId, jstring searchTerm, jint startPage, jint endPage) {
-        LOGD("Native searchTextDirect called for pdfId: %s, term: %s, pages %d-%d", 
-             env->GetStringUTFChars(pdfId, nullptr), 
-             env->GetStringUTFChars(searchTerm, nullptr), 
-             startPage, endPage);
+        std::string id = jstringToString(env, pdfId);
+        std::u16string term = jstringToUtf16(env, searchTerm);
+        LOGD("Native searchTextDirect called for pdfId: %s, term length: %zu, pages %d-%d",
+             id.c_str(), term.size(), startPage, endPage);
         
-        // Create empty array for now
-        jclass arrayClass = env->FindClass("com/facebook/react/bridge/Arguments");
-        jmethodID createArrayMethod = env->GetStaticMethodID(arrayClass, "createArray", "()Lcom/facebook/react/bridge/WritableArray;");
-        return env->CallStaticObjectMethod(arrayClass, createArrayMethod);
+        PDFJSI& jsi = PDFJSI::getInstance();
+        std::vector<TextSearchHit> hits;
+        std::string error;
+        std::shared_ptr<PDFDocument> document = jsi.renderEngine().resolveDocument(id, std::string(), error);
+        if (!document) {
+            LOGE("searchTextDirect: cannot open %s: %s", id.c_str(), error.c_str());
+        } else if (!jsi.textIndex().search(document, term, startPage, endPage, hits, error)) {
+            LOGE("searchTextDirect failed for %s: %s", id.c_str(), error.c_str());
+        }
+        return createSearchResultArray(env, hits);
+    }
+    
+    JNIEXPORT jobject JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeHitTest(JNIEnv *env, jobject thiz, jstring pdfId, jint pageNumber, jfloat x, jfloat y, jfloat tolerance) {
+        std::string id = jstringToString(env, pdfId);
+        PDFJSI& jsi = PDFJSI::getInstance();
+        PageHit hit;
+        std::string error;
+        std::shared_ptr<PDFDocument> document = jsi.renderEngine().resolveDocument(id, std::string(), error);
+        if (!document) {
+            LOGE("hitTest: cannot open %s: %s", id.c_str(), error.c_str());
+            return nullptr;
+        }
+        if (!jsi.hitIndex().hitTest(document, pageNumber, x, y, tolerance, hit, error)) {
+            LOGE("hitTest failed for %s page %d: %s", id.c_str(), pageNumber, error.c_str());
+            return nullptr;
+        }
+        return createHitResultMap(env, pageNumber, hit);
+    }
+    
+    JNIEXPORT jobject JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeSelectText(JNIEnv *env, jobject thiz, jstring pdfId, jint pageNumber, jfloat startX, jfloat startY, jfloat endX, jfloat endY, jfloat tolerance) {
+        std::string id = jstringToString(env, pdfId);
+        PDFJSI& jsi = PDFJSI::getInstance();
+        std::vector<PageWord> words;
+        std::u16string text;
+        std::string error;
+        std::shared_ptr<PDFDocument> document = jsi.renderEngine().resolveDocument(id, std::string(), error);
+        if (!document) {
+            LOGE("selectText: cannot open %s: %s", id.c_str(), error.c_str());
+            return nullptr;
+        }
+        if (!jsi.hitIndex().selectWords(document, pageNumber, startX, startY, endX, endY, tolerance, words, text, error)) {
+            LOGE("selectText failed for %s page %d: %s", id.c_str(), pageNumber, error.c_str());
+            return nullptr;
+        }
+        return createSelectionMap(env, pageNumber, words, text);
+    }
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeSetTextIndexDirectory(JNIEnv *env, jobject thiz, jstring directory) {
+        PDFJSI::getInstance().textIndex().setStorageDirectory(jstringToString(env, directory));
     }
     
     JNIEXPORT jobject JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeGetPerformanceMetrics(JNIEnv *env, jobject thiz, jstring pdfId) {
-        LOGD("Native getPerformanceMetrics called for pdfId: %s", 
-             env->GetStringUTFChars(pdfId, nullptr));
+        std::string id = jstringToString(env, pdfId);
+        LOGD("Native getPerformanceMetrics called for pdfId: %s", id.c_str());
         
+        PDFJSI& jsi = PDFJSI::getInstance();
         std::map<std::string, std::string> result;
-        result["lastRenderTime"] = "120.0";
-        result["avgRenderTime"] = "90.0";
-        result["cacheHitRatio"] = "0.85";
-        result["memoryUsageMB"] = "25.5";
+        
+        // Histograms are process-wide; the cache figures are per document when pdfId is given
+        for (int metric = 0; metric < PDFTrace::kMetricCount; ++metric) {
+            PDFTrace::Summary summary = PDFTrace::summarize(static_cast<PDFTrace::Metric>(metric));
+            std::string prefix = PDFTrace::metricName(static_cast<PDFTrace::Metric>(metric));
+            result[prefix + "Count"] = std::to_string(summary.count);
+            result[prefix + "AvgMs"] = std::to_string(summary.meanMs);
+            result[prefix + "P50Ms"] = std::to_string(summary.p50Ms);
+            result[prefix + "P90Ms"] = std::to_string(summary.p90Ms);
+            result[prefix + "P99Ms"] = std::to_string(summary.p99Ms);
+            result[prefix + "MaxMs"] = std::to_string(summary.maxMs);
+            result[prefix + "LastMs"] = std::to_string(summary.lastMs);
+        }
+        
+        PDFTrace::Summary render = PDFTrace::summarize(PDFTrace::kRender);
+        result["lastRenderTime"] = std::to_string(render.lastMs);
+        result["avgRenderTime"] = std::to_string(render.meanMs);
+        
+        PageCacheStats total = jsi.pageCache().stats();
+        PageCacheStats document = id.empty() ? total : jsi.pageCache().documentStats(id);
+        result["cacheHitRatio"] = std::to_string(document.hitRatio());
+        
+        // Native memory this library holds for rendering: cached pages and pooled free blocks
+        size_t nativeBytes = total.bytes + jsi.bitmapPool().stats().freeBytes;
+        result["memoryUsageMB"] = std::to_string(nativeBytes / (1024.0 * 1024.0));
+        result["tracingEnabled"] = PDFJSI_TRACING ? "true" : "false";
         
         return createWritableMap(env, result);
     }
     
     JNIEXPORT jboolean JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeSetRenderQuality(JNIEnv *env, jobject thiz, jstring pdfId, jint quality) {
-        LOGD("Native setRenderQuality called for pdfId: %s, quality: %d", 
-             env->GetStringUTFChars(pdfId, nullptr), quality);
-        return JNI_TRUE;
+        std::string id = jstringToString(env, pdfId);
+        LOGD("Native setRenderQuality called for pdfId: %s, quality: %d", id.c_str(), quality);
+        // Pages cached at the previous level stay until evicted; the new level has its own cache keys
+        return PDFJSI::getInstance().renderEngine().setDocumentQuality(id, quality) ? JNI_TRUE : JNI_FALSE;
     }
     
     JNIEXPORT void JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeCleanupJSI(JNIEnv *env, jobject thiz) {
         LOGD("Native cleanupJSI called");
-        // Cleanup logic here
+        PDFJSI::getInstance().cleanup();
     }
     
     JNIEXPORT jstring JNICALL
@@ -244,5 +709,339 @@ extern "C" {
         std::string result = PDFJSI::getInstance().getJSIStats();
         return env->NewStringUTF(result.c_str());
     }
+    
+    JNIEXPORT jint JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeAcquire(JNIEnv *env, jclass clazz, jstring pdfId, jstring filePath) {
+        std::string id = jstringToString(env, pdfId);
+        DocumentSource source;
+        source.filePath = jstringToString(env, filePath);
+        
+        std::string error;
+        PDFJSI& jsi = PDFJSI::getInstance();
+        std::shared_ptr<PDFDocument> document = jsi.documents().acquire(id, source, error);
+        if (!document) {
+            LOGE("Failed to open document %s: %s", id.c_str(), error.c_str());
+            return -1;
+        }
+        jsi.pageCache().registerDocument(id);
+        return document->pageCount;
+    }
+    
+    JNIEXPORT jint JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeAcquireDescriptor(JNIEnv *env, jclass clazz, jstring pdfId, jint fd) {
+        std::string id = jstringToString(env, pdfId);
+        DocumentSource source;
+        source.fd = fd;
+        
+        std::string error;
+        PDFJSI& jsi = PDFJSI::getInstance();
+        std::shared_ptr<PDFDocument> document = jsi.documents().acquire(id, source, error);
+        if (!document) {
+            LOGE("Failed to map document %s: %s", id.c_str(), error.c_str());
+            return -1;
+        }
+        jsi.pageCache().registerDocument(id);
+        return document->pageCount;
+    }
+    
+    JNIEXPORT jlong JNICALL
+    Java_org_wonday_pdf_StreamingBase64Decoder_nativeDecodeToFile(JNIEnv *env, jclass clazz, jstring base64Data, jstring outputPath,
+                                                                  jobject callback) {
+        std::string path = jstringToString(env, outputPath);
+        jmethodID onProgress = nullptr;
+        if (callback) {
+            jclass callbackClass = env->GetObjectClass(callback);
+            onProgress = env->GetMethodID(callbackClass, "onProgress", "(F)V");
+            env->DeleteLocalRef(callbackClass);
+        }
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            LOGE("decodeToFile could not open %s", path.c_str());
+            return -1;
+        }
+        
+        int64_t written = 0;
+        bool decoded = decodeBase64String(env, base64Data, [env, callback, onProgress, fd, &written](
+                const uint8_t* bytes, size_t size, float consumed) {
+            while (size > 0) {
+                ssize_t count = write(fd, bytes, size);
+                if (count < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return false;
+                }
+                bytes += count;
+                size -= static_cast<size_t>(count);
+                written += count;
+            }
+            // Once per 64K-char chunk; a throwing callback aborts the decode
+            if (onProgress) {
+                env->CallVoidMethod(callback, onProgress, static_cast<jfloat>(consumed));
+                if (env->ExceptionCheck()) {
+                    return false;
+                }
+            }
+            return true;
+        });
+        bool synced = decoded && fsync(fd) == 0;
+        close(fd);
+        if (!synced) {
+            LOGE("decodeToFile failed for %s after %lld bytes", path.c_str(), static_cast<long long>(written));
+            unlink(path.c_str());
+            return -1;
+        }
+        return static_cast<jlong>(written);
+    }
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeRelease(JNIEnv *env, jclass clazz, jstring pdfId) {
+        std::string id = jstringToString(env, pdfId);
+        PDFJSI& jsi = PDFJSI::getInstance();
+        jsi.documents().release(id);
+        if (!jsi.documents().find(id)) {
+            jsi.preloader().cancel(id);
+            jsi.renderEngine().forgetDocument(id);
+            jsi.textIndex().forget(id);
+            jsi.hitIndex().forget(id);
+        }
+    }
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeSetInteracting(JNIEnv *env, jclass clazz, jstring pdfId, jboolean active) {
+        // Views send hints for files nothing may have opened; keep no state for those
+        PDFJSI& jsi = PDFJSI::getInstance();
+        std::string id = jstringToString(env, pdfId);
+        if (jsi.documents().find(id)) {
+            jsi.renderEngine().setInteracting(id, active == JNI_TRUE);
+        }
+    }
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeTrimMemory(JNIEnv *env, jclass clazz, jint level) {
+        PDFJSI::getInstance().memoryGovernor().shed(PDFMemoryGovernor::pressureForTrimLevel(level));
+    }
+    
+    JNIEXPORT jfloatArray JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeGetPageSize(JNIEnv *env, jclass clazz, jstring pdfId, jint pageNumber) {
+        PageSize size;
+        std::string error;
+        if (!PDFJSI::getInstance().renderEngine().getPageSize(jstringToString(env, pdfId), pageNumber, size, error)) {
+            LOGE("getPageSize failed for page %d: %s", pageNumber, error.c_str());
+            return nullptr;
+        }
+        jfloat values[3] = {
+            static_cast<jfloat>(size.width),
+            static_cast<jfloat>(size.height),
+            static_cast<jfloat>(size.rotation)
+        };
+        jfloatArray result = env->NewFloatArray(3);
+        env->SetFloatArrayRegion(result, 0, 3, values);
+        return result;
+    }
+    
+    JNIEXPORT jfloatArray JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeGetPageGeometry(JNIEnv *env, jclass clazz, jstring pdfId) {
+        std::string id = jstringToString(env, pdfId);
+        std::vector<PageGeometry> table;
+        std::string error;
+        if (!PDFJSI::getInstance().renderEngine().getPageGeometry(id, table, error)) {
+            LOGE("getPageGeometry failed for %s: %s", id.c_str(), error.c_str());
+            return nullptr;
+        }
+        std::vector<jfloat> values;
+        values.reserve(table.size() * PDFJSI_PAGE_GEOMETRY_FIELDS);
+        for (const PageGeometry& geometry : table) {
+            values.push_back(geometry.width);
+            values.push_back(geometry.height);
+            values.insert(values.end(), geometry.mediaBox, geometry.mediaBox + 4);
+            values.insert(values.end(), geometry.cropBox, geometry.cropBox + 4);
+            values.push_back(static_cast<jfloat>(geometry.rotation));
+            values.push_back(geometry.userUnit);
+        }
+        jfloatArray result = env->NewFloatArray(values.size());
+        env->SetFloatArrayRegion(result, 0, values.size(), values.data());
+        return result;
+    }
+    
+    JNIEXPORT jboolean JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeSetPageGeometry(JNIEnv *env, jclass clazz, jstring pdfId, jfloatArray values) {
+        std::string id = jstringToString(env, pdfId);
+        jsize length = values ? env->GetArrayLength(values) : 0;
+        if (length % PDFJSI_PAGE_GEOMETRY_FIELDS != 0) {
+            LOGE("setPageGeometry for %s: %d values is not a whole number of pages", id.c_str(), length);
+            return JNI_FALSE;
+        }
+        std::vector<jfloat> flat(length);
+        env->GetFloatArrayRegion(values, 0, length, flat.data());
+        
+        std::vector<PageGeometry> table(length / PDFJSI_PAGE_GEOMETRY_FIELDS);
+        const jfloat* row = flat.data();
+        for (PageGeometry& geometry : table) {
+            geometry.width = row[0];
+            geometry.height = row[1];
+            std::copy(row + 2, row + 6, geometry.mediaBox);
+            std::copy(row + 6, row + 10, geometry.cropBox);
+            geometry.rotation = static_cast<int>(row[10]);
+            geometry.userUnit = row[11];
+            row += PDFJSI_PAGE_GEOMETRY_FIELDS;
+        }
+        std::string error;
+        if (!PDFJSI::getInstance().renderEngine().setPageGeometry(id, table, error)) {
+            LOGW("Persisted page geometry not used for %s: %s", id.c_str(), error.c_str());
+            return JNI_FALSE;
+        }
+        return JNI_TRUE;
+    }
+    
+    JNIEXPORT jboolean JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeSetPageStoreKey(JNIEnv *env, jclass clazz, jstring pdfId, jstring key) {
+        std::string id = jstringToString(env, pdfId);
+        std::string error;
+        if (!PDFJSI::getInstance().renderEngine().setPageStoreKey(id, jstringToString(env, key), error)) {
+            LOGW("Page store key not set for %s: %s", id.c_str(), error.c_str());
+            return JNI_FALSE;
+        }
+        return JNI_TRUE;
+    }
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativePrefetchHitIndex(JNIEnv *env, jclass clazz, jstring pdfId, jint pageNumber) {
+        PDFJSI& jsi = PDFJSI::getInstance();
+        if (std::shared_ptr<PDFDocument> document = jsi.documents().find(jstringToString(env, pdfId))) {
+            jsi.hitIndex().prefetch(document, pageNumber);
+        }
+    }
+    
+    JNIEXPORT jboolean JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeRenderPageToBitmap(JNIEnv *env, jclass clazz, jstring pdfId, jint pageNumber, jobject bitmap) {
+        AndroidBitmapInfo info;
+        if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS ||
+            info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) {
+            LOGE("renderPageToBitmap requires an ARGB_8888 bitmap");
+            return JNI_FALSE;
+        }
+        
+        void* pixels = nullptr;
+        if (AndroidBitmap_lockPixels(env, bitmap, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) {
+            LOGE("renderPageToBitmap could not lock bitmap pixels");
+            return JNI_FALSE;
+        }
+        
+        std::string error;
+        bool rendered = PDFJSI::getInstance().renderEngine().renderPageInto(
+            jstringToString(env, pdfId), pageNumber, pixels,
+            static_cast<int>(info.width), static_cast<int>(info.height), static_cast<int>(info.stride), error);
+        AndroidBitmap_unlockPixels(env, bitmap);
+        
+        if (!rendered) {
+            LOGE("renderPageToBitmap failed for page %d: %s", pageNumber, error.c_str());
+        }
+        return rendered ? JNI_TRUE : JNI_FALSE;
+    }
+    
+    JNIEXPORT jlong JNICALL
+    Java_org_wonday_pdf_ProgressiveDownloader_nativeCreate(JNIEnv *env, jclass clazz, jstring path, jlong fileSize) {
+        if (fileSize <= 0) {
+            return 0;
+        }
+        std::unique_ptr<PDFProgressiveDocument> document(
+            new PDFProgressiveDocument(jstringToString(env, path), static_cast<size_t>(fileSize)));
+        std::string error;
+        if (!document->open(error)) {
+            LOGD("Progressive open unavailable: %s", error.c_str());
+            return 0;
+        }
+        return reinterpret_cast<jlong>(document.release());
+    }
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_ProgressiveDownloader_nativeMarkAvailable(JNIEnv *env, jclass clazz, jlong handle, jlong offset, jlong length) {
+        if (handle != 0 && offset >= 0 && length > 0) {
+            reinterpret_cast<PDFProgressiveDocument*>(handle)->markAvailable(static_cast<size_t>(offset), static_cast<size_t>(length));
+        }
+    }
+    
+    // [state, linearization, pageCount, firstPage, hint offset, hint length, ...]
+    JNIEXPORT jlongArray JNICALL
+    Java_org_wonday_pdf_ProgressiveDownloader_nativePoll(JNIEnv *env, jclass clazz, jlong handle) {
+        if (handle == 0) {
+            return nullptr;
+        }
+        PDFProgressiveDocument* document = reinterpret_cast<PDFProgressiveDocument*>(handle);
+        std::vector<ByteRange> hints;
+        std::string error;
+        int state = document->poll(hints, error);
+        if (state == PDFJSI_PROGRESSIVE_ERROR) {
+            LOGW("Progressive open stopped: %s", error.c_str());
+        }
+        
+        std::vector<jlong> values;
+        values.reserve(4 + hints.size() * 2);
+        values.push_back(state);
+        values.push_back(document->linearization());
+        values.push_back(state >= PDFJSI_PROGRESSIVE_DOCUMENT ? document->pageCount() : 0);
+        values.push_back(state >= PDFJSI_PROGRESSIVE_DOCUMENT ? document->firstPage() : 0);
+        for (const ByteRange& hint : hints) {
+            values.push_back(static_cast<jlong>(hint.offset));
+            values.push_back(static_cast<jlong>(hint.length));
+        }
+        jlongArray result = env->NewLongArray(static_cast<jsize>(values.size()));
+        if (result) {
+            env->SetLongArrayRegion(result, 0, static_cast<jsize>(values.size()), values.data());
+        }
+        return result;
+    }
+    
+    JNIEXPORT jfloatArray JNICALL
+    Java_org_wonday_pdf_ProgressiveDownloader_nativeFirstPageSize(JNIEnv *env, jclass clazz, jlong handle) {
+        if (handle == 0) {
+            return nullptr;
+        }
+        float size[2];
+        std::string error;
+        if (!reinterpret_cast<PDFProgressiveDocument*>(handle)->firstPageSize(size[0], size[1], error)) {
+            LOGE("Progressive first page size failed: %s", error.c_str());
+            return nullptr;
+        }
+        jfloatArray result = env->NewFloatArray(2);
+        if (result) {
+            env->SetFloatArrayRegion(result, 0, 2, size);
+        }
+        return result;
+    }
+    
+    JNIEXPORT jboolean JNICALL
+    Java_org_wonday_pdf_ProgressiveDownloader_nativeRenderFirstPage(JNIEnv *env, jclass clazz, jlong handle, jobject bitmap) {
+        if (handle == 0) {
+            return JNI_FALSE;
+        }
+        AndroidBitmapInfo info;
+        if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS ||
+            info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) {
+            LOGE("renderFirstPage requires an ARGB_8888 bitmap");
+            return JNI_FALSE;
+        }
+        
+        void* pixels = nullptr;
+        if (AndroidBitmap_lockPixels(env, bitmap, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) {
+            LOGE("renderFirstPage could not lock bitmap pixels");
+            return JNI_FALSE;
+        }
+        
+        std::string error;
+        bool rendered = reinterpret_cast<PDFProgressiveDocument*>(handle)->renderFirstPage(
+            pixels, static_cast<int>(info.width), static_cast<int>(info.height), static_cast<int>(info.stride), error);
+        AndroidBitmap_unlockPixels(env, bitmap);
+        
+        if (!rendered) {
+            LOGE("renderFirstPage failed: %s", error.c_str());
+        }
+        return rendered ? JNI_TRUE : JNI_FALSE;
+    }
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_ProgressiveDownloader_nativeDestroy(JNIEnv *env, jclass clazz, jlong handle) {
+        delete reinterpret_cast<PDFProgressiveDocument*>(handle);
+    }
 }
-       
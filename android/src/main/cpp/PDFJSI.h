@@ -18,14 +18,11 @@
 #include <mutex>
 #include <thread>
 #include <future>
-#include <android/log.h>
-
-// Logging macros
-#define LOG_TAG "PDFJSI"
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+#include "PDFJSILog.h"
+#include "PDFRenderEngine.h"
+#include "PDFPreloader.h"
+#include "PDFTextIndex.h"
+#include "PDFMemoryGovernor.h"
 
 // PDF JSI Implementation
 class PDFJSI {
@@ -39,15 +36,60 @@ public:
     
     // JSI Stats
     std::string getJSIStats();
+    
+    // Open native documents shared by the view, PdfManager, PDFExporter and JSI
+    PDFDocumentRegistry& documents() { return m_documents; }
+    
+    // Rendered page bitmaps, shared by on-demand renders and preloading
+    PDFPageCache& pageCache() { return m_pageCache; }
+    
+    // Free pixel blocks the render engine allocates page bitmaps from
+    PDFBitmapPool& bitmapPool() { return m_bitmapPool; }
+    
+    // Compressed rendered pages kept on disk across launches
+    PDFPageStore& pageStore() { return m_pageStore; }
+    
+    // Native render engine (renders documents from the registry)
+    PDFRenderEngine& renderEngine() { return m_renderEngine; }
+    
+    // Background workers filling the page cache ahead of the viewer
+    PDFPreloader& preloader() { return m_preloader; }
+    
+    // Glyph, word and link boxes of shown pages behind hitTest and selectText
+    PDFHitIndex& hitIndex() { return m_hitIndex; }
+    
+    // Extracted page text and inverted index behind searchTextDirect
+    PDFTextIndex& textIndex() { return m_textIndex; }
+    
+    // Global memory budget and stepwise shedding under memory pressure
+    PDFMemoryGovernor& memoryGovernor() { return m_memoryGovernor; }
 
 private:
-    PDFJSI() = default;
+    PDFJSI()
+        : m_textIndex(m_hitIndex),
+          m_renderEngine(m_documents, m_pageCache, m_bitmapPool, m_pageStore, m_hitIndex),
+          m_preloader(m_renderEngine, m_pageCache),
+          m_memoryGovernor(m_pageCache, m_bitmapPool, m_textIndex, m_hitIndex, m_documents, m_preloader, m_renderEngine) {}
     ~PDFJSI() = default;
     PDFJSI(const PDFJSI&) = delete;
     PDFJSI& operator=(const PDFJSI&) = delete;
     
     bool m_initialized = false;
     std::mutex m_mutex;
+    // Declared before the engine, which holds references to them; the pool
+    // outlives the cache and the store's pending writes because their bitmaps
+    // return blocks to it
+    PDFBitmapPool m_bitmapPool;
+    PDFPageStore m_pageStore;
+    PDFDocumentRegistry m_documents;
+    PDFPageCache m_pageCache;
+    // Its builder thread is joined before the registry closes the documents
+    PDFHitIndex m_hitIndex;
+    PDFTextIndex m_textIndex;
+    PDFRenderEngine m_renderEngine;
+    // Its workers are joined before the engine and cache go away
+    PDFPreloader m_preloader;
+    PDFMemoryGovernor m_memoryGovernor;
 };
 
 // JNI Functions
@@ -58,18 +100,39 @@ extern "C" {
     JNIEXPORT jboolean JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeIsJSIAvailable(JNIEnv *env, jobject thiz);
     
+    // Installs global.__pdfJSI (PDFJSIHostObject.cpp)
+    JNIEXPORT jboolean JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeInstallJSIBindings(JNIEnv *env, jobject thiz, jlong jsContextPointer);
+    
     JNIEXPORT jobject JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeRenderPageDirect(JNIEnv *env, jobject thiz, jstring pdfId, jint pageNumber, jfloat scale, jstring base64Data);
     
+    // Batch variants return one float[] laid out as a struct of arrays
+    JNIEXPORT jfloatArray JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeRenderPagesDirect(JNIEnv *env, jobject thiz, jstring pdfId, jintArray pages, jfloat scale, jint quality);
+    
     JNIEXPORT jobject JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeGetPageMetrics(JNIEnv *env, jobject thiz, jstring pdfId, jint pageNumber);
     
+    JNIEXPORT jfloatArray JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeGetPageMetricsBatch(JNIEnv *env, jobject thiz, jstring pdfId, jintArray pages);
+    
     JNIEXPORT jboolean JNICALL
-    Java_org_wonday_pdf_PDFJSIManager_nativePreloadPagesDirect(JNIEnv *env, jobject thiz, jstring pdfId, jint startPage, jint endPage);
+    Java_org_wonday_pdf_PDFJSIManager_nativePreloadPagesDirect(JNIEnv *env, jobject thiz, jstring pdfId, jint startPage, jint endPage, jint currentPage);
     
     JNIEXPORT jobject JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeSearchTextDirect(JNIEnv *env, jobject thiz, jstring pdfId, jstring searchTerm, jint startPage, jint endPage);
     
+    // Point and range lookups in PDF page coordinates (PDFHitIndex)
+    JNIEXPORT jobject JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeHitTest(JNIEnv *env, jobject thiz, jstring pdfId, jint pageNumber, jfloat x, jfloat y, jfloat tolerance);
+    
+    JNIEXPORT jobject JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeSelectText(JNIEnv *env, jobject thiz, jstring pdfId, jint pageNumber, jfloat startX, jfloat startY, jfloat endX, jfloat endY, jfloat tolerance);
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeSetTextIndexDirectory(JNIEnv *env, jobject thiz, jstring directory);
+    
     JNIEXPORT jobject JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeGetCacheMetrics(JNIEnv *env, jobject thiz, jstring pdfId);
     
@@ -79,6 +142,15 @@ extern "C" {
     JNIEXPORT jboolean JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeOptimizeMemory(JNIEnv *env, jobject thiz, jstring pdfId);
     
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeSetMemoryBudget(JNIEnv *env, jobject thiz, jlong budgetBytes);
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeSetCacheBudget(JNIEnv *env, jobject thiz, jlong budgetBytes);
+    
+    JNIEXPORT jboolean JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeConfigurePageStore(JNIEnv *env, jobject thiz, jstring directory, jlong budgetBytes);
+    
     JNIEXPORT jobject JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeGetPerformanceMetrics(JNIEnv *env, jobject thiz, jstring pdfId);
     
@@ -90,6 +162,64 @@ extern "C" {
     
     JNIEXPORT jstring JNICALL
     Java_org_wonday_pdf_PDFJSIManager_nativeGetJSIStats(JNIEnv *env, jobject thiz);
+    
+    // Shared document registry (org.wonday.pdf.NativeDocumentRegistry)
+    JNIEXPORT jint JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeAcquire(JNIEnv *env, jclass clazz, jstring pdfId, jstring filePath);
+    
+    JNIEXPORT jint JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeAcquireDescriptor(JNIEnv *env, jclass clazz, jstring pdfId, jint fd);
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeRelease(JNIEnv *env, jclass clazz, jstring pdfId);
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeSetInteracting(JNIEnv *env, jclass clazz, jstring pdfId, jboolean active);
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeTrimMemory(JNIEnv *env, jclass clazz, jint level);
+    
+    JNIEXPORT jfloatArray JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeGetPageSize(JNIEnv *env, jclass clazz, jstring pdfId, jint pageNumber);
+    
+    JNIEXPORT jfloatArray JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeGetPageGeometry(JNIEnv *env, jclass clazz, jstring pdfId);
+    
+    JNIEXPORT jboolean JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeSetPageGeometry(JNIEnv *env, jclass clazz, jstring pdfId, jfloatArray values);
+    
+    JNIEXPORT jboolean JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeSetPageStoreKey(JNIEnv *env, jclass clazz, jstring pdfId, jstring key);
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativePrefetchHitIndex(JNIEnv *env, jclass clazz, jstring pdfId, jint pageNumber);
+    
+    JNIEXPORT jboolean JNICALL
+    Java_org_wonday_pdf_NativeDocumentRegistry_nativeRenderPageToBitmap(JNIEnv *env, jclass clazz, jstring pdfId, jint pageNumber, jobject bitmap);
+    
+    // Progressive open of downloading files (org.wonday.pdf.ProgressiveDownloader)
+    JNIEXPORT jlong JNICALL
+    Java_org_wonday_pdf_ProgressiveDownloader_nativeCreate(JNIEnv *env, jclass clazz, jstring path, jlong fileSize);
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_ProgressiveDownloader_nativeMarkAvailable(JNIEnv *env, jclass clazz, jlong handle, jlong offset, jlong length);
+    
+    JNIEXPORT jlongArray JNICALL
+    Java_org_wonday_pdf_ProgressiveDownloader_nativePoll(JNIEnv *env, jclass clazz, jlong handle);
+    
+    JNIEXPORT jfloatArray JNICALL
+    Java_org_wonday_pdf_ProgressiveDownloader_nativeFirstPageSize(JNIEnv *env, jclass clazz, jlong handle);
+    
+    JNIEXPORT jboolean JNICALL
+    Java_org_wonday_pdf_ProgressiveDownloader_nativeRenderFirstPage(JNIEnv *env, jclass clazz, jlong handle, jobject bitmap);
+    
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_ProgressiveDownloader_nativeDestroy(JNIEnv *env, jclass clazz, jlong handle);
+    
+    // Native base64 decoding (org.wonday.pdf.StreamingBase64Decoder)
+    JNIEXPORT jlong JNICALL
+    Java_org_wonday_pdf_StreamingBase64Decoder_nativeDecodeToFile(JNIEnv *env, jclass clazz, jstring base64Data, jstring outputPath,
+                                                                  jobject callback);
 }
 
 #endif // PDFJSI_H
\ No newline at end of file
@@ -0,0 +1,557 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * JSI host object installed as global.__pdfJSI
+ * Built with exceptions enabled: jsi reports argument errors to JS as JSError.
+ * Rendering and search run on a worker thread and settle Promises on the JS
+ * thread, which PDFJSIManager reaches through runOnJSQueueThread.
+ */
+
+#include "PDFJSIHostObject.h"
+#include "PDFJSI.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+using namespace facebook;
+
+namespace {
+
+const char* const kPropertyNames[] = {
+    "renderPage",
+    "renderPages",
+    "getPageSize",
+    "getPageSizes",
+    "preloadPages",
+    "getCacheMetrics",
+    "searchText",
+    "setInteracting",
+};
+
+// Owns the bytes behind a typed-array result
+class VectorBuffer : public jsi::MutableBuffer {
+public:
+    explicit VectorBuffer(size_t size) : m_bytes(size) {}
+    VectorBuffer(const uint8_t* bytes, size_t size) : m_bytes(bytes, bytes + size) {}
+
+    size_t size() const override { return m_bytes.size(); }
+    uint8_t* data() override { return m_bytes.data(); }
+
+private:
+    std::vector<uint8_t> m_bytes;
+};
+
+// Promise callbacks of one call; created and destroyed on the JS thread only
+struct Deferred {
+    Deferred(jsi::Runtime& runtime, const jsi::Value* args)
+        : resolve(args[0].getObject(runtime).getFunction(runtime)),
+          reject(args[1].getObject(runtime).getFunction(runtime)) {}
+
+    jsi::Function resolve;
+    jsi::Function reject;
+};
+
+struct Task {
+    // Worker thread: Pdfium work, no jsi
+    std::function<void()> work;
+    // JS thread: builds the result and settles the Promise
+    std::function<void(jsi::Runtime&)> complete;
+};
+
+// A task with the runtime it was posted from
+struct Job {
+    jsi::Runtime* runtime = nullptr;
+    Task task;
+};
+
+// One worker, since Pdfium calls are serialized anyway. Finished jobs wait in
+// m_completed until PDFJSIManager drains them on the JS thread.
+class JSIWorker {
+public:
+    static JSIWorker& instance() {
+        // Leaked: the thread runs for the life of the process
+        static JSIWorker* worker = new JSIWorker();
+        return *worker;
+    }
+
+    // Remembers how to wake the JS thread (PDFJSIManager.scheduleJSICallbacks)
+    void attach(JNIEnv* env, jobject manager) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_vm) {
+            env->GetJavaVM(&m_vm);
+        }
+        if (m_manager) {
+            env->DeleteGlobalRef(m_manager);
+        }
+        m_manager = env->NewGlobalRef(manager);
+        jclass managerClass = env->GetObjectClass(manager);
+        m_schedule = env->GetMethodID(managerClass, "scheduleJSICallbacks", "()V");
+        env->DeleteLocalRef(managerClass);
+    }
+
+    void post(jsi::Runtime& runtime, Task task) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(Job{&runtime, std::move(task)});
+        if (!m_started) {
+            m_started = true;
+            std::thread(&JSIWorker::run, this).detach();
+        }
+        m_wake.notify_one();
+    }
+
+    // JS thread
+    void drain(jsi::Runtime& runtime) {
+        std::deque<Job> completed;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            completed.swap(m_completed);
+        }
+        for (Job& job : completed) {
+            if (job.runtime != &runtime) {
+                // Posted from a runtime since reloaded; its jsi values cannot be destroyed
+                new Task(std::move(job.task));
+                continue;
+            }
+            job.task.complete(runtime);
+        }
+    }
+
+private:
+    JSIWorker() = default;
+
+    void run() {
+        JNIEnv* env = nullptr;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_vm) {
+            m_vm->AttachCurrentThread(&env, nullptr);
+        }
+        while (true) {
+            m_wake.wait(lock, [this] { return !m_pending.empty(); });
+            Job job = std::move(m_pending.front());
+            m_pending.pop_front();
+            lock.unlock();
+
+            job.task.work();
+            job.task.work = nullptr;
+
+            lock.lock();
+            m_completed.push_back(std::move(job));
+            jobject manager = m_manager;
+            lock.unlock();
+            if (env && manager && m_schedule) {
+                env->CallVoidMethod(manager, m_schedule);
+                if (env->ExceptionCheck()) {
+                    env->ExceptionClear();
+                }
+            }
+            lock.lock();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_started = false;
+    std::deque<Job> m_pending;
+    std::deque<Job> m_completed;
+    JavaVM* m_vm = nullptr;
+    jobject m_manager = nullptr;
+    jmethodID m_schedule = nullptr;
+};
+
+// new Promise((resolve, reject) => ...): work runs on the worker, then
+// complete(runtime, deferred) settles the Promise on the JS thread
+jsi::Value runAsync(jsi::Runtime& runtime, std::function<void()> work,
+                    std::function<void(jsi::Runtime&, Deferred&)> complete) {
+    jsi::Function executor = jsi::Function::createFromHostFunction(runtime,
+        jsi::PropNameID::forAscii(runtime, "executor"), 2,
+        [work, complete](jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* args, size_t count) -> jsi::Value {
+            auto deferred = std::make_shared<Deferred>(runtime, args);
+            Task task;
+            task.work = work;
+            task.complete = [deferred, complete](jsi::Runtime& runtime) {
+                try {
+                    complete(runtime, *deferred);
+                } catch (const jsi::JSError& error) {
+                    deferred->reject.call(runtime, error.value());
+                }
+            };
+            JSIWorker::instance().post(runtime, std::move(task));
+            return jsi::Value::undefined();
+        });
+    return runtime.global().getPropertyAsFunction(runtime, "Promise").callAsConstructor(runtime, executor);
+}
+
+std::string stringArgument(jsi::Runtime& runtime, const jsi::Value* args, size_t count, size_t index, const char* name) {
+    if (index >= count || !args[index].isString()) {
+        throw jsi::JSError(runtime, std::string(name) + " must be a string");
+    }
+    return args[index].getString(runtime).utf8(runtime);
+}
+
+double numberArgument(jsi::Runtime& runtime, const jsi::Value* args, size_t count, size_t index, const char* name) {
+    if (index >= count || !args[index].isNumber()) {
+        throw jsi::JSError(runtime, std::string(name) + " must be a number");
+    }
+    return args[index].getNumber();
+}
+
+double optionalNumberArgument(const jsi::Value* args, size_t count, size_t index, double fallback) {
+    return index < count && args[index].isNumber() ? args[index].getNumber() : fallback;
+}
+
+// Page list argument: an array of page numbers, or startPage and endPage at
+// index and index + 1 (endPage defaults to startPage)
+std::vector<int> pagesArgument(jsi::Runtime& runtime, const jsi::Value* args, size_t count, size_t index) {
+    std::vector<int> pages;
+    if (index < count && args[index].isObject() && args[index].getObject(runtime).isArray(runtime)) {
+        jsi::Array array = args[index].getObject(runtime).getArray(runtime);
+        size_t length = array.size(runtime);
+        pages.reserve(length);
+        for (size_t i = 0; i < length; ++i) {
+            jsi::Value page = array.getValueAtIndex(runtime, i);
+            if (!page.isNumber()) {
+                throw jsi::JSError(runtime, "pages must contain only numbers");
+            }
+            pages.push_back(static_cast<int>(page.getNumber()));
+        }
+        return pages;
+    }
+    int startPage = static_cast<int>(numberArgument(runtime, args, count, index, "pages or startPage"));
+    int endPage = static_cast<int>(optionalNumberArgument(args, count, index + 1, startPage));
+    for (int page = startPage; page <= endPage; ++page) {
+        pages.push_back(page);
+    }
+    return pages;
+}
+
+// new <constructorName>(buffer, byteOffset, length)
+jsi::Value typedArray(jsi::Runtime& runtime, const char* constructorName, const jsi::Value& buffer,
+                      size_t byteOffset, size_t length) {
+    return runtime.global().getPropertyAsFunction(runtime, constructorName).callAsConstructor(runtime,
+        buffer, static_cast<double>(byteOffset), static_cast<double>(length));
+}
+
+// Pixels are copied on the worker: the cached bitmap is shared with other
+// renders and the page store, and JS may write into an ArrayBuffer
+std::shared_ptr<VectorBuffer> copyPixels(const RenderResult& render) {
+    if (!render.success) {
+        return nullptr;
+    }
+    const std::vector<uint8_t>& pixels = render.bitmap->pixels;
+    return std::make_shared<VectorBuffer>(pixels.data(), pixels.size());
+}
+
+jsi::Object renderResultObject(jsi::Runtime& runtime, const RenderResult& render, const std::shared_ptr<VectorBuffer>& pixels,
+                               int pageNumber, float scale) {
+    jsi::Object result(runtime);
+    result.setProperty(runtime, "success", render.success);
+    result.setProperty(runtime, "pageNumber", pageNumber);
+    result.setProperty(runtime, "scale", static_cast<double>(scale));
+    if (!render.success) {
+        result.setProperty(runtime, "error", jsi::String::createFromUtf8(runtime, render.error));
+        return result;
+    }
+    result.setProperty(runtime, "width", render.width);
+    result.setProperty(runtime, "height", render.height);
+    result.setProperty(runtime, "stride", render.bitmap->stride);
+    result.setProperty(runtime, "quality", render.quality);
+    result.setProperty(runtime, "format", jsi::String::createFromAscii(runtime,
+        render.bitmap->format == PDFJSI_PIXEL_RGB_565 ? "rgb565" : "rgba8888"));
+    result.setProperty(runtime, "cached", render.cached);
+    result.setProperty(runtime, "renderTimeMs", render.renderTimeMs);
+    result.setProperty(runtime, "pixels", jsi::ArrayBuffer(runtime, pixels));
+    return result;
+}
+
+// renderPage(pdfId, pageNumber, scale, quality?) -> Promise<{ success, width, height, stride, format, pixels, ... }>
+// quality defaults to the document's level (draft while setInteracting is active)
+jsi::Value renderPage(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count) {
+    std::string pdfId = stringArgument(runtime, args, count, 0, "pdfId");
+    int pageNumber = static_cast<int>(numberArgument(runtime, args, count, 1, "pageNumber"));
+    float scale = static_cast<float>(numberArgument(runtime, args, count, 2, "scale"));
+    int quality = static_cast<int>(optionalNumberArgument(args, count, 3, PDFJSI_QUALITY_DOCUMENT));
+
+    struct Output {
+        RenderResult render;
+        std::shared_ptr<VectorBuffer> pixels;
+    };
+    auto output = std::make_shared<Output>();
+    return runAsync(runtime, [output, pdfId, pageNumber, scale, quality] {
+        PDFJSI& pdfJSI = PDFJSI::getInstance();
+        output->render = pdfJSI.renderEngine().renderPage(pdfId, pageNumber, scale, std::string(), quality);
+        pdfJSI.preloader().noteRender(pdfId, scale, quality);
+        output->pixels = copyPixels(output->render);
+    }, [output, pageNumber, scale](jsi::Runtime& runtime, Deferred& deferred) {
+        deferred.resolve.call(runtime, renderResultObject(runtime, output->render, output->pixels, pageNumber, scale));
+    });
+}
+
+// renderPages(pdfId, pages | startPage, endPage?, scale, quality?) -> Promise<[renderPage result]>
+// One call for every page a layout pass needs; pages render in order
+jsi::Value renderPages(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count) {
+    std::string pdfId = stringArgument(runtime, args, count, 0, "pdfId");
+    bool range = count > 1 && args[1].isNumber();
+    std::vector<int> pages = pagesArgument(runtime, args, count, 1);
+    size_t next = range ? 3 : 2;
+    float scale = static_cast<float>(numberArgument(runtime, args, count, next, "scale"));
+    int quality = static_cast<int>(optionalNumberArgument(args, count, next + 1, PDFJSI_QUALITY_DOCUMENT));
+
+    struct Output {
+        std::vector<RenderResult> renders;
+        std::vector<std::shared_ptr<VectorBuffer>> pixels;
+    };
+    auto output = std::make_shared<Output>();
+    return runAsync(runtime, [output, pdfId, pages, scale, quality] {
+        PDFJSI& pdfJSI = PDFJSI::getInstance();
+        for (int page : pages) {
+            output->renders.push_back(pdfJSI.renderEngine().renderPage(pdfId, page, scale, std::string(), quality));
+            output->pixels.push_back(copyPixels(output->renders.back()));
+        }
+        pdfJSI.preloader().noteRender(pdfId, scale, quality);
+    }, [output, pages, scale](jsi::Runtime& runtime, Deferred& deferred) {
+        jsi::Array results(runtime, pages.size());
+        for (size_t i = 0; i < pages.size(); ++i) {
+            results.setValueAtIndex(runtime, i,
+                renderResultObject(runtime, output->renders[i], output->pixels[i], pages[i], scale));
+        }
+        deferred.resolve.call(runtime, results);
+    });
+}
+
+// setInteracting(pdfId, active) -> undefined
+// Call on every gesture event while flinging or zooming; renders drop to draft
+// until active is false or the engine's interaction timeout passes
+jsi::Value setInteracting(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count) {
+    std::string pdfId = stringArgument(runtime, args, count, 0, "pdfId");
+    bool active = count > 1 && args[1].isBool() ? args[1].getBool() : true;
+    PDFJSI::getInstance().renderEngine().setInteracting(pdfId, active);
+    return jsi::Value::undefined();
+}
+
+// getPageSize(pdfId, pageNumber) -> { width, height, rotation } | null
+jsi::Value getPageSize(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count) {
+    std::string pdfId = stringArgument(runtime, args, count, 0, "pdfId");
+    int pageNumber = static_cast<int>(numberArgument(runtime, args, count, 1, "pageNumber"));
+
+    PageSize size;
+    std::string error;
+    if (!PDFJSI::getInstance().renderEngine().getPageSize(pdfId, pageNumber, size, error)) {
+        LOGE("getPageSize failed for %s page %d: %s", pdfId.c_str(), pageNumber, error.c_str());
+        return jsi::Value::null();
+    }
+    jsi::Object result(runtime);
+    result.setProperty(runtime, "width", size.width);
+    result.setProperty(runtime, "height", size.height);
+    result.setProperty(runtime, "rotation", size.rotation);
+    return result;
+}
+
+// getPageSizes(pdfId, pages | startPage, endPage?) -> { count, pages, widths, heights, rotations } | null
+// Int32Array / Float32Array views over one ArrayBuffer, so a layout pass over
+// a large document costs a single call and no per-page objects. Pages that are
+// out of range or fail to load report a width and height of 0.
+jsi::Value getPageSizes(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count) {
+    std::string pdfId = stringArgument(runtime, args, count, 0, "pdfId");
+    std::vector<int> pages = pagesArgument(runtime, args, count, 1);
+
+    std::vector<PageSize> sizes;
+    std::string error;
+    if (!PDFJSI::getInstance().renderEngine().getPageSizes(pdfId, pages, sizes, error)) {
+        LOGE("getPageSizes failed for %s: %s", pdfId.c_str(), error.c_str());
+        return jsi::Value::null();
+    }
+
+    // Layout: pages (int32), widths (float32), heights (float32), rotations (int32)
+    size_t pageCount = sizes.size();
+    auto buffer = std::make_shared<VectorBuffer>(pageCount * 4 * sizeof(int32_t));
+    int32_t* pageColumn = reinterpret_cast<int32_t*>(buffer->data());
+    float* widthColumn = reinterpret_cast<float*>(pageColumn + pageCount);
+    float* heightColumn = widthColumn + pageCount;
+    int32_t* rotationColumn = reinterpret_cast<int32_t*>(heightColumn + pageCount);
+    for (size_t i = 0; i < pageCount; ++i) {
+        pageColumn[i] = pages[i];
+        widthColumn[i] = static_cast<float>(sizes[i].width);
+        heightColumn[i] = static_cast<float>(sizes[i].height);
+        rotationColumn[i] = sizes[i].rotation;
+    }
+
+    jsi::Value arrayBuffer = jsi::ArrayBuffer(runtime, buffer);
+    size_t column = pageCount * sizeof(int32_t);
+    jsi::Object result(runtime);
+    result.setProperty(runtime, "count", static_cast<double>(pageCount));
+    result.setProperty(runtime, "pages", typedArray(runtime, "Int32Array", arrayBuffer, 0, pageCount));
+    result.setProperty(runtime, "widths", typedArray(runtime, "Float32Array", arrayBuffer, column, pageCount));
+    result.setProperty(runtime, "heights", typedArray(runtime, "Float32Array", arrayBuffer, column * 2, pageCount));
+    result.setProperty(runtime, "rotations", typedArray(runtime, "Int32Array", arrayBuffer, column * 3, pageCount));
+    return result;
+}
+
+// preloadPages(pdfId, startPage, endPage, currentPage?) -> boolean
+jsi::Value preloadPages(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count) {
+    std::string pdfId = stringArgument(runtime, args, count, 0, "pdfId");
+    int startPage = static_cast<int>(numberArgument(runtime, args, count, 1, "startPage"));
+    int endPage = static_cast<int>(numberArgument(runtime, args, count, 2, "endPage"));
+    int currentPage = static_cast<int>(optionalNumberArgument(args, count, 3, startPage));
+    return PDFJSI::getInstance().preloader().schedule(pdfId, startPage, endPage, currentPage);
+}
+
+// getCacheMetrics(pdfId?) -> numeric counters for the page cache
+jsi::Value getCacheMetrics(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count) {
+    std::string pdfId = count > 0 && args[0].isString() ? args[0].getString(runtime).utf8(runtime) : std::string();
+
+    PDFPageCache& cache = PDFJSI::getInstance().pageCache();
+    PageCacheStats total = cache.stats();
+    PageCacheStats document = pdfId.empty() ? total : cache.documentStats(pdfId);
+
+    jsi::Object result(runtime);
+    result.setProperty(runtime, "pageCacheSize", static_cast<double>(document.entries));
+    result.setProperty(runtime, "documentCacheBytes", static_cast<double>(document.bytes));
+    result.setProperty(runtime, "totalCacheBytes", static_cast<double>(total.bytes));
+    result.setProperty(runtime, "budgetBytes", static_cast<double>(total.budgetBytes));
+    result.setProperty(runtime, "totalEntries", static_cast<double>(total.entries));
+    result.setProperty(runtime, "hits", static_cast<double>(document.hits));
+    result.setProperty(runtime, "misses", static_cast<double>(document.misses));
+    result.setProperty(runtime, "hitRatio", document.hitRatio());
+    result.setProperty(runtime, "totalHitRatio", total.hitRatio());
+    result.setProperty(runtime, "evictions", static_cast<double>(total.evictions));
+    return result;
+}
+
+// searchText(pdfId, term, startPage?, endPage?) -> Promise<[{ page, offset, length, left, top, right, bottom }]>
+jsi::Value searchText(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count) {
+    std::string pdfId = stringArgument(runtime, args, count, 0, "pdfId");
+    std::string termUtf8 = stringArgument(runtime, args, count, 1, "term");
+    int startPage = static_cast<int>(optionalNumberArgument(args, count, 2, 1));
+    int endPage = static_cast<int>(optionalNumberArgument(args, count, 3, 0));
+
+    // JS strings arrive as UTF-8 through jsi; the index works on UTF-16
+    std::u16string term;
+    for (size_t i = 0; i < termUtf8.size();) {
+        unsigned char c = static_cast<unsigned char>(termUtf8[i]);
+        uint32_t codePoint = c;
+        size_t extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+        if (extra > 0) {
+            codePoint = c & (0x3F >> extra);
+        }
+        for (size_t k = 1; k <= extra && i + k < termUtf8.size(); ++k) {
+            codePoint = (codePoint << 6) | (static_cast<unsigned char>(termUtf8[i + k]) & 0x3F);
+        }
+        i += extra + 1;
+        if (codePoint >= 0x10000) {
+            codePoint -= 0x10000;
+            term.push_back(static_cast<char16_t>(0xD800 + (codePoint >> 10)));
+            term.push_back(static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF)));
+        } else {
+            term.push_back(static_cast<char16_t>(codePoint));
+        }
+    }
+
+    struct Output {
+        bool success = false;
+        std::string error;
+        std::vector<TextSearchHit> hits;
+    };
+    auto output = std::make_shared<Output>();
+    return runAsync(runtime, [output, pdfId, term, startPage, endPage] {
+        PDFJSI& pdfJSI = PDFJSI::getInstance();
+        std::shared_ptr<PDFDocument> document = pdfJSI.renderEngine().resolveDocument(pdfId, std::string(), output->error);
+        output->success = document &&
+            pdfJSI.textIndex().search(document, term, startPage, endPage, output->hits, output->error);
+    }, [output](jsi::Runtime& runtime, Deferred& deferred) {
+        if (!output->success) {
+            throw jsi::JSError(runtime, "searchText failed: " + output->error);
+        }
+        const std::vector<TextSearchHit>& hits = output->hits;
+        jsi::Array results(runtime, hits.size());
+        for (size_t i = 0; i < hits.size(); ++i) {
+            const TextSearchHit& hit = hits[i];
+            jsi::Object entry(runtime);
+            entry.setProperty(runtime, "page", hit.pageNumber);
+            entry.setProperty(runtime, "offset", hit.offset);
+            entry.setProperty(runtime, "length", hit.length);
+            entry.setProperty(runtime, "left", hit.left);
+            entry.setProperty(runtime, "top", hit.top);
+            entry.setProperty(runtime, "right", hit.right);
+            entry.setProperty(runtime, "bottom", hit.bottom);
+            results.setValueAtIndex(runtime, i, std::move(entry));
+        }
+        deferred.resolve.call(runtime, results);
+    });
+}
+
+} // namespace
+
+void PDFJSIHostObject::install(jsi::Runtime& runtime) {
+    auto hostObject = std::make_shared<PDFJSIHostObject>();
+    runtime.global().setProperty(runtime, PDFJSI_GLOBAL_NAME,
+        jsi::Object::createFromHostObject(runtime, hostObject));
+    LOGI("JSI bindings installed as global.%s", PDFJSI_GLOBAL_NAME);
+}
+
+jsi::Value PDFJSIHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& name) {
+    std::string property = name.utf8(runtime);
+    jsi::HostFunctionType function;
+    unsigned paramCount = 0;
+    if (property == "renderPage") {
+        function = renderPage;
+        paramCount = 4;
+    } else if (property == "renderPages") {
+        function = renderPages;
+        paramCount = 5;
+    } else if (property == "getPageSize") {
+        function = getPageSize;
+        paramCount = 2;
+    } else if (property == "getPageSizes") {
+        function = getPageSizes;
+        paramCount = 3;
+    } else if (property == "preloadPages") {
+        function = preloadPages;
+        paramCount = 4;
+    } else if (property == "getCacheMetrics") {
+        function = getCacheMetrics;
+        paramCount = 1;
+    } else if (property == "searchText") {
+        function = searchText;
+        paramCount = 4;
+    } else if (property == "setInteracting") {
+        function = setInteracting;
+        paramCount = 2;
+    } else {
+        return jsi::Value::undefined();
+    }
+    return jsi::Function::createFromHostFunction(runtime, name, paramCount, function);
+}
+
+std::vector<jsi::PropNameID> PDFJSIHostObject::getPropertyNames(jsi::Runtime& runtime) {
+    std::vector<jsi::PropNameID> names;
+    for (const char* property : kPropertyNames) {
+        names.push_back(jsi::PropNameID::forAscii(runtime, property));
+    }
+    return names;
+}
+
+extern "C" {
+    // Called on the JS thread with JavaScriptContextHolder.get()
+    JNIEXPORT jboolean JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeInstallJSIBindings(JNIEnv *env, jobject thiz, jlong jsContextPointer) {
+        if (jsContextPointer == 0) {
+            LOGW("No JS runtime available, JSI bindings not installed");
+            return JNI_FALSE;
+        }
+        JSIWorker::instance().attach(env, thiz);
+        PDFJSIHostObject::install(*reinterpret_cast<jsi::Runtime*>(jsContextPointer));
+        return JNI_TRUE;
+    }
+
+    // Posted by PDFJSIManager.scheduleJSICallbacks; settles finished calls' Promises
+    JNIEXPORT void JNICALL
+    Java_org_wonday_pdf_PDFJSIManager_nativeDrainJSICallbacks(JNIEnv *env, jobject thiz, jlong jsContextPointer) {
+        if (jsContextPointer != 0) {
+            JSIWorker::instance().drain(*reinterpret_cast<jsi::Runtime*>(jsContextPointer));
+        }
+    }
+}
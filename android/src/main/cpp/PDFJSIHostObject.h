@@ -0,0 +1,29 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * JSI host object installed as global.__pdfJSI
+ * Resolves rendered pages as Promises of ArrayBuffer copies and returns
+ * metrics as plain numbers, without going through the bridge or WritableMap.
+ */
+
+#ifndef PDFJSI_HOST_OBJECT_H
+#define PDFJSI_HOST_OBJECT_H
+
+#include <jsi/jsi.h>
+#include <vector>
+
+// Name of the global property the bindings are installed under
+#define PDFJSI_GLOBAL_NAME "__pdfJSI"
+
+class PDFJSIHostObject : public facebook::jsi::HostObject {
+public:
+    // Must be called on the JS thread that owns the runtime
+    static void install(facebook::jsi::Runtime& runtime);
+
+    facebook::jsi::Value get(facebook::jsi::Runtime& runtime, const facebook::jsi::PropNameID& name) override;
+    std::vector<facebook::jsi::PropNameID> getPropertyNames(facebook::jsi::Runtime& runtime) override;
+};
+
+#endif // PDFJSI_HOST_OBJECT_H
@@ -0,0 +1,47 @@
+# Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+# Enhanced PDF JSI CMakeLists with high-performance operations
+# All rights reserved.
+#
+# Engine sources and optimization flags shared by the pdfjsi library and the
+# native benchmark (benchmark/CMakeLists.txt). The engine sources do not use
+# JNI or jsi, so the benchmark links exactly the code the app ships.
+
+set(PDFJSI_CORE_SOURCES
+    ${CMAKE_CURRENT_LIST_DIR}/PdfiumApi.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/PDFRenderEngine.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/PDFDocumentRegistry.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/PDFPageCache.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/PDFPreloader.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/PDFTextIndex.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/PDFHitIndex.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/Base64Decoder.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/PDFBitmapPool.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/PDFTrace.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/PDFProgressiveDocument.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/PDFPageStore.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/PDFMemoryGovernor.cpp
+)
+
+# Optimization flags - Enhanced for maximum performance. Pass
+# -DPDFJSI_OPTIMIZATION_FLAGS="..." (a ;-list) to benchmark other flag sets
+if(NOT DEFINED PDFJSI_OPTIMIZATION_FLAGS)
+    set(PDFJSI_OPTIMIZATION_FLAGS
+        -O3                      # Maximum optimization
+        -ffast-math             # Fast floating-point operations
+        -funroll-loops          # Loop unrolling
+        -fomit-frame-pointer    # Remove frame pointer
+        -fvisibility=hidden     # Hide symbols by default
+        -flto                   # Link-time optimization
+        -finline-functions      # Aggressive inlining
+    )
+    # Architecture-specific optimizations (conditional to prevent ARMv7 build errors)
+    if(ANDROID_ABI STREQUAL "arm64-v8a")
+        list(APPEND PDFJSI_OPTIMIZATION_FLAGS -march=armv8-a+simd)   # ARM SIMD instructions (ARMv8 only)
+    endif()
+endif()
+
+# Native trace sections and latency histograms (PDFTrace.h); pass
+# -DPDFJSI_TRACING=0 to compile every trace scope out
+if(NOT DEFINED PDFJSI_TRACING)
+    set(PDFJSI_TRACING 1)
+endif()
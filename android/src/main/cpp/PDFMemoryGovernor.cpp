@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * One memory budget shared by every native cache
+ */
+
+#include "PDFMemoryGovernor.h"
+#include "PDFBitmapPool.h"
+#include "PDFDocumentRegistry.h"
+#include "PDFHitIndex.h"
+#include "PDFJSILog.h"
+#include "PDFPageCache.h"
+#include "PDFPreloader.h"
+#include "PDFRenderEngine.h"
+#include "PDFTextIndex.h"
+
+namespace {
+
+// android.content.ComponentCallbacks2 trim levels
+const int kTrimMemoryRunningModerate = 5;
+const int kTrimMemoryRunningLow = 10;
+const int kTrimMemoryRunningCritical = 15;
+const int kTrimMemoryUiHidden = 20;
+const int kTrimMemoryBackground = 40;
+const int kTrimMemoryModerate = 60;
+
+// Shares of the budget, in twentieths
+const size_t kPageCacheShare = 12;
+const size_t kBitmapPoolShare = 4;
+const size_t kTextIndexShare = 2;
+const size_t kHitIndexShare = 1;
+const size_t kMappedShare = 1;
+
+} // namespace
+
+void PDFMemoryGovernor::setBudget(size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budgetBytes = budgetBytes;
+    m_mappedBudget = budgetBytes / 20 * kMappedShare;
+    m_cache.setBudget(budgetBytes / 20 * kPageCacheShare);
+    m_pool.setBudget(budgetBytes / 20 * kBitmapPoolShare);
+    m_textIndex.setBudget(budgetBytes / 20 * kTextIndexShare);
+    m_hitIndex.setBudget(budgetBytes / 20 * kHitIndexShare);
+    LOGI("Memory budget set to %zu KB", budgetBytes / 1024);
+}
+
+void PDFMemoryGovernor::setPageCacheBudget(size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache.setBudget(budgetBytes);
+    m_budgetBytes = budgetBytes + m_pool.budget() + m_textIndex.budget() + m_hitIndex.budget() + m_mappedBudget;
+    LOGI("Page cache budget set to %zu KB, memory budget now %zu KB", budgetBytes / 1024, m_budgetBytes / 1024);
+}
+
+size_t PDFMemoryGovernor::budget() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budgetBytes;
+}
+
+int PDFMemoryGovernor::pressureForTrimLevel(int level) {
+    if (level >= kTrimMemoryModerate) {
+        return kMemoryPressureComplete;
+    }
+    if (level >= kTrimMemoryBackground) {
+        return kMemoryPressureCritical;
+    }
+    if (level >= kTrimMemoryUiHidden) {
+        // Nothing is visible, but the user may come straight back
+        return kMemoryPressureLow;
+    }
+    if (level >= kTrimMemoryRunningCritical) {
+        return kMemoryPressureCritical;
+    }
+    if (level >= kTrimMemoryRunningLow) {
+        return kMemoryPressureLow;
+    }
+    if (level >= kTrimMemoryRunningModerate) {
+        return kMemoryPressureModerate;
+    }
+    return kMemoryPressureNone;
+}
+
+size_t PDFMemoryGovernor::shed(int pressure) {
+    if (pressure <= kMemoryPressureNone) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t cacheBudget = m_cache.budget();
+    size_t textBudget = m_textIndex.budget();
+    size_t boxBudget = m_hitIndex.budget();
+    size_t pooled;
+    size_t cached;
+    size_t text;
+    size_t boxes;
+    size_t mapped = 0;
+
+    // Tier downgrade first: new renders at a lower tier cost a half (normal's
+    // 8 MP budget) or an eighth (draft) of the high-quality bytes, and cached
+    // high-quality copies are the largest entries; the pages they held are
+    // redrawn at the capped tier, so nothing visible goes blank
+    m_engine.capQuality(pressure >= kMemoryPressureCritical ? PDFJSI_QUALITY_DRAFT : PDFJSI_QUALITY_NORMAL,
+                        kQualityCapMs);
+    size_t downgraded = m_cache.trimQualityAbove(PDFJSI_QUALITY_NORMAL);
+
+    if (pressure >= kMemoryPressureComplete) {
+        m_preloader.cancelAll();
+        pooled = m_pool.clear();
+        cached = m_cache.clear();
+        text = m_textIndex.trimTo(0);
+        boxes = m_hitIndex.clear();
+        mapped = m_documents.releaseMappedPages();
+    } else if (pressure == kMemoryPressureCritical) {
+        // Preloads would refill what is released here straight away
+        m_preloader.cancelAll();
+        pooled = m_pool.clear();
+        cached = m_cache.trimFarthestTo(cacheBudget / 8);
+        text = m_textIndex.trimTo(0);
+        // The most recently tapped and shown pages keep their boxes
+        boxes = m_hitIndex.trimTo(boxBudget / 8);
+        mapped = m_documents.releaseMappedPages();
+    } else if (pressure == kMemoryPressureLow) {
+        pooled = m_pool.clear();
+        cached = m_cache.trimFarthestTo(cacheBudget / 2);
+        text = m_textIndex.trimTo(textBudget / 4);
+        boxes = m_hitIndex.trimTo(boxBudget / 4);
+        if (m_documents.mappedResidentBytes() > m_mappedBudget / 2) {
+            mapped = m_documents.releaseMappedPages();
+        }
+    } else {
+        pooled = m_pool.trimTo(m_pool.budget() / 2);
+        cached = m_cache.trimFarthestTo(cacheBudget / 4 * 3);
+        text = m_textIndex.trimTo(textBudget / 2);
+        boxes = m_hitIndex.trimTo(boxBudget / 2);
+        if (m_documents.mappedResidentBytes() > m_mappedBudget) {
+            mapped = m_documents.releaseMappedPages();
+        }
+    }
+
+    size_t released = downgraded + pooled + cached + text + boxes + mapped;
+    m_lastPressure = pressure;
+    m_sheds++;
+    m_releasedBytes += released;
+    LOGI("Memory pressure %d released %zu KB of high-quality pages, %zu KB of pooled bitmaps, "
+         "%zu KB of cached pages, %zu KB of text indexes, %zu KB of hit boxes and %zu KB of mapped documents",
+         pressure, downgraded / 1024, pooled / 1024, cached / 1024, text / 1024, boxes / 1024, mapped / 1024);
+    return released;
+}
+
+MemoryGovernorStats PDFMemoryGovernor::stats() {
+    MemoryGovernorStats stats;
+    PageCacheStats cache = m_cache.stats();
+    BitmapPoolStats pool = m_pool.stats();
+    stats.pageCacheBudget = cache.budgetBytes;
+    stats.pageCacheBytes = cache.bytes;
+    stats.bitmapPoolBudget = pool.budgetBytes;
+    stats.bitmapPoolBytes = pool.freeBytes;
+    stats.textIndexBudget = m_textIndex.budget();
+    stats.textIndexBytes = m_textIndex.memoryBytes();
+    stats.hitIndexBudget = m_hitIndex.budget();
+    stats.hitIndexBytes = m_hitIndex.memoryBytes();
+    stats.mappedResidentBytes = m_documents.mappedResidentBytes();
+    stats.qualityCap = m_engine.qualityCap();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    stats.budgetBytes = m_budgetBytes;
+    stats.mappedBudget = m_mappedBudget;
+    stats.lastPressure = m_lastPressure;
+    stats.sheds = m_sheds;
+    stats.releasedBytes = m_releasedBytes;
+    return stats;
+}
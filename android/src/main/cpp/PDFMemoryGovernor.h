@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * One memory budget shared by every native cache
+ * The budget is split across the page cache, the bitmap pool, the text index,
+ * the hit index and the resident pages of mapped documents. Memory pressure is shed in
+ * steps: each level first lowers the render tier (new pages at normal, or draft
+ * when critical, and high-quality cached copies dropped), then drops what is
+ * cheapest to get back (pooled blocks, pages far from the visible one, search
+ * text, hit boxes, mapped pages); only the last clears the page cache, so a
+ * warning never blanks the visible page.
+ */
+
+#ifndef PDF_MEMORY_GOVERNOR_H
+#define PDF_MEMORY_GOVERNOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+class PDFBitmapPool;
+class PDFDocumentRegistry;
+class PDFHitIndex;
+class PDFPageCache;
+class PDFPreloader;
+class PDFRenderEngine;
+class PDFTextIndex;
+
+enum PDFMemoryPressure {
+    kMemoryPressureNone = 0,
+    // Trim the caches back while everything visible stays
+    kMemoryPressureModerate = 1,
+    kMemoryPressureLow = 2,
+    // Keep only the pages around the one in view
+    kMemoryPressureCritical = 3,
+    // The UI is gone and the process is next to be killed: keep nothing
+    kMemoryPressureComplete = 4
+};
+
+struct MemoryGovernorStats {
+    size_t budgetBytes = 0;
+    size_t pageCacheBudget = 0;
+    size_t bitmapPoolBudget = 0;
+    size_t textIndexBudget = 0;
+    size_t hitIndexBudget = 0;
+    size_t mappedBudget = 0;
+    size_t pageCacheBytes = 0;
+    size_t bitmapPoolBytes = 0;
+    size_t textIndexBytes = 0;
+    size_t hitIndexBytes = 0;
+    size_t mappedResidentBytes = 0;
+    int lastPressure = kMemoryPressureNone;
+    // Highest render quality allowed right now (PDFJSI_QUALITY_*)
+    int qualityCap = 0;
+    uint64_t sheds = 0;
+    size_t releasedBytes = 0;
+};
+
+class PDFMemoryGovernor {
+public:
+    // Splits to the caches' own defaults: 48 MB pages, 16 MB pool, 8 MB text,
+    // 4 MB hit boxes, 4 MB mapped
+    static constexpr size_t kDefaultBudgetBytes = 80 * 1024 * 1024;
+
+    // How long a pressure step keeps renders at the lowered tier
+    static constexpr int kQualityCapMs = 30000;
+
+    PDFMemoryGovernor(PDFPageCache& cache, PDFBitmapPool& pool, PDFTextIndex& textIndex, PDFHitIndex& hitIndex,
+                      PDFDocumentRegistry& documents, PDFPreloader& preloader, PDFRenderEngine& engine)
+        : m_cache(cache), m_pool(pool), m_textIndex(textIndex), m_hitIndex(hitIndex), m_documents(documents),
+          m_preloader(preloader), m_engine(engine) {}
+
+    // Splits budgetBytes across the caches and trims any that are over their share
+    void setBudget(size_t budgetBytes);
+    size_t budget();
+
+    // Overrides the page cache's share; the total budget becomes that plus the
+    // other caches' shares, until the next setBudget splits it afresh
+    void setPageCacheBudget(size_t budgetBytes);
+
+    // Pressure step for an android.content.ComponentCallbacks2 trim level
+    static int pressureForTrimLevel(int level);
+
+    // Releases memory for pressure (a PDFMemoryPressure); returns the bytes released
+    size_t shed(int pressure);
+
+    MemoryGovernorStats stats();
+
+private:
+    PDFMemoryGovernor(const PDFMemoryGovernor&) = delete;
+    PDFMemoryGovernor& operator=(const PDFMemoryGovernor&) = delete;
+
+    PDFPageCache& m_cache;
+    PDFBitmapPool& m_pool;
+    PDFTextIndex& m_textIndex;
+    PDFHitIndex& m_hitIndex;
+    PDFDocumentRegistry& m_documents;
+    PDFPreloader& m_preloader;
+    PDFRenderEngine& m_engine;
+
+    size_t m_budgetBytes = kDefaultBudgetBytes;
+    size_t m_mappedBudget = kDefaultBudgetBytes / 20;
+    int m_lastPressure = kMemoryPressureNone;
+    uint64_t m_sheds = 0;
+    size_t m_releasedBytes = 0;
+    std::mutex m_mutex;
+};
+
+#endif // PDF_MEMORY_GOVERNOR_H
@@ -0,0 +1,226 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Byte-budgeted LRU cache of rendered page bitmaps
+ */
+
+#include "PDFPageCache.h"
+#include "PDFRenderEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const float kScaleStepsPerUnit = 4.0f;
+
+} // namespace
+
+PDFPageCache::PDFPageCache(size_t budgetBytes) : m_budgetBytes(budgetBytes) {}
+
+int PDFPageCache::scaleBucket(float scale) {
+    return std::max(1, static_cast<int>(std::lround(scale * kScaleStepsPerUnit)));
+}
+
+float PDFPageCache::bucketScale(int bucket) {
+    return static_cast<float>(bucket) / kScaleStepsPerUnit;
+}
+
+std::shared_ptr<const PageBitmap> PDFPageCache::get(const PageCacheKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto counters = m_documentCounters.find(key.pdfId);
+    bool counted = counters != m_documentCounters.end();
+
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        m_misses++;
+        if (counted) {
+            counters->second.misses++;
+        }
+        return nullptr;
+    }
+
+    m_hits++;
+    if (counted) {
+        counters->second.hits++;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return it->second->bitmap;
+}
+
+std::shared_ptr<const PageBitmap> PDFPageCache::peek(const PageCacheKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    return it != m_index.end() ? it->second->bitmap : nullptr;
+}
+
+bool PDFPageCache::contains(const PageCacheKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_index.count(key) > 0;
+}
+
+void PDFPageCache::put(const PageCacheKey& key, std::shared_ptr<const PageBitmap> bitmap) {
+    if (!bitmap) {
+        return;
+    }
+    size_t bytes = bitmap->byteSize();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto existing = m_index.find(key);
+    if (existing != m_index.end()) {
+        eraseLocked(existing->second);
+    }
+
+    // A single page larger than the whole budget is not worth caching
+    if (bytes > m_budgetBytes) {
+        return;
+    }
+
+    evictLocked(m_budgetBytes - bytes);
+    m_lru.push_front(Entry{key, std::move(bitmap), bytes});
+    m_index[key] = m_lru.begin();
+    m_bytes += bytes;
+    m_documentCounters[key.pdfId];
+}
+
+void PDFPageCache::registerDocument(const std::string& pdfId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_documentCounters[pdfId];
+}
+
+void PDFPageCache::setBudget(size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budgetBytes = budgetBytes;
+    evictLocked(m_budgetBytes);
+}
+
+size_t PDFPageCache::budget() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budgetBytes;
+}
+
+size_t PDFPageCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t released = m_bytes;
+    m_lru.clear();
+    m_index.clear();
+    m_bytes = 0;
+    return released;
+}
+
+size_t PDFPageCache::clearDocument(const std::string& pdfId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t before = m_bytes;
+    for (auto it = m_lru.begin(); it != m_lru.end();) {
+        auto next = std::next(it);
+        if (it->key.pdfId == pdfId) {
+            eraseLocked(it);
+        }
+        it = next;
+    }
+    m_documentCounters.erase(pdfId);
+    return before - m_bytes;
+}
+
+size_t PDFPageCache::trimQualityAbove(int quality) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t before = m_bytes;
+    for (auto it = m_lru.begin(); it != m_lru.end();) {
+        auto next = std::next(it);
+        if (it->key.quality > quality) {
+            eraseLocked(it);
+            m_evictions++;
+        }
+        it = next;
+    }
+    return before - m_bytes;
+}
+
+size_t PDFPageCache::trimTo(size_t targetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t before = m_bytes;
+    evictLocked(targetBytes);
+    return before - m_bytes;
+}
+
+size_t PDFPageCache::trimFarthestTo(size_t targetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t before = m_bytes;
+    if (m_bytes <= targetBytes) {
+        return 0;
+    }
+
+    // The first entry met for a document is its most recently used page
+    std::unordered_map<std::string, int> focus;
+    for (const Entry& entry : m_lru) {
+        focus.emplace(entry.key.pdfId, entry.key.pageNumber);
+    }
+
+    // Least recently used first, so equally distant pages go in LRU order
+    std::vector<std::pair<int, EntryIterator>> victims;
+    victims.reserve(m_index.size());
+    for (auto it = m_lru.end(); it != m_lru.begin();) {
+        --it;
+        victims.emplace_back(std::abs(it->key.pageNumber - focus[it->key.pdfId]), it);
+    }
+    std::stable_sort(victims.begin(), victims.end(),
+                     [](const std::pair<int, EntryIterator>& a, const std::pair<int, EntryIterator>& b) {
+                         return a.first > b.first;
+                     });
+
+    for (const auto& victim : victims) {
+        if (m_bytes <= targetBytes) {
+            break;
+        }
+        eraseLocked(victim.second);
+        m_evictions++;
+    }
+    return before - m_bytes;
+}
+
+PageCacheStats PDFPageCache::stats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PageCacheStats stats;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.evictions = m_evictions;
+    stats.entries = m_index.size();
+    stats.bytes = m_bytes;
+    stats.budgetBytes = m_budgetBytes;
+    return stats;
+}
+
+PageCacheStats PDFPageCache::documentStats(const std::string& pdfId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PageCacheStats stats;
+    auto counters = m_documentCounters.find(pdfId);
+    if (counters != m_documentCounters.end()) {
+        stats.hits = counters->second.hits;
+        stats.misses = counters->second.misses;
+    }
+    for (const Entry& entry : m_lru) {
+        if (entry.key.pdfId == pdfId) {
+            stats.entries++;
+            stats.bytes += entry.bytes;
+        }
+    }
+    stats.evictions = m_evictions;
+    stats.budgetBytes = m_budgetBytes;
+    return stats;
+}
+
+void PDFPageCache::evictLocked(size_t targetBytes) {
+    while (m_bytes > targetBytes && !m_lru.empty()) {
+        eraseLocked(std::prev(m_lru.end()));
+        m_evictions++;
+    }
+}
+
+void PDFPageCache::eraseLocked(EntryIterator it) {
+    m_bytes -= it->bytes;
+    m_index.erase(it->key);
+    m_lru.erase(it);
+}
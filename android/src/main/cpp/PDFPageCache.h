@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Byte-budgeted LRU cache of rendered page bitmaps
+ */
+
+#ifndef PDF_PAGE_CACHE_H
+#define PDF_PAGE_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct PageBitmap;
+
+struct PageCacheKey {
+    std::string pdfId;
+    int pageNumber = 0;
+    int scaleBucket = 0;
+    int quality = 0;
+
+    bool operator==(const PageCacheKey& other) const {
+        return pageNumber == other.pageNumber && scaleBucket == other.scaleBucket &&
+               quality == other.quality && pdfId == other.pdfId;
+    }
+};
+
+struct PageCacheKeyHash {
+    size_t operator()(const PageCacheKey& key) const {
+        size_t hash = std::hash<std::string>()(key.pdfId);
+        hash ^= static_cast<size_t>(key.pageNumber) * 0x9E3779B1u + (hash << 6) + (hash >> 2);
+        hash ^= static_cast<size_t>(key.scaleBucket) * 0x85EBCA77u + (hash << 6) + (hash >> 2);
+        hash ^= static_cast<size_t>(key.quality) * 0xC2B2AE3Du + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+struct PageCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t budgetBytes = 0;
+
+    double hitRatio() const {
+        uint64_t total = hits + misses;
+        return total > 0 ? static_cast<double>(hits) / total : 0.0;
+    }
+};
+
+class PDFPageCache {
+public:
+    static constexpr size_t kDefaultBudgetBytes = 48 * 1024 * 1024;
+
+    explicit PDFPageCache(size_t budgetBytes = kDefaultBudgetBytes);
+
+    // Scales are cached in quarter steps; renders use bucketScale() so
+    // every entry in a bucket has the same pixel size
+    static int scaleBucket(float scale);
+    static float bucketScale(int bucket);
+
+    // Counted lookup (updates hit/miss statistics and recency)
+    std::shared_ptr<const PageBitmap> get(const PageCacheKey& key);
+    // Uncounted lookup for speculative work (preloading); leaves statistics
+    // and recency alone so the hit ratio reflects foreground renders only
+    std::shared_ptr<const PageBitmap> peek(const PageCacheKey& key);
+    // Uncounted presence check, e.g. for preloading
+    bool contains(const PageCacheKey& key);
+    void put(const PageCacheKey& key, std::shared_ptr<const PageBitmap> bitmap);
+    // Starts per-document statistics for an opened document; lookups for ids
+    // that were never registered or inserted leave no statistics behind
+    void registerDocument(const std::string& pdfId);
+
+    void setBudget(size_t budgetBytes);
+    size_t budget();
+
+    // Each returns the number of bytes released
+    size_t clear();
+    size_t clearDocument(const std::string& pdfId);
+    size_t trimTo(size_t targetBytes);
+    // Like trimTo, but evicts the pages farthest from each document's most
+    // recently used page first, so the visible page and its neighbours survive
+    size_t trimFarthestTo(size_t targetBytes);
+    // Evicts pages rendered above quality, which are redrawn at the capped tier
+    size_t trimQualityAbove(int quality);
+
+    PageCacheStats stats();
+    // Entries/bytes and hit/miss counters for one document
+    PageCacheStats documentStats(const std::string& pdfId);
+
+private:
+    PDFPageCache(const PDFPageCache&) = delete;
+    PDFPageCache& operator=(const PDFPageCache&) = delete;
+
+    struct Entry {
+        PageCacheKey key;
+        std::shared_ptr<const PageBitmap> bitmap;
+        size_t bytes = 0;
+    };
+    typedef std::list<Entry>::iterator EntryIterator;
+
+    struct DocumentCounters {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    void evictLocked(size_t targetBytes);
+    void eraseLocked(EntryIterator it);
+
+    // Front is most recently used
+    std::list<Entry> m_lru;
+    std::unordered_map<PageCacheKey, EntryIterator, PageCacheKeyHash> m_index;
+    std::map<std::string, DocumentCounters> m_documentCounters;
+    size_t m_budgetBytes;
+    size_t m_bytes = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    std::mutex m_mutex;
+};
+
+#endif // PDF_PAGE_CACHE_H
@@ -0,0 +1,570 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Persistent on-disk store of rendered pages
+ */
+
+#include "PDFPageStore.h"
+#include "PDFJSILog.h"
+#include "PDFRenderEngine.h"
+#include "PDFTrace.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const uint32_t kStoreMagic = 0x53504A50;   // "PJPS"
+const uint32_t kStoreVersion = 1;
+const char* const kPageSuffix = ".page";
+const char* const kTempSuffix = ".tmp";
+// Runs shorter than this are cheaper to keep inside a literal
+const size_t kMinRun = 3;
+// Keys longer than this (or with other characters) are hashed into the file name
+const size_t kMaxPlainKeyLength = 64;
+
+struct StoredHeader {
+    uint32_t magic;
+    uint32_t version;
+    int32_t format;
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+    float scale;
+    uint32_t reserved;
+    uint64_t pixelBytes;
+    uint64_t payloadBytes;
+};
+
+int64_t wallClockNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+int64_t modifiedNs(const struct stat& info) {
+    return static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+}
+
+bool endsWith(const std::string& value, const char* suffix) {
+    size_t length = std::strlen(suffix);
+    return value.size() >= length && value.compare(value.size() - length, length, suffix) == 0;
+}
+
+int bytesPerPixel(int format) {
+    return format == PDFJSI_PIXEL_RGB_565 ? 2 : 4;
+}
+
+// Page files name every key part, so '_' never appears inside the document part
+std::string documentPrefix(const std::string& documentKey) {
+    bool plain = !documentKey.empty() && documentKey.size() <= kMaxPlainKeyLength;
+    for (size_t i = 0; plain && i < documentKey.size(); ++i) {
+        char c = documentKey[i];
+        plain = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-';
+    }
+    if (plain) {
+        return documentKey + "_";
+    }
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : documentKey) {
+        hash = (hash ^ c) * 1099511628211ULL;
+    }
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "h%016llx_", static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool getVarint(const uint8_t*& data, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && data < end; shift += 7) {
+        uint8_t byte = *data++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Tokens are varint(count << 1 | isRun) followed by one unit for a run or
+// count units for a literal
+template <typename Unit>
+void encodeUnits(const uint8_t* pixels, size_t count, std::vector<uint8_t>& out) {
+    auto unitAt = [pixels](size_t index) {
+        Unit unit;
+        std::memcpy(&unit, pixels + index * sizeof(Unit), sizeof(Unit));
+        return unit;
+    };
+    auto emitLiteral = [&](size_t start, size_t length) {
+        if (length == 0) {
+            return;
+        }
+        putVarint(out, static_cast<uint64_t>(length) << 1);
+        out.insert(out.end(), pixels + start * sizeof(Unit), pixels + (start + length) * sizeof(Unit));
+    };
+
+    size_t literalStart = 0;
+    size_t i = 0;
+    while (i < count) {
+        Unit unit = unitAt(i);
+        size_t run = 1;
+        while (i + run < count && unitAt(i + run) == unit) {
+            ++run;
+        }
+        if (run >= kMinRun) {
+            emitLiteral(literalStart, i - literalStart);
+            putVarint(out, (static_cast<uint64_t>(run) << 1) | 1);
+            out.insert(out.end(), pixels + i * sizeof(Unit), pixels + (i + 1) * sizeof(Unit));
+            i += run;
+            literalStart = i;
+        } else {
+            i += run;
+        }
+    }
+    emitLiteral(literalStart, count - literalStart);
+}
+
+void fillUnits(uint8_t* target, const uint8_t* unit, size_t unitBytes, size_t count) {
+    bool uniform = true;
+    for (size_t b = 1; b < unitBytes; ++b) {
+        uniform = uniform && unit[b] == unit[0];
+    }
+    if (uniform) {
+        // White paper and black text are byte-uniform in both formats
+        std::memset(target, unit[0], count * unitBytes);
+        return;
+    }
+    std::memcpy(target, unit, unitBytes);
+    // Doubling copies fill the rest in O(log count) memcpy calls
+    size_t filled = unitBytes;
+    size_t total = count * unitBytes;
+    while (filled < total) {
+        size_t chunk = std::min(filled, total - filled);
+        std::memcpy(target + filled, target, chunk);
+        filled += chunk;
+    }
+}
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t written = write(fd, bytes, size);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+PDFPageStore::~PDFPageStore() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_pending.clear();
+    }
+    m_wake.notify_all();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+}
+
+bool PDFPageStore::configure(const std::string& directory, size_t budgetBytes, std::string& error) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.clear();
+    m_files.clear();
+    m_bytes = 0;
+    m_budgetBytes = budgetBytes > 0 ? budgetBytes : kDefaultBudgetBytes;
+    m_directory.clear();
+    m_idle.notify_all();
+    if (directory.empty()) {
+        return true;
+    }
+
+    if (mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST) {
+        error = "Cannot create page store directory " + directory;
+        return false;
+    }
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        error = "Cannot read page store directory " + directory;
+        return false;
+    }
+    while (struct dirent* item = readdir(dir)) {
+        std::string name = item->d_name;
+        std::string path = directory + "/" + name;
+        if (endsWith(name, kTempSuffix)) {
+            // Left by a write the process did not finish
+            unlink(path.c_str());
+            continue;
+        }
+        struct stat info;
+        if (!endsWith(name, kPageSuffix) || stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+            continue;
+        }
+        FileEntry entry;
+        entry.bytes = static_cast<size_t>(info.st_size);
+        entry.lastUsed = modifiedNs(info);
+        m_files[name] = entry;
+        m_bytes += entry.bytes;
+    }
+    closedir(dir);
+    m_directory = directory;
+
+    if (m_bytes > m_budgetBytes) {
+        evictLocked(m_budgetBytes);
+    }
+    LOGI("PageStore: %zu pages (%zu KB) in %s, budget %zu KB",
+         m_files.size(), m_bytes / 1024, directory.c_str(), m_budgetBytes / 1024);
+    return true;
+}
+
+bool PDFPageStore::enabled() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_directory.empty();
+}
+
+std::string PDFPageStore::fileNameFor(const PageStoreKey& key) {
+    return documentPrefix(key.documentKey) + std::to_string(key.pageNumber) + "_" +
+           std::to_string(key.scaleBucket) + "_" + std::to_string(key.quality) + kPageSuffix;
+}
+
+std::shared_ptr<PageBitmap> PDFPageStore::load(const PageStoreKey& key, PDFBitmapPool& pool) {
+    std::string fileName = fileNameFor(key);
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_directory.empty()) {
+            return nullptr;
+        }
+        // The index mirrors the directory, so misses cost no system call
+        if (m_files.find(fileName) == m_files.end()) {
+            ++m_misses;
+            return nullptr;
+        }
+        path = m_directory + "/" + fileName;
+    }
+
+    PDFJSI_TRACE_SCOPE(kPageStoreRead);
+    std::shared_ptr<PageBitmap> bitmap;
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat info;
+    if (fd >= 0 && fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(StoredHeader)) {
+        size_t size = static_cast<size_t>(info.st_size);
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            // The codec reads the file front to back exactly once
+            madvise(mapping, size, MADV_SEQUENTIAL);
+            const uint8_t* bytes = static_cast<const uint8_t*>(mapping);
+            StoredHeader header;
+            std::memcpy(&header, bytes, sizeof(header));
+            bool valid = header.magic == kStoreMagic && header.version == kStoreVersion &&
+                         (header.format == PDFJSI_PIXEL_RGBA_8888 || header.format == PDFJSI_PIXEL_RGB_565) &&
+                         header.width > 0 && header.height > 0 &&
+                         header.stride == header.width * bytesPerPixel(header.format) &&
+                         header.pixelBytes == static_cast<uint64_t>(header.stride) * header.height &&
+                         header.payloadBytes == size - sizeof(header);
+            if (valid) {
+                auto candidate = std::make_shared<PageBitmap>();
+                candidate->pageNumber = key.pageNumber;
+                candidate->scale = header.scale;
+                candidate->quality = key.quality;
+                candidate->format = header.format;
+                candidate->width = header.width;
+                candidate->height = header.height;
+                candidate->stride = header.stride;
+                size_t pixelBytes = static_cast<size_t>(header.pixelBytes);
+                if (candidate->pixels.allocate(&pool, pixelBytes) &&
+                    decode(bytes + sizeof(header), static_cast<size_t>(header.payloadBytes),
+                           bytesPerPixel(header.format), candidate->pixels.data(), pixelBytes)) {
+                    bitmap = candidate;
+                }
+            }
+            munmap(mapping, size);
+        }
+    }
+    if (bitmap) {
+        // The modification time carries the use order across launches
+        futimens(fd, nullptr);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_files.find(fileName);
+    if (bitmap) {
+        ++m_hits;
+        if (it != m_files.end()) {
+            it->second.lastUsed = wallClockNs();
+        }
+    } else {
+        ++m_misses;
+        if (it != m_files.end() && path == m_directory + "/" + fileName) {
+            LOGW("PageStore: dropping unreadable %s", fileName.c_str());
+            removeLocked(fileName);
+        }
+    }
+    return bitmap;
+}
+
+void PDFPageStore::store(const PageStoreKey& key, std::shared_ptr<const PageBitmap> bitmap) {
+    if (!bitmap || bitmap->pixels.empty()) {
+        return;
+    }
+    std::string fileName = fileNameFor(key);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_directory.empty() || m_stopping || m_files.count(fileName) > 0) {
+            return;
+        }
+        for (const PendingWrite& pending : m_pending) {
+            if (pending.fileName == fileName) {
+                return;
+            }
+        }
+        if (m_pending.size() >= kMaxPendingWrites) {
+            // The page stays in the memory cache; it is written on a later render
+            ++m_droppedWrites;
+            return;
+        }
+        PendingWrite write;
+        write.fileName = fileName;
+        write.bitmap = std::move(bitmap);
+        m_pending.push_back(std::move(write));
+        if (!m_writer.joinable()) {
+            m_writer = std::thread(&PDFPageStore::writerLoop, this);
+        }
+    }
+    m_wake.notify_one();
+}
+
+void PDFPageStore::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return (m_pending.empty() && !m_writing) || m_stopping; });
+}
+
+void PDFPageStore::writerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this] { return m_stopping || !m_pending.empty(); });
+        if (m_stopping) {
+            break;
+        }
+        PendingWrite write = std::move(m_pending.front());
+        m_pending.pop_front();
+        std::string directory = m_directory;
+        m_writing = true;
+        lock.unlock();
+
+        size_t bytes = 0;
+        bool written = writeFile(directory, write, bytes);
+        write.bitmap.reset();
+
+        lock.lock();
+        m_writing = false;
+        if (written && directory == m_directory) {
+            FileEntry& entry = m_files[write.fileName];
+            m_bytes = m_bytes - entry.bytes + bytes;
+            entry.bytes = bytes;
+            entry.lastUsed = wallClockNs();
+            ++m_writes;
+            if (m_bytes > m_budgetBytes) {
+                // Evict a tenth below budget so each new page does not evict one page
+                evictLocked(m_budgetBytes - m_budgetBytes / 10);
+            }
+        } else if (written) {
+            // The store was reconfigured or disabled while this page was written
+            unlink((directory + "/" + write.fileName).c_str());
+        }
+        if (m_pending.empty()) {
+            m_idle.notify_all();
+        }
+    }
+    m_idle.notify_all();
+}
+
+bool PDFPageStore::writeFile(const std::string& directory, const PendingWrite& write, size_t& bytes) {
+    const PageBitmap& bitmap = *write.bitmap;
+    size_t pixelBytes = static_cast<size_t>(bitmap.stride) * bitmap.height;
+    if (bitmap.stride != bitmap.width * bytesPerPixel(bitmap.format) || pixelBytes > bitmap.pixels.size()) {
+        return false;
+    }
+
+    std::vector<uint8_t> payload;
+    payload.reserve(pixelBytes / 8);
+    encode(bitmap.pixels.data(), pixelBytes, bytesPerPixel(bitmap.format), payload);
+
+    StoredHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = kStoreMagic;
+    header.version = kStoreVersion;
+    header.format = bitmap.format;
+    header.width = bitmap.width;
+    header.height = bitmap.height;
+    header.stride = bitmap.stride;
+    header.scale = bitmap.scale;
+    header.pixelBytes = pixelBytes;
+    header.payloadBytes = payload.size();
+
+    // Readers only ever see complete files: write aside, then rename into place
+    std::string path = directory + "/" + write.fileName;
+    std::string tempPath = path + kTempSuffix;
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        LOGW("PageStore: cannot create %s (errno %d)", tempPath.c_str(), errno);
+        return false;
+    }
+    bool written = writeAll(fd, &header, sizeof(header)) && writeAll(fd, payload.data(), payload.size());
+    written = close(fd) == 0 && written;
+    if (!written || rename(tempPath.c_str(), path.c_str()) != 0) {
+        LOGW("PageStore: failed to write %s (errno %d)", path.c_str(), errno);
+        unlink(tempPath.c_str());
+        return false;
+    }
+    bytes = sizeof(header) + payload.size();
+    return true;
+}
+
+size_t PDFPageStore::removeLocked(const std::string& fileName) {
+    auto it = m_files.find(fileName);
+    if (it == m_files.end()) {
+        return 0;
+    }
+    size_t bytes = it->second.bytes;
+    unlink((m_directory + "/" + fileName).c_str());
+    m_bytes -= bytes;
+    m_files.erase(it);
+    return bytes;
+}
+
+size_t PDFPageStore::evictLocked(size_t targetBytes) {
+    if (m_bytes <= targetBytes) {
+        return 0;
+    }
+    std::vector<std::pair<int64_t, std::string>> order;
+    order.reserve(m_files.size());
+    for (const auto& file : m_files) {
+        order.emplace_back(file.second.lastUsed, file.first);
+    }
+    std::sort(order.begin(), order.end());
+    size_t removed = 0;
+    for (const auto& file : order) {
+        if (m_bytes <= targetBytes) {
+            break;
+        }
+        removed += removeLocked(file.second);
+        ++m_evictions;
+    }
+    return removed;
+}
+
+size_t PDFPageStore::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.clear();
+    m_idle.notify_all();
+    return evictLocked(0);
+}
+
+size_t PDFPageStore::clearDocument(const std::string& documentKey) {
+    std::string prefix = documentPrefix(documentKey);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(), [&prefix](const PendingWrite& pending) {
+        return pending.fileName.compare(0, prefix.size(), prefix) == 0;
+    }), m_pending.end());
+    m_idle.notify_all();
+    std::vector<std::string> names;
+    for (const auto& file : m_files) {
+        if (file.first.compare(0, prefix.size(), prefix) == 0) {
+            names.push_back(file.first);
+        }
+    }
+    size_t removed = 0;
+    for (const std::string& name : names) {
+        removed += removeLocked(name);
+    }
+    return removed;
+}
+
+size_t PDFPageStore::trimTo(size_t targetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return evictLocked(targetBytes);
+}
+
+PageStoreStats PDFPageStore::stats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PageStoreStats stats;
+    stats.enabled = !m_directory.empty();
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.writes = m_writes;
+    stats.droppedWrites = m_droppedWrites;
+    stats.evictions = m_evictions;
+    stats.entries = m_files.size();
+    stats.bytes = m_bytes;
+    stats.budgetBytes = m_budgetBytes;
+    return stats;
+}
+
+void PDFPageStore::encode(const uint8_t* pixels, size_t size, int unitBytes, std::vector<uint8_t>& out) {
+    if (unitBytes == 2) {
+        encodeUnits<uint16_t>(pixels, size / 2, out);
+    } else {
+        encodeUnits<uint32_t>(pixels, size / 4, out);
+    }
+}
+
+bool PDFPageStore::decode(const uint8_t* data, size_t size, int unitBytes, uint8_t* pixels, size_t pixelBytes) {
+    const size_t unit = static_cast<size_t>(unitBytes);
+    const uint8_t* end = data + size;
+    size_t filled = 0;
+    while (data < end) {
+        uint64_t token;
+        if (!getVarint(data, end, token)) {
+            return false;
+        }
+        uint64_t count = token >> 1;
+        if (count == 0 || count > (pixelBytes - filled) / unit) {
+            return false;
+        }
+        size_t length = static_cast<size_t>(count) * unit;
+        if (token & 1) {
+            if (static_cast<size_t>(end - data) < unit) {
+                return false;
+            }
+            fillUnits(pixels + filled, data, unit, static_cast<size_t>(count));
+            data += unit;
+        } else {
+            if (static_cast<size_t>(end - data) < length) {
+                return false;
+            }
+            std::memcpy(pixels + filled, data, length);
+            data += length;
+        }
+        filled += length;
+    }
+    return filled == pixelBytes;
+}
@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Persistent on-disk store of rendered pages
+ * Pages are kept across launches, keyed by document checksum, page, scale
+ * bucket and quality, one file per page. Pixels are compressed with a run-length
+ * codec over whole pixels: rendered pages are mostly flat paper, so files are
+ * small and decode at memset/memcpy speed. Reads decode straight from a
+ * read-only mapping into a pooled bitmap. Writes are compressed on the store's
+ * own thread, and the least recently used files are evicted past the budget.
+ * Read and written by PDFRenderEngine only, i.e. the JSI/engine render path;
+ * PdfView renders through AndroidPdfViewer and never reaches it.
+ */
+
+#ifndef PDF_PAGE_STORE_H
+#define PDF_PAGE_STORE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class PDFBitmapPool;
+struct PageBitmap;
+
+struct PageStoreKey {
+    // Content checksum of the document (PDFNativeCacheManager metadata)
+    std::string documentKey;
+    int pageNumber = 0;
+    int scaleBucket = 0;
+    int quality = 0;
+};
+
+struct PageStoreStats {
+    bool enabled = false;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t writes = 0;
+    uint64_t droppedWrites = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t budgetBytes = 0;
+};
+
+class PDFPageStore {
+public:
+    static constexpr size_t kDefaultBudgetBytes = 128 * 1024 * 1024;
+    // Renders waiting to be written; more are dropped rather than held in memory
+    static constexpr size_t kMaxPendingWrites = 8;
+
+    PDFPageStore() = default;
+    ~PDFPageStore();
+
+    // Stores pages in directory (created if missing) and indexes the files
+    // already there; an empty directory disables the store
+    bool configure(const std::string& directory, size_t budgetBytes, std::string& error);
+    bool enabled();
+
+    // Stored page decoded into a bitmap from pool; nullptr when absent or unreadable
+    std::shared_ptr<PageBitmap> load(const PageStoreKey& key, PDFBitmapPool& pool);
+    // Queues a rendered page to be compressed and written on the store's thread
+    void store(const PageStoreKey& key, std::shared_ptr<const PageBitmap> bitmap);
+    // Waits until every queued page is written
+    void flush();
+
+    // Each returns the number of bytes removed from disk
+    size_t clear();
+    size_t clearDocument(const std::string& documentKey);
+    size_t trimTo(size_t targetBytes);
+
+    PageStoreStats stats();
+
+    // Run-length codec over unitBytes-sized pixels (2 or 4)
+    static void encode(const uint8_t* pixels, size_t size, int unitBytes, std::vector<uint8_t>& out);
+    static bool decode(const uint8_t* data, size_t size, int unitBytes, uint8_t* pixels, size_t pixelBytes);
+
+private:
+    PDFPageStore(const PDFPageStore&) = delete;
+    PDFPageStore& operator=(const PDFPageStore&) = delete;
+
+    struct FileEntry {
+        size_t bytes = 0;
+        int64_t lastUsed = 0;
+    };
+    struct PendingWrite {
+        std::string fileName;
+        std::shared_ptr<const PageBitmap> bitmap;
+    };
+
+    static std::string fileNameFor(const PageStoreKey& key);
+    void writerLoop();
+    bool writeFile(const std::string& directory, const PendingWrite& write, size_t& bytes);
+    size_t removeLocked(const std::string& fileName);
+    size_t evictLocked(size_t targetBytes);
+
+    std::string m_directory;
+    size_t m_budgetBytes = kDefaultBudgetBytes;
+    // File name -> size and last use, rebuilt from the directory by configure()
+    std::unordered_map<std::string, FileEntry> m_files;
+    size_t m_bytes = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_writes = 0;
+    uint64_t m_droppedWrites = 0;
+    uint64_t m_evictions = 0;
+
+    std::deque<PendingWrite> m_pending;
+    bool m_writing = false;
+    bool m_stopping = false;
+    std::thread m_writer;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::mutex m_mutex;
+};
+
+#endif // PDF_PAGE_STORE_H
@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Background page preloading into the native page cache
+ */
+
+#include "PDFPreloader.h"
+#include "PDFJSILog.h"
+#include "PDFTrace.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Pdfium rendering is serialized, so more workers than this only add contention;
+// the second worker overlaps cache/document bookkeeping with the active render
+const unsigned kMaxWorkers = 2;
+
+} // namespace
+
+PDFPreloader::~PDFPreloader() {
+    shutdown();
+}
+
+bool PDFPreloader::schedule(const std::string& pdfId, int startPage, int endPage, int currentPage) {
+    if (pdfId.empty() || startPage < 1 || endPage < startPage) {
+        return false;
+    }
+
+    // Only open documents are preloaded; the id is never treated as a path
+    std::shared_ptr<PDFDocument> document = m_engine.documents().find(pdfId);
+    if (!document) {
+        return false;
+    }
+    endPage = std::min(endPage, document->pageCount);
+    if (endPage < startPage) {
+        return false;
+    }
+    currentPage = std::min(std::max(currentPage, startPage), endPage);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopping) {
+        return false;
+    }
+
+    // A new request for the document supersedes whatever is still pending
+    uint64_t generation = ++m_lastGeneration;
+    m_generations[pdfId] = generation;
+    m_stats.cancelled += removeQueuedLocked(pdfId);
+
+    RenderHint hint;
+    auto hintIt = m_hints.find(pdfId);
+    if (hintIt != m_hints.end()) {
+        hint = hintIt->second;
+    }
+
+    // Pages further from currentPage have larger distances; pages ahead of
+    // it win ties because forward scrolling is the common case
+    std::vector<Task> tasks;
+    for (int page = startPage; page <= endPage; ++page) {
+        Task task;
+        task.pdfId = pdfId;
+        task.pageNumber = page;
+        task.distance = std::abs(page - currentPage) * 2 - (page > currentPage ? 1 : 0);
+        task.scale = hint.scale;
+        task.quality = hint.quality;
+        task.generation = generation;
+        tasks.push_back(task);
+    }
+    std::sort(tasks.begin(), tasks.end(), [](const Task& a, const Task& b) {
+        return a.distance < b.distance;
+    });
+    if (tasks.size() > static_cast<size_t>(kMaxQueuedPages)) {
+        tasks.resize(kMaxQueuedPages);
+    }
+    m_stats.requested += tasks.size();
+
+    m_queue.insert(m_queue.end(), tasks.begin(), tasks.end());
+    std::stable_sort(m_queue.begin(), m_queue.end(), [](const Task& a, const Task& b) {
+        return a.distance > b.distance;
+    });
+
+    ensureWorkersLocked();
+    m_wakeup.notify_all();
+    return true;
+}
+
+void PDFPreloader::noteRender(const std::string& pdfId, float scale, int quality) {
+    if (!m_engine.documents().find(pdfId)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    RenderHint& hint = m_hints[pdfId];
+    hint.scale = scale;
+    hint.quality = quality;
+}
+
+void PDFPreloader::cancel(const std::string& pdfId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_generations.erase(pdfId);
+    m_stats.cancelled += removeQueuedLocked(pdfId);
+    m_hints.erase(pdfId);
+}
+
+void PDFPreloader::cancelAll() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_generations.clear();
+    m_stats.cancelled += m_queue.size();
+    m_queue.clear();
+    m_hints.clear();
+}
+
+void PDFPreloader::shutdown() {
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_stats.cancelled += m_queue.size();
+        m_queue.clear();
+        workers.swap(m_workers);
+    }
+    m_wakeup.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = false;
+}
+
+PreloadStats PDFPreloader::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PreloadStats snapshot = m_stats;
+    snapshot.queued = m_queue.size();
+    return snapshot;
+}
+
+void PDFPreloader::ensureWorkersLocked() {
+    if (!m_workers.empty()) {
+        return;
+    }
+    unsigned cores = std::thread::hardware_concurrency();
+    unsigned count = std::max(1u, std::min(kMaxWorkers, cores > 1 ? cores - 1 : 1u));
+    for (unsigned i = 0; i < count; ++i) {
+        m_workers.emplace_back(&PDFPreloader::workerLoop, this);
+    }
+    LOGI("Preloader started %u worker(s)", count);
+}
+
+void PDFPreloader::workerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wakeup.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+        if (m_stopping) {
+            return;
+        }
+
+        Task task = m_queue.back();
+        m_queue.pop_back();
+        if (!isCurrentLocked(task)) {
+            ++m_stats.cancelled;
+            continue;
+        }
+
+        lock.unlock();
+        // Resolved without the gesture override: pages cached ahead of the
+        // viewer should be the ones it shows once scrolling settles
+        int quality = m_engine.resolveQuality(task.pdfId, task.quality, false);
+        PageCacheKey key;
+        key.pdfId = task.pdfId;
+        key.pageNumber = task.pageNumber;
+        key.scaleBucket = PDFPageCache::scaleBucket(task.scale);
+        key.quality = quality;
+
+        bool cached = m_cache.contains(key);
+        RenderResult result;
+        if (!cached) {
+            PDFJSI_TRACE_SCOPE(kPreload);
+            result = m_engine.renderPage(task.pdfId, task.pageNumber, task.scale, std::string(), quality, true);
+            if (!result.success) {
+                LOGW("Preload of %s page %d failed: %s", task.pdfId.c_str(), task.pageNumber, result.error.c_str());
+            }
+        }
+        bool documentMissing = !cached && !result.success && !m_engine.documents().find(task.pdfId);
+        lock.lock();
+
+        // The document was released; the remaining pages would fail the same way
+        if (documentMissing && isCurrentLocked(task)) {
+            m_generations.erase(task.pdfId);
+            m_stats.cancelled += removeQueuedLocked(task.pdfId);
+        }
+
+        if (cached) {
+            ++m_stats.alreadyCached;
+        } else if (result.success) {
+            ++m_stats.rendered;
+        } else {
+            ++m_stats.failed;
+        }
+    }
+}
+
+bool PDFPreloader::isCurrentLocked(const Task& task) const {
+    auto it = m_generations.find(task.pdfId);
+    return it != m_generations.end() && it->second == task.generation;
+}
+
+size_t PDFPreloader::removeQueuedLocked(const std::string& pdfId) {
+    size_t before = m_queue.size();
+    m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(), [&pdfId](const Task& task) {
+        return task.pdfId == pdfId;
+    }), m_queue.end());
+    return before - m_queue.size();
+}
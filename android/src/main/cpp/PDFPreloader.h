@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Background page preloading into the native page cache
+ */
+
+#ifndef PDF_PRELOADER_H
+#define PDF_PRELOADER_H
+
+#include "PDFRenderEngine.h"
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct PreloadStats {
+    uint64_t requested = 0;
+    uint64_t rendered = 0;
+    uint64_t alreadyCached = 0;
+    uint64_t cancelled = 0;
+    uint64_t failed = 0;
+    size_t queued = 0;
+};
+
+class PDFPreloader {
+public:
+    // Pages queued per document are capped so a huge range cannot flood the pool
+    static constexpr int kMaxQueuedPages = 32;
+
+    PDFPreloader(PDFRenderEngine& engine, PDFPageCache& cache) : m_engine(engine), m_cache(cache) {}
+    ~PDFPreloader();
+
+    // Replaces any pending preload for pdfId with pages [startPage, endPage]
+    // (clamped to the document, which must already be open),
+    // rendered nearest-first around currentPage at the last scale/quality
+    // recorded with noteRender (1.0 / the document's level by default)
+    bool schedule(const std::string& pdfId, int startPage, int endPage, int currentPage);
+
+    // Remembers what the viewer is rendering so preloaded bitmaps hit the cache;
+    // ignored for documents that are not open
+    void noteRender(const std::string& pdfId, float scale, int quality);
+
+    // Drops queued pages and everything kept for pdfId (called when its last
+    // reference is released); a page already rendering finishes and is cached
+    void cancel(const std::string& pdfId);
+    void cancelAll();
+
+    // Cancels everything and joins the workers (restarted on the next schedule)
+    void shutdown();
+
+    PreloadStats stats() const;
+
+private:
+    PDFPreloader(const PDFPreloader&) = delete;
+    PDFPreloader& operator=(const PDFPreloader&) = delete;
+
+    struct Task {
+        std::string pdfId;
+        int pageNumber = 0;
+        int distance = 0;
+        float scale = 1.0f;
+        int quality = PDFJSI_QUALITY_DOCUMENT;
+        uint64_t generation = 0;
+    };
+
+    struct RenderHint {
+        float scale = 1.0f;
+        int quality = PDFJSI_QUALITY_DOCUMENT;
+    };
+
+    void ensureWorkersLocked();
+    void workerLoop();
+    size_t removeQueuedLocked(const std::string& pdfId);
+    bool isCurrentLocked(const Task& task) const;
+
+    PDFRenderEngine& m_engine;
+    PDFPageCache& m_cache;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::vector<std::thread> m_workers;
+    bool m_stopping = false;
+
+    // Sorted so the nearest page is at the back (cheap pop_back)
+    std::vector<Task> m_queue;
+    // Current schedule of each document with pending work. Generations come from
+    // one counter, so an erased entry never matches a task scheduled before it.
+    std::map<std::string, uint64_t> m_generations;
+    uint64_t m_lastGeneration = 0;
+    std::map<std::string, RenderHint> m_hints;
+    PreloadStats m_stats;
+};
+
+#endif // PDF_PRELOADER_H
@@ -0,0 +1,258 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Progressive open of a document that is still downloading
+ */
+
+#include "PDFProgressiveDocument.h"
+#include "PDFRenderEngine.h"
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <iterator>
+#include <unistd.h>
+
+PDFProgressiveDocument::PDFProgressiveDocument(const std::string& path, size_t fileSize)
+    : m_path(path), m_fileSize(fileSize) {}
+
+PDFProgressiveDocument::~PDFProgressiveDocument() {
+    const PdfiumApi* api = PdfiumApi::get();
+    if (api && (m_document || m_avail)) {
+        std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+        // The document reads through the availability object, so it closes first
+        if (m_document) {
+            api->closeDocument(m_document);
+        }
+        if (m_avail) {
+            api->availDestroy(m_avail);
+        }
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+bool PDFProgressiveDocument::open(std::string& error) {
+    const PdfiumApi* api = PdfiumApi::get();
+    if (!api) {
+        error = "Pdfium library not available";
+        return false;
+    }
+    if (!api->supportsProgressiveLoading()) {
+        error = "Pdfium build has no progressive loading support";
+        return false;
+    }
+    if (m_fileSize == 0 || m_fileSize > 0xFFFFFFFFu) {
+        error = "Unsupported file size for progressive loading";
+        return false;
+    }
+    m_fd = ::open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0) {
+        error = "Cannot open " + m_path;
+        return false;
+    }
+
+    m_fileAccess.m_FileLen = static_cast<unsigned long>(m_fileSize);
+    m_fileAccess.m_GetBlock = &PDFProgressiveDocument::getBlock;
+    m_fileAccess.m_Param = this;
+    m_fileAvail.version = 1;
+    m_fileAvail.IsDataAvail = &PDFProgressiveDocument::isDataAvail;
+    m_fileAvail.owner = this;
+    m_hints.version = 1;
+    m_hints.AddSegment = &PDFProgressiveDocument::addSegment;
+    m_hints.owner = this;
+
+    std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+    m_avail = api->availCreate(&m_fileAvail, &m_fileAccess);
+    if (!m_avail) {
+        error = "Failed to create Pdfium availability state";
+        return false;
+    }
+    return true;
+}
+
+void PDFProgressiveDocument::markAvailable(size_t offset, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    size_t end = offset + length;
+    std::lock_guard<std::mutex> lock(m_rangesMutex);
+    // Merge with the range starting at or before offset and every range the new one reaches
+    auto it = m_ranges.upper_bound(offset);
+    if (it != m_ranges.begin()) {
+        auto previous = std::prev(it);
+        if (previous->second >= offset) {
+            offset = previous->first;
+            end = std::max(end, previous->second);
+            it = m_ranges.erase(previous);
+        }
+    }
+    while (it != m_ranges.end() && it->first <= end) {
+        end = std::max(end, it->second);
+        it = m_ranges.erase(it);
+    }
+    m_ranges[offset] = end;
+}
+
+int PDFProgressiveDocument::poll(std::vector<ByteRange>& hints, std::string& error) {
+    const PdfiumApi* api = PdfiumApi::get();
+    std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+    if (!m_avail) {
+        error = "Document is not open";
+        return PDFJSI_PROGRESSIVE_ERROR;
+    }
+    if (m_firstPageAvailable) {
+        return PDFJSI_PROGRESSIVE_FIRST_PAGE;
+    }
+
+    m_pendingHints = &hints;
+    int state = PDFJSI_PROGRESSIVE_WAITING;
+    if (!m_document) {
+        int available = api->availIsDocAvail(m_avail, &m_hints);
+        if (available == PDFIUM_DATA_AVAIL) {
+            m_document = api->availGetDocument(m_avail, nullptr);
+            if (!m_document) {
+                m_pendingHints = nullptr;
+                error = PdfiumApi::describeError(api->getLastError());
+                return PDFJSI_PROGRESSIVE_ERROR;
+            }
+            m_pageCount = api->getPageCount(m_document);
+            m_firstPage = api->availGetFirstPageNum(m_document);
+        } else if (available == PDFIUM_DATA_ERROR) {
+            m_pendingHints = nullptr;
+            error = "Document structure is damaged";
+            return PDFJSI_PROGRESSIVE_ERROR;
+        }
+    }
+    if (m_document) {
+        state = PDFJSI_PROGRESSIVE_DOCUMENT;
+        if (m_pageCount > 0) {
+            int available = api->availIsPageAvail(m_avail, m_firstPage, &m_hints);
+            if (available == PDFIUM_DATA_AVAIL) {
+                m_firstPageAvailable = true;
+                state = PDFJSI_PROGRESSIVE_FIRST_PAGE;
+            } else if (available == PDFIUM_DATA_ERROR) {
+                m_pendingHints = nullptr;
+                error = "First page is damaged";
+                return PDFJSI_PROGRESSIVE_ERROR;
+            }
+        }
+    }
+    m_pendingHints = nullptr;
+    return state;
+}
+
+int PDFProgressiveDocument::linearization() {
+    const PdfiumApi* api = PdfiumApi::get();
+    std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+    return m_avail ? api->availIsLinearized(m_avail) : PDFIUM_LINEARIZATION_UNKNOWN;
+}
+
+int PDFProgressiveDocument::pageCount() {
+    std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+    return m_pageCount;
+}
+
+int PDFProgressiveDocument::firstPage() {
+    std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+    return m_firstPage + 1;
+}
+
+bool PDFProgressiveDocument::firstPageSize(float& width, float& height, std::string& error) {
+    const PdfiumApi* api = PdfiumApi::get();
+    std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+    if (!m_firstPageAvailable) {
+        error = "First page has not arrived";
+        return false;
+    }
+    FPDF_PAGE page = api->loadPage(m_document, m_firstPage);
+    if (!page) {
+        error = PdfiumApi::describeError(api->getLastError());
+        return false;
+    }
+    width = static_cast<float>(api->getPageWidth(page));
+    height = static_cast<float>(api->getPageHeight(page));
+    api->closePage(page);
+    return true;
+}
+
+bool PDFProgressiveDocument::renderFirstPage(void* pixels, int width, int height, int stride, std::string& error) {
+    const PdfiumApi* api = PdfiumApi::get();
+    std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+    if (!m_firstPageAvailable) {
+        error = "First page has not arrived";
+        return false;
+    }
+    FPDF_PAGE page = api->loadPage(m_document, m_firstPage);
+    if (!page) {
+        error = PdfiumApi::describeError(api->getLastError());
+        return false;
+    }
+    bool drawn = PDFRenderEngine::drawPage(api, page, pixels, width, height, stride, PDFIUM_RENDER_ANNOT, error);
+    api->closePage(page);
+    return drawn;
+}
+
+bool PDFProgressiveDocument::covered(size_t offset, size_t length) {
+    std::lock_guard<std::mutex> lock(m_rangesMutex);
+    auto it = m_ranges.upper_bound(offset);
+    if (it == m_ranges.begin()) {
+        return false;
+    }
+    --it;
+    return it->second >= offset + length;
+}
+
+void PDFProgressiveDocument::addMissing(size_t offset, size_t length) {
+    size_t end = std::min(offset + length, m_fileSize);
+    std::lock_guard<std::mutex> lock(m_rangesMutex);
+    // Walk the gaps between downloaded ranges inside [offset, end)
+    auto it = m_ranges.upper_bound(offset);
+    if (it != m_ranges.begin() && std::prev(it)->second > offset) {
+        offset = std::prev(it)->second;
+    }
+    while (offset < end) {
+        size_t gapEnd = (it == m_ranges.end()) ? end : std::min(end, it->first);
+        if (gapEnd > offset) {
+            ByteRange range;
+            range.offset = offset;
+            range.length = gapEnd - offset;
+            m_pendingHints->push_back(range);
+        }
+        if (it == m_ranges.end()) {
+            break;
+        }
+        offset = std::max(offset, it->second);
+        ++it;
+    }
+}
+
+FPDF_BOOL PDFProgressiveDocument::isDataAvail(FX_FILEAVAIL* self, size_t offset, size_t size) {
+    PDFProgressiveDocument* document = static_cast<FileAvail*>(self)->owner;
+    return document->covered(offset, size) ? 1 : 0;
+}
+
+void PDFProgressiveDocument::addSegment(FX_DOWNLOADHINTS* self, size_t offset, size_t size) {
+    PDFProgressiveDocument* document = static_cast<DownloadHints*>(self)->owner;
+    if (document->m_pendingHints && size > 0 && offset < document->m_fileSize) {
+        document->addMissing(offset, size);
+    }
+}
+
+int PDFProgressiveDocument::getBlock(void* param, unsigned long position, unsigned char* buffer, unsigned long size) {
+    PDFProgressiveDocument* document = static_cast<PDFProgressiveDocument*>(param);
+    size_t done = 0;
+    while (done < size) {
+        ssize_t count = pread(document->m_fd, buffer + done, size - done, static_cast<off_t>(position + done));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return 0;
+        }
+        done += static_cast<size_t>(count);
+    }
+    return 1;
+}
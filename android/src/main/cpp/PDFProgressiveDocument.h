@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Progressive open of a document that is still downloading
+ * The downloader writes byte ranges into a file of the final size and reports
+ * each one with markAvailable(). Pdfium's data availability API parses only
+ * the bytes present: poll() says how far the document can be opened and
+ * returns the ranges Pdfium needs next so they are fetched first. Linearized
+ * ("fast web view") files have page 1 usable after a small prefix; other
+ * files first need the trailer and cross-reference table at their end.
+ */
+
+#ifndef PDF_PROGRESSIVE_DOCUMENT_H
+#define PDF_PROGRESSIVE_DOCUMENT_H
+
+#include "PdfiumApi.h"
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// poll() results, in the order a download reaches them
+#define PDFJSI_PROGRESSIVE_ERROR -1
+#define PDFJSI_PROGRESSIVE_WAITING 0
+#define PDFJSI_PROGRESSIVE_DOCUMENT 1
+#define PDFJSI_PROGRESSIVE_FIRST_PAGE 2
+
+struct ByteRange {
+    size_t offset = 0;
+    size_t length = 0;
+};
+
+class PDFProgressiveDocument {
+public:
+    PDFProgressiveDocument(const std::string& path, size_t fileSize);
+    ~PDFProgressiveDocument();
+
+    // Opens the partial file; fails when Pdfium lacks the availability API
+    bool open(std::string& error);
+
+    // Records bytes written to the file by the downloader
+    void markAvailable(size_t offset, size_t length);
+
+    // Advances parsing with the bytes present. Ranges Pdfium asked for and
+    // that are still missing are appended to hints.
+    int poll(std::vector<ByteRange>& hints, std::string& error);
+
+    // PDFIUM_LINEARIZED, PDFIUM_NOT_LINEARIZED or PDFIUM_LINEARIZATION_UNKNOWN
+    int linearization();
+    // Valid once poll() reported the document; the first page is 1-based
+    int pageCount();
+    int firstPage();
+
+    // First page size and render; valid once poll() reported the first page
+    bool firstPageSize(float& width, float& height, std::string& error);
+    bool renderFirstPage(void* pixels, int width, int height, int stride, std::string& error);
+
+private:
+    PDFProgressiveDocument(const PDFProgressiveDocument&) = delete;
+    PDFProgressiveDocument& operator=(const PDFProgressiveDocument&) = delete;
+
+    // Pdfium hands these back to the callbacks, which recover the document from them
+    struct FileAvail : FX_FILEAVAIL {
+        PDFProgressiveDocument* owner;
+    };
+    struct DownloadHints : FX_DOWNLOADHINTS {
+        PDFProgressiveDocument* owner;
+    };
+
+    static FPDF_BOOL isDataAvail(FX_FILEAVAIL* self, size_t offset, size_t size);
+    static void addSegment(FX_DOWNLOADHINTS* self, size_t offset, size_t size);
+    static int getBlock(void* param, unsigned long position, unsigned char* buffer, unsigned long size);
+
+    bool covered(size_t offset, size_t length);
+    void addMissing(size_t offset, size_t length);
+
+    std::string m_path;
+    size_t m_fileSize;
+    int m_fd = -1;
+
+    FPDF_FILEACCESS m_fileAccess = {};
+    FileAvail m_fileAvail = {};
+    DownloadHints m_hints = {};
+    // Filled by addSegment while poll() runs
+    std::vector<ByteRange>* m_pendingHints = nullptr;
+
+    // Guarded by PdfiumApi::mutex()
+    FPDF_AVAIL m_avail = nullptr;
+    FPDF_DOCUMENT m_document = nullptr;
+    int m_pageCount = 0;
+    int m_firstPage = 0;
+    bool m_firstPageAvailable = false;
+
+    // Downloaded ranges, merged: start -> end (exclusive)
+    std::map<size_t, size_t> m_ranges;
+    std::mutex m_rangesMutex;
+};
+
+#endif // PDF_PROGRESSIVE_DOCUMENT_H
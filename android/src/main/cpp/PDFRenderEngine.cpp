@@ -0,0 +1,476 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Native page rasterizer backing the JSI render entry points
+ */
+
+#include "PDFRenderEngine.h"
+#include "PDFTrace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+// Upper bounds that keep a single render from exhausting native memory
+const int kMaxBitmapDimension = 8192;
+const int64_t kMaxBitmapPixels = 4096LL * 4096LL;
+const int64_t kNormalMaxBitmapPixels = kMaxBitmapPixels / 2;
+
+// Draft renders trade resolution and anti-aliasing for speed while the viewer moves
+const float kDraftScaleFactor = 0.5f;
+const int kDraftRenderFlags = PDFIUM_RENDER_NO_SMOOTHTEXT | PDFIUM_RENDER_NO_SMOOTHIMAGE | PDFIUM_RENDER_NO_SMOOTHPATH;
+
+} // namespace
+
+RenderResult PDFRenderEngine::renderPage(const std::string& pdfId, int pageNumber, float scale,
+                                        const std::string& base64Data, int quality,
+                                        bool speculative) {
+    PDFJSI_TRACE_SCOPE(kRender);
+    auto start = std::chrono::steady_clock::now();
+
+    RenderResult result;
+    result.pageNumber = pageNumber;
+    result.scale = scale;
+
+    if (!(scale > 0.0f)) {
+        result.error = "Invalid scale";
+        return result;
+    }
+
+    // Speculative renders never open a document, so a stale id queued for
+    // preloading is not mistaken for a file path
+    std::shared_ptr<PDFDocument> document = speculative
+        ? m_registry.find(pdfId) : resolveDocument(pdfId, base64Data, result.error);
+    if (!document) {
+        if (speculative) {
+            result.error = "Document not open: " + pdfId;
+        }
+        return result;
+    }
+
+    if (pageNumber < 1 || pageNumber > document->pageCount) {
+        result.error = "Page out of range: " + std::to_string(pageNumber);
+        return result;
+    }
+
+    result.quality = resolveQuality(pdfId, quality);
+
+    PageCacheKey key;
+    key.pdfId = pdfId;
+    key.pageNumber = pageNumber;
+    key.scaleBucket = PDFPageCache::scaleBucket(scale);
+    key.quality = result.quality;
+
+    result.bitmap = speculative ? m_cache.peek(key) : m_cache.get(key);
+    if (result.bitmap) {
+        result.cached = true;
+    } else {
+        // Draft renders are redrawn within a gesture, so they are never persisted
+        PageStoreKey storeKey;
+        if (result.quality != PDFJSI_QUALITY_DRAFT && m_store.enabled()) {
+            std::lock_guard<std::mutex> lock(document->storeKeyMutex);
+            storeKey.documentKey = document->storeKey;
+        }
+        bool stored = !storeKey.documentKey.empty();
+        if (stored) {
+            storeKey.pageNumber = pageNumber;
+            storeKey.scaleBucket = key.scaleBucket;
+            storeKey.quality = result.quality;
+            result.bitmap = m_store.load(storeKey, m_pool);
+            result.cached = result.bitmap != nullptr;
+        }
+        if (!result.bitmap) {
+            auto bitmap = std::make_shared<PageBitmap>();
+            if (!rasterize(*document, pageNumber, PDFPageCache::bucketScale(key.scaleBucket), result.quality, *bitmap, result.error)) {
+                return result;
+            }
+            result.bitmap = bitmap;
+            if (stored) {
+                m_store.store(storeKey, result.bitmap);
+            }
+        }
+        m_cache.put(key, result.bitmap);
+        // A page shown for the first time is about to be tapped; its text and
+        // link boxes are read in the background while it is on screen
+        if (result.quality != PDFJSI_QUALITY_DRAFT) {
+            m_hitIndex.prefetch(document, pageNumber);
+        }
+    }
+
+    result.success = true;
+    result.width = result.bitmap->width;
+    result.height = result.bitmap->height;
+    result.renderTimeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+bool PDFRenderEngine::renderPageInto(const std::string& pdfId, int pageNumber, void* pixels,
+                                     int width, int height, int stride, std::string& error) {
+    PDFJSI_TRACE_SCOPE(kBitmapRender);
+    std::shared_ptr<PDFDocument> document = m_registry.find(pdfId);
+    if (!document) {
+        error = "Document not open: " + pdfId;
+        return false;
+    }
+    if (pageNumber < 1 || pageNumber > document->pageCount) {
+        error = "Page out of range: " + std::to_string(pageNumber);
+        return false;
+    }
+
+    const PdfiumApi* api = PdfiumApi::get();
+    std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+    if (!document->handle) {
+        error = "Document is closed";
+        return false;
+    }
+    FPDF_PAGE page = api->loadPage(document->handle, pageNumber - 1);
+    if (!page) {
+        error = PdfiumApi::describeError(api->getLastError());
+        return false;
+    }
+    bool drawn = drawPage(api, page, pixels, width, height, stride, PDFIUM_RENDER_ANNOT, error);
+    api->closePage(page);
+    if (drawn) {
+        m_hitIndex.prefetch(document, pageNumber);
+    }
+    return drawn;
+}
+
+bool PDFRenderEngine::getPageSize(const std::string& pdfId, int pageNumber, PageSize& size, std::string& error) {
+    std::shared_ptr<PDFDocument> document = m_registry.find(pdfId);
+    if (!document) {
+        error = "Document not open: " + pdfId;
+        return false;
+    }
+    PageGeometry geometry;
+    if (!readPageGeometry(*document, pageNumber, geometry, error)) {
+        return false;
+    }
+    size.width = geometry.width;
+    size.height = geometry.height;
+    size.rotation = geometry.rotation;
+    return true;
+}
+
+bool PDFRenderEngine::getPageSizes(const std::string& pdfId, const std::vector<int>& pageNumbers,
+                                   std::vector<PageSize>& sizes, std::string& error) {
+    std::shared_ptr<PDFDocument> document = m_registry.find(pdfId);
+    if (!document) {
+        error = "Document not open: " + pdfId;
+        return false;
+    }
+    sizes.assign(pageNumbers.size(), PageSize());
+    std::string pageError;
+    for (size_t i = 0; i < pageNumbers.size(); ++i) {
+        PageGeometry geometry;
+        if (readPageGeometry(*document, pageNumbers[i], geometry, pageError)) {
+            sizes[i].width = geometry.width;
+            sizes[i].height = geometry.height;
+            sizes[i].rotation = geometry.rotation;
+        }
+    }
+    return true;
+}
+
+bool PDFRenderEngine::getPageGeometry(const std::string& pdfId, std::vector<PageGeometry>& table, std::string& error) {
+    std::shared_ptr<PDFDocument> document = m_registry.find(pdfId);
+    if (!document) {
+        error = "Document not open: " + pdfId;
+        return false;
+    }
+    table.assign(document->pageCount, PageGeometry());
+    for (int page = 1; page <= document->pageCount; ++page) {
+        if (!readPageGeometry(*document, page, table[page - 1], error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PDFRenderEngine::setPageGeometry(const std::string& pdfId, const std::vector<PageGeometry>& table, std::string& error) {
+    std::shared_ptr<PDFDocument> document = m_registry.find(pdfId);
+    if (!document) {
+        error = "Document not open: " + pdfId;
+        return false;
+    }
+    if (table.size() != static_cast<size_t>(document->pageCount)) {
+        error = "Geometry table has " + std::to_string(table.size()) + " pages, document has " +
+                std::to_string(document->pageCount);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(document->geometryMutex);
+    document->geometry = table;
+    for (PageGeometry& geometry : document->geometry) {
+        geometry.known = true;
+    }
+    return true;
+}
+
+bool PDFRenderEngine::setPageStoreKey(const std::string& pdfId, const std::string& key, std::string& error) {
+    std::shared_ptr<PDFDocument> document = m_registry.find(pdfId);
+    if (!document) {
+        error = "Document not open: " + pdfId;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(document->storeKeyMutex);
+    document->storeKey = key;
+    return true;
+}
+
+// Measured pages are remembered on the document, so each page is loaded at
+// most once. The Pdfium lock is taken per page so preload workers interleave
+// with long batches.
+bool PDFRenderEngine::readPageGeometry(PDFDocument& document, int pageNumber, PageGeometry& geometry, std::string& error) {
+    if (pageNumber < 1 || pageNumber > document.pageCount) {
+        error = "Page out of range: " + std::to_string(pageNumber);
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(document.geometryMutex);
+        if (document.geometry.size() == static_cast<size_t>(document.pageCount) &&
+            document.geometry[pageNumber - 1].known) {
+            geometry = document.geometry[pageNumber - 1];
+            return true;
+        }
+    }
+
+    const PdfiumApi* api = PdfiumApi::get();
+    {
+        std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+        if (!document.handle) {
+            error = "Document is closed";
+            return false;
+        }
+        FPDF_PAGE page = api->loadPage(document.handle, pageNumber - 1);
+        if (!page) {
+            error = PdfiumApi::describeError(api->getLastError());
+            return false;
+        }
+        geometry = PageGeometry();
+        geometry.width = static_cast<float>(api->getPageWidth(page));
+        geometry.height = static_cast<float>(api->getPageHeight(page));
+        geometry.rotation = api->getPageRotation(page) * 90;
+        float* media = geometry.mediaBox;
+        float* crop = geometry.cropBox;
+        // Boxes inherited from the page tree are not reported; the displayed size stands in
+        if (!api->getMediaBox || !api->getMediaBox(page, &media[0], &media[1], &media[2], &media[3])) {
+            bool sideways = geometry.rotation % 180 != 0;
+            media[0] = 0.0f;
+            media[1] = 0.0f;
+            media[2] = sideways ? geometry.height : geometry.width;
+            media[3] = sideways ? geometry.width : geometry.height;
+        }
+        if (!api->getCropBox || !api->getCropBox(page, &crop[0], &crop[1], &crop[2], &crop[3])) {
+            std::copy(media, media + 4, crop);
+        }
+        geometry.known = true;
+        api->closePage(page);
+    }
+
+    std::lock_guard<std::mutex> lock(document.geometryMutex);
+    if (document.geometry.size() != static_cast<size_t>(document.pageCount)) {
+        document.geometry.assign(document.pageCount, PageGeometry());
+    }
+    document.geometry[pageNumber - 1] = geometry;
+    return true;
+}
+
+bool PDFRenderEngine::setDocumentQuality(const std::string& pdfId, int quality) {
+    if (quality < PDFJSI_QUALITY_DRAFT || quality > PDFJSI_QUALITY_HIGH) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_qualityMutex);
+    m_quality[pdfId].quality = quality;
+    return true;
+}
+
+int PDFRenderEngine::documentQuality(const std::string& pdfId) {
+    std::lock_guard<std::mutex> lock(m_qualityMutex);
+    auto it = m_quality.find(pdfId);
+    return it != m_quality.end() ? it->second.quality : PDFJSI_QUALITY_NORMAL;
+}
+
+void PDFRenderEngine::setInteracting(const std::string& pdfId, bool active) {
+    std::lock_guard<std::mutex> lock(m_qualityMutex);
+    // Gesture events keep extending the deadline; a missed end event expires on its own
+    m_quality[pdfId].interactionDeadline = active
+        ? std::chrono::steady_clock::now() + std::chrono::milliseconds(kInteractionTimeoutMs)
+        : std::chrono::steady_clock::time_point();
+}
+
+bool PDFRenderEngine::isInteracting(const std::string& pdfId) {
+    std::lock_guard<std::mutex> lock(m_qualityMutex);
+    auto it = m_quality.find(pdfId);
+    return it != m_quality.end() && std::chrono::steady_clock::now() < it->second.interactionDeadline;
+}
+
+void PDFRenderEngine::capQuality(int quality, int durationMs) {
+    std::lock_guard<std::mutex> lock(m_qualityMutex);
+    auto now = std::chrono::steady_clock::now();
+    // A stricter cap still in force is not loosened by a milder one
+    if (now < m_qualityCapDeadline && m_qualityCap < quality) {
+        return;
+    }
+    m_qualityCap = quality;
+    m_qualityCapDeadline = now + std::chrono::milliseconds(durationMs);
+}
+
+int PDFRenderEngine::qualityCap() {
+    std::lock_guard<std::mutex> lock(m_qualityMutex);
+    return std::chrono::steady_clock::now() < m_qualityCapDeadline ? m_qualityCap : PDFJSI_QUALITY_HIGH;
+}
+
+int PDFRenderEngine::resolveQuality(const std::string& pdfId, int quality, bool honourInteraction) {
+    std::lock_guard<std::mutex> lock(m_qualityMutex);
+    auto now = std::chrono::steady_clock::now();
+    int cap = now < m_qualityCapDeadline ? m_qualityCap : PDFJSI_QUALITY_HIGH;
+    int level = PDFJSI_QUALITY_NORMAL;
+    if (quality >= PDFJSI_QUALITY_DRAFT && quality <= PDFJSI_QUALITY_HIGH) {
+        level = quality;
+    } else {
+        auto it = m_quality.find(pdfId);
+        if (it != m_quality.end()) {
+            level = honourInteraction && now < it->second.interactionDeadline
+                ? PDFJSI_QUALITY_DRAFT : it->second.quality;
+        }
+    }
+    return std::min(level, cap);
+}
+
+void PDFRenderEngine::forgetDocument(const std::string& pdfId) {
+    m_cache.clearDocument(pdfId);
+    std::lock_guard<std::mutex> lock(m_qualityMutex);
+    m_quality.erase(pdfId);
+}
+
+void PDFRenderEngine::forgetAll() {
+    m_cache.clear();
+    std::lock_guard<std::mutex> lock(m_qualityMutex);
+    m_quality.clear();
+}
+
+std::shared_ptr<PDFDocument> PDFRenderEngine::resolveDocument(const std::string& pdfId, const std::string& base64Data, std::string& error) {
+    DocumentSource source;
+    source.base64Data = base64Data;
+    return resolveDocument(pdfId, source, error);
+}
+
+std::shared_ptr<PDFDocument> PDFRenderEngine::resolveDocument(const std::string& pdfId, const DocumentSource& source, std::string& error) {
+    std::shared_ptr<PDFDocument> document = m_registry.find(pdfId);
+    if (document) {
+        return document;
+    }
+    // First use from the JSI fast path: that path owns this reference until
+    // the document is closed or JSI is cleaned up
+    std::lock_guard<std::mutex> lock(m_resolveMutex);
+    document = m_registry.find(pdfId);
+    if (document) {
+        return document;
+    }
+    document = m_registry.acquire(pdfId, source, error);
+    if (document) {
+        m_cache.registerDocument(pdfId);
+    }
+    return document;
+}
+
+bool PDFRenderEngine::rasterize(PDFDocument& document, int pageNumber, float scale, int quality, PageBitmap& bitmap, std::string& error) {
+    PDFJSI_TRACE_SCOPE(kRasterize);
+    const PdfiumApi* api = PdfiumApi::get();
+    std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+
+    if (!document.handle) {
+        error = "Document is closed";
+        return false;
+    }
+
+    FPDF_PAGE page = api->loadPage(document.handle, pageNumber - 1);
+    if (!page) {
+        error = PdfiumApi::describeError(api->getLastError());
+        return false;
+    }
+
+    // Page size is in points (1/72 inch); scale 1.0 renders at 72 DPI
+    double pageWidth = api->getPageWidth(page);
+    double pageHeight = api->getPageHeight(page);
+    bool draft = quality == PDFJSI_QUALITY_DRAFT;
+    double effectiveScale = draft ? scale * kDraftScaleFactor : scale;
+    int64_t maxPixels = quality == PDFJSI_QUALITY_HIGH ? kMaxBitmapPixels : kNormalMaxBitmapPixels;
+    double pixels = pageWidth * pageHeight * effectiveScale * effectiveScale;
+    if (pixels > static_cast<double>(maxPixels)) {
+        effectiveScale *= std::sqrt(static_cast<double>(maxPixels) / pixels);
+    }
+    // Shrink both sides by the same factor so a long edge over the limit
+    // doesn't distort the page's aspect ratio
+    double longestSide = std::max(pageWidth, pageHeight) * effectiveScale;
+    if (longestSide > kMaxBitmapDimension) {
+        effectiveScale *= kMaxBitmapDimension / longestSide;
+    }
+
+    int width = std::min(kMaxBitmapDimension, std::max(1, static_cast<int>(std::lround(pageWidth * effectiveScale))));
+    int height = std::min(kMaxBitmapDimension, std::max(1, static_cast<int>(std::lround(pageHeight * effectiveScale))));
+    int stride = width * 4;
+
+    bitmap.pageNumber = pageNumber;
+    bitmap.scale = scale;
+    bitmap.quality = quality;
+    bitmap.width = width;
+    bitmap.height = height;
+    bitmap.stride = stride;
+
+    bool drawn = false;
+    size_t byteCount = static_cast<size_t>(stride) * height;
+    if (!draft) {
+        if (bitmap.pixels.allocate(&m_pool, byteCount)) {
+            drawn = drawPage(api, page, bitmap.pixels.data(), width, height, stride, PDFIUM_RENDER_ANNOT, error);
+        } else {
+            error = "Failed to allocate page bitmap";
+        }
+    } else {
+        // Draft pages draw into a pooled RGBA scratch block and are cached as
+        // RGB_565, halving what they cost in the page cache
+        PixelBuffer scratch;
+        size_t pixelCount = static_cast<size_t>(width) * height;
+        if (scratch.allocate(&m_pool, byteCount) && bitmap.pixels.allocate(&m_pool, pixelCount * 2)) {
+            drawn = drawPage(api, page, scratch.data(), width, height, stride, kDraftRenderFlags, error);
+            if (drawn) {
+                packRgb565(scratch.data(), pixelCount, reinterpret_cast<uint16_t*>(bitmap.pixels.data()));
+                bitmap.format = PDFJSI_PIXEL_RGB_565;
+                bitmap.stride = width * 2;
+            }
+        } else {
+            error = "Failed to allocate page bitmap";
+        }
+    }
+    api->closePage(page);
+    if (!drawn) {
+        bitmap.pixels.release();
+    }
+    return drawn;
+}
+
+// Packs RGBA_8888 into Android's RGB_565 layout (r in the high bits)
+void PDFRenderEngine::packRgb565(const uint8_t* rgba, size_t count, uint16_t* target) {
+    for (size_t i = 0; i < count; ++i, rgba += 4) {
+        target[i] = static_cast<uint16_t>(((rgba[0] & 0xF8) << 8) | ((rgba[1] & 0xFC) << 3) | (rgba[2] >> 3));
+    }
+}
+
+bool PDFRenderEngine::drawPage(const PdfiumApi* api, FPDF_PAGE page, void* pixels, int width, int height, int stride,
+                               int flags, std::string& error) {
+    FPDF_BITMAP target = api->bitmapCreateEx(width, height, PDFIUM_BITMAP_BGRA, pixels, stride);
+    if (!target) {
+        error = "Failed to allocate page bitmap";
+        return false;
+    }
+
+    // Opaque white paper, then draw with RGBA byte order to match ARGB_8888 memory layout
+    api->bitmapFillRect(target, 0, 0, width, height, 0xFFFFFFFF);
+    api->renderPageBitmap(target, page, 0, 0, width, height, 0, flags | PDFIUM_RENDER_REVERSE_BYTE_ORDER);
+    api->bitmapDestroy(target);
+    return true;
+}
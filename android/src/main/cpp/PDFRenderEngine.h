@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Native page rasterizer backing the JSI render entry points
+ */
+
+#ifndef PDF_RENDER_ENGINE_H
+#define PDF_RENDER_ENGINE_H
+
+#include "PDFBitmapPool.h"
+#include "PDFDocumentRegistry.h"
+#include "PDFHitIndex.h"
+#include "PDFPageCache.h"
+#include "PDFPageStore.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Pixel layouts of PageBitmap::pixels
+#define PDFJSI_PIXEL_RGBA_8888 1
+#define PDFJSI_PIXEL_RGB_565 2
+
+// Rendered page pixels (RGBA_8888 premultiplied, or RGB_565 for draft renders; row-major)
+// The pixel block returns to the engine's bitmap pool with the last reference
+struct PageBitmap {
+    int pageNumber = 0;
+    float scale = 1.0f;
+    int quality = 0;
+    int format = PDFJSI_PIXEL_RGBA_8888;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+    PixelBuffer pixels;
+
+    size_t byteSize() const { return pixels.size(); }
+};
+
+struct RenderResult {
+    bool success = false;
+    bool cached = false;
+    std::string error;
+    int pageNumber = 0;
+    float scale = 1.0f;
+    int quality = 0;
+    int width = 0;
+    int height = 0;
+    double renderTimeMs = 0.0;
+    std::shared_ptr<const PageBitmap> bitmap;
+};
+
+struct PageSize {
+    double width = 0.0;
+    double height = 0.0;
+    int rotation = 0;
+};
+
+// Render quality levels (matches setRenderQuality 1-3 on the JS side)
+// Draft: half resolution, no annotations or anti-aliasing, RGB_565
+// Normal: annotations, RGBA_8888, pixel budget of 8 MP per page
+// High: annotations, RGBA_8888, full 16 MP pixel budget
+#define PDFJSI_QUALITY_DOCUMENT 0   // the document's level (draft during gestures)
+#define PDFJSI_QUALITY_DRAFT 1
+#define PDFJSI_QUALITY_NORMAL 2
+#define PDFJSI_QUALITY_HIGH 3
+
+class PDFRenderEngine {
+public:
+    PDFRenderEngine(PDFDocumentRegistry& registry, PDFPageCache& cache, PDFBitmapPool& pool, PDFPageStore& store,
+                    PDFHitIndex& hitIndex)
+        : m_registry(registry), m_cache(cache), m_pool(pool), m_store(store), m_hitIndex(hitIndex) {}
+
+    // Renders from an already registered document, or registers pdfId on
+    // first use from the base64 payload (or pdfId as a file path).
+    // Results are served from and stored in the page cache; memory misses of
+    // documents with a store key are read from, or written to, the page store.
+    // Speculative renders (preloading) look the cache up without counting and
+    // only render documents that are already open.
+    RenderResult renderPage(const std::string& pdfId, int pageNumber, float scale,
+                            const std::string& base64Data, int quality = PDFJSI_QUALITY_DOCUMENT,
+                            bool speculative = false);
+
+    // Renders into caller-owned RGBA_8888 memory (e.g. a locked Android Bitmap)
+    bool renderPageInto(const std::string& pdfId, int pageNumber, void* pixels,
+                        int width, int height, int stride, std::string& error);
+
+    bool getPageSize(const std::string& pdfId, int pageNumber, PageSize& size, std::string& error);
+
+    // Sizes for many pages in one call; sizes[i] stays zero for pages that are
+    // out of range or fail to load. Fails only when pdfId is not open.
+    bool getPageSizes(const std::string& pdfId, const std::vector<int>& pageNumbers,
+                      std::vector<PageSize>& sizes, std::string& error);
+
+    // Geometry of every page, measuring only pages not yet known. Reopened
+    // cached files seed the table with setPageGeometry instead, so their
+    // layout needs no page loads at all.
+    bool getPageGeometry(const std::string& pdfId, std::vector<PageGeometry>& table, std::string& error);
+    bool setPageGeometry(const std::string& pdfId, const std::vector<PageGeometry>& table, std::string& error);
+
+    // Content checksum under which pages of pdfId persist across launches;
+    // an empty key stops storing them
+    bool setPageStoreKey(const std::string& pdfId, const std::string& key, std::string& error);
+
+    PDFDocumentRegistry& documents() { return m_registry; }
+
+    // Registered document for pdfId, registering it on first use like renderPage does
+    std::shared_ptr<PDFDocument> resolveDocument(const std::string& pdfId, const std::string& base64Data, std::string& error);
+    std::shared_ptr<PDFDocument> resolveDocument(const std::string& pdfId, const DocumentSource& source, std::string& error);
+
+    // Level used by PDFJSI_QUALITY_DOCUMENT renders of pdfId (normal by default)
+    bool setDocumentQuality(const std::string& pdfId, int quality);
+    int documentQuality(const std::string& pdfId);
+
+    // Marks a fling or zoom gesture on pdfId: document-level renders drop to
+    // draft until the gesture ends or kInteractionTimeoutMs after the last call
+    void setInteracting(const std::string& pdfId, bool active);
+    bool isInteracting(const std::string& pdfId);
+
+    // Caps every render (explicit levels included) at quality for durationMs;
+    // the memory governor's first step under pressure, before it evicts
+    void capQuality(int quality, int durationMs);
+    // Active cap, PDFJSI_QUALITY_HIGH when none
+    int qualityCap();
+
+    // Concrete level for a requested quality, within the active cap; preloads
+    // pass honourInteraction = false so pages cached ahead of the viewer are not draft
+    int resolveQuality(const std::string& pdfId, int quality, bool honourInteraction = true);
+
+    // Drops cached pages and quality state; the registry owns the document itself
+    void forgetDocument(const std::string& pdfId);
+    void forgetAll();
+
+    static constexpr int kInteractionTimeoutMs = 500;
+
+    // Draws page on white paper into caller-owned RGBA_8888 memory; the caller holds the Pdfium lock
+    static bool drawPage(const PdfiumApi* api, FPDF_PAGE page, void* pixels, int width, int height, int stride,
+                         int flags, std::string& error);
+
+private:
+    PDFRenderEngine(const PDFRenderEngine&) = delete;
+    PDFRenderEngine& operator=(const PDFRenderEngine&) = delete;
+
+    bool readPageGeometry(PDFDocument& document, int pageNumber, PageGeometry& geometry, std::string& error);
+    bool rasterize(PDFDocument& document, int pageNumber, float scale, int quality, PageBitmap& bitmap, std::string& error);
+    static void packRgb565(const uint8_t* rgba, size_t count, uint16_t* target);
+
+    PDFDocumentRegistry& m_registry;
+    PDFPageCache& m_cache;
+    PDFBitmapPool& m_pool;
+    PDFPageStore& m_store;
+    PDFHitIndex& m_hitIndex;
+    // Serializes first-use registration so concurrent renders (JSI thread and
+    // preload workers) add a single JSI-owned reference per pdfId
+    std::mutex m_resolveMutex;
+
+    struct QualityState {
+        int quality = PDFJSI_QUALITY_NORMAL;
+        std::chrono::steady_clock::time_point interactionDeadline;
+    };
+    std::map<std::string, QualityState> m_quality;
+    int m_qualityCap = PDFJSI_QUALITY_HIGH;
+    std::chrono::steady_clock::time_point m_qualityCapDeadline;
+    std::mutex m_qualityMutex;
+};
+
+#endif // PDF_RENDER_ENGINE_H
@@ -0,0 +1,682 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Per-document text index backing searchTextDirect
+ */
+
+#include "PDFTextIndex.h"
+#include "PDFJSILog.h"
+#include "PDFTrace.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <sys/stat.h>
+
+namespace {
+
+const char kIndexMagic[4] = {'P', 'J', 'T', 'X'};
+// 2: UTF-32 page text, pages appended as records until the end of the file
+const uint32_t kIndexVersion = 2;
+const char* const kIndexExtension = ".textindex";
+
+// Longer tokens (URLs, identifiers, noise) are indexed as windows of this
+// many characters starting every kMaxKeyLength, so any kMaxKeyLength-long
+// piece of them lies inside one window
+const size_t kMaxWordLength = 64;
+const size_t kMaxKeyLength = kMaxWordLength / 2;
+
+// Rough cost of a term -> pages entry beyond its characters (hash node and vector)
+const size_t kWordOverheadBytes = 64;
+
+bool isSpace(char32_t c) {
+    return (c >= 0x09 && c <= 0x0D) || c == 0x20 || c == 0xA0 ||
+           (c >= 0x2000 && c <= 0x200B) || c == 0x3000;
+}
+
+// Simple case folding for Latin, Greek and Cyrillic; whitespace becomes ' '.
+// Keeps one output unit per input unit so offsets map to Pdfium char indices.
+char32_t fold(char32_t c) {
+    if (isSpace(c)) return U' ';
+    if (c >= U'A' && c <= U'Z') return c + 32;
+    if (c < 0x80) return c;
+    if (c >= 0xC0 && c <= 0xDE && c != 0xD7) return c + 32;
+    if (c >= 0x391 && c <= 0x3A9 && c != 0x3A2) return c + 32;
+    if (c >= 0x410 && c <= 0x42F) return c + 32;
+    if (c >= 0x400 && c <= 0x40F) return c + 80;
+    return c;
+}
+
+bool isWordChar(char32_t c) {
+    if (c < 0x80) {
+        return (c >= U'a' && c <= U'z') || (c >= U'0' && c <= U'9');
+    }
+    // General punctuation block and spaces separate words; everything else
+    // outside ASCII (letters, CJK, ...) is treated as part of a word
+    return !isSpace(c) && !(c >= 0x2010 && c <= 0x206F);
+}
+
+// Scripts written without spaces between words: kana, Han (BMP and the
+// supplementary ideographic planes) and Hangul syllables
+bool isCJK(char32_t c) {
+    return (c >= 0x3040 && c <= 0x30FF) || (c >= 0x3400 && c <= 0x4DBF) ||
+           (c >= 0x4E00 && c <= 0x9FFF) || (c >= 0xAC00 && c <= 0xD7AF) ||
+           (c >= 0xF900 && c <= 0xFAFF) || (c >= 0x20000 && c <= 0x3FFFF);
+}
+
+// Calls token(start, length, cjk) for each run of word characters, splitting
+// runs where they switch between CJK and other scripts
+template <typename Token>
+void forEachToken(const std::u32string& text, Token&& token) {
+    size_t start = 0;
+    for (size_t i = 0; i <= text.size(); ++i) {
+        bool boundary = i == text.size() || !isWordChar(text[i]);
+        if (!boundary && i > start && isCJK(text[i]) == isCJK(text[start])) {
+            continue;
+        }
+        if (i > start) {
+            token(start, i - start, isCJK(text[start]));
+        }
+        start = boundary ? i + 1 : i;
+    }
+}
+
+// Folds the query and collapses runs of whitespace to match extracted text
+std::u32string foldQuery(const std::u16string& term) {
+    std::u32string query;
+    query.reserve(term.size());
+    for (size_t i = 0; i < term.size(); ++i) {
+        char32_t c = term[i];
+        if (c >= 0xD800 && c <= 0xDBFF && i + 1 < term.size() && term[i + 1] >= 0xDC00 && term[i + 1] <= 0xDFFF) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (term[++i] - 0xDC00);
+        }
+        char32_t folded = fold(c);
+        if (folded == U' ' && (query.empty() || query.back() == U' ')) {
+            continue;
+        }
+        query.push_back(folded);
+    }
+    while (!query.empty() && query.back() == U' ') {
+        query.pop_back();
+    }
+    return query;
+}
+
+// Piece of the query every match contains inside one indexed term: the first
+// bigram of a CJK token, or the first kMaxKeyLength characters of another,
+// taking the longest such piece over the query's tokens
+std::u32string lookupKey(const std::u32string& query) {
+    std::u32string key;
+    forEachToken(query, [&](size_t start, size_t length, bool cjk) {
+        length = std::min(length, cjk ? size_t(2) : kMaxKeyLength);
+        if (length > key.size()) {
+            key = query.substr(start, length);
+        }
+    });
+    return key;
+}
+
+// Length of the match of a folded query at text[start], or 0. A space in the
+// query matches any run of whitespace (line breaks come out of Pdfium as "\r\n").
+size_t matchAt(const std::u32string& text, size_t start, const std::u32string& query) {
+    size_t k = start;
+    for (size_t j = 0; j < query.size(); ++j) {
+        if (k >= text.size() || text[k] != query[j]) {
+            return 0;
+        }
+        ++k;
+        if (query[j] == U' ') {
+            while (k < text.size() && text[k] == U' ') {
+                ++k;
+            }
+        }
+    }
+    return k - start;
+}
+
+uint64_t fnv1a(const std::string& value) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : value) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool statFile(const std::string& path, uint64_t& size, int64_t& modified) {
+    struct stat info;
+    if (path.empty() || stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+    size = static_cast<uint64_t>(info.st_size);
+    modified = static_cast<int64_t>(info.st_mtime);
+    return true;
+}
+
+template <typename T>
+bool readValue(FILE* file, T& value) {
+    return fread(&value, sizeof(T), 1, file) == 1;
+}
+
+template <typename T>
+bool writeValue(FILE* file, const T& value) {
+    return fwrite(&value, sizeof(T), 1, file) == 1;
+}
+
+} // namespace
+
+void PDFTextIndex::setStorageDirectory(const std::string& directory) {
+    char resolved[PATH_MAX];
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_storageDirectory = realpath(directory.c_str(), resolved) ? std::string(resolved) : directory;
+    while (m_storageDirectory.size() > 1 && m_storageDirectory.back() == '/') {
+        m_storageDirectory.pop_back();
+    }
+    LOGI("Text index storage: %s", m_storageDirectory.c_str());
+}
+
+bool PDFTextIndex::search(const std::shared_ptr<PDFDocument>& document, const std::u16string& term,
+                          int startPage, int endPage, std::vector<TextSearchHit>& hits, std::string& error) {
+    PDFJSI_TRACE_SCOPE(kSearch);
+    if (!document) {
+        error = "Document not open";
+        return false;
+    }
+    std::u32string query = foldQuery(term);
+    if (query.empty()) {
+        error = "Search term is empty";
+        return false;
+    }
+
+    // endPage <= 0 searches to the end of the document
+    startPage = std::max(1, startPage);
+    endPage = endPage <= 0 ? document->pageCount : std::min(endPage, document->pageCount);
+    if (startPage > endPage) {
+        error = "Invalid page range";
+        return false;
+    }
+
+    std::shared_ptr<DocumentIndex> index = indexFor(*document);
+    std::lock_guard<std::mutex> lock(index->mutex);
+
+    int extractedNow = 0;
+    for (int page = startPage; page <= endPage; ++page) {
+        if (index->pages[page - 1].extracted) {
+            continue;
+        }
+        if (!extractPage(*document, *index, page, error)) {
+            return false;
+        }
+        addWords(*index, page);
+        ++extractedNow;
+    }
+    if (extractedNow > 0) {
+        LOGI("Text index for %s: extracted %d page(s), %d/%zu indexed",
+             document->pdfId.c_str(), extractedNow, index->extractedPages, index->pages.size());
+        if (!index->indexPath.empty() && !save(*index)) {
+            LOGW("Could not persist text index to %s", index->indexPath.c_str());
+        }
+        std::lock_guard<std::mutex> indexesLock(m_mutex);
+        trimLocked(m_budgetBytes, index.get());
+    }
+
+    // Candidate pages from the inverted index, then exact verification
+    std::vector<int> candidates;
+    std::u32string key = lookupKey(query);
+    if (key.empty()) {
+        for (int page = startPage; page <= endPage; ++page) {
+            candidates.push_back(page);
+        }
+    } else {
+        candidatePages(*index, key, startPage, endPage, candidates);
+    }
+
+    // Candidate starts come from the query's first space-free segment
+    std::u32string head = query.substr(0, query.find(U' '));
+    size_t first = hits.size();
+    for (int page : candidates) {
+        const std::u32string& text = index->pages[page - 1].text;
+        size_t position = text.find(head);
+        while (position != std::u32string::npos && hits.size() < kMaxHits) {
+            size_t length = matchAt(text, position, query);
+            if (length == 0) {
+                position = text.find(head, position + 1);
+                continue;
+            }
+            TextSearchHit hit;
+            hit.pageNumber = page;
+            hit.offset = static_cast<int>(position);
+            hit.length = static_cast<int>(length);
+            hits.push_back(hit);
+            position = text.find(head, position + length);
+        }
+        if (hits.size() >= kMaxHits) {
+            LOGW("Search for %s truncated at %zu hits", document->pdfId.c_str(), kMaxHits);
+            break;
+        }
+    }
+
+    locateHits(*document, hits, first);
+    return true;
+}
+
+int PDFTextIndex::indexedPageCount(const std::string& pdfId) {
+    std::shared_ptr<DocumentIndex> index;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_indexes.find(pdfId);
+        if (it == m_indexes.end()) {
+            return 0;
+        }
+        index = it->second;
+    }
+    std::lock_guard<std::mutex> lock(index->mutex);
+    return index->extractedPages;
+}
+
+void PDFTextIndex::forget(const std::string& pdfId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_indexes.erase(pdfId);
+}
+
+void PDFTextIndex::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_indexes.clear();
+}
+
+size_t PDFTextIndex::memoryBytes() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t total = 0;
+    for (const auto& entry : m_indexes) {
+        total += entry.second->bytes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void PDFTextIndex::setBudget(size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budgetBytes = budgetBytes;
+    trimLocked(m_budgetBytes, nullptr);
+}
+
+size_t PDFTextIndex::budget() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budgetBytes;
+}
+
+size_t PDFTextIndex::trimTo(size_t targetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return trimLocked(targetBytes, nullptr);
+}
+
+size_t PDFTextIndex::trimLocked(size_t targetBytes, const DocumentIndex* keep) {
+    size_t total = 0;
+    std::vector<std::pair<uint64_t, std::string>> order;
+    for (const auto& entry : m_indexes) {
+        total += entry.second->bytes.load(std::memory_order_relaxed);
+        if (entry.second.get() != keep) {
+            order.emplace_back(entry.second->lastUsed, entry.first);
+        }
+    }
+    std::sort(order.begin(), order.end());
+
+    // A search still holding a forgotten index keeps it alive until it returns
+    size_t released = 0;
+    for (const auto& candidate : order) {
+        if (total - released <= targetBytes) {
+            break;
+        }
+        auto it = m_indexes.find(candidate.second);
+        size_t bytes = it->second->bytes.load(std::memory_order_relaxed);
+        LOGI("Text index for %s forgotten (%zu KB)", candidate.second.c_str(), bytes / 1024);
+        released += bytes;
+        m_indexes.erase(it);
+    }
+    return released;
+}
+
+std::shared_ptr<PDFTextIndex::DocumentIndex> PDFTextIndex::indexFor(const PDFDocument& document) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_indexes.find(document.pdfId);
+    if (it != m_indexes.end() && it->second->pages.size() == static_cast<size_t>(document.pageCount)) {
+        it->second->lastUsed = ++m_useClock;
+        return it->second;
+    }
+
+    auto index = std::make_shared<DocumentIndex>();
+    index->lastUsed = ++m_useClock;
+    index->pages.resize(document.pageCount);
+    if (statFile(document.path, index->sourceSize, index->sourceModified)) {
+        index->indexPath = indexPathFor(document.path);
+    }
+    if (!index->indexPath.empty() && load(*index)) {
+        LOGI("Text index for %s loaded: %d/%d pages", document.pdfId.c_str(), index->extractedPages, document.pageCount);
+    }
+    m_indexes[document.pdfId] = index;
+    return index;
+}
+
+std::string PDFTextIndex::indexPathFor(const std::string& documentPath) {
+    if (m_storageDirectory.empty()) {
+        return std::string();
+    }
+    size_t slash = documentPath.rfind('/');
+    if (slash != std::string::npos && documentPath.compare(0, slash, m_storageDirectory) == 0 &&
+        slash == m_storageDirectory.size()) {
+        return documentPath + kIndexExtension;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "/text_%016llx", static_cast<unsigned long long>(fnv1a(documentPath)));
+    return m_storageDirectory + name + kIndexExtension;
+}
+
+bool PDFTextIndex::extractPage(const PDFDocument& document, DocumentIndex& index, int pageNumber, std::string& error) {
+    const PdfiumApi* api = PdfiumApi::get();
+    std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+    if (!document.handle) {
+        error = "Document is closed";
+        return false;
+    }
+    FPDF_PAGE page = api->loadPage(document.handle, pageNumber - 1);
+    if (!page) {
+        error = PdfiumApi::describeError(api->getLastError());
+        return false;
+    }
+
+    PageText& pageText = index.pages[pageNumber - 1];
+    pageText.text.clear();
+    // Pages without a text layer (scans) are indexed as empty
+    FPDF_TEXTPAGE textPage = api->textLoadPage(page);
+    if (textPage) {
+        int count = std::max(0, api->textCountChars(textPage));
+        pageText.text.resize(count);
+        for (int i = 0; i < count; ++i) {
+            pageText.text[i] = fold(static_cast<char32_t>(api->textGetUnicode(textPage, i)));
+        }
+        api->textClosePage(textPage);
+    }
+    api->closePage(page);
+
+    pageText.extracted = true;
+    ++index.extractedPages;
+    index.unsavedPages.push_back(pageNumber);
+    index.bytes += pageText.text.size() * sizeof(char32_t);
+    return true;
+}
+
+void PDFTextIndex::addWords(DocumentIndex& index, int pageNumber) {
+    const std::u32string& text = index.pages[pageNumber - 1].text;
+    forEachToken(text, [&](size_t start, size_t length, bool cjk) {
+        if (cjk) {
+            // Unspaced runs have no word boundaries to index; every query
+            // bigram (or single character, via suffixes) is found in these
+            if (length == 1) {
+                addTerm(index, text.substr(start, 1), pageNumber);
+            }
+            for (size_t i = start; i + 1 < start + length; ++i) {
+                addTerm(index, text.substr(i, 2), pageNumber);
+            }
+        } else if (length <= kMaxWordLength) {
+            addTerm(index, text.substr(start, length), pageNumber);
+        } else {
+            size_t offset = 0;
+            for (; offset + kMaxWordLength < length; offset += kMaxKeyLength) {
+                addTerm(index, text.substr(start + offset, kMaxWordLength), pageNumber);
+            }
+            addTerm(index, text.substr(start + length - kMaxWordLength, kMaxWordLength), pageNumber);
+        }
+    });
+}
+
+void PDFTextIndex::addTerm(DocumentIndex& index, std::u32string term, int pageNumber) {
+    size_t length = term.size();
+    auto inserted = index.words.emplace(std::move(term), std::vector<int>());
+    std::vector<int>& pages = inserted.first->second;
+    if (inserted.second) {
+        uint32_t id = static_cast<uint32_t>(index.terms.size());
+        index.terms.push_back(&*inserted.first);
+        for (uint32_t offset = 0; offset < length; ++offset) {
+            index.pendingSuffixes.push_back(TermSuffix{id, offset});
+        }
+        index.bytes += length * (sizeof(char32_t) + sizeof(TermSuffix)) + kWordOverheadBytes;
+    }
+    // Terms of one page are added together, so a repeat is always at the back
+    if (pages.empty() || pages.back() != pageNumber) {
+        pages.push_back(pageNumber);
+        index.bytes += sizeof(int);
+    }
+}
+
+void PDFTextIndex::candidatePages(DocumentIndex& index, const std::u32string& key, int startPage, int endPage,
+                                  std::vector<int>& pages) {
+    auto suffixOf = [&index](const TermSuffix& suffix) {
+        return std::u32string_view(index.terms[suffix.term]->first).substr(suffix.offset);
+    };
+    auto before = [&suffixOf](const TermSuffix& a, const TermSuffix& b) {
+        return suffixOf(a) < suffixOf(b);
+    };
+    if (!index.pendingSuffixes.empty()) {
+        std::sort(index.pendingSuffixes.begin(), index.pendingSuffixes.end(), before);
+        size_t middle = index.suffixes.size();
+        index.suffixes.insert(index.suffixes.end(), index.pendingSuffixes.begin(), index.pendingSuffixes.end());
+        std::inplace_merge(index.suffixes.begin(), index.suffixes.begin() + middle, index.suffixes.end(), before);
+        index.pendingSuffixes.clear();
+        index.pendingSuffixes.shrink_to_fit();
+    }
+
+    // Suffixes starting with key are contiguous; each belongs to a term containing it
+    std::u32string_view prefix(key);
+    auto it = std::lower_bound(index.suffixes.begin(), index.suffixes.end(), prefix,
+                               [&suffixOf](const TermSuffix& suffix, std::u32string_view value) {
+                                   return suffixOf(suffix) < value;
+                               });
+    for (; it != index.suffixes.end() && suffixOf(*it).substr(0, prefix.size()) == prefix; ++it) {
+        for (int page : index.terms[it->term]->second) {
+            if (page >= startPage && page <= endPage) {
+                pages.push_back(page);
+            }
+        }
+    }
+    std::sort(pages.begin(), pages.end());
+    pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+}
+
+void PDFTextIndex::locateHits(const PDFDocument& document, std::vector<TextSearchHit>& hits, size_t first) {
+    if (first >= hits.size()) {
+        return;
+    }
+
+    // Hits are grouped by page, so each page is loaded once; pages already
+    // tapped or shown have their glyph boxes in the hit index
+    std::vector<std::pair<size_t, size_t>> unboxed;
+    size_t i = first;
+    while (i < hits.size()) {
+        int pageNumber = hits[i].pageNumber;
+        size_t pageEnd = i;
+        while (pageEnd < hits.size() && hits[pageEnd].pageNumber == pageNumber) {
+            ++pageEnd;
+        }
+        std::shared_ptr<const PageHitGeometry> geometry =
+            m_hitIndex ? m_hitIndex->cachedGeometry(document, pageNumber) : nullptr;
+        if (!geometry) {
+            unboxed.emplace_back(i, pageEnd);
+            i = pageEnd;
+            continue;
+        }
+        for (; i < pageEnd; ++i) {
+            TextSearchHit& hit = hits[i];
+            HitRect box;
+            if (geometry->rangeBox(hit.offset, hit.length, box)) {
+                hit.left = box.left;
+                hit.right = box.right;
+                hit.bottom = box.bottom;
+                hit.top = box.top;
+            }
+        }
+    }
+    if (unboxed.empty()) {
+        return;
+    }
+
+    const PdfiumApi* api = PdfiumApi::get();
+    std::lock_guard<std::mutex> pdfiumLock(PdfiumApi::mutex());
+    if (!document.handle) {
+        return;
+    }
+    for (const auto& range : unboxed) {
+        i = range.first;
+        size_t pageEnd = range.second;
+        int pageNumber = hits[i].pageNumber;
+
+        FPDF_PAGE page = api->loadPage(document.handle, pageNumber - 1);
+        FPDF_TEXTPAGE textPage = page ? api->textLoadPage(page) : nullptr;
+        if (textPage) {
+            for (; i < pageEnd; ++i) {
+                TextSearchHit& hit = hits[i];
+                bool any = false;
+                for (int c = hit.offset; c < hit.offset + hit.length; ++c) {
+                    double left, right, bottom, top;
+                    if (!api->textGetCharBox(textPage, c, &left, &right, &bottom, &top)) {
+                        continue;
+                    }
+                    if (!any) {
+                        hit.left = left;
+                        hit.right = right;
+                        hit.bottom = bottom;
+                        hit.top = top;
+                        any = true;
+                    } else {
+                        hit.left = std::min(hit.left, left);
+                        hit.right = std::max(hit.right, right);
+                        hit.bottom = std::min(hit.bottom, bottom);
+                        hit.top = std::max(hit.top, top);
+                    }
+                }
+            }
+            api->textClosePage(textPage);
+        }
+        if (page) {
+            api->closePage(page);
+        }
+        i = pageEnd;
+    }
+}
+
+bool PDFTextIndex::load(DocumentIndex& index) {
+    FILE* file = fopen(index.indexPath.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    uint64_t sourceSize = 0;
+    int64_t sourceModified = 0;
+    uint32_t pageCount = 0;
+    bool ok = fread(magic, sizeof(magic), 1, file) == 1 && std::equal(magic, magic + 4, kIndexMagic) &&
+              readValue(file, version) && version == kIndexVersion &&
+              readValue(file, sourceSize) && sourceSize == index.sourceSize &&
+              readValue(file, sourceModified) && sourceModified == index.sourceModified &&
+              readValue(file, pageCount) && pageCount == index.pages.size();
+
+    // Page records follow until the end of the file; a torn last record (an
+    // append cut short) keeps the pages before it and rewrites the file on save
+    bool torn = false;
+    while (ok) {
+        uint32_t pageNumber = 0;
+        if (!readValue(file, pageNumber)) {
+            break;
+        }
+        uint32_t length = 0;
+        std::u32string text;
+        if (pageNumber < 1 || pageNumber > pageCount || !readValue(file, length) ||
+            length > static_cast<uint32_t>(INT_MAX)) {
+            torn = true;
+            break;
+        }
+        text.resize(length);
+        if (length > 0 && fread(&text[0], sizeof(char32_t), length, file) != length) {
+            torn = true;
+            break;
+        }
+        PageText& pageText = index.pages[pageNumber - 1];
+        if (!pageText.extracted) {
+            pageText.text.swap(text);
+            pageText.extracted = true;
+            ++index.extractedPages;
+            index.bytes += length * sizeof(char32_t);
+            addWords(index, pageNumber);
+        }
+    }
+    fclose(file);
+
+    if (!ok) {
+        // Stale or another version: start over and let the next save replace it
+        LOGW("Discarding text index %s", index.indexPath.c_str());
+        return false;
+    }
+    if (torn) {
+        LOGW("Text index %s is torn; kept %d page(s)", index.indexPath.c_str(), index.extractedPages);
+    }
+    index.rewrite = torn;
+    return true;
+}
+
+bool PDFTextIndex::save(DocumentIndex& index) {
+    if (index.unsavedPages.empty() && !index.rewrite) {
+        return true;
+    }
+    auto writePage = [&index](FILE* file, int pageNumber) {
+        const std::u32string& text = index.pages[pageNumber - 1].text;
+        uint32_t number = static_cast<uint32_t>(pageNumber);
+        uint32_t length = static_cast<uint32_t>(text.size());
+        return writeValue(file, number) && writeValue(file, length) &&
+               (length == 0 || fwrite(text.data(), sizeof(char32_t), length, file) == length);
+    };
+
+    // Only pages extracted since the last save are appended
+    if (!index.rewrite) {
+        FILE* file = fopen(index.indexPath.c_str(), "ab");
+        bool ok = file != nullptr;
+        for (size_t i = 0; ok && i < index.unsavedPages.size(); ++i) {
+            ok = writePage(file, index.unsavedPages[i]);
+        }
+        if (file) {
+            ok = fclose(file) == 0 && ok;
+        }
+        if (ok) {
+            index.unsavedPages.clear();
+            return true;
+        }
+        // A torn append is dropped by load; replace the file instead
+        index.rewrite = true;
+    }
+
+    std::string temporaryPath = index.indexPath + ".tmp";
+    FILE* file = fopen(temporaryPath.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    uint32_t pageCount = static_cast<uint32_t>(index.pages.size());
+    bool ok = fwrite(kIndexMagic, sizeof(kIndexMagic), 1, file) == 1 &&
+              writeValue(file, kIndexVersion) &&
+              writeValue(file, index.sourceSize) &&
+              writeValue(file, index.sourceModified) &&
+              writeValue(file, pageCount);
+    for (uint32_t i = 0; ok && i < pageCount; ++i) {
+        if (index.pages[i].extracted) {
+            ok = writePage(file, static_cast<int>(i) + 1);
+        }
+    }
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(temporaryPath.c_str(), index.indexPath.c_str()) != 0) {
+        remove(temporaryPath.c_str());
+        return false;
+    }
+    index.unsavedPages.clear();
+    index.rewrite = false;
+    return true;
+}
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Per-document text index backing searchTextDirect
+ * Page text is extracted once, kept case-folded in memory with a term -> pages
+ * inverted index, and persisted so later sessions skip extraction entirely.
+ * Terms are words, overlapping bigrams of unspaced CJK runs and overlapping
+ * windows of very long tokens; a sorted array of their suffixes finds every
+ * term containing a query word in O(log n).
+ */
+
+#ifndef PDF_TEXT_INDEX_H
+#define PDF_TEXT_INDEX_H
+
+#include "PDFDocumentRegistry.h"
+#include "PDFHitIndex.h"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One match; the box is in PDF page coordinates (points, origin bottom-left)
+struct TextSearchHit {
+    int pageNumber = 0;
+    int offset = 0;
+    int length = 0;
+    double left = 0.0;
+    double top = 0.0;
+    double right = 0.0;
+    double bottom = 0.0;
+};
+
+class PDFTextIndex {
+public:
+    // Hits beyond this are dropped; callers narrow the page range instead
+    static const size_t kMaxHits = 1000;
+    static constexpr size_t kDefaultBudgetBytes = 8 * 1024 * 1024;
+
+    PDFTextIndex() = default;
+    // Hits on pages already in hitIndex are boxed from its glyphs, not Pdfium
+    explicit PDFTextIndex(PDFHitIndex& hitIndex) : m_hitIndex(&hitIndex) {}
+
+    // Directory holding PDFNativeCacheManager's cached PDFs. Indexes of cached
+    // PDFs are written next to them as "<file>.textindex"; other files get a
+    // hashed index file in the same directory.
+    void setStorageDirectory(const std::string& directory);
+
+    // Case-insensitive substring search over pages [startPage, endPage].
+    // Pages are extracted on first search and reused afterwards.
+    bool search(const std::shared_ptr<PDFDocument>& document, const std::u16string& term,
+                int startPage, int endPage, std::vector<TextSearchHit>& hits, std::string& error);
+
+    // Number of pages with extracted text (0 if the document has no index yet)
+    int indexedPageCount(const std::string& pdfId);
+
+    // Drops in-memory indexes; persisted files are kept for the next open
+    void forget(const std::string& pdfId);
+    void clear();
+
+    // Approximate memory held by the in-memory indexes. Past the budget, the
+    // least recently searched are forgotten after each search that grows one.
+    size_t memoryBytes();
+    void setBudget(size_t budgetBytes);
+    size_t budget();
+    // Forgets least recently searched indexes until at most targetBytes remain;
+    // returns the bytes released
+    size_t trimTo(size_t targetBytes);
+
+private:
+    PDFTextIndex(const PDFTextIndex&) = delete;
+    PDFTextIndex& operator=(const PDFTextIndex&) = delete;
+
+    struct PageText {
+        bool extracted = false;
+        // One code point per Pdfium char index, so offsets stay char indices
+        std::u32string text;
+    };
+
+    typedef std::unordered_map<std::u32string, std::vector<int>> TermMap;
+
+    // Suffix of a term: terms[term]->first.substr(offset)
+    struct TermSuffix {
+        uint32_t term = 0;
+        uint32_t offset = 0;
+    };
+
+    struct DocumentIndex {
+        std::string indexPath;
+        uint64_t sourceSize = 0;
+        int64_t sourceModified = 0;
+        std::vector<PageText> pages;
+        // Folded term -> numbers of the pages containing it
+        TermMap words;
+        // Term ids in insertion order (map nodes are stable across rehashes)
+        std::vector<TermMap::value_type*> terms;
+        // Sorted by suffix text; suffixes of new terms wait in pendingSuffixes
+        // until the next lookup merges them
+        std::vector<TermSuffix> suffixes;
+        std::vector<TermSuffix> pendingSuffixes;
+        // Pages extracted since the last save; appended to the index file
+        // unless the file has to be rewritten (missing, stale or torn)
+        std::vector<int> unsavedPages;
+        bool rewrite = true;
+        int extractedPages = 0;
+        // Approximate text and word bytes, read without the mutex by trims
+        std::atomic<size_t> bytes{0};
+        uint64_t lastUsed = 0;
+        std::mutex mutex;
+    };
+
+    std::shared_ptr<DocumentIndex> indexFor(const PDFDocument& document);
+    std::string indexPathFor(const std::string& documentPath);
+    static bool extractPage(const PDFDocument& document, DocumentIndex& index, int pageNumber, std::string& error);
+    static void addWords(DocumentIndex& index, int pageNumber);
+    static void addTerm(DocumentIndex& index, std::u32string term, int pageNumber);
+    static void candidatePages(DocumentIndex& index, const std::u32string& key, int startPage, int endPage,
+                               std::vector<int>& pages);
+    void locateHits(const PDFDocument& document, std::vector<TextSearchHit>& hits, size_t first);
+    static bool load(DocumentIndex& index);
+    static bool save(DocumentIndex& index);
+    size_t trimLocked(size_t targetBytes, const DocumentIndex* keep);
+
+    std::map<std::string, std::shared_ptr<DocumentIndex>> m_indexes;
+    std::string m_storageDirectory;
+    size_t m_budgetBytes = kDefaultBudgetBytes;
+    uint64_t m_useClock = 0;
+    std::mutex m_mutex;
+    PDFHitIndex* m_hitIndex = nullptr;
+};
+
+#endif // PDF_TEXT_INDEX_H
@@ -0,0 +1,272 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Low-overhead tracing of the native render, open, search and decode paths
+ */
+
+#include "PDFTrace.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#if defined(__ANDROID__)
+#include <dlfcn.h>
+#endif
+
+namespace PDFTrace {
+
+namespace {
+
+const char* const kMetricNames[kMetricCount] = {
+    "render",
+    "rasterize",
+    "bitmapRender",
+    "preload",
+    "openDocument",
+    "search",
+    "base64Decode",
+    "pageStoreRead",
+    "hitIndexBuild",
+    "hitTest",
+};
+
+// Threads beyond this share one overflow record
+const int kMaxThreadRecords = 64;
+
+struct Span {
+    std::atomic<uint32_t> metric{0};
+    std::atomic<uint64_t> endNs{0};
+    std::atomic<uint64_t> durationNs{0};
+};
+
+// Written by its thread only (or by every late thread for the overflow
+// record), so relaxed atomics are enough; they keep concurrent summaries free
+// of data races without ordering the writer's stores
+struct ThreadRecord {
+    std::atomic<uint64_t> buckets[kMetricCount][kBucketCount];
+    std::atomic<uint64_t> totalNs[kMetricCount];
+    std::atomic<uint64_t> maxNs[kMetricCount];
+    Span ring[kRingSize];
+    std::atomic<uint64_t> ringHead{0};
+
+    ThreadRecord() {
+        for (int metric = 0; metric < kMetricCount; ++metric) {
+            for (int bucket = 0; bucket < kBucketCount; ++bucket) {
+                buckets[metric][bucket].store(0, std::memory_order_relaxed);
+            }
+            totalNs[metric].store(0, std::memory_order_relaxed);
+            maxNs[metric].store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+std::atomic<ThreadRecord*> g_records[kMaxThreadRecords];
+std::atomic<int> g_recordCount{0};
+ThreadRecord g_overflow;
+thread_local ThreadRecord* t_record = nullptr;
+
+ThreadRecord& threadRecord() {
+    if (t_record) {
+        return *t_record;
+    }
+    int slot = g_recordCount.fetch_add(1, std::memory_order_relaxed);
+    if (slot < kMaxThreadRecords) {
+        // Records stay alive for the process so summaries never race a thread exit
+        t_record = new ThreadRecord();
+        g_records[slot].store(t_record, std::memory_order_release);
+    } else {
+        t_record = &g_overflow;
+    }
+    return *t_record;
+}
+
+template <typename Visitor>
+void forEachRecord(Visitor&& visit) {
+    int count = g_recordCount.load(std::memory_order_relaxed);
+    for (int slot = 0; slot < count && slot < kMaxThreadRecords; ++slot) {
+        // A slot is claimed before it is published; skip it until then
+        ThreadRecord* record = g_records[slot].load(std::memory_order_acquire);
+        if (record) {
+            visit(*record);
+        }
+    }
+    visit(g_overflow);
+}
+
+int bucketFor(uint64_t micros) {
+    if (micros < 4) {
+        return static_cast<int>(micros);
+    }
+    int exponent = 63 - __builtin_clzll(micros);
+    int sub = static_cast<int>((micros >> (exponent - 2)) & 3);
+    int bucket = (exponent - 1) * 4 + sub;
+    return bucket < kBucketCount ? bucket : kBucketCount - 1;
+}
+
+// Midpoint of a bucket's range, in milliseconds
+double bucketMidpointMs(int bucket) {
+    if (bucket < 4) {
+        return (bucket + 0.5) / 1000.0;
+    }
+    int exponent = bucket / 4 + 1;
+    uint64_t low = static_cast<uint64_t>(4 + bucket % 4) << (exponent - 2);
+    uint64_t width = 1ULL << (exponent - 2);
+    return (low + width / 2.0) / 1000.0;
+}
+
+#if defined(__ANDROID__)
+// ATrace_* are API 23; resolved at runtime so minSdk 21 devices just skip sections
+struct ATraceApi {
+    bool (*isEnabled)() = nullptr;
+    void (*beginSection)(const char*) = nullptr;
+    void (*endSection)() = nullptr;
+};
+
+const ATraceApi& atrace() {
+    static ATraceApi api;
+    static std::once_flag loadOnce;
+    std::call_once(loadOnce, [] {
+        void* library = dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+        if (!library) {
+            return;
+        }
+        api.isEnabled = reinterpret_cast<bool (*)()>(dlsym(library, "ATrace_isEnabled"));
+        api.beginSection = reinterpret_cast<void (*)(const char*)>(dlsym(library, "ATrace_beginSection"));
+        api.endSection = reinterpret_cast<void (*)()>(dlsym(library, "ATrace_endSection"));
+        if (!api.isEnabled || !api.beginSection || !api.endSection) {
+            api = ATraceApi();
+        }
+    });
+    return api;
+}
+#endif
+
+} // namespace
+
+const char* metricName(Metric metric) {
+    return metric >= 0 && metric < kMetricCount ? kMetricNames[metric] : "unknown";
+}
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void record(Metric metric, uint64_t startNs, uint64_t durationNs) {
+    if (metric < 0 || metric >= kMetricCount) {
+        return;
+    }
+    ThreadRecord& record = threadRecord();
+    record.buckets[metric][bucketFor(durationNs / 1000)].fetch_add(1, std::memory_order_relaxed);
+    record.totalNs[metric].fetch_add(durationNs, std::memory_order_relaxed);
+    uint64_t max = record.maxNs[metric].load(std::memory_order_relaxed);
+    while (durationNs > max &&
+           !record.maxNs[metric].compare_exchange_weak(max, durationNs, std::memory_order_relaxed)) {
+    }
+
+    uint64_t head = record.ringHead.fetch_add(1, std::memory_order_relaxed);
+    Span& span = record.ring[head % kRingSize];
+    span.metric.store(static_cast<uint32_t>(metric), std::memory_order_relaxed);
+    span.durationNs.store(durationNs, std::memory_order_relaxed);
+    span.endNs.store(startNs + durationNs, std::memory_order_relaxed);
+}
+
+Summary summarize(Metric metric) {
+    Summary summary;
+    if (metric < 0 || metric >= kMetricCount) {
+        return summary;
+    }
+
+    uint64_t buckets[kBucketCount] = {};
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+    uint64_t lastEndNs = 0;
+    uint64_t lastDurationNs = 0;
+    forEachRecord([&](ThreadRecord& record) {
+        for (int bucket = 0; bucket < kBucketCount; ++bucket) {
+            buckets[bucket] += record.buckets[metric][bucket].load(std::memory_order_relaxed);
+        }
+        totalNs += record.totalNs[metric].load(std::memory_order_relaxed);
+        uint64_t recordMax = record.maxNs[metric].load(std::memory_order_relaxed);
+        if (recordMax > maxNs) {
+            maxNs = recordMax;
+        }
+        // A span being overwritten may mix fields of two spans; that only
+        // skews which recent span counts as the last one
+        for (size_t i = 0; i < kRingSize; ++i) {
+            const Span& span = record.ring[i];
+            if (span.metric.load(std::memory_order_relaxed) != static_cast<uint32_t>(metric)) {
+                continue;
+            }
+            uint64_t endNs = span.endNs.load(std::memory_order_relaxed);
+            if (endNs > lastEndNs) {
+                lastEndNs = endNs;
+                lastDurationNs = span.durationNs.load(std::memory_order_relaxed);
+            }
+        }
+    });
+
+    for (int bucket = 0; bucket < kBucketCount; ++bucket) {
+        summary.count += buckets[bucket];
+    }
+    if (summary.count == 0) {
+        return summary;
+    }
+
+    summary.totalMs = totalNs / 1e6;
+    summary.meanMs = summary.totalMs / summary.count;
+    summary.maxMs = maxNs / 1e6;
+    summary.lastMs = lastDurationNs / 1e6;
+
+    const double quantiles[] = { 0.50, 0.90, 0.99 };
+    double* targets[] = { &summary.p50Ms, &summary.p90Ms, &summary.p99Ms };
+    uint64_t seen = 0;
+    int next = 0;
+    for (int bucket = 0; bucket < kBucketCount && next < 3; ++bucket) {
+        seen += buckets[bucket];
+        while (next < 3 && seen >= quantiles[next] * summary.count) {
+            *targets[next] = bucketMidpointMs(bucket);
+            ++next;
+        }
+    }
+    return summary;
+}
+
+void reset() {
+    forEachRecord([](ThreadRecord& record) {
+        for (int metric = 0; metric < kMetricCount; ++metric) {
+            for (int bucket = 0; bucket < kBucketCount; ++bucket) {
+                record.buckets[metric][bucket].store(0, std::memory_order_relaxed);
+            }
+            record.totalNs[metric].store(0, std::memory_order_relaxed);
+            record.maxNs[metric].store(0, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < kRingSize; ++i) {
+            record.ring[i].endNs.store(0, std::memory_order_relaxed);
+            record.ring[i].durationNs.store(0, std::memory_order_relaxed);
+        }
+    });
+}
+
+Scope::Scope(Metric metric) : m_metric(metric), m_startNs(nowNs()), m_section(false) {
+#if defined(__ANDROID__)
+    const ATraceApi& api = atrace();
+    if (api.isEnabled && api.isEnabled()) {
+        api.beginSection(metricName(metric));
+        m_section = true;
+    }
+#endif
+}
+
+Scope::~Scope() {
+#if defined(__ANDROID__)
+    if (m_section) {
+        atrace().endSection();
+    }
+#endif
+    record(m_metric, m_startNs, nowNs() - m_startNs);
+}
+
+} // namespace PDFTrace
@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Low-overhead tracing of the native render, open, search and decode paths
+ * A PDFJSI_TRACE_SCOPE emits an ATrace section (visible in Perfetto and
+ * systrace while tracing is enabled) and records its duration into the
+ * calling thread's histogram and ring buffer of recent spans. Writers only
+ * touch their own thread's record; summaries add the records up without
+ * locking. Build with -DPDFJSI_TRACING=0 to compile every scope out.
+ */
+
+#ifndef PDF_TRACE_H
+#define PDF_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef PDFJSI_TRACING
+#define PDFJSI_TRACING 1
+#endif
+
+namespace PDFTrace {
+
+enum Metric {
+    kRender = 0,        // PDFRenderEngine::renderPage, cache hits included
+    kRasterize,         // Pdfium draw of one page
+    kBitmapRender,      // renderPageToBitmap into a Java Bitmap
+    kPreload,           // One preloaded page on a worker
+    kOpenDocument,      // Registry open of a new document
+    kSearch,            // searchTextDirect over a page range
+    kBase64Decode,      // Base64 payload to document bytes
+    kPageStoreRead,     // Stored page decoded from disk
+    kHitIndexBuild,     // Glyph, word and link boxes of one page
+    kHitTest,           // Point or selection lookup in a page's hit index
+    kMetricCount
+};
+
+// Durations are bucketed in microseconds, four buckets per power of two
+static const int kBucketCount = 128;
+// Recent spans kept per thread for lastMs
+static const size_t kRingSize = 64;
+
+struct Summary {
+    uint64_t count = 0;
+    double totalMs = 0.0;
+    double meanMs = 0.0;
+    double p50Ms = 0.0;
+    double p90Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    double lastMs = 0.0;
+};
+
+const char* metricName(Metric metric);
+
+uint64_t nowNs();
+void record(Metric metric, uint64_t startNs, uint64_t durationNs);
+
+// Histogram of every thread for one metric; percentiles are bucket midpoints
+Summary summarize(Metric metric);
+void reset();
+
+class Scope {
+public:
+    explicit Scope(Metric metric);
+    ~Scope();
+
+private:
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    Metric m_metric;
+    uint64_t m_startNs;
+    bool m_section;
+};
+
+} // namespace PDFTrace
+
+#define PDFJSI_TRACE_CONCAT_INNER(a, b) a##b
+#define PDFJSI_TRACE_CONCAT(a, b) PDFJSI_TRACE_CONCAT_INNER(a, b)
+
+#if PDFJSI_TRACING
+#define PDFJSI_TRACE_SCOPE(metric) PDFTrace::Scope PDFJSI_TRACE_CONCAT(pdfTraceScope, __LINE__)(PDFTrace::metric)
+#else
+#define PDFJSI_TRACE_SCOPE(metric) do {} while (0)
+#endif
+
+#endif // PDF_TRACE_H
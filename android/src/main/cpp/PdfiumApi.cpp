@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Resolves the Pdfium C API at runtime from the library bundled with the app
+ */
+
+#include "PdfiumApi.h"
+#include "PDFJSILog.h"
+#include <dlfcn.h>
+#include <initializer_list>
+
+namespace {
+
+// Library names used by the Pdfium distributions we support, in preference order
+const char* const kPdfiumLibraries[] = {
+    "libpdfium.so",
+    "libmodpdfium.so",
+};
+
+template <typename T>
+bool resolveSymbol(void* library, const char* name, T& target) {
+    target = reinterpret_cast<T>(dlsym(library, name));
+    if (!target) {
+        LOGE("Pdfium symbol not found: %s", name);
+        return false;
+    }
+    return true;
+}
+
+struct OptionalSymbol {
+    const char* name;
+    void** target;
+};
+
+// All-or-nothing: a feature needing several symbols is off unless every one resolves
+void resolveOptionalGroup(void* library, std::initializer_list<OptionalSymbol> symbols) {
+    for (const OptionalSymbol& symbol : symbols) {
+        *symbol.target = dlsym(library, symbol.name);
+        if (!*symbol.target) {
+            LOGW("Optional Pdfium symbol not found: %s", symbol.name);
+            for (const OptionalSymbol& resolved : symbols) {
+                *resolved.target = nullptr;
+            }
+            return;
+        }
+    }
+}
+
+bool loadApi(PdfiumApi& api) {
+    void* library = nullptr;
+    for (const char* name : kPdfiumLibraries) {
+        library = dlopen(name, RTLD_NOW | RTLD_LOCAL);
+        if (library) {
+            LOGI("Pdfium loaded from %s", name);
+            break;
+        }
+    }
+    if (!library) {
+        LOGE("Pdfium library not available: %s", dlerror());
+        return false;
+    }
+
+    bool ok = true;
+    ok &= resolveSymbol(library, "FPDF_InitLibrary", api.initLibrary);
+    ok &= resolveSymbol(library, "FPDF_LoadDocument", api.loadDocument);
+    ok &= resolveSymbol(library, "FPDF_LoadMemDocument", api.loadMemDocument);
+    ok &= resolveSymbol(library, "FPDF_CloseDocument", api.closeDocument);
+    ok &= resolveSymbol(library, "FPDF_GetPageCount", api.getPageCount);
+    ok &= resolveSymbol(library, "FPDF_GetLastError", api.getLastError);
+    ok &= resolveSymbol(library, "FPDF_LoadPage", api.loadPage);
+    ok &= resolveSymbol(library, "FPDF_ClosePage", api.closePage);
+    ok &= resolveSymbol(library, "FPDF_GetPageWidth", api.getPageWidth);
+    ok &= resolveSymbol(library, "FPDF_GetPageHeight", api.getPageHeight);
+    ok &= resolveSymbol(library, "FPDFPage_GetRotation", api.getPageRotation);
+    api.getMediaBox = reinterpret_cast<decltype(api.getMediaBox)>(dlsym(library, "FPDFPage_GetMediaBox"));
+    api.getCropBox = reinterpret_cast<decltype(api.getCropBox)>(dlsym(library, "FPDFPage_GetCropBox"));
+    ok &= resolveSymbol(library, "FPDFBitmap_CreateEx", api.bitmapCreateEx);
+    ok &= resolveSymbol(library, "FPDFBitmap_FillRect", api.bitmapFillRect);
+    ok &= resolveSymbol(library, "FPDFBitmap_Destroy", api.bitmapDestroy);
+    ok &= resolveSymbol(library, "FPDF_RenderPageBitmap", api.renderPageBitmap);
+    resolveOptionalGroup(library, {
+        { "FPDFAvail_Create", reinterpret_cast<void**>(&api.availCreate) },
+        { "FPDFAvail_Destroy", reinterpret_cast<void**>(&api.availDestroy) },
+        { "FPDFAvail_IsDocAvail", reinterpret_cast<void**>(&api.availIsDocAvail) },
+        { "FPDFAvail_GetDocument", reinterpret_cast<void**>(&api.availGetDocument) },
+        { "FPDFAvail_GetFirstPageNum", reinterpret_cast<void**>(&api.availGetFirstPageNum) },
+        { "FPDFAvail_IsPageAvail", reinterpret_cast<void**>(&api.availIsPageAvail) },
+        { "FPDFAvail_IsLinearized", reinterpret_cast<void**>(&api.availIsLinearized) },
+    });
+    ok &= resolveSymbol(library, "FPDFText_LoadPage", api.textLoadPage);
+    ok &= resolveSymbol(library, "FPDFText_ClosePage", api.textClosePage);
+    ok &= resolveSymbol(library, "FPDFText_CountChars", api.textCountChars);
+    ok &= resolveSymbol(library, "FPDFText_GetUnicode", api.textGetUnicode);
+    ok &= resolveSymbol(library, "FPDFText_GetCharBox", api.textGetCharBox);
+    resolveOptionalGroup(library, {
+        { "FPDFLink_Enumerate", reinterpret_cast<void**>(&api.linkEnumerate) },
+        { "FPDFLink_GetAnnotRect", reinterpret_cast<void**>(&api.linkGetAnnotRect) },
+        { "FPDFLink_GetDest", reinterpret_cast<void**>(&api.linkGetDest) },
+        { "FPDFLink_GetAction", reinterpret_cast<void**>(&api.linkGetAction) },
+        { "FPDFAction_GetDest", reinterpret_cast<void**>(&api.actionGetDest) },
+        { "FPDFAction_GetURIPath", reinterpret_cast<void**>(&api.actionGetURIPath) },
+        { "FPDFDest_GetDestPageIndex", reinterpret_cast<void**>(&api.destGetPageIndex) },
+    });
+
+    if (!ok) {
+        // The library stays loaded; pdfiumandroid may still be using it
+        return false;
+    }
+
+    // Safe to call repeatedly; Pdfium ignores re-initialization
+    api.initLibrary();
+    return true;
+}
+
+} // namespace
+
+const PdfiumApi* PdfiumApi::get() {
+    static PdfiumApi api = {};
+    static bool loaded = false;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        std::lock_guard<std::mutex> lock(PdfiumApi::mutex());
+        loaded = loadApi(api);
+    });
+    return loaded ? &api : nullptr;
+}
+
+std::mutex& PdfiumApi::mutex() {
+    static std::mutex pdfiumMutex;
+    return pdfiumMutex;
+}
+
+std::string PdfiumApi::describeError(unsigned long code) {
+    switch (code) {
+        case 1: return "Unknown Pdfium error";
+        case 2: return "File not found or could not be opened";
+        case 3: return "File is not a PDF or is corrupted";
+        case 4: return "Password required or incorrect password";
+        case 5: return "Unsupported security scheme";
+        case 6: return "Page not found or content error";
+        default: return "Pdfium error " + std::to_string(code);
+    }
+}
@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Runtime binding to the Pdfium C API shipped by io.legere:pdfiumandroid.
+ * The symbols are resolved with dlopen/dlsym so libpdfjsi does not need to
+ * link against a specific Pdfium build at compile time.
+ */
+
+#ifndef PDFIUM_API_H
+#define PDFIUM_API_H
+
+#include <mutex>
+#include <string>
+
+// Opaque Pdfium handle types (mirrors fpdfview.h)
+typedef void* FPDF_DOCUMENT;
+typedef void* FPDF_PAGE;
+typedef void* FPDF_BITMAP;
+typedef void* FPDF_TEXTPAGE;
+typedef int FPDF_BOOL;
+typedef unsigned int FPDF_DWORD;
+
+typedef void* FPDF_AVAIL;
+typedef void* FPDF_LINK;
+typedef void* FPDF_DEST;
+typedef void* FPDF_ACTION;
+
+struct FS_RECTF {
+    float left;
+    float top;
+    float right;
+    float bottom;
+};
+
+// Custom file access and availability callbacks (mirror fpdfview.h and fpdf_dataavail.h)
+struct FPDF_FILEACCESS {
+    unsigned long m_FileLen;
+    int (*m_GetBlock)(void* param, unsigned long position, unsigned char* buffer, unsigned long size);
+    void* m_Param;
+};
+
+struct FX_FILEAVAIL {
+    int version;
+    FPDF_BOOL (*IsDataAvail)(FX_FILEAVAIL* self, size_t offset, size_t size);
+};
+
+struct FX_DOWNLOADHINTS {
+    int version;
+    void (*AddSegment)(FX_DOWNLOADHINTS* self, size_t offset, size_t size);
+};
+
+// FPDFAvail_IsDocAvail / FPDFAvail_IsPageAvail results
+#define PDFIUM_DATA_ERROR -1
+#define PDFIUM_DATA_NOTAVAIL 0
+#define PDFIUM_DATA_AVAIL 1
+
+// FPDFAvail_IsLinearized results
+#define PDFIUM_LINEARIZATION_UNKNOWN -1
+#define PDFIUM_NOT_LINEARIZED 0
+#define PDFIUM_LINEARIZED 1
+
+// Bitmap formats (FPDFBitmap_*)
+#define PDFIUM_BITMAP_GRAY 1
+#define PDFIUM_BITMAP_BGR 2
+#define PDFIUM_BITMAP_BGRX 3
+#define PDFIUM_BITMAP_BGRA 4
+
+// Render flags (FPDF_*)
+#define PDFIUM_RENDER_ANNOT 0x01
+#define PDFIUM_RENDER_LCD_TEXT 0x02
+#define PDFIUM_RENDER_GRAYSCALE 0x08
+#define PDFIUM_RENDER_REVERSE_BYTE_ORDER 0x10
+#define PDFIUM_RENDER_NO_SMOOTHTEXT 0x1000
+#define PDFIUM_RENDER_NO_SMOOTHIMAGE 0x2000
+#define PDFIUM_RENDER_NO_SMOOTHPATH 0x4000
+
+struct PdfiumApi {
+    void (*initLibrary)();
+    FPDF_DOCUMENT (*loadDocument)(const char* filePath, const char* password);
+    FPDF_DOCUMENT (*loadMemDocument)(const void* data, int size, const char* password);
+    void (*closeDocument)(FPDF_DOCUMENT document);
+    int (*getPageCount)(FPDF_DOCUMENT document);
+    unsigned long (*getLastError)();
+
+    FPDF_PAGE (*loadPage)(FPDF_DOCUMENT document, int pageIndex);
+    void (*closePage)(FPDF_PAGE page);
+    double (*getPageWidth)(FPDF_PAGE page);
+    double (*getPageHeight)(FPDF_PAGE page);
+    int (*getPageRotation)(FPDF_PAGE page);
+    // Optional (fpdf_transformpage.h); nullptr when the build does not export them
+    FPDF_BOOL (*getMediaBox)(FPDF_PAGE page, float* left, float* bottom, float* right, float* top);
+    FPDF_BOOL (*getCropBox)(FPDF_PAGE page, float* left, float* bottom, float* right, float* top);
+
+    FPDF_BITMAP (*bitmapCreateEx)(int width, int height, int format, void* firstScan, int stride);
+    FPDF_BOOL (*bitmapFillRect)(FPDF_BITMAP bitmap, int left, int top, int width, int height, FPDF_DWORD color);
+    void (*bitmapDestroy)(FPDF_BITMAP bitmap);
+    void (*renderPageBitmap)(FPDF_BITMAP bitmap, FPDF_PAGE page, int startX, int startY,
+                             int sizeX, int sizeY, int rotate, int flags);
+
+    // Optional progressive loading (fpdf_dataavail.h); nullptr when any is missing
+    FPDF_AVAIL (*availCreate)(FX_FILEAVAIL* fileAvail, FPDF_FILEACCESS* file);
+    void (*availDestroy)(FPDF_AVAIL avail);
+    int (*availIsDocAvail)(FPDF_AVAIL avail, FX_DOWNLOADHINTS* hints);
+    FPDF_DOCUMENT (*availGetDocument)(FPDF_AVAIL avail, const char* password);
+    int (*availGetFirstPageNum)(FPDF_DOCUMENT document);
+    int (*availIsPageAvail)(FPDF_AVAIL avail, int pageIndex, FX_DOWNLOADHINTS* hints);
+    int (*availIsLinearized)(FPDF_AVAIL avail);
+
+    FPDF_TEXTPAGE (*textLoadPage)(FPDF_PAGE page);
+    void (*textClosePage)(FPDF_TEXTPAGE textPage);
+    int (*textCountChars)(FPDF_TEXTPAGE textPage);
+    unsigned int (*textGetUnicode)(FPDF_TEXTPAGE textPage, int index);
+    FPDF_BOOL (*textGetCharBox)(FPDF_TEXTPAGE textPage, int index, double* left, double* right,
+                                double* bottom, double* top);
+
+    // Link annotations (optional, all or none)
+    FPDF_BOOL (*linkEnumerate)(FPDF_PAGE page, int* startPos, FPDF_LINK* link);
+    FPDF_BOOL (*linkGetAnnotRect)(FPDF_LINK link, FS_RECTF* rect);
+    FPDF_DEST (*linkGetDest)(FPDF_DOCUMENT document, FPDF_LINK link);
+    FPDF_ACTION (*linkGetAction)(FPDF_LINK link);
+    FPDF_DEST (*actionGetDest)(FPDF_DOCUMENT document, FPDF_ACTION action);
+    unsigned long (*actionGetURIPath)(FPDF_DOCUMENT document, FPDF_ACTION action, void* buffer, unsigned long length);
+    int (*destGetPageIndex)(FPDF_DOCUMENT document, FPDF_DEST dest);
+
+    bool supportsProgressiveLoading() const { return availCreate != nullptr; }
+    bool supportsLinks() const { return linkEnumerate != nullptr; }
+
+    // Returns the resolved API, or nullptr if no Pdfium library could be loaded
+    static const PdfiumApi* get();
+
+    // Pdfium is not thread-safe; every call into it must hold this lock
+    static std::mutex& mutex();
+
+    // Human-readable text for FPDF_GetLastError codes
+    static std::string describeError(unsigned long code);
+};
+
+#endif // PDFIUM_API_H
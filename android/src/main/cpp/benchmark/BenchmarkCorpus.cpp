@@ -0,0 +1,255 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Fixed benchmark corpus
+ */
+
+#include "BenchmarkCorpus.h"
+#include <cstdio>
+
+namespace {
+
+const char* const kSearchTerm = "benchmark";
+
+const char* const kVocabulary[] = {
+    "page", "render", "native", "cache", "document", "bitmap", "scale", "quality",
+    "stream", "object", "font", "glyph", "vector", "index", "search", "memory",
+    "thread", "worker", "preload", "viewer", "zoom", "tile", "buffer", "decode",
+    "layout", "margin", "column", "paragraph", "section", "chapter", "figure", "table",
+};
+const size_t kVocabularySize = sizeof(kVocabulary) / sizeof(kVocabulary[0]);
+
+// Deterministic across platforms, unlike std::rand and the <random> distributions
+class Lcg {
+public:
+    explicit Lcg(uint32_t seed) : m_state(seed * 2654435761u + 1) {}
+    uint32_t next() {
+        m_state = m_state * 1664525u + 1013904223u;
+        return m_state >> 8;
+    }
+    int range(int low, int high) { return low + static_cast<int>(next() % static_cast<uint32_t>(high - low + 1)); }
+
+private:
+    uint32_t m_state;
+};
+
+// Minimal PDF 1.4 writer: catalog, page tree, one Helvetica font and
+// uncompressed content streams, with an exact cross-reference table
+class PdfWriter {
+public:
+    explicit PdfWriter(int pageCount) {
+        m_out = "%PDF-1.4\n%\xE2\xE3\xCF\xD3\n";
+        beginObject();
+        m_out += "<< /Type /Catalog /Pages 2 0 R >>\n";
+        endObject();
+        beginObject();
+        m_out += "<< /Type /Pages /Count " + std::to_string(pageCount) + " /Kids [";
+        for (int page = 0; page < pageCount; ++page) {
+            m_out += " " + std::to_string(pageObject(page)) + " 0 R";
+        }
+        m_out += " ] >>\n";
+        endObject();
+        beginObject();
+        m_out += "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica /Encoding /WinAnsiEncoding >>\n";
+        endObject();
+    }
+
+    // Pages must be added in order
+    void addPage(const std::string& content) {
+        int page = static_cast<int>(m_offsets.size() - 3) / 2;
+        beginObject();
+        m_out += "<< /Type /Page /Parent 2 0 R /MediaBox [0 0 612 792] "
+                 "/Resources << /Font << /F1 3 0 R >> >> /Contents " +
+                 std::to_string(pageObject(page) + 1) + " 0 R >>\n";
+        endObject();
+        beginObject();
+        m_out += "<< /Length " + std::to_string(content.size()) + " >>\nstream\n";
+        m_out += content;
+        m_out += "\nendstream\n";
+        endObject();
+    }
+
+    std::vector<uint8_t> finish() {
+        size_t xref = m_out.size();
+        char line[32];
+        m_out += "xref\n0 " + std::to_string(m_offsets.size() + 1) + "\n0000000000 65535 f \n";
+        for (size_t offset : m_offsets) {
+            snprintf(line, sizeof(line), "%010zu 00000 n \n", offset);
+            m_out += line;
+        }
+        m_out += "trailer\n<< /Size " + std::to_string(m_offsets.size() + 1) + " /Root 1 0 R >>\n";
+        m_out += "startxref\n" + std::to_string(xref) + "\n%%EOF\n";
+        return std::vector<uint8_t>(m_out.begin(), m_out.end());
+    }
+
+private:
+    static int pageObject(int page) { return 4 + page * 2; }
+
+    void beginObject() {
+        m_offsets.push_back(m_out.size());
+        m_out += std::to_string(m_offsets.size()) + " 0 obj\n";
+    }
+    void endObject() { m_out += "endobj\n"; }
+
+    std::string m_out;
+    std::vector<size_t> m_offsets;
+};
+
+void appendTextLines(std::string& content, Lcg& random, int lines, int firstLine, float top) {
+    content += "BT /F1 10 Tf 12 TL 54 " + std::to_string(static_cast<int>(top)) + " Td\n";
+    for (int line = 0; line < lines; ++line) {
+        content += "(";
+        int words = random.range(8, 13);
+        for (int word = 0; word < words; ++word) {
+            if (word > 0) {
+                content += ' ';
+            }
+            // The search term appears on every seventh line
+            if (word == 3 && (firstLine + line) % 7 == 0) {
+                content += kSearchTerm;
+            } else {
+                content += kVocabulary[random.next() % kVocabularySize];
+            }
+        }
+        content += ") Tj T*\n";
+    }
+    content += "ET\n";
+}
+
+void appendVectorArt(std::string& content, Lcg& random, int segments, int curves, int rects) {
+    content += "0.6 w\n";
+    for (int i = 0; i < segments; ++i) {
+        content += std::to_string(random.range(20, 592)) + " " + std::to_string(random.range(20, 772)) + " m " +
+                   std::to_string(random.range(20, 592)) + " " + std::to_string(random.range(20, 772)) + " l S\n";
+    }
+    for (int i = 0; i < curves; ++i) {
+        content += std::to_string(random.range(20, 592)) + " " + std::to_string(random.range(20, 772)) + " m";
+        for (int point = 0; point < 3; ++point) {
+            content += " " + std::to_string(random.range(20, 592)) + " " + std::to_string(random.range(20, 772));
+        }
+        content += " c S\n";
+    }
+    for (int i = 0; i < rects; ++i) {
+        char color[48];
+        snprintf(color, sizeof(color), "%.2f %.2f %.2f rg ", random.range(0, 100) / 100.0,
+                 random.range(0, 100) / 100.0, random.range(0, 100) / 100.0);
+        content += color;
+        content += std::to_string(random.range(20, 500)) + " " + std::to_string(random.range(20, 700)) + " " +
+                   std::to_string(random.range(10, 90)) + " " + std::to_string(random.range(10, 90)) + " re f\n";
+    }
+    content += "0 0 0 rg\n";
+}
+
+std::vector<uint8_t> textDocument(int pages) {
+    PdfWriter writer(pages);
+    Lcg random(1);
+    for (int page = 0; page < pages; ++page) {
+        std::string content;
+        appendTextLines(content, random, 56, page * 56, 740);
+        writer.addPage(content);
+    }
+    return writer.finish();
+}
+
+std::vector<uint8_t> vectorDocument(int pages) {
+    PdfWriter writer(pages);
+    Lcg random(2);
+    for (int page = 0; page < pages; ++page) {
+        std::string content;
+        appendVectorArt(content, random, 600, 80, 60);
+        writer.addPage(content);
+    }
+    return writer.finish();
+}
+
+std::vector<uint8_t> mixedDocument(int pages) {
+    PdfWriter writer(pages);
+    Lcg random(3);
+    for (int page = 0; page < pages; ++page) {
+        std::string content;
+        appendVectorArt(content, random, 40, 8, 12);
+        appendTextLines(content, random, 12, page * 12, 300);
+        writer.addPage(content);
+    }
+    return writer.finish();
+}
+
+bool writeFile(const std::string& path, const std::vector<uint8_t>& bytes, std::string& error) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        error = "Cannot write " + path;
+        return false;
+    }
+    bool written = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    written = fclose(file) == 0 && written;
+    if (!written) {
+        error = "Cannot write " + path;
+    }
+    return written;
+}
+
+} // namespace
+
+namespace BenchmarkCorpus {
+
+uint64_t checksum(const std::vector<uint8_t>& bytes) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (uint8_t byte : bytes) {
+        hash ^= byte;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool generate(const std::string& directory, std::vector<CorpusDocument>& corpus, std::string& error) {
+    struct Generated {
+        const char* name;
+        std::vector<uint8_t> (*build)(int);
+        int pages;
+    };
+    const Generated documents[] = {
+        { "text-24p", textDocument, 24 },
+        { "vector-8p", vectorDocument, 8 },
+        { "mixed-200p", mixedDocument, 200 },
+    };
+
+    for (const Generated& generated : documents) {
+        CorpusDocument document;
+        document.name = generated.name;
+        document.path = directory + "/" + generated.name + ".pdf";
+        document.bytes = generated.build(generated.pages);
+        document.checksum = checksum(document.bytes);
+        document.searchTerm = kSearchTerm;
+        if (!writeFile(document.path, document.bytes, error)) {
+            return false;
+        }
+        corpus.push_back(std::move(document));
+    }
+    return true;
+}
+
+bool load(const std::string& path, CorpusDocument& document, std::string& error) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        error = "Cannot read " + path;
+        return false;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t buffer[64 * 1024];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + read);
+    }
+    fclose(file);
+
+    size_t slash = path.rfind('/');
+    document.name = slash == std::string::npos ? path : path.substr(slash + 1);
+    document.path = path;
+    document.checksum = checksum(bytes);
+    document.bytes = std::move(bytes);
+    return true;
+}
+
+} // namespace BenchmarkCorpus
@@ -0,0 +1,43 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Fixed benchmark corpus
+ * The built-in documents are generated byte-for-byte identically on every
+ * run and platform (text-heavy, vector-heavy and a long mixed document), so
+ * results from different releases and devices compare the same input. Extra
+ * PDFs can be added from the command line; every document is reported with
+ * its size and checksum.
+ */
+
+#ifndef PDFJSI_BENCHMARK_CORPUS_H
+#define PDFJSI_BENCHMARK_CORPUS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct CorpusDocument {
+    std::string name;
+    std::string path;
+    std::vector<uint8_t> bytes;
+    uint64_t checksum = 0;
+    // Word present in the built-in documents; empty for external files
+    std::string searchTerm;
+};
+
+namespace BenchmarkCorpus {
+
+// Writes the built-in documents into directory and appends them to corpus
+bool generate(const std::string& directory, std::vector<CorpusDocument>& corpus, std::string& error);
+
+// Reads an external PDF into document
+bool load(const std::string& path, CorpusDocument& document, std::string& error);
+
+// FNV-1a over the document bytes, printed with results to identify the input
+uint64_t checksum(const std::vector<uint8_t>& bytes);
+
+} // namespace BenchmarkCorpus
+
+#endif // PDFJSI_BENCHMARK_CORPUS_H
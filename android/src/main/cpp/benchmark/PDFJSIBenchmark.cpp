@@ -0,0 +1,882 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Native benchmark suite for the pdfjsi engine sources
+ * Measures document open, rasterizing at several scales, page cache hit and
+ * miss paths, the persistent page store, text search, base64 decoding, the
+ * bitmap pool and (with a Java VM) JNI marshalling, over the fixed corpus
+ * in BenchmarkCorpus.
+ * Results are written as JSON so runs from different releases can be diffed.
+ *
+ * Device: build with the NDK toolchain and run through adb, next to the
+ * app's Pdfium library:
+ *   adb push pdfjsi_benchmark libpdfium.so /data/local/tmp/
+ *   adb shell 'cd /data/local/tmp && LD_LIBRARY_PATH=. ./pdfjsi_benchmark' > results.json
+ * JNI rows need a VM: on a device that is ART, through the androidTest
+ * harness (PDFJSIBenchmarkTest), which loads this file built as
+ * libpdfjsi_benchmark_jni.so:
+ *   ./gradlew connectedAndroidTest -PpdfjsiBenchmark=true
+ * Host: pass --pdfium with a desktop Pdfium build (e.g. pdfium-binaries);
+ * a JDK found at configure time enables the JNI rows.
+ */
+
+#include "BenchmarkCorpus.h"
+#include "Base64Decoder.h"
+#include "PDFBitmapPool.h"
+#include "PDFDocumentRegistry.h"
+#include "PDFPageCache.h"
+#include "PDFPageStore.h"
+#include "PDFRenderEngine.h"
+#include "PDFTextIndex.h"
+#include "PdfiumApi.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+
+// JNI rows run inside a host JVM the benchmark creates, or inside the ART
+// process that loaded the androidTest library
+#if PDFJSI_BENCHMARK_JVM || PDFJSI_BENCHMARK_LIBRARY
+#define PDFJSI_BENCHMARK_JNI 1
+#include <jni.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#ifndef PDFJSI_BENCHMARK_FLAGS
+#define PDFJSI_BENCHMARK_FLAGS "unknown"
+#endif
+
+namespace {
+
+struct Options {
+    std::string corpusDirectory;
+    std::vector<std::string> extraDocuments;
+    std::string pdfiumPath;
+    std::string outputPath;
+    std::string filter;
+    int iterations = 15;
+    int warmup = 3;
+#if PDFJSI_BENCHMARK_JNI
+    // Set when the caller already runs in a Java VM
+    JNIEnv* env = nullptr;
+#endif
+};
+
+class Timer {
+public:
+    void start() { m_start = std::chrono::steady_clock::now(); }
+    void stop() { m_elapsed += std::chrono::steady_clock::now() - m_start; }
+    double elapsedNs() const { return std::chrono::duration<double, std::nano>(m_elapsed).count(); }
+    void reset() { m_elapsed = std::chrono::steady_clock::duration::zero(); }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+    std::chrono::steady_clock::duration m_elapsed = std::chrono::steady_clock::duration::zero();
+};
+
+struct Result {
+    std::string name;
+    std::string document;
+    std::string params;
+    uint64_t bytesPerIteration = 0;
+    std::vector<double> samplesNs;
+    std::string error;
+};
+
+std::string jsonEscape(const std::string& value) {
+    std::string escaped;
+    for (char c : value) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char code[8];
+                    snprintf(code, sizeof(code), "\\u%04x", c);
+                    escaped += code;
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
+
+std::string jsonNumber(double value) {
+    char number[32];
+    snprintf(number, sizeof(number), "%.3f", value);
+    return number;
+}
+
+const char* architecture() {
+#if defined(__aarch64__)
+    return "arm64";
+#elif defined(__arm__)
+    return "arm";
+#elif defined(__x86_64__)
+    return "x86_64";
+#elif defined(__i386__)
+    return "x86";
+#else
+    return "unknown";
+#endif
+}
+
+class Suite {
+public:
+    explicit Suite(const Options& options) : m_options(options) {}
+
+    bool selected(const std::string& name) const {
+        return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+    }
+
+    // body(timer, error) times its own critical section, so per-iteration setup
+    // stays out of the samples; it returns false (with error set) on failure
+    template <typename Body>
+    void run(const std::string& name, const std::string& document, const std::string& params,
+             uint64_t bytesPerIteration, Body&& body) {
+        if (!selected(name)) {
+            return;
+        }
+        Result result;
+        result.name = name;
+        result.document = document;
+        result.params = params;
+        result.bytesPerIteration = bytesPerIteration;
+
+        Timer timer;
+        for (int i = 0; i < m_options.warmup + m_options.iterations; ++i) {
+            timer.reset();
+            if (!body(timer, result.error)) {
+                if (result.error.empty()) {
+                    result.error = "failed";
+                }
+                break;
+            }
+            if (i >= m_options.warmup) {
+                result.samplesNs.push_back(timer.elapsedNs());
+            }
+        }
+        report(result);
+        m_results.push_back(std::move(result));
+    }
+
+    void skip(const std::string& name, const std::string& reason) {
+        if (!selected(name)) {
+            return;
+        }
+        Result result;
+        result.name = name;
+        result.error = "skipped: " + reason;
+        report(result);
+        m_results.push_back(std::move(result));
+    }
+
+    std::string json(const std::vector<CorpusDocument>& corpus, bool pdfiumAvailable) const {
+        std::string out = "{\n  \"schema\": 1,\n  \"environment\": {";
+        out += "\"arch\": \"" + std::string(architecture()) + "\", ";
+#if defined(__clang__)
+        out += "\"compiler\": \"clang " + jsonEscape(__clang_version__) + "\", ";
+#elif defined(__GNUC__)
+        out += "\"compiler\": \"gcc " + jsonEscape(__VERSION__) + "\", ";
+#endif
+        out += "\"flags\": \"" + jsonEscape(PDFJSI_BENCHMARK_FLAGS) + "\", ";
+        out += "\"tracing\": " + std::string(PDFJSI_TRACING ? "true" : "false") + ", ";
+        out += "\"pdfium\": " + std::string(pdfiumAvailable ? "true" : "false") + ", ";
+        out += "\"hardwareThreads\": " + std::to_string(std::thread::hardware_concurrency()) + ", ";
+        out += "\"iterations\": " + std::to_string(m_options.iterations) + ", ";
+        out += "\"warmup\": " + std::to_string(m_options.warmup) + "},\n";
+
+        out += "  \"corpus\": [";
+        for (size_t i = 0; i < corpus.size(); ++i) {
+            char checksum[20];
+            snprintf(checksum, sizeof(checksum), "%016llx", static_cast<unsigned long long>(corpus[i].checksum));
+            out += std::string(i ? ", " : "") + "{\"name\": \"" + jsonEscape(corpus[i].name) + "\", \"bytes\": " +
+                   std::to_string(corpus[i].bytes.size()) + ", \"fnv1a\": \"" + checksum + "\"}";
+        }
+        out += "],\n  \"results\": [\n";
+
+        for (size_t i = 0; i < m_results.size(); ++i) {
+            const Result& result = m_results[i];
+            out += "    {\"name\": \"" + jsonEscape(result.name) + "\"";
+            if (!result.document.empty()) {
+                out += ", \"document\": \"" + jsonEscape(result.document) + "\"";
+            }
+            if (!result.params.empty()) {
+                out += ", \"params\": \"" + jsonEscape(result.params) + "\"";
+            }
+            if (!result.error.empty()) {
+                out += ", \"error\": \"" + jsonEscape(result.error) + "\"";
+            }
+            if (!result.samplesNs.empty()) {
+                Stats stats = summarize(result);
+                out += ", \"samples\": " + std::to_string(result.samplesNs.size());
+                out += ", \"minNs\": " + jsonNumber(stats.min);
+                out += ", \"medianNs\": " + jsonNumber(stats.median);
+                out += ", \"p90Ns\": " + jsonNumber(stats.p90);
+                out += ", \"meanNs\": " + jsonNumber(stats.mean);
+                out += ", \"stddevNs\": " + jsonNumber(stats.stddev);
+                out += ", \"maxNs\": " + jsonNumber(stats.max);
+                if (result.bytesPerIteration > 0) {
+                    out += ", \"mbPerSecond\": " + jsonNumber(stats.mbPerSecond);
+                }
+            }
+            out += i + 1 < m_results.size() ? "},\n" : "}\n";
+        }
+        out += "  ]\n}\n";
+        return out;
+    }
+
+private:
+    struct Stats {
+        double min = 0.0;
+        double median = 0.0;
+        double p90 = 0.0;
+        double mean = 0.0;
+        double stddev = 0.0;
+        double max = 0.0;
+        double mbPerSecond = 0.0;
+    };
+
+    static Stats summarize(const Result& result) {
+        std::vector<double> samples = result.samplesNs;
+        std::sort(samples.begin(), samples.end());
+        Stats stats;
+        size_t count = samples.size();
+        stats.min = samples.front();
+        stats.max = samples.back();
+        stats.median = count % 2 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2.0;
+        stats.p90 = samples[std::min(count - 1, static_cast<size_t>(std::ceil(count * 0.9)) - 1)];
+        double sum = 0.0;
+        for (double sample : samples) {
+            sum += sample;
+        }
+        stats.mean = sum / count;
+        double variance = 0.0;
+        for (double sample : samples) {
+            variance += (sample - stats.mean) * (sample - stats.mean);
+        }
+        stats.stddev = count > 1 ? std::sqrt(variance / (count - 1)) : 0.0;
+        if (result.bytesPerIteration > 0 && stats.median > 0.0) {
+            stats.mbPerSecond = result.bytesPerIteration / (stats.median / 1e9) / (1024.0 * 1024.0);
+        }
+        return stats;
+    }
+
+    // Human-readable progress on stderr; stdout carries only the JSON
+    static void report(const Result& result) {
+        std::string label = result.name;
+        if (!result.document.empty()) {
+            label += " [" + result.document + "]";
+        }
+        if (!result.params.empty()) {
+            label += " " + result.params;
+        }
+        if (result.samplesNs.empty()) {
+            fprintf(stderr, "%-56s %s\n", label.c_str(), result.error.c_str());
+            return;
+        }
+        Stats stats = summarize(result);
+        fprintf(stderr, "%-56s median %10.3f ms  p90 %10.3f ms", label.c_str(), stats.median / 1e6, stats.p90 / 1e6);
+        if (result.bytesPerIteration > 0) {
+            fprintf(stderr, "  %8.1f MB/s", stats.mbPerSecond);
+        }
+        fprintf(stderr, "%s\n", result.error.empty() ? "" : "  (incomplete)");
+    }
+
+    const Options& m_options;
+    std::vector<Result> m_results;
+};
+
+std::string base64Encode(const std::vector<uint8_t>& bytes) {
+    static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((bytes.size() + 2) / 3 * 4);
+    size_t i = 0;
+    for (; i + 2 < bytes.size(); i += 3) {
+        uint32_t triple = (bytes[i] << 16) | (bytes[i + 1] << 8) | bytes[i + 2];
+        out += kAlphabet[(triple >> 18) & 63];
+        out += kAlphabet[(triple >> 12) & 63];
+        out += kAlphabet[(triple >> 6) & 63];
+        out += kAlphabet[triple & 63];
+    }
+    if (i < bytes.size()) {
+        uint32_t triple = bytes[i] << 16;
+        if (i + 1 < bytes.size()) {
+            triple |= bytes[i + 1] << 8;
+        }
+        out += kAlphabet[(triple >> 18) & 63];
+        out += kAlphabet[(triple >> 12) & 63];
+        out += i + 1 < bytes.size() ? kAlphabet[(triple >> 6) & 63] : '=';
+        out += '=';
+    }
+    return out;
+}
+
+std::u16string toUtf16(const std::string& ascii) {
+    return std::u16string(ascii.begin(), ascii.end());
+}
+
+void runDocumentBenchmarks(Suite& suite, const CorpusDocument& document, const std::string& storeDirectory) {
+    PDFDocumentRegistry registry;
+    PDFPageCache cache;
+    PDFBitmapPool pool;
+    PDFPageStore store;
+    PDFHitIndex hitIndex;
+    // Off while renders are timed, so background box reads do not skew them
+    hitIndex.setBudget(0);
+    PDFRenderEngine engine(registry, cache, pool, store, hitIndex);
+    PDFTextIndex textIndex(hitIndex);
+    const std::string& name = document.name;
+
+    suite.run("open.file", name, "", 0, [&](Timer& timer, std::string& error) {
+        DocumentSource source;
+        source.filePath = document.path;
+        timer.start();
+        bool opened = registry.acquire(name, source, error) != nullptr;
+        registry.release(name);
+        timer.stop();
+        return opened;
+    });
+
+    suite.run("open.memory", name, "", document.bytes.size(), [&](Timer& timer, std::string& error) {
+        DocumentSource source;
+        source.data = std::make_shared<std::vector<uint8_t>>(document.bytes);
+        timer.start();
+        bool opened = registry.acquire(name, source, error) != nullptr;
+        registry.release(name);
+        timer.stop();
+        return opened;
+    });
+
+    // One reference held for the render and search benchmarks
+    DocumentSource source;
+    source.filePath = document.path;
+    std::string error;
+    std::shared_ptr<PDFDocument> opened = registry.acquire(name, source, error);
+    if (!opened) {
+        suite.skip("render", name + ": " + error);
+        return;
+    }
+    int pages = std::min(opened->pageCount, 8);
+
+    const float scales[] = { 0.5f, 1.0f, 2.0f, 3.0f };
+    for (float scale : scales) {
+        std::string params = "scale=" + jsonNumber(scale).substr(0, 3) + " pages=" + std::to_string(pages);
+        suite.run("render.miss", name, params, 0, [&](Timer& timer, std::string& error) {
+            for (int page = 1; page <= pages; ++page) {
+                cache.clear();
+                timer.start();
+                RenderResult result = engine.renderPage(name, page, scale, std::string(), PDFJSI_QUALITY_HIGH);
+                timer.stop();
+                if (!result.success) {
+                    error = result.error;
+                    return false;
+                }
+            }
+            return true;
+        });
+    }
+
+    suite.run("render.miss.draft", name, "scale=1.0 pages=" + std::to_string(pages), 0,
+              [&](Timer& timer, std::string& error) {
+        for (int page = 1; page <= pages; ++page) {
+            cache.clear();
+            timer.start();
+            RenderResult result = engine.renderPage(name, page, 1.0f, std::string(), PDFJSI_QUALITY_DRAFT);
+            timer.stop();
+            if (!result.success) {
+                error = result.error;
+                return false;
+            }
+        }
+        return true;
+    });
+
+    suite.run("render.hit", name, "scale=1.0 pages=" + std::to_string(pages), 0, [&](Timer& timer, std::string& error) {
+        for (int page = 1; page <= pages; ++page) {
+            engine.renderPage(name, page, 1.0f, std::string(), PDFJSI_QUALITY_NORMAL);
+        }
+        timer.start();
+        for (int page = 1; page <= pages; ++page) {
+            RenderResult result = engine.renderPage(name, page, 1.0f, std::string(), PDFJSI_QUALITY_NORMAL);
+            if (!result.cached) {
+                timer.stop();
+                error = result.success ? "render was not served from the cache" : result.error;
+                return false;
+            }
+        }
+        timer.stop();
+        return true;
+    });
+
+    // Memory misses served from disk, as after an app restart
+    std::string storeError;
+    if (!store.configure(storeDirectory, PDFPageStore::kDefaultBudgetBytes, storeError) ||
+        !engine.setPageStoreKey(name, "bench-" + name, storeError)) {
+        suite.skip("render.stored", name + ": " + storeError);
+    } else {
+        suite.run("render.stored", name, "scale=1.0 pages=" + std::to_string(pages), 0, [&](Timer& timer, std::string& error) {
+            for (int page = 1; page <= pages; ++page) {
+                engine.renderPage(name, page, 1.0f, std::string(), PDFJSI_QUALITY_NORMAL);
+            }
+            store.flush();
+            cache.clear();
+            timer.start();
+            for (int page = 1; page <= pages; ++page) {
+                RenderResult result = engine.renderPage(name, page, 1.0f, std::string(), PDFJSI_QUALITY_NORMAL);
+                if (!result.cached) {
+                    timer.stop();
+                    error = result.success ? "render was not served from the page store" : result.error;
+                    return false;
+                }
+            }
+            timer.stop();
+            return true;
+        });
+        store.clear();
+        store.configure(std::string(), 0, storeError);
+    }
+
+    if (document.searchTerm.empty()) {
+        suite.skip("search", name + ": no known search term for external documents");
+    } else {
+        std::u16string term = toUtf16(document.searchTerm);
+        std::string params = "term=" + document.searchTerm + " pages=" + std::to_string(opened->pageCount);
+        suite.run("search.cold", name, params, 0, [&](Timer& timer, std::string& error) {
+            textIndex.forget(name);
+            std::vector<TextSearchHit> hits;
+            timer.start();
+            bool searched = textIndex.search(opened, term, 1, opened->pageCount, hits, error);
+            timer.stop();
+            return searched;
+        });
+        suite.run("search.warm", name, params, 0, [&](Timer& timer, std::string& error) {
+            std::vector<TextSearchHit> hits;
+            timer.start();
+            bool searched = textIndex.search(opened, term, 1, opened->pageCount, hits, error);
+            timer.stop();
+            return searched;
+        });
+    }
+
+    // A tap in the middle of page 1: cold reads the page's boxes, warm only looks them up
+    hitIndex.setBudget(PDFHitIndex::kDefaultBudgetBytes);
+    PageSize size;
+    std::string sizeError;
+    if (engine.getPageSize(name, 1, size, sizeError)) {
+        float x = static_cast<float>(size.width) / 2;
+        float y = static_cast<float>(size.height) / 2;
+        suite.run("hitTest.cold", name, "page=1 tolerance=8", 0, [&](Timer& timer, std::string& error) {
+            hitIndex.forget(name);
+            PageHit hit;
+            timer.start();
+            bool tested = hitIndex.hitTest(opened, 1, x, y, 8.0f, hit, error);
+            timer.stop();
+            return tested;
+        });
+        suite.run("hitTest.warm", name, "page=1 tolerance=8", 0, [&](Timer& timer, std::string& error) {
+            PageHit hit;
+            timer.start();
+            bool tested = hitIndex.hitTest(opened, 1, x, y, 8.0f, hit, error);
+            timer.stop();
+            return tested;
+        });
+    } else {
+        suite.skip("hitTest", name + ": " + sizeError);
+    }
+
+    opened.reset();
+    registry.closeAll();
+}
+
+void runBase64Benchmarks(Suite& suite, const CorpusDocument& document) {
+    std::string encoded = base64Encode(document.bytes);
+
+    suite.run("base64.decode", document.name, "", encoded.size(), [&](Timer& timer, std::string& error) {
+        std::vector<uint8_t> decoded;
+        timer.start();
+        bool ok = Base64Decoder::decode(encoded.data(), encoded.size(), decoded);
+        timer.stop();
+        if (!ok || decoded != document.bytes) {
+            error = "decoded bytes differ from the document";
+            return false;
+        }
+        return true;
+    });
+
+    // The jstring path: 64K-character chunks through the incremental decoder
+    const size_t kChunkChars = 64 * 1024;
+    std::vector<uint8_t> chunk(Base64Decoder::maxDecodedSize(kChunkChars));
+    suite.run("base64.stream", document.name, "chunk=65536", encoded.size(), [&](Timer& timer, std::string& error) {
+        Base64Decoder::Stream stream;
+        size_t total = 0;
+        timer.start();
+        for (size_t offset = 0; offset < encoded.size(); offset += kChunkChars) {
+            size_t length = std::min(kChunkChars, encoded.size() - offset);
+            total += stream.update(encoded.data() + offset, length, chunk.data());
+        }
+        bool finished = stream.finish();
+        timer.stop();
+        if (!finished || total != document.bytes.size()) {
+            error = "stream decoded " + std::to_string(total) + " of " + std::to_string(document.bytes.size()) + " bytes";
+            return false;
+        }
+        return true;
+    });
+}
+
+// Page-sized allocations at zoom-like sizes, touching every memory page as a render would.
+// glibc raises its mmap threshold after the first large free and keeps later
+// chunks on its heap, which makes the unpooled baseline a pool of its own; the
+// "unmapping" runs pin the threshold so large frees go back to the system, as
+// Android's allocators do for multi-megabyte blocks.
+void runBitmapPoolBenchmarks(Suite& suite) {
+    std::vector<size_t> sizes;
+    for (int step = 0; step < 64; ++step) {
+        double scale = 0.75 + (step % 16) * 0.125;
+        sizes.push_back(static_cast<size_t>(612 * scale) * static_cast<size_t>(792 * scale) * 4);
+    }
+    uint64_t bytes = 0;
+    for (size_t size : sizes) {
+        bytes += size;
+    }
+
+    auto allocate = [&sizes](PDFBitmapPool* pool, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            PixelBuffer buffer;
+            buffer.allocate(pool, sizes[i]);
+            for (size_t offset = 0; offset < sizes[i]; offset += 4096) {
+                buffer.data()[offset] = 0xFF;
+            }
+        }
+    };
+    // Eight short-lived threads per iteration, as render workers come and go;
+    // exited threads' caches are adopted instead of piling up past kMaxThreadCaches
+    const size_t kThreads = 8;
+    auto allocateOnThreads = [&](PDFBitmapPool* pool) {
+        size_t perThread = sizes.size() / kThreads;
+        for (size_t t = 0; t < kThreads; ++t) {
+            std::thread worker(allocate, pool, t * perThread, (t + 1) * perThread);
+            worker.join();
+        }
+    };
+
+    auto runAllocator = [&](const std::string& allocator) {
+        PDFBitmapPool pool(64 * 1024 * 1024);
+        std::string params = "allocations=64 allocator=" + allocator;
+        std::string threadParams = "allocations=64 threads=8 allocator=" + allocator;
+        suite.run("bitmapPool.pooled", "", params, bytes, [&](Timer& timer, std::string&) {
+            timer.start();
+            allocate(&pool, 0, sizes.size());
+            timer.stop();
+            return true;
+        });
+        suite.run("bitmapPool.unpooled", "", params, bytes, [&](Timer& timer, std::string&) {
+            timer.start();
+            allocate(nullptr, 0, sizes.size());
+            timer.stop();
+            return true;
+        });
+        suite.run("bitmapPool.pooledThreads", "", threadParams, bytes, [&](Timer& timer, std::string&) {
+            timer.start();
+            allocateOnThreads(&pool);
+            timer.stop();
+            return true;
+        });
+        suite.run("bitmapPool.unpooledThreads", "", threadParams, bytes, [&](Timer& timer, std::string&) {
+            timer.start();
+            allocateOnThreads(nullptr);
+            timer.stop();
+            return true;
+        });
+    };
+
+    runAllocator("default");
+#ifdef __GLIBC__
+    mallopt(M_MMAP_THRESHOLD, 128 * 1024);
+    runAllocator("unmapping");
+    // Back to glibc's largest dynamic threshold for the benchmarks that follow
+    mallopt(M_MMAP_THRESHOLD, 32 * 1024 * 1024);
+#endif
+}
+
+// Page store codec over a letter page at 2x: white paper with rows of glyph-like strokes
+void runPageStoreBenchmarks(Suite& suite) {
+    const int width = 1224;
+    const int height = 1584;
+    const size_t size = static_cast<size_t>(width) * height * 4;
+    std::vector<uint8_t> page(size, 0xFF);
+    uint32_t seed = 12345;
+    for (int y = 144; y + 24 < height - 144; y += 36) {
+        for (int row = y; row < y + 24; ++row) {
+            for (int x = 144; x < width - 144; ++x) {
+                seed = seed * 1103515245u + 12345u;
+                if ((seed >> 16) % 5 == 0) {
+                    uint8_t gray = static_cast<uint8_t>((seed >> 8) & 0xFF);
+                    uint8_t* pixel = page.data() + (static_cast<size_t>(row) * width + x) * 4;
+                    pixel[0] = pixel[1] = pixel[2] = gray;
+                }
+            }
+        }
+    }
+
+    std::vector<uint8_t> encoded;
+    PDFPageStore::encode(page.data(), size, 4, encoded);
+    std::string params = "page=1224x1584 ratio=" + jsonNumber(static_cast<double>(size) / encoded.size()).substr(0, 4);
+
+    suite.run("pageStore.encode", "", params, size, [&](Timer& timer, std::string&) {
+        std::vector<uint8_t> out;
+        out.reserve(size / 8);
+        timer.start();
+        PDFPageStore::encode(page.data(), size, 4, out);
+        timer.stop();
+        return true;
+    });
+
+    std::vector<uint8_t> decoded(size);
+    suite.run("pageStore.decode", "", params, size, [&](Timer& timer, std::string& error) {
+        timer.start();
+        bool ok = PDFPageStore::decode(encoded.data(), encoded.size(), 4, decoded.data(), size);
+        timer.stop();
+        if (!ok || decoded != page) {
+            error = "decoded pixels differ from the page";
+            return false;
+        }
+        return true;
+    });
+}
+
+#if PDFJSI_BENCHMARK_JNI
+void runJniBenchmarks(Suite& suite, JNIEnv* env) {
+    std::string small(1024, 'a');
+    suite.run("jni.newStringUtf", "", "chars=1024 calls=1000", 0, [&](Timer& timer, std::string&) {
+        timer.start();
+        for (int i = 0; i < 1000; ++i) {
+            jstring value = env->NewStringUTF(small.c_str());
+            env->DeleteLocalRef(value);
+        }
+        timer.stop();
+        return true;
+    });
+
+    // A base64 payload crossing JNI: whole-string copy against the chunked reads decodeBase64String uses
+    std::string large(1024 * 1024, 'Q');
+    jstring payload = env->NewStringUTF(large.c_str());
+    jsize payloadLength = env->GetStringLength(payload);
+    suite.run("jni.getStringUtfChars", "", "chars=1048576", large.size(), [&](Timer& timer, std::string&) {
+        timer.start();
+        const char* chars = env->GetStringUTFChars(payload, nullptr);
+        std::string copy(chars);
+        env->ReleaseStringUTFChars(payload, chars);
+        timer.stop();
+        return copy.size() == large.size();
+    });
+    std::vector<char> chunk(64 * 1024 * 3 + 1);
+    suite.run("jni.getStringUtfRegion", "", "chars=1048576 chunk=65536", large.size(), [&](Timer& timer, std::string&) {
+        timer.start();
+        for (jsize offset = 0; offset < payloadLength; offset += 64 * 1024) {
+            jsize count = std::min<jsize>(64 * 1024, payloadLength - offset);
+            env->GetStringUTFRegion(payload, offset, count, chunk.data());
+        }
+        timer.stop();
+        return true;
+    });
+    env->DeleteLocalRef(payload);
+
+    // Stand-in for createWritableMap: ten string pairs into a java.util.HashMap
+    jclass mapClass = env->FindClass("java/util/HashMap");
+    jmethodID constructor = env->GetMethodID(mapClass, "<init>", "()V");
+    jmethodID put = env->GetMethodID(mapClass, "put", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
+    suite.run("jni.mapPut", "", "entries=10 maps=100", 0, [&](Timer& timer, std::string&) {
+        timer.start();
+        for (int map = 0; map < 100; ++map) {
+            env->PushLocalFrame(32);
+            jobject object = env->NewObject(mapClass, constructor);
+            for (int entry = 0; entry < 10; ++entry) {
+                jstring key = env->NewStringUTF("metricName");
+                jstring value = env->NewStringUTF("123.456");
+                env->DeleteLocalRef(env->CallObjectMethod(object, put, key, value));
+            }
+            env->PopLocalFrame(nullptr);
+        }
+        timer.stop();
+        return true;
+    });
+    env->DeleteLocalRef(mapClass);
+}
+#endif
+
+#if PDFJSI_BENCHMARK_JVM
+void runHostJniBenchmarks(Suite& suite) {
+    JavaVM* vm = nullptr;
+    JNIEnv* env = nullptr;
+    JavaVMInitArgs args;
+    args.version = JNI_VERSION_1_8;
+    args.nOptions = 0;
+    args.options = nullptr;
+    args.ignoreUnrecognized = JNI_TRUE;
+    if (JNI_CreateJavaVM(&vm, reinterpret_cast<void**>(&env), &args) != JNI_OK) {
+        suite.skip("jni", "could not create a Java VM");
+        return;
+    }
+    runJniBenchmarks(suite, env);
+    vm->DestroyJavaVM();
+}
+#endif
+
+int usage(const char* program) {
+    fprintf(stderr,
+            "usage: %s [--corpus-dir DIR] [--pdf FILE]... [--pdfium LIB] [--iterations N] [--warmup N]\n"
+            "          [--filter SUBSTRING] [--out FILE]\n"
+            "Writes JSON results to stdout (or --out) and a summary to stderr.\n",
+            program);
+    return 2;
+}
+
+bool parseArguments(int argc, char** argv, Options& options) {
+#if defined(__ANDROID__)
+    options.corpusDirectory = "/data/local/tmp/pdfjsi_benchmark_corpus";
+#else
+    options.corpusDirectory = "pdfjsi_benchmark_corpus";
+#endif
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--corpus-dir" && hasValue) {
+            options.corpusDirectory = argv[++i];
+        } else if (arg == "--pdf" && hasValue) {
+            options.extraDocuments.push_back(argv[++i]);
+        } else if (arg == "--pdfium" && hasValue) {
+            options.pdfiumPath = argv[++i];
+        } else if (arg == "--iterations" && hasValue) {
+            options.iterations = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--warmup" && hasValue) {
+            options.warmup = std::max(0, atoi(argv[++i]));
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            options.outputPath = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+int runBenchmarks(const Options& options) {
+    // Loaded globally first so PdfiumApi's dlopen by soname finds it
+    if (!options.pdfiumPath.empty() && !dlopen(options.pdfiumPath.c_str(), RTLD_NOW | RTLD_GLOBAL)) {
+        fprintf(stderr, "Cannot load %s: %s\n", options.pdfiumPath.c_str(), dlerror());
+        return 1;
+    }
+    bool pdfiumAvailable = PdfiumApi::get() != nullptr;
+
+    std::vector<CorpusDocument> corpus;
+    std::string error;
+    mkdir(options.corpusDirectory.c_str(), 0755);
+    if (!BenchmarkCorpus::generate(options.corpusDirectory, corpus, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    for (const std::string& path : options.extraDocuments) {
+        CorpusDocument document;
+        if (!BenchmarkCorpus::load(path, document, error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        corpus.push_back(std::move(document));
+    }
+
+    Suite suite(options);
+    std::string storeDirectory = options.corpusDirectory + "/page_store";
+    for (const CorpusDocument& document : corpus) {
+        if (pdfiumAvailable) {
+            runDocumentBenchmarks(suite, document, storeDirectory);
+        }
+        runBase64Benchmarks(suite, document);
+    }
+    if (!pdfiumAvailable) {
+        suite.skip("open", "Pdfium library not available (see --pdfium)");
+        suite.skip("render", "Pdfium library not available (see --pdfium)");
+        suite.skip("search", "Pdfium library not available (see --pdfium)");
+    }
+    runBitmapPoolBenchmarks(suite);
+    runPageStoreBenchmarks(suite);
+#if PDFJSI_BENCHMARK_JNI
+    if (options.env) {
+        runJniBenchmarks(suite, options.env);
+    } else {
+#if PDFJSI_BENCHMARK_JVM
+        runHostJniBenchmarks(suite);
+#else
+        suite.skip("jni", "no Java VM to call into");
+#endif
+    }
+#else
+    suite.skip("jni", "built without a Java VM (host builds with a JDK or the androidTest harness enable it)");
+#endif
+
+    std::string json = suite.json(corpus, pdfiumAvailable);
+    if (options.outputPath.empty()) {
+        fputs(json.c_str(), stdout);
+        return 0;
+    }
+    FILE* file = fopen(options.outputPath.c_str(), "w");
+    if (!file || fputs(json.c_str(), file) < 0 || fclose(file) != 0) {
+        fprintf(stderr, "Cannot write %s\n", options.outputPath.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+#if PDFJSI_BENCHMARK_LIBRARY
+// PDFJSIBenchmarkTest.nativeRun(String[] args): the command line arguments
+// above; returns the process exit status the executable would have
+extern "C" JNIEXPORT jint JNICALL
+Java_org_wonday_pdf_benchmark_PDFJSIBenchmarkTest_nativeRun(JNIEnv* env, jclass clazz, jobjectArray args) {
+    std::vector<std::string> values(1, "pdfjsi_benchmark");
+    jsize count = env->GetArrayLength(args);
+    for (jsize i = 0; i < count; ++i) {
+        jstring arg = static_cast<jstring>(env->GetObjectArrayElement(args, i));
+        const char* chars = env->GetStringUTFChars(arg, nullptr);
+        values.push_back(chars);
+        env->ReleaseStringUTFChars(arg, chars);
+        env->DeleteLocalRef(arg);
+    }
+    std::vector<char*> argv;
+    for (std::string& value : values) {
+        argv.push_back(&value[0]);
+    }
+
+    Options options;
+    if (!parseArguments(static_cast<int>(argv.size()), argv.data(), options)) {
+        return usage(argv[0]);
+    }
+    options.env = env;
+    return runBenchmarks(options);
+}
+#else
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        return usage(argv[0]);
+    }
+    return runBenchmarks(options);
+}
+#endif
@@ -0,0 +1,37 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Enhanced PDF JSI Integration with high-performance operations
+ * All rights reserved.
+ *
+ * Host stand-in for the NDK logging header, so the engine sources build into
+ * the desktop benchmark. Warnings and errors go to stderr; debug and info
+ * output is dropped to keep benchmark timings and stdout clean.
+ */
+
+#ifndef PDFJSI_BENCHMARK_HOST_ANDROID_LOG_H
+#define PDFJSI_BENCHMARK_HOST_ANDROID_LOG_H
+
+#include <cstdarg>
+#include <cstdio>
+
+enum {
+    ANDROID_LOG_DEBUG = 3,
+    ANDROID_LOG_INFO = 4,
+    ANDROID_LOG_WARN = 5,
+    ANDROID_LOG_ERROR = 6,
+};
+
+inline int __android_log_print(int priority, const char* tag, const char* format, ...) {
+    if (priority < ANDROID_LOG_WARN) {
+        return 0;
+    }
+    va_list args;
+    va_start(args, format);
+    std::fprintf(stderr, "%s: ", tag);
+    int written = std::vfprintf(stderr, format, args);
+    std::fputc('\n', stderr);
+    va_end(args);
+    return written;
+}
+
+#endif // PDFJSI_BENCHMARK_HOST_ANDROID_LOG_H
@@ -1,162 +0,0 @@
-/**
- * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
- * Bitmap Pool for efficient bitmap reuse
- * 
- * OPTIMIZATION: 90% reduction in bitmap allocations, 60% less memory, 40% faster rendering
- * Instead of creating a new Bitmap for each page render, reuse bitmaps from a pool.
- */
-
-package org.wonday.pdf;
-
-import android.graphics.Bitmap;
-import android.graphics.Color;
-import android.util.Log;
-
-import java.util.LinkedList;
-import java.util.Queue;
-
-public class BitmapPool {
-    private static final String TAG = "BitmapPool";
-    private static final int MAX_POOL_SIZE = 10;
-    private final Queue<Bitmap> pool = new LinkedList<>();
-    private final Object lock = new Object();
-    
-    // Statistics
-    private int poolHits = 0;
-    private int poolMisses = 0;
-    private int totalCreated = 0;
-    private int totalRecycled = 0;
-    
-    /**
-     * Obtain a bitmap from the pool or create a new one
-     * @param width Desired width
-     * @param height Desired height
-     * @param config Bitmap configuration
-     * @return Bitmap ready for use
-     */
-    public Bitmap obtain(int width, int height, Bitmap.Config config) {
-        synchronized (lock) {
-            // Try to find a suitable bitmap in the pool
-            Bitmap bitmap = pool.poll();
-            
-            if (bitmap != null && 
-                bitmap.getWidth() == width && 
-                bitmap.getHeight() == height && 
-                bitmap.getConfig() == config &&
-                !bitmap.isRecycled()) {
-                
-                poolHits++;
-                Log.d(TAG, String.format("Pool HIT: %dx%d, pool size: %d, hit rate: %.1f%%", 
-                    width, height, pool.size(), getHitRate() * 100));
-                return bitmap;
-            }
-            
-            // Put back if not suitable
-            if (bitmap != null && !bitmap.isRecycled()) {
-                pool.offer(bitmap);
-            }
-            
-            // Create new bitmap if no suitable one found
-            poolMisses++;
-            totalCreated++;
-            Log.d(TAG, String.format("Pool MISS: Creating new %dx%d bitmap, total created: %d", 
-                width, height, totalCreated));
-            return Bitmap.createBitmap(width, height, config);
-        }
-    }
-    
-    /**
-     * Return a bitmap to the pool for reuse
-     * @param bitmap Bitmap to recycle
-     */
-    public void recycle(Bitmap bitmap) {
-        if (bitmap == null || bitmap.isRecycled()) {
-            return;
-        }
-        
-        synchronized (lock) {
-            if (pool.size() < MAX_POOL_SIZE) {
-                // Clear bitmap for reuse
-                bitmap.eraseColor(Color.TRANSPARENT);
-                pool.offer(bitmap);
-                totalRecycled++;
-                Log.d(TAG, String.format("Bitmap recycled to pool, pool size: %d, total recycled: %d", 
-                    pool.size(), totalRecycled));
-            } else {
-                // Pool full, recycle bitmap
-                bitmap.recycle();
-                Log.d(TAG, "Pool full, bitmap recycled to system");
-            }
-        }
-    }
-    
-    /**
-     * Clear the entire pool
-     */
-    public void clear() {
-        synchronized (lock) {
-            while (!pool.isEmpty()) {
-                Bitmap bitmap = pool.poll();
-                if (bitmap != null && !bitmap.isRecycled()) {
-                    bitmap.recycle();
-                }
-            }
-            Log.d(TAG, "Bitmap pool cleared");
-        }
-    }
-    
-    /**
-     * Get pool statistics
-     * @return Statistics string
-     */
-    public String getStatistics() {
-        synchronized (lock) {
-            int totalAccess = poolHits + poolMisses;
-            double hitRate = totalAccess > 0 ? (double) poolHits / totalAccess : 0.0;
-            
-            return String.format(
-                "BitmapPool Stats: Size=%d/%d, Hits=%d, Misses=%d, HitRate=%.1f%%, Created=%d, Recycled=%d",
-                pool.size(), MAX_POOL_SIZE, poolHits, poolMisses, hitRate * 100, 
-                totalCreated, totalRecycled
-            );
-        }
-    }
-    
-    /**
-     * Get hit rate
-     * @return Hit rate (0.0 to 1.0)
-     */
-    public double getHitRate() {
-        synchronized (lock) {
-            int totalAccess = poolHits + poolMisses;
-            return totalAccess > 0 ? (double) poolHits / totalAccess : 0.0;
-        }
-    }
-    
-    /**
-     * Get current pool size
-     * @return Number of bitmaps in pool
-     */
-    public int getPoolSize() {
-        synchronized (lock) {
-            return pool.size();
-        }
-    }
-    
-    /**
-     * Get total memory used by pool (approximate)
-     * @return Memory in bytes
-     */
-    public long getMemoryUsage() {
-        synchronized (lock) {
-            long totalMemory = 0;
-            for (Bitmap bitmap : pool) {
-                if (bitmap != null && !bitmap.isRecycled()) {
-                    totalMemory += bitmap.getByteCount();
-                }
-            }
-            return totalMemory;
-        }
-    }
-}
-
@@ -8,6 +8,7 @@
 
 package org.wonday.pdf;
 
+import android.os.ParcelFileDescriptor;
 import android.util.Log;
 
 import java.io.File;
@@ -31,7 +32,7 @@ public class MemoryMappedCache {
     // Statistics
     private int totalMaps = 0;
     private int totalUnmaps = 0;
-    private long totalBytesM apped = 0;
+    private long totalBytesMapped = 0;
     
     /**
      * Memory-map a PDF file for zero-copy access
@@ -85,7 +86,41 @@ public class MemoryMappedCache {
     }
     
     /**
-     * Read PDF bytes from memory-mapped file (zero-copy)
+     * Open a cached PDF in the native document registry straight from its file
+     * OPTIMIZATION: Native code maps the file itself, so the document is never
+     * copied into a byte[]; Pdfium reads pages lazily from the page cache.
+     * The native mapping is independent of mapPDFFile/unmapPDF and lives until
+     * the last NativeDocumentRegistry reference to pdfId is released.
+     * @param pdfId Document identifier in the native registry
+     * @param pdfFile PDF file to map
+     * @return Page count, or -1 if the document could not be opened
+     */
+    public int acquireNativeDocument(String pdfId, File pdfFile) {
+        if (!pdfFile.exists()) {
+            Log.w(TAG, "PDF file not found: " + pdfFile.getAbsolutePath());
+            return -1;
+        }
+        try (ParcelFileDescriptor descriptor = ParcelFileDescriptor.open(pdfFile, ParcelFileDescriptor.MODE_READ_ONLY)) {
+            int pageCount = NativeDocumentRegistry.acquireDescriptor(pdfId, descriptor.getFd());
+            if (pageCount > 0) {
+                synchronized (lock) {
+                    totalMaps++;
+                    totalBytesMapped += pdfFile.length();
+                }
+                Log.d(TAG, String.format("Native memory map for %s: %d pages, %d bytes",
+                    pdfId, pageCount, pdfFile.length()));
+            }
+            return pageCount;
+        } catch (IOException e) {
+            Log.e(TAG, "Error opening PDF for native mapping: " + pdfFile.getAbsolutePath(), e);
+            return -1;
+        }
+    }
+    
+    /**
+     * Read PDF bytes from memory-mapped file
+     * Copies the range into a new array; use acquireNativeDocument to hand
+     * whole documents to the native engine without a copy
      * @param cacheId Unique cache identifier
      * @param offset Offset in bytes
      * @param length Number of bytes to read
@@ -204,6 +239,29 @@ public class MemoryMappedCache {
         }
     }
     
+    /**
+     * Unmap least recently used files until at most maxMappings remain
+     * @param maxMappings Mappings to keep
+     * @return Number of files unmapped
+     */
+    public int trimTo(int maxMappings) {
+        synchronized (lock) {
+            int unmapped = 0;
+            while (mappedBuffers.size() > Math.max(0, maxMappings)) {
+                int before = mappedBuffers.size();
+                evictLeastRecentlyUsed();
+                if (mappedBuffers.size() >= before) {
+                    break;
+                }
+                unmapped++;
+            }
+            if (unmapped > 0) {
+                Log.d(TAG, "Trimmed " + unmapped + " memory maps under memory pressure");
+            }
+            return unmapped;
+        }
+    }
+    
     /**
      * Clear all memory-mapped resources
      */
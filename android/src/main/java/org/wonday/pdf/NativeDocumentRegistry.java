@@ -0,0 +1,218 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Shared native document registry
+ *
+ * OPTIMIZATION: One native parse per document instead of one per subsystem
+ * PdfView, PDFExporter, thumbnails and the JSI fast path acquire documents here
+ * by pdfId; the native PDFJSI singleton opens each file once, reference counts
+ * it and closes it when the last holder releases it (or on nativeCleanupJSI).
+ */
+
+package org.wonday.pdf;
+
+import android.graphics.Bitmap;
+import android.util.Log;
+
+import com.facebook.soloader.SoLoader;
+
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+public final class NativeDocumentRegistry {
+    private static final String TAG = "NativeDocumentRegistry";
+    private static final boolean nativeAvailable;
+
+    // Values per page in getPageGeometry tables (PDFJSI_PAGE_GEOMETRY_FIELDS)
+    public static final int PAGE_GEOMETRY_FIELDS = 12;
+
+    // Single thread keeps acquire/release from views ordered and off the UI thread
+    private static final ExecutorService registryExecutor = Executors.newSingleThreadExecutor();
+
+    static {
+        boolean loaded = false;
+        try {
+            SoLoader.loadLibrary("pdfjsi");
+            loaded = true;
+        } catch (UnsatisfiedLinkError e) {
+            Log.e(TAG, "PDF JSI native library not available, registry disabled", e);
+        }
+        nativeAvailable = loaded;
+    }
+
+    private NativeDocumentRegistry() {}
+
+    public static boolean isAvailable() {
+        return nativeAvailable;
+    }
+
+    /**
+     * Open (or reuse) a document and add a reference for pdfId
+     * @param pdfId Document identifier shared by all holders
+     * @param filePath Local file path; may be null when pdfId is itself a path
+     * @return Page count, or -1 if the document could not be opened
+     */
+    public static int acquire(String pdfId, String filePath) {
+        if (!nativeAvailable || pdfId == null) {
+            return -1;
+        }
+        return nativeAcquire(pdfId, filePath);
+    }
+
+    /**
+     * Open (or reuse) a document by memory-mapping an open file descriptor
+     * OPTIMIZATION: No heap copy of the document; pages fault in from the page cache
+     * The native side makes its own mapping, so the caller may close fd afterwards.
+     * @param pdfId Document identifier shared by all holders
+     * @param fd Readable descriptor of a regular file
+     * @return Page count, or -1 if the document could not be opened
+     */
+    public static int acquireDescriptor(String pdfId, int fd) {
+        if (!nativeAvailable || pdfId == null || fd < 0) {
+            return -1;
+        }
+        return nativeAcquireDescriptor(pdfId, fd);
+    }
+
+    /**
+     * Drop one reference; the native document closes with its last reference
+     */
+    public static void release(String pdfId) {
+        if (!nativeAvailable || pdfId == null) {
+            return;
+        }
+        nativeRelease(pdfId);
+    }
+
+    /**
+     * Asynchronous acquire for callers on the UI thread (e.g. PdfView)
+     */
+    public static void acquireAsync(final String pdfId, final String filePath) {
+        if (!nativeAvailable || pdfId == null) {
+            return;
+        }
+        registryExecutor.execute(() -> {
+            int pageCount = nativeAcquire(pdfId, filePath);
+            Log.d(TAG, "acquireAsync " + pdfId + " -> " + pageCount + " pages");
+        });
+    }
+
+    /**
+     * Asynchronous release, ordered after the caller's earlier acquireAsync
+     */
+    public static void releaseAsync(final String pdfId) {
+        if (!nativeAvailable || pdfId == null) {
+            return;
+        }
+        registryExecutor.execute(() -> nativeRelease(pdfId));
+    }
+
+    /**
+     * Page size in points
+     * @param pageNumber Page number (starting from 1)
+     * @return {width, height, rotationDegrees}, or null if unavailable
+     */
+    public static float[] getPageSize(String pdfId, int pageNumber) {
+        if (!nativeAvailable || pdfId == null) {
+            return null;
+        }
+        return nativeGetPageSize(pdfId, pageNumber);
+    }
+
+    /**
+     * Geometry of every page, measuring only pages the native side has not seen
+     * @return PAGE_GEOMETRY_FIELDS values per page (width, height, mediaBox
+     *         left/bottom/right/top, cropBox left/bottom/right/top, rotation,
+     *         userUnit), or null if the document is not open
+     */
+    public static float[] getPageGeometry(String pdfId) {
+        if (!nativeAvailable || pdfId == null) {
+            return null;
+        }
+        return nativeGetPageGeometry(pdfId);
+    }
+
+    /**
+     * Seed the native document with a table from getPageGeometry, so page sizes
+     * are answered without loading pages
+     * @return false if the table does not match the document's page count
+     */
+    public static boolean setPageGeometry(String pdfId, float[] geometry) {
+        if (!nativeAvailable || pdfId == null || geometry == null) {
+            return false;
+        }
+        return nativeSetPageGeometry(pdfId, geometry);
+    }
+
+    /**
+     * Name the document's pages in the persistent native page store
+     * OPTIMIZATION: Pages rendered in an earlier launch are decoded from disk instead of rasterized
+     * @param key Content checksum of the file; equal files share their stored pages
+     * @return false if pdfId is not open
+     */
+    public static boolean setPageStoreKey(String pdfId, String key) {
+        if (!nativeAvailable || pdfId == null || key == null) {
+            return false;
+        }
+        return nativeSetPageStoreKey(pdfId, key);
+    }
+
+    /**
+     * Read a shown page's glyph, word and link boxes into the native hit index
+     * OPTIMIZATION: Runs on the index's own thread, so hitTest/selectText on the
+     * page answer from a spatial grid instead of loading the page text
+     * @param pageNumber Page number (starting from 1)
+     */
+    public static void prefetchHitIndex(String pdfId, int pageNumber) {
+        if (!nativeAvailable || pdfId == null) {
+            return;
+        }
+        nativePrefetchHitIndex(pdfId, pageNumber);
+    }
+
+    /**
+     * Render a page into an ARGB_8888 bitmap, scaled to the bitmap's size
+     * @param pageNumber Page number (starting from 1)
+     * @return true if the page was rendered natively
+     */
+    public static boolean renderPage(String pdfId, int pageNumber, Bitmap bitmap) {
+        if (!nativeAvailable || pdfId == null || bitmap == null
+                || bitmap.getConfig() != Bitmap.Config.ARGB_8888) {
+            return false;
+        }
+        return nativeRenderPageToBitmap(pdfId, pageNumber, bitmap);
+    }
+
+    /**
+     * Mark a scroll or zoom gesture on the document; native JSI renders drop
+     * to draft quality until active is false or shortly after the last call
+     */
+    public static void setInteracting(String pdfId, boolean active) {
+        if (!nativeAvailable || pdfId == null) {
+            return;
+        }
+        nativeSetInteracting(pdfId, active);
+    }
+
+    /**
+     * Release pooled render buffers and cached pages for an onTrimMemory level
+     * @param level ComponentCallbacks2.TRIM_MEMORY_* level
+     */
+    public static void trimMemory(int level) {
+        if (!nativeAvailable) {
+            return;
+        }
+        nativeTrimMemory(level);
+    }
+
+    private static native int nativeAcquire(String pdfId, String filePath);
+    private static native int nativeAcquireDescriptor(String pdfId, int fd);
+    private static native void nativeRelease(String pdfId);
+    private static native float[] nativeGetPageSize(String pdfId, int pageNumber);
+    private static native float[] nativeGetPageGeometry(String pdfId);
+    private static native boolean nativeSetPageGeometry(String pdfId, float[] geometry);
+    private static native boolean nativeSetPageStoreKey(String pdfId, String key);
+    private static native boolean nativeRenderPageToBitmap(String pdfId, int pageNumber, Bitmap bitmap);
+    private static native void nativePrefetchHitIndex(String pdfId, int pageNumber);
+    private static native void nativeSetInteracting(String pdfId, boolean active);
+    private static native void nativeTrimMemory(int level);
+}
@@ -5,7 +5,10 @@ import android.graphics.Canvas;
 import android.graphics.Color;
 import android.graphics.Paint;
 import android.graphics.Rect;
+import android.app.ActivityManager;
+import android.content.Context;
 import android.graphics.pdf.PdfRenderer;
+import android.os.Build;
 import android.os.ParcelFileDescriptor;
 import android.util.Log;
 
@@ -18,6 +21,7 @@ import com.facebook.react.bridge.ReadableMap;
 import com.facebook.react.bridge.WritableArray;
 import com.facebook.react.bridge.WritableMap;
 import com.facebook.react.bridge.Arguments;
+import com.facebook.react.modules.core.DeviceEventManagerModule;
 
 import java.io.File;
 import java.io.FileOutputStream;
@@ -26,14 +30,23 @@ import java.util.ArrayList;
 import java.util.List;
 import java.util.Date;
 import java.util.Locale;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.Semaphore;
+import java.util.concurrent.atomic.AtomicInteger;
 import java.text.SimpleDateFormat;
 import android.graphics.pdf.PdfDocument;
 
 public class PDFExporter extends ReactContextBaseJavaModule {
     private static final String TAG = "PDFExporter";
+    private static final String EXPORT_PROGRESS_EVENT = "PDFExportProgress";
+    // Floor of the page pixel budget, so small heaps still export one page at a time
+    private static final long EXPORT_MIN_BITMAP_BUDGET_KB = 16 * 1024;
     private LicenseVerifier licenseVerifier;
-    // OPTIMIZATION: Bitmap pool for 90% reduction in bitmap allocations
-    private final BitmapPool bitmapPool = new BitmapPool();
+    // Runs whole exports one after another; each export starts its own page workers
+    private final ExecutorService exportExecutor = Executors.newSingleThreadExecutor();
 
     public PDFExporter(ReactApplicationContext reactContext) {
         super(reactContext);
@@ -45,6 +58,16 @@ public class PDFExporter extends ReactContextBaseJavaModule {
         return "PDFExporter";
     }
 
+    /**
+     * Stops the export thread with the module; an export in progress is
+     * interrupted and its page workers are shut down
+     */
+    @Override
+    public void invalidate() {
+        super.invalidate();
+        exportExecutor.shutdownNow();
+    }
+
     /**
      * Generate a unique filename with timestamp to prevent overwrites
      * @param baseName Base filename without extension
@@ -66,6 +89,14 @@ public class PDFExporter extends ReactContextBaseJavaModule {
     }
 
     
+    /**
+     * Export pages to image files
+     * OPTIMIZATION: Pages render and encode on a worker pool sized to the cores, each
+     * image is written as soon as its page finishes, and the pixels of pages in flight
+     * are capped, so long documents neither take minutes nor run out of memory.
+     * Emits PDFExportProgress events ({ progressId, filePath, page, completed, total, path })
+     * when options.progressId is set; resolves with paths in page order.
+     */
     @ReactMethod
     public void exportToImages(String filePath, ReadableMap options, Promise promise) {
         try {
@@ -89,15 +120,32 @@ public class PDFExporter extends ReactContextBaseJavaModule {
             int dpi = options.hasKey("dpi") ? options.getInt("dpi") : 150;
             String format = options.hasKey("format") ? options.getString("format") : "png";
             String outputDir = options.hasKey("outputDir") ? options.getString("outputDir") : null;
+            String progressId = options.hasKey("progressId") ? options.getString("progressId") : null;
 
-            List<String> exportedFiles = exportPagesToImages(pdfFile, pages, dpi, format, outputDir);
-
-            WritableArray result = Arguments.createArray();
-            for (String file : exportedFiles) {
-                result.pushString(file);
+            List<Integer> requested = null;
+            if (pages != null && pages.size() > 0) {
+                requested = new ArrayList<>();
+                for (int i = 0; i < pages.size(); i++) {
+                    requested.add(pages.getInt(i));
+                }
             }
+            final List<Integer> requestedPages = requested;
 
-            promise.resolve(result);
+            // Off the module thread, which would otherwise be blocked for the whole export
+            exportExecutor.execute(() -> {
+                try {
+                    List<String> exportedFiles = exportPagesToImages(pdfFile, requestedPages, dpi, format, outputDir, progressId);
+
+                    WritableArray result = Arguments.createArray();
+                    for (String file : exportedFiles) {
+                        result.pushString(file);
+                    }
+                    promise.resolve(result);
+                } catch (Exception e) {
+                    Log.e(TAG, "Error exporting to images", e);
+                    promise.reject("EXPORT_ERROR", e.getMessage());
+                }
+            });
 
         } catch (Exception e) {
             Log.e(TAG, "Error exporting to images", e);
@@ -105,6 +153,15 @@ public class PDFExporter extends ReactContextBaseJavaModule {
         }
     }
 
+    // Required by NativeEventEmitter for PDFExportProgress
+    @ReactMethod
+    public void addListener(String eventName) {
+    }
+
+    @ReactMethod
+    public void removeListeners(double count) {
+    }
+
     @ReactMethod
     public void exportPageToImage(String filePath, int pageIndex, ReadableMap options, Promise promise) {
         try {
@@ -157,6 +214,25 @@ public class PDFExporter extends ReactContextBaseJavaModule {
     private String exportSinglePageToImage(File pdfFile, int pageIndex, int dpi, String format, String outputDir) throws IOException {
         Log.i(TAG, "🖼️ [EXPORT] exportSinglePageToImage - START - pageIndex: " + pageIndex + ", dpi: " + dpi + ", format: " + format);
         
+        // Prefer the shared native document: reuses the parse held by the viewer or JSI engine
+        String pdfId = pdfFile.getAbsolutePath();
+        int nativePageCount = NativeDocumentRegistry.acquire(pdfId, pdfId);
+        if (nativePageCount > 0) {
+            try {
+                if (pageIndex < 0 || pageIndex >= nativePageCount) {
+                    Log.e(TAG, "❌ [EXPORT] Invalid page index: " + pageIndex + " (total: " + nativePageCount + ")");
+                    throw new IOException("Invalid page index: " + pageIndex);
+                }
+                Bitmap nativeBitmap = renderPageNative(pdfId, pageIndex, dpi / 72f);
+                if (nativeBitmap != null) {
+                    Log.i(TAG, "✅ [RENDER] Page rendered natively");
+                    return writePageImage(nativeBitmap, pdfFile, pageIndex, format, outputDir);
+                }
+            } finally {
+                NativeDocumentRegistry.release(pdfId);
+            }
+        }
+        
         try (ParcelFileDescriptor fileDescriptor = ParcelFileDescriptor.open(pdfFile, ParcelFileDescriptor.MODE_READ_ONLY);
              PdfRenderer pdfRenderer = new PdfRenderer(fileDescriptor)) {
 
@@ -176,80 +252,104 @@ public class PDFExporter extends ReactContextBaseJavaModule {
             
             Log.i(TAG, "🖼️ [BITMAP] Creating bitmap - width: " + width + "px, height: " + height + "px, dpi: " + dpi);
             
-            // OPTIMIZATION: Use bitmap pool for reduced allocations
-            Bitmap bitmap = bitmapPool.obtain(width, height, Bitmap.Config.ARGB_8888);
-            Canvas canvas = new Canvas(bitmap);
-            canvas.drawColor(Color.WHITE);
-            
-            Bitmap renderBitmap = bitmapPool.obtain(width, height, Bitmap.Config.ARGB_8888);
+            // OPTIMIZATION: PdfRenderer draws over the existing contents, so the page
+            // renders straight onto white paper without a second bitmap
+            Bitmap bitmap = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888);
+            bitmap.eraseColor(Color.WHITE);
             Log.i(TAG, "🖼️ [RENDER] Rendering page to bitmap...");
-            page.render(renderBitmap, null, null, PdfRenderer.Page.RENDER_MODE_FOR_PRINT);
-            canvas.drawBitmap(renderBitmap, 0, 0, null);
-            bitmapPool.recycle(renderBitmap); // Return to pool instead of recycle()
+            page.render(bitmap, null, null, PdfRenderer.Page.RENDER_MODE_FOR_PRINT);
             
             page.close();
             Log.i(TAG, "✅ [RENDER] Page rendered successfully");
 
-            if (outputDir == null) {
-                outputDir = getReactApplicationContext().getCacheDir().getAbsolutePath();
-                Log.i(TAG, "📁 [FILE] Using cache dir: " + outputDir);
-            }
+            return writePageImage(bitmap, pdfFile, pageIndex, format, outputDir);
+        }
+    }
 
-            // Generate unique filename with timestamp to prevent overwrites
-            String baseName = pdfFile.getName().replace(".pdf", "");
-            String fileName = generateTimestampedFileName(baseName, pageIndex + 1, format);
-            File outputFile = new File(outputDir, fileName);
-            
-            Log.i(TAG, "📁 [FILE] Writing to: " + outputFile.getAbsolutePath());
+    /**
+     * Render a page from the shared native document registry
+     * @param pdfId Registry key of an acquired document
+     * @param pageIndex Page index (starting from 0)
+     * @param scale Pixels per PDF point (dpi / 72)
+     * @return Rendered bitmap, or null to fall back to PdfRenderer
+     */
+    private Bitmap renderPageNative(String pdfId, int pageIndex, float scale) {
+        float[] pageSize = NativeDocumentRegistry.getPageSize(pdfId, pageIndex + 1);
+        if (pageSize == null) {
+            return null;
+        }
+
+        int width = Math.max(1, (int) (pageSize[0] * scale));
+        int height = Math.max(1, (int) (pageSize[1] * scale));
+        Bitmap bitmap = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888);
+        if (!NativeDocumentRegistry.renderPage(pdfId, pageIndex + 1, bitmap)) {
+            bitmap.recycle();
+            return null;
+        }
+        return bitmap;
+    }
+
+    private String writePageImage(Bitmap bitmap, File pdfFile, int pageIndex, String format, String outputDir) throws IOException {
+        if (outputDir == null) {
+            outputDir = getReactApplicationContext().getCacheDir().getAbsolutePath();
+            Log.i(TAG, "📁 [FILE] Using cache dir: " + outputDir);
+        }
+
+        // Generate unique filename with timestamp to prevent overwrites
+        String baseName = pdfFile.getName().replace(".pdf", "");
+        String fileName = generateTimestampedFileName(baseName, pageIndex + 1, format);
+        File outputFile = new File(outputDir, fileName);
+        
+        Log.i(TAG, "📁 [FILE] Writing to: " + outputFile.getAbsolutePath());
+        
+        try (FileOutputStream out = new FileOutputStream(outputFile)) {
+            // OPTIMIZATION: Smart format selection for better performance
+            // JPEG: 5-6x faster than PNG, 90% quality is visually identical
+            // WebP: 3-4x faster than PNG, better compression than JPEG
+            // PNG: Slowest but lossless (use only when required)
+            Bitmap.CompressFormat compressFormat;
+            int qualityPercent;
             
-            try (FileOutputStream out = new FileOutputStream(outputFile)) {
-                // OPTIMIZATION: Smart format selection for better performance
-                // JPEG: 5-6x faster than PNG, 90% quality is visually identical
-                // WebP: 3-4x faster than PNG, better compression than JPEG
-                // PNG: Slowest but lossless (use only when required)
-                Bitmap.CompressFormat compressFormat;
-                int qualityPercent;
-                
-                if (format.equalsIgnoreCase("jpeg") || format.equalsIgnoreCase("jpg")) {
-                    compressFormat = Bitmap.CompressFormat.JPEG;
-                    qualityPercent = 90; // High quality, much faster than PNG
-                } else if (format.equalsIgnoreCase("webp")) {
-                    compressFormat = Bitmap.CompressFormat.WEBP;
-                    qualityPercent = 90; // Modern format, balanced speed/quality
-                } else {
-                    // PNG: Default for backward compatibility
-                    compressFormat = Bitmap.CompressFormat.PNG;
-                    qualityPercent = 100;
-                }
-                
-                Log.i(TAG, "📁 [FILE] Compressing as " + compressFormat + " at " + qualityPercent + "% quality");
-                bitmap.compress(compressFormat, qualityPercent, out);
+            if (format.equalsIgnoreCase("jpeg") || format.equalsIgnoreCase("jpg")) {
+                compressFormat = Bitmap.CompressFormat.JPEG;
+                qualityPercent = 90; // High quality, much faster than PNG
+            } else if (format.equalsIgnoreCase("webp")) {
+                compressFormat = Bitmap.CompressFormat.WEBP;
+                qualityPercent = 90; // Modern format, balanced speed/quality
+            } else {
+                // PNG: Default for backward compatibility
+                compressFormat = Bitmap.CompressFormat.PNG;
+                qualityPercent = 100;
             }
             
-            bitmap.recycle();
-            
-            long fileSize = outputFile.length();
-            Log.i(TAG, "✅ [EXPORT] exportSinglePageToImage - SUCCESS - size: " + fileSize + " bytes, path: " + outputFile.getAbsolutePath());
-            return outputFile.getAbsolutePath();
+            Log.i(TAG, "📁 [FILE] Compressing as " + compressFormat + " at " + qualityPercent + "% quality");
+            bitmap.compress(compressFormat, qualityPercent, out);
         }
+        
+        bitmap.recycle();
+        
+        long fileSize = outputFile.length();
+        Log.i(TAG, "✅ [EXPORT] exportSinglePageToImage - SUCCESS - size: " + fileSize + " bytes, path: " + outputFile.getAbsolutePath());
+        return outputFile.getAbsolutePath();
     }
 
     
-    private List<String> exportPagesToImages(File pdfFile, ReadableArray pages, int dpi, String format, String outputDir) throws IOException {
+    private List<String> exportPagesToImages(File pdfFile, List<Integer> pages, int dpi, String format,
+                                             String outputDir, String progressId) throws IOException {
         Log.i(TAG, "🖼️ [EXPORT] exportPagesToImages - START - dpi: " + dpi + ", format: " + format);
-        
-        List<String> exportedFiles = new ArrayList<>();
-        
-        try (ParcelFileDescriptor fileDescriptor = ParcelFileDescriptor.open(pdfFile, ParcelFileDescriptor.MODE_READ_ONLY);
-             PdfRenderer pdfRenderer = new PdfRenderer(fileDescriptor)) {
 
-            int pageCount = pdfRenderer.getPageCount();
+        // Prefer the shared native document, as exportSinglePageToImage does; workers
+        // fall back to a PdfRenderer of their own, since one renderer holds one open page
+        String pdfId = pdfFile.getAbsolutePath();
+        int nativePageCount = NativeDocumentRegistry.acquire(pdfId, pdfId);
+        final boolean nativeDocument = nativePageCount > 0;
+        try {
+            int pageCount = nativeDocument ? nativePageCount : countPages(pdfFile);
             Log.i(TAG, "📁 [FILE] PDF has " + pageCount + " total pages");
 
             List<Integer> pagesToExport = new ArrayList<>();
-            if (pages != null && pages.size() > 0) {
-                for (int i = 0; i < pages.size(); i++) {
-                    int pageIndex = pages.getInt(i);
+            if (pages != null) {
+                for (int pageIndex : pages) {
                     if (pageIndex >= 0 && pageIndex < pageCount) {
                         pagesToExport.add(pageIndex);
                     }
@@ -261,48 +361,192 @@ public class PDFExporter extends ReactContextBaseJavaModule {
                 }
                 Log.i(TAG, "📊 [PROGRESS] Exporting all " + pageCount + " pages");
             }
+            if (pagesToExport.isEmpty()) {
+                return new ArrayList<>();
+            }
+            if (outputDir != null && !outputDir.isEmpty()) {
+                new File(outputDir).mkdirs();
+            }
 
-            int current = 0;
-            for (int pageIndex : pagesToExport) {
-                try {
-                    current++;
-                    Log.i(TAG, "📊 [PROGRESS] Exporting page " + current + "/" + pagesToExport.size() + " (page number: " + (pageIndex + 1) + ")");
-                    
-                    PdfRenderer.Page page = pdfRenderer.openPage(pageIndex);
-                    
-                    float scale = dpi / 72f; // 72 DPI is default
-                    int width = (int) (page.getWidth() * scale);
-                    int height = (int) (page.getHeight() * scale);
+            final int total = pagesToExport.size();
+            final float scale = dpi / 72f; // 72 DPI is default
+            final String[] exported = new String[total];
+            final AtomicInteger next = new AtomicInteger();
+            final AtomicInteger completed = new AtomicInteger();
+            // Pixel memory of the page bitmaps alive at once, in KB
+            final int budgetKb = (int) Math.max(EXPORT_MIN_BITMAP_BUDGET_KB,
+                    Math.min(Integer.MAX_VALUE, bitmapMemoryBudget() / 1024));
+            final Semaphore bitmapBudget = new Semaphore(budgetKb);
+
+            int workers = Math.max(1, Math.min(Runtime.getRuntime().availableProcessors(), total));
+            ExecutorService pool = Executors.newFixedThreadPool(workers);
+            List<Future<?>> running = new ArrayList<>();
+            for (int w = 0; w < workers; w++) {
+                running.add(pool.submit(() -> {
+                    ParcelFileDescriptor descriptor = null;
+                    PdfRenderer renderer = null;
+                    try {
+                        for (int i = next.getAndIncrement(); i < total; i = next.getAndIncrement()) {
+                            int pageIndex = pagesToExport.get(i);
+                            String outputPath = null;
+                            try {
+                                if (!nativeDocument && renderer == null) {
+                                    descriptor = ParcelFileDescriptor.open(pdfFile, ParcelFileDescriptor.MODE_READ_ONLY);
+                                    renderer = new PdfRenderer(descriptor);
+                                }
+                                outputPath = exportPage(pdfId, renderer, pageIndex, scale, format, outputDir, bitmapBudget, budgetKb);
+                                exported[i] = outputPath;
+                            } catch (Exception e) {
+                                Log.e(TAG, "❌ [EXPORT] Error exporting page " + (pageIndex + 1), e);
+                            }
+                            emitProgress(progressId, pdfId, pageIndex + 1, completed.incrementAndGet(), total, outputPath);
+                        }
+                    } finally {
+                        closeQuietly(renderer, descriptor);
+                    }
+                }));
+            }
+            pool.shutdown();
+            try {
+                for (Future<?> worker : running) {
+                    worker.get();
+                }
+            } catch (InterruptedException e) {
+                pool.shutdownNow();
+                Thread.currentThread().interrupt();
+                throw new IOException("Export interrupted");
+            } catch (ExecutionException e) {
+                throw new IOException("Export worker failed", e.getCause());
+            }
 
-                    Log.i(TAG, "🖼️ [BITMAP] Creating " + width + "x" + height + " bitmap");
-                    
-                    Bitmap bitmap = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888);
-                    Canvas canvas = new Canvas(bitmap);
-                    canvas.drawColor(Color.WHITE);
+            List<String> exportedFiles = new ArrayList<>();
+            for (String path : exported) {
+                if (path != null) {
+                    exportedFiles.add(path);
+                }
+            }
+            Log.i(TAG, "✅ [EXPORT] exportPagesToImages - SUCCESS - Exported " + exportedFiles.size() + " pages with " + workers + " workers");
+            return exportedFiles;
+        } finally {
+            if (nativeDocument) {
+                NativeDocumentRegistry.release(pdfId);
+            }
+        }
+    }
+
+    /**
+     * Render, encode and write one page; the bitmap is recycled before returning
+     * @param renderer Worker's own renderer, or null to render from the native document
+     */
+    /**
+     * Bytes of page pixels an export may hold at once: a quarter of the memory
+     * bitmaps are allocated from. Bitmap pixels live in the native heap from
+     * Android 8.0 (API 26), where the Java heap limit says nothing about them,
+     * so the budget comes from the memory the system can still hand out.
+     */
+    private long bitmapMemoryBudget() {
+        if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.O) {
+            ActivityManager activityManager =
+                    (ActivityManager) getReactApplicationContext().getSystemService(Context.ACTIVITY_SERVICE);
+            if (activityManager != null) {
+                ActivityManager.MemoryInfo memoryInfo = new ActivityManager.MemoryInfo();
+                activityManager.getMemoryInfo(memoryInfo);
+                // Below the threshold the system starts killing background processes
+                return Math.max(0L, memoryInfo.availMem - memoryInfo.threshold) / 4;
+            }
+        }
+        return Runtime.getRuntime().maxMemory() / 4;
+    }
 
-                    page.render(bitmap, null, null, PdfRenderer.Page.RENDER_MODE_FOR_DISPLAY);
+    private String exportPage(String pdfId, PdfRenderer renderer, int pageIndex, float scale, String format,
+                              String outputDir, Semaphore bitmapBudget, int budgetKb) throws Exception {
+        PdfRenderer.Page page = null;
+        int width;
+        int height;
+        if (renderer != null) {
+            page = renderer.openPage(pageIndex);
+            width = Math.max(1, (int) (page.getWidth() * scale));
+            height = Math.max(1, (int) (page.getHeight() * scale));
+        } else {
+            float[] pageSize = NativeDocumentRegistry.getPageSize(pdfId, pageIndex + 1);
+            if (pageSize == null) {
+                throw new IOException("Cannot measure page " + (pageIndex + 1));
+            }
+            width = Math.max(1, (int) (pageSize[0] * scale));
+            height = Math.max(1, (int) (pageSize[1] * scale));
+        }
 
-                    String fileName = String.format("page_%d.%s", pageIndex + 1, format);
-                    String outputPath = saveBitmap(bitmap, fileName, outputDir);
-                    exportedFiles.add(outputPath);
+        // A page larger than the whole budget waits for every other page to finish
+        int costKb = (int) Math.min(budgetKb, Math.max(1L, (long) width * height * 4 / 1024));
+        bitmapBudget.acquire(costKb);
+        Bitmap bitmap = null;
+        try {
+            bitmap = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888);
+            if (page != null) {
+                // PdfRenderer draws over the existing contents, so start from white paper
+                bitmap.eraseColor(Color.WHITE);
+                page.render(bitmap, null, null, PdfRenderer.Page.RENDER_MODE_FOR_DISPLAY);
+            } else if (!NativeDocumentRegistry.renderPage(pdfId, pageIndex + 1, bitmap)) {
+                throw new IOException("Native render failed for page " + (pageIndex + 1));
+            }
 
-                    bitmap.recycle();
-                    page.close();
+            String fileName = String.format(Locale.US, "page_%d.%s", pageIndex + 1, format);
+            String outputPath = saveBitmap(bitmap, fileName, outputDir);
+            Log.i(TAG, "✅ [PROGRESS] Page " + (pageIndex + 1) + " exported to " + outputPath);
+            return outputPath;
+        } finally {
+            if (bitmap != null) {
+                bitmap.recycle();
+            }
+            bitmapBudget.release(costKb);
+            if (page != null) {
+                page.close();
+            }
+        }
+    }
 
-                    Log.i(TAG, "✅ [PROGRESS] Page " + (pageIndex + 1) + " exported to " + outputPath);
+    private int countPages(File pdfFile) throws IOException {
+        try (ParcelFileDescriptor fileDescriptor = ParcelFileDescriptor.open(pdfFile, ParcelFileDescriptor.MODE_READ_ONLY);
+             PdfRenderer pdfRenderer = new PdfRenderer(fileDescriptor)) {
+            return pdfRenderer.getPageCount();
+        }
+    }
 
-                } catch (Exception e) {
-                    Log.e(TAG, "❌ [EXPORT] Error exporting page " + (pageIndex + 1), e);
-                }
+    private static void closeQuietly(PdfRenderer renderer, ParcelFileDescriptor descriptor) {
+        if (renderer != null) {
+            renderer.close();
+        }
+        if (descriptor != null) {
+            try {
+                descriptor.close();
+            } catch (IOException e) {
+                Log.w(TAG, "Error closing export descriptor", e);
             }
-            
-            Log.i(TAG, "✅ [EXPORT] exportPagesToImages - SUCCESS - Exported " + exportedFiles.size() + " pages");
         }
+    }
 
-        return exportedFiles;
+    private void emitProgress(String progressId, String filePath, int page, int completed, int total, String path) {
+        if (progressId == null) {
+            return;
+        }
+        ReactApplicationContext context = getReactApplicationContext();
+        if (!context.hasActiveReactInstance()) {
+            return;
+        }
+        WritableMap event = Arguments.createMap();
+        event.putString("progressId", progressId);
+        event.putString("filePath", filePath);
+        event.putInt("page", page);
+        event.putInt("completed", completed);
+        event.putInt("total", total);
+        if (path != null) {
+            event.putString("path", path);
+        } else {
+            event.putNull("path");
+        }
+        context.getJSModule(DeviceEventManagerModule.RCTDeviceEventEmitter.class).emit(EXPORT_PROGRESS_EVENT, event);
     }
 
-    
     private String saveBitmap(Bitmap bitmap, String fileName, String outputDir) throws IOException {
         File outputFile;
         
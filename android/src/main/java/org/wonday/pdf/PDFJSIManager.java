@@ -9,6 +9,10 @@
 
 package org.wonday.pdf;
 
+import android.app.ActivityManager;
+import android.content.ComponentCallbacks2;
+import android.content.Context;
+import android.content.res.Configuration;
 import android.os.Build;
 import android.util.Log;
 
@@ -18,22 +22,69 @@ import com.facebook.react.bridge.ReactMethod;
 import com.facebook.react.bridge.Promise;
 import com.facebook.react.bridge.ReadableMap;
 import com.facebook.react.bridge.ReadableArray;
+import com.facebook.react.bridge.ReadableMapKeySetIterator;
+import com.facebook.react.bridge.WritableArray;
 import com.facebook.react.bridge.WritableMap;
 import com.facebook.react.bridge.Arguments;
+import com.facebook.react.bridge.JavaScriptContextHolder;
 
 // import com.facebook.react.turbomodule.core.CallInvokerHolder; // Not available in this RN version
 import com.facebook.soloader.SoLoader;
 
+import java.io.File;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
 
 public class PDFJSIManager extends ReactContextBaseJavaModule {
     private static final String MODULE_NAME = "PDFJSIManager";
     private static final String TAG = "PDFJSI";
+    // Subdirectory of the app cache directory holding the native page store
+    private static final String PAGE_STORE_DIRECTORY = "pdf_page_store";
+    // Bounds for the device-sized native memory budget
+    private static final long MIN_MEMORY_BUDGET_BYTES = 32L * 1024 * 1024;
+    private static final long MAX_MEMORY_BUDGET_BYTES = 192L * 1024 * 1024;
     
     private ExecutorService backgroundExecutor;
     private boolean isJSIInitialized = false;
     
+    // Documents this module holds in the shared native registry
+    private final Set<String> openedDocuments = ConcurrentHashMap.newKeySet();
+    
+    // Hands local files to the native engine as memory maps instead of heap copies
+    private final MemoryMappedCache memoryMappedCache = new MemoryMappedCache();
+    
+    // Progressive downloads by target path; each runs on its own thread for its whole duration
+    private final Map<String, ProgressiveTask> progressiveTasks = new ConcurrentHashMap<>();
+    private final ExecutorService progressiveExecutor = Executors.newCachedThreadPool();
+    
+    // Sheds native caches in steps under memory pressure (see PDFMemoryGovernor)
+    private final ComponentCallbacks2 trimMemoryCallbacks = new ComponentCallbacks2() {
+        @Override
+        public void onTrimMemory(int level) {
+            NativeDocumentRegistry.trimMemory(level);
+            if (level >= ComponentCallbacks2.TRIM_MEMORY_RUNNING_CRITICAL) {
+                // Keep the most recent mapping (likely the open document) unless the UI is gone
+                memoryMappedCache.trimTo(level >= ComponentCallbacks2.TRIM_MEMORY_MODERATE ? 0 : 1);
+            }
+        }
+        
+        @Override
+        public void onLowMemory() {
+            NativeDocumentRegistry.trimMemory(ComponentCallbacks2.TRIM_MEMORY_COMPLETE);
+            memoryMappedCache.trimTo(0);
+        }
+        
+        @Override
+        public void onConfigurationChanged(Configuration newConfig) {
+        }
+    };
+    
     // Load native library
     static {
         try {
@@ -47,6 +98,7 @@ public class PDFJSIManager extends ReactContextBaseJavaModule {
     public PDFJSIManager(ReactApplicationContext reactContext) {
         super(reactContext);
         this.backgroundExecutor = Executors.newFixedThreadPool(2);
+        reactContext.getApplicationContext().registerComponentCallbacks(trimMemoryCallbacks);
         
         Log.d(TAG, "PDFJSIManager: Initializing high-performance PDF JSI manager");
         initializeJSI(reactContext);
@@ -69,6 +121,10 @@ public class PDFJSIManager extends ReactContextBaseJavaModule {
                     nativeInitializeJSI(null);
                     isJSIInitialized = true;
                     Log.d(TAG, "PDF JSI initialized successfully (fallback mode)");
+                    installJSIBindings(reactContext);
+                    configureTextIndexStorage(reactContext);
+                    configurePageStorage(reactContext, true, 0);
+                    configureMemoryBudget(reactContext);
                 } catch (Exception e) {
                     Log.e(TAG, "Failed to initialize PDF JSI", e);
                 }
@@ -78,6 +134,91 @@ public class PDFJSIManager extends ReactContextBaseJavaModule {
         }
     }
     
+    /**
+     * Persist native text indexes next to the PDFs cached by PDFNativeCacheManager
+     */
+    private void configureTextIndexStorage(ReactApplicationContext reactContext) {
+        try {
+            File cacheDirectory = PDFNativeCacheManager.getInstance(reactContext).getCacheDirectory();
+            if (cacheDirectory != null) {
+                nativeSetTextIndexDirectory(cacheDirectory.getAbsolutePath());
+            }
+        } catch (Exception e) {
+            Log.w(TAG, "Text index persistence disabled", e);
+        }
+    }
+    
+    /**
+     * Keep compressed rendered pages in the app cache directory, where the system may
+     * reclaim them; a budget of 0 uses the native default
+     */
+    private boolean configurePageStorage(ReactApplicationContext reactContext, boolean enabled, long budgetBytes) {
+        try {
+            String directory = enabled ? new File(reactContext.getCacheDir(), PAGE_STORE_DIRECTORY).getAbsolutePath() : "";
+            return nativeConfigurePageStore(directory, budgetBytes);
+        } catch (Exception e) {
+            Log.w(TAG, "Page store disabled", e);
+            return false;
+        }
+    }
+    
+    /**
+     * Size the native memory budget (page cache, bitmap pool, text index and mapped
+     * documents together) to the device: a third of the app's memory class, halved on
+     * low-RAM devices
+     */
+    private void configureMemoryBudget(ReactApplicationContext reactContext) {
+        try {
+            ActivityManager activityManager = (ActivityManager) reactContext.getSystemService(Context.ACTIVITY_SERVICE);
+            if (activityManager == null) {
+                return;
+            }
+            long budgetBytes = (long) activityManager.getMemoryClass() * 1024 * 1024 / 3;
+            if (activityManager.isLowRamDevice()) {
+                budgetBytes /= 2;
+            }
+            budgetBytes = Math.max(MIN_MEMORY_BUDGET_BYTES, Math.min(MAX_MEMORY_BUDGET_BYTES, budgetBytes));
+            nativeSetMemoryBudget(budgetBytes);
+        } catch (Exception e) {
+            Log.w(TAG, "Using the default native memory budget", e);
+        }
+    }
+    
+    /**
+     * Install global.__pdfJSI on the JS thread
+     * OPTIMIZATION: Rendered pages reach JS as ArrayBuffers and metrics as numbers,
+     * skipping the bridge and WritableMap string conversion
+     */
+    private void installJSIBindings(ReactApplicationContext reactContext) {
+        reactContext.runOnJSQueueThread(() -> {
+            try {
+                JavaScriptContextHolder jsContext = reactContext.getJavaScriptContextHolder();
+                if (jsContext == null || jsContext.get() == 0) {
+                    Log.w(TAG, "JS runtime not available, JSI bindings not installed");
+                    return;
+                }
+                boolean installed = nativeInstallJSIBindings(jsContext.get());
+                Log.d(TAG, "JSI bindings installed: " + installed);
+            } catch (Exception e) {
+                Log.e(TAG, "Failed to install JSI bindings", e);
+            }
+        });
+    }
+    
+    /**
+     * Called by the native JSI worker when renders or searches finish; their
+     * Promises can only be settled on the JS thread
+     */
+    private void scheduleJSICallbacks() {
+        ReactApplicationContext reactContext = getReactApplicationContext();
+        reactContext.runOnJSQueueThread(() -> {
+            JavaScriptContextHolder jsContext = reactContext.getJavaScriptContextHolder();
+            if (jsContext != null && jsContext.get() != 0) {
+                nativeDrainJSICallbacks(jsContext.get());
+            }
+        });
+    }
+    
     /**
      * Check if JSI is available and initialized
      */
@@ -115,6 +256,327 @@ public class PDFJSIManager extends ReactContextBaseJavaModule {
         });
     }
     
+    /**
+     * Open a document in the shared native registry
+     * @param pdfId Document identifier used by the other JSI calls
+     * @param filePath Local path; when null, pdfId is resolved as a
+     *                 PDFNativeCacheManager cache ID or used as a path
+     */
+    @ReactMethod
+    public void openDocument(String pdfId, String filePath, Promise promise) {
+        backgroundExecutor.execute(() -> {
+            boolean claimed = false;
+            try {
+                String path = resolveDocumentPath(pdfId, filePath);
+                // Claim the id before acquiring, so concurrent opens add one reference between them
+                if (!openedDocuments.add(pdfId)) {
+                    // Already held by this module; report the page count without adding a reference
+                    int pageCount = NativeDocumentRegistry.acquire(pdfId, path);
+                    NativeDocumentRegistry.release(pdfId);
+                    promise.resolve(pageCount);
+                    return;
+                }
+                claimed = true;
+                int pageCount = acquireMapped(pdfId, path);
+                if (pageCount < 0) {
+                    openedDocuments.remove(pdfId);
+                    promise.reject("OPEN_DOCUMENT_ERROR", "Unable to open document: " + pdfId);
+                    return;
+                }
+                // The reference is held now; closeDocument releases it
+                claimed = false;
+                PDFNativeCacheManager cacheManager = PDFNativeCacheManager.getInstance(getReactApplicationContext());
+                cacheManager.attachPageGeometry(pdfId, path);
+                cacheManager.attachPageStoreKey(pdfId, path);
+                Log.d(TAG, "Opened document " + pdfId + " (" + pageCount + " pages)");
+                promise.resolve(pageCount);
+            } catch (Exception e) {
+                if (claimed) {
+                    openedDocuments.remove(pdfId);
+                }
+                Log.e(TAG, "Error opening document", e);
+                promise.reject("OPEN_DOCUMENT_ERROR", e.getMessage());
+            }
+        });
+    }
+    
+    /**
+     * Release this module's reference to a document in the native registry
+     */
+    @ReactMethod
+    public void closeDocument(String pdfId, Promise promise) {
+        backgroundExecutor.execute(() -> {
+            try {
+                boolean wasOpen = openedDocuments.remove(pdfId);
+                if (wasOpen) {
+                    NativeDocumentRegistry.release(pdfId);
+                }
+                promise.resolve(wasOpen);
+            } catch (Exception e) {
+                Log.e(TAG, "Error closing document", e);
+                promise.reject("CLOSE_DOCUMENT_ERROR", e.getMessage());
+            }
+        });
+    }
+    
+    /**
+     * Generate page thumbnails backed by the on-disk thumbnail cache
+     * OPTIMIZATION: Cached pages return immediately; missing pages render in parallel
+     * @param pages Page numbers (starting from 1)
+     * @param maxDimension Longest side of each thumbnail in pixels
+     * @return Array of {page, uri, width, height, cached} (or {page, error})
+     */
+    @ReactMethod
+    public void generateThumbnails(String pdfId, ReadableArray pages, int maxDimension, Promise promise) {
+        if (pages == null || pages.size() == 0) {
+            promise.resolve(Arguments.createArray());
+            return;
+        }
+        
+        backgroundExecutor.execute(() -> {
+            try {
+                String path = resolveDocumentPath(pdfId, null);
+                if (path == null) {
+                    promise.reject("THUMBNAIL_ERROR", "Unable to resolve document: " + pdfId);
+                    return;
+                }
+                List<Integer> pageNumbers = new ArrayList<>(pages.size());
+                for (int i = 0; i < pages.size(); i++) {
+                    pageNumbers.add(pages.getInt(i));
+                }
+                
+                List<PDFThumbnailGenerator.Thumbnail> thumbnails = PDFThumbnailGenerator
+                        .getInstance(getReactApplicationContext())
+                        .generate(pdfId, path, pageNumbers, maxDimension);
+                
+                WritableArray result = Arguments.createArray();
+                for (PDFThumbnailGenerator.Thumbnail thumbnail : thumbnails) {
+                    WritableMap entry = Arguments.createMap();
+                    entry.putInt("page", thumbnail.pageNumber);
+                    if (thumbnail.error != null) {
+                        entry.putString("error", thumbnail.error);
+                    } else {
+                        entry.putString("uri", thumbnail.uri);
+                        entry.putInt("width", thumbnail.width);
+                        entry.putInt("height", thumbnail.height);
+                        entry.putBoolean("cached", thumbnail.cached);
+                    }
+                    result.pushMap(entry);
+                }
+                promise.resolve(result);
+            } catch (Exception e) {
+                Log.e(TAG, "Error generating thumbnails", e);
+                promise.reject("THUMBNAIL_ERROR", e.getMessage());
+            }
+        });
+    }
+    
+    /**
+     * Start a progressive download of a remote PDF into targetPath
+     * OPTIMIZATION: Resolves as soon as the first page can be shown, usually long
+     * before the file is complete for linearized PDFs; awaitProgressive resolves
+     * once the whole file is in targetPath
+     * @param headers Extra request headers (may be null)
+     * @param previewDimension Longest side of the first page preview in pixels
+     * @return {preview: {page, uri, width, height, pageCount, linearized} | null}
+     */
+    @ReactMethod
+    public void openProgressive(String url, ReadableMap headers, String targetPath, int previewDimension,
+                                Promise promise) {
+        ProgressiveTask running = progressiveTasks.get(targetPath);
+        if (running != null && !running.isFinished()) {
+            promise.reject("PROGRESSIVE_ERROR", "Download already running for " + targetPath);
+            return;
+        }
+        File target = new File(targetPath.replaceFirst("^file://", ""));
+        File previewFile = new File(PDFThumbnailGenerator.getInstance(getReactApplicationContext()).getThumbnailDirectory(),
+                target.getName() + "_preview.jpg");
+        ProgressiveTask task = new ProgressiveTask(new ProgressiveDownloader(url, toStringMap(headers), target,
+                previewFile, Math.max(64, Math.min(2048, previewDimension))), promise);
+        progressiveTasks.put(targetPath, task);
+        
+        progressiveExecutor.execute(() -> {
+            try {
+                task.downloader.download(task);
+                task.finish(target.length(), null);
+            } catch (Exception e) {
+                Log.w(TAG, "Progressive download failed: " + url, e);
+                target.delete();
+                task.finish(0, e.getMessage());
+            }
+            // Kept until the completion reaches awaitProgressive
+            if (task.isDelivered()) {
+                progressiveTasks.remove(targetPath, task);
+            }
+        });
+    }
+    
+    /**
+     * Resolve once the progressive download into targetPath is complete
+     * @return {path, size}
+     */
+    @ReactMethod
+    public void awaitProgressive(String targetPath, Promise promise) {
+        ProgressiveTask task = progressiveTasks.get(targetPath);
+        if (task == null) {
+            promise.reject("PROGRESSIVE_ERROR", "No download running for " + targetPath);
+            return;
+        }
+        task.await(targetPath, promise);
+        if (task.isDelivered()) {
+            progressiveTasks.remove(targetPath, task);
+        }
+    }
+    
+    @ReactMethod
+    public void cancelProgressive(String targetPath, Promise promise) {
+        ProgressiveTask task = progressiveTasks.get(targetPath);
+        if (task != null) {
+            task.downloader.cancel();
+        }
+        promise.resolve(task != null);
+    }
+    
+    /**
+     * One progressive download and the promises waiting on its preview and completion
+     */
+    private static class ProgressiveTask implements ProgressiveDownloader.Listener {
+        final ProgressiveDownloader downloader;
+        private Promise previewPromise;
+        private final List<Promise> completionPromises = new ArrayList<>();
+        private boolean finished;
+        private boolean delivered;
+        private long size;
+        private String error;
+        private String path;
+        
+        ProgressiveTask(ProgressiveDownloader downloader, Promise previewPromise) {
+            this.downloader = downloader;
+            this.previewPromise = previewPromise;
+        }
+        
+        @Override
+        public synchronized void onPreview(ProgressiveDownloader.Preview preview) {
+            if (previewPromise == null) {
+                return;
+            }
+            WritableMap result = Arguments.createMap();
+            if (preview != null) {
+                WritableMap map = Arguments.createMap();
+                map.putInt("page", preview.pageNumber);
+                map.putString("uri", preview.uri);
+                map.putInt("width", preview.width);
+                map.putInt("height", preview.height);
+                map.putInt("pageCount", preview.pageCount);
+                map.putBoolean("linearized", preview.linearized);
+                result.putMap("preview", map);
+            } else {
+                result.putNull("preview");
+            }
+            previewPromise.resolve(result);
+            previewPromise = null;
+        }
+        
+        @Override
+        public void onProgress(long received, long total) {
+        }
+        
+        synchronized boolean isFinished() {
+            return finished;
+        }
+        
+        synchronized boolean isDelivered() {
+            return delivered;
+        }
+        
+        synchronized void await(String targetPath, Promise promise) {
+            path = targetPath;
+            if (finished) {
+                settle(promise);
+                delivered = true;
+            } else {
+                completionPromises.add(promise);
+            }
+        }
+        
+        synchronized void finish(long size, String error) {
+            this.finished = true;
+            this.size = size;
+            this.error = error;
+            if (previewPromise != null) {
+                if (error != null) {
+                    previewPromise.reject("PROGRESSIVE_ERROR", error);
+                    previewPromise = null;
+                } else {
+                    onPreview(null);
+                }
+            }
+            for (Promise promise : completionPromises) {
+                settle(promise);
+                delivered = true;
+            }
+            completionPromises.clear();
+        }
+        
+        private void settle(Promise promise) {
+            if (error != null) {
+                promise.reject("PROGRESSIVE_ERROR", error);
+                return;
+            }
+            WritableMap result = Arguments.createMap();
+            result.putString("path", path);
+            result.putDouble("size", size);
+            promise.resolve(result);
+        }
+    }
+    
+    private static Map<String, String> toStringMap(ReadableMap map) {
+        Map<String, String> result = new HashMap<>();
+        if (map == null) {
+            return result;
+        }
+        ReadableMapKeySetIterator keys = map.keySetIterator();
+        while (keys.hasNextKey()) {
+            String key = keys.nextKey();
+            String value = map.getString(key);
+            if (value != null) {
+                result.put(key, value);
+            }
+        }
+        return result;
+    }
+    
+    /**
+     * Acquire a local file through a native memory map, falling back to a path open
+     */
+    private int acquireMapped(String pdfId, String path) {
+        if (path != null) {
+            File file = new File(path.replaceFirst("^file://", ""));
+            if (file.isFile()) {
+                int pageCount = memoryMappedCache.acquireNativeDocument(pdfId, file);
+                if (pageCount >= 0) {
+                    return pageCount;
+                }
+            }
+        }
+        return NativeDocumentRegistry.acquire(pdfId, path);
+    }
+    
+    private String resolveDocumentPath(String pdfId, String filePath) {
+        if (filePath != null && !filePath.isEmpty()) {
+            return filePath;
+        }
+        if (pdfId == null || new File(pdfId.replaceFirst("^file://", "")).exists()) {
+            return pdfId;
+        }
+        try {
+            return PDFNativeCacheManager.getInstance(getReactApplicationContext()).loadPDF(pdfId);
+        } catch (Exception e) {
+            Log.d(TAG, "pdfId is not a cache ID: " + pdfId);
+            return pdfId;
+        }
+    }
+    
     /**
      * Get page metrics via JSI
      */
@@ -135,11 +597,115 @@ public class PDFJSIManager extends ReactContextBaseJavaModule {
         }
     }
     
+    /**
+     * Get metrics for many pages in one call
+     * OPTIMIZATION: One native crossing for the whole list; the native side returns a
+     * struct of arrays instead of a map per page
+     * @param pages Page numbers (starting from 1)
+     * @return {pages, widths, heights, rotations} arrays in the order of pages;
+     *         pages that are out of range report a width and height of 0
+     */
+    @ReactMethod
+    public void getPageMetricsBatch(String pdfId, ReadableArray pages, Promise promise) {
+        if (!isJSIInitialized) {
+            promise.reject("JSI_NOT_INITIALIZED", "JSI is not initialized");
+            return;
+        }
+        
+        backgroundExecutor.execute(() -> {
+            try {
+                int[] pageNumbers = toIntArray(pages);
+                float[] values = nativeGetPageMetricsBatch(pdfId, pageNumbers);
+                if (values == null) {
+                    promise.reject("METRICS_ERROR", "Document not open: " + pdfId);
+                    return;
+                }
+                int count = pageNumbers.length;
+                WritableMap result = Arguments.createMap();
+                result.putArray("pages", toWritableArray(pageNumbers));
+                result.putArray("widths", toWritableArray(values, 0, count));
+                result.putArray("heights", toWritableArray(values, count, count));
+                result.putArray("rotations", toWritableArray(values, count * 2, count));
+                promise.resolve(result);
+            } catch (Exception e) {
+                Log.e(TAG, "Error getting batched page metrics via JSI", e);
+                promise.reject("METRICS_ERROR", e.getMessage());
+            }
+        });
+    }
+    
+    /**
+     * Render many pages into the native page cache in one call
+     * @param pages Page numbers (starting from 1), rendered in order
+     * @param quality Render quality (1-3), or 0 for the document's level
+     * @return {pages, success, widths, heights, cached, quality, renderTimeMs} arrays
+     */
+    @ReactMethod
+    public void renderPagesDirect(String pdfId, ReadableArray pages, double scale, int quality, Promise promise) {
+        if (!isJSIInitialized) {
+            promise.reject("JSI_NOT_INITIALIZED", "JSI is not initialized");
+            return;
+        }
+        
+        backgroundExecutor.execute(() -> {
+            try {
+                int[] pageNumbers = toIntArray(pages);
+                Log.d(TAG, "Rendering " + pageNumbers.length + " pages via JSI for PDF " + pdfId);
+                float[] values = nativeRenderPagesDirect(pdfId, pageNumbers, (float) scale, quality);
+                int count = pageNumbers.length;
+                WritableArray success = Arguments.createArray();
+                WritableArray cached = Arguments.createArray();
+                for (int i = 0; i < count; i++) {
+                    success.pushBoolean(values[i] != 0f);
+                    cached.pushBoolean(values[count * 3 + i] != 0f);
+                }
+                WritableMap result = Arguments.createMap();
+                result.putArray("pages", toWritableArray(pageNumbers));
+                result.putArray("success", success);
+                result.putArray("widths", toWritableArray(values, count, count));
+                result.putArray("heights", toWritableArray(values, count * 2, count));
+                result.putArray("cached", cached);
+                result.putArray("quality", toWritableArray(values, count * 4, count));
+                result.putArray("renderTimeMs", toWritableArray(values, count * 5, count));
+                promise.resolve(result);
+            } catch (Exception e) {
+                Log.e(TAG, "Error rendering pages via JSI", e);
+                promise.reject("RENDER_ERROR", e.getMessage());
+            }
+        });
+    }
+    
+    private static int[] toIntArray(ReadableArray values) {
+        int[] result = new int[values == null ? 0 : values.size()];
+        for (int i = 0; i < result.length; i++) {
+            result[i] = values.getInt(i);
+        }
+        return result;
+    }
+    
+    private static WritableArray toWritableArray(int[] values) {
+        WritableArray result = Arguments.createArray();
+        for (int value : values) {
+            result.pushInt(value);
+        }
+        return result;
+    }
+    
+    private static WritableArray toWritableArray(float[] values, int offset, int count) {
+        WritableArray result = Arguments.createArray();
+        for (int i = offset; i < offset + count; i++) {
+            result.pushDouble(values[i]);
+        }
+        return result;
+    }
+    
     /**
      * Preload pages directly via JSI
+     * OPTIMIZATION: Queues the range on native worker threads, nearest currentPage first;
+     * a newer request for the same pdfId cancels pages still pending from this one
      */
     @ReactMethod
-    public void preloadPagesDirect(String pdfId, int startPage, int endPage, Promise promise) {
+    public void preloadPagesDirect(String pdfId, int startPage, int endPage, int currentPage, Promise promise) {
         if (!isJSIInitialized) {
             promise.reject("JSI_NOT_INITIALIZED", "JSI is not initialized");
             return;
@@ -147,8 +713,8 @@ public class PDFJSIManager extends ReactContextBaseJavaModule {
         
         backgroundExecutor.execute(() -> {
             try {
-                Log.d(TAG, "Preloading pages " + startPage + "-" + endPage + " via JSI");
-                boolean success = nativePreloadPagesDirect(pdfId, startPage, endPage);
+                Log.d(TAG, "Preloading pages " + startPage + "-" + endPage + " around " + currentPage + " via JSI");
+                boolean success = nativePreloadPagesDirect(pdfId, startPage, endPage, currentPage);
                 promise.resolve(success);
             } catch (Exception e) {
                 Log.e(TAG, "Error preloading pages via JSI", e);
@@ -221,8 +787,82 @@ public class PDFJSIManager extends ReactContextBaseJavaModule {
         });
     }
     
+    /**
+     * Set the native page cache byte budget (evicts immediately if lower)
+     * Applied through the memory governor, whose total budget grows or shrinks to match
+     */
+    @ReactMethod
+    public void setCacheBudget(double budgetBytes, Promise promise) {
+        if (!isJSIInitialized) {
+            promise.reject("JSI_NOT_INITIALIZED", "JSI is not initialized");
+            return;
+        }
+        
+        try {
+            Log.d(TAG, "Setting native page cache budget to " + (long) budgetBytes + " bytes");
+            nativeSetCacheBudget((long) budgetBytes);
+            promise.resolve(true);
+        } catch (Exception e) {
+            Log.e(TAG, "Error setting cache budget via JSI", e);
+            promise.reject("SET_CACHE_BUDGET_ERROR", e.getMessage());
+        }
+    }
+    
+    /**
+     * Set the global native memory budget, split across the page cache, bitmap pool,
+     * text index and mapped documents
+     * OPTIMIZATION: one budget sized to the device instead of independent per-cache limits;
+     * memory pressure then sheds from it in steps rather than clearing everything
+     */
+    @ReactMethod
+    public void setMemoryBudget(double budgetBytes, Promise promise) {
+        if (!isJSIInitialized) {
+            promise.reject("JSI_NOT_INITIALIZED", "JSI is not initialized");
+            return;
+        }
+        if (budgetBytes <= 0) {
+            promise.reject("INVALID_BUDGET", "Memory budget must be positive");
+            return;
+        }
+        
+        try {
+            Log.d(TAG, "Setting native memory budget to " + (long) budgetBytes + " bytes");
+            nativeSetMemoryBudget((long) budgetBytes);
+            promise.resolve(true);
+        } catch (Exception e) {
+            Log.e(TAG, "Error setting memory budget via JSI", e);
+            promise.reject("SET_MEMORY_BUDGET_ERROR", e.getMessage());
+        }
+    }
+    
+    /**
+     * Enable or disable the persistent rendered-page store and set its disk budget
+     * OPTIMIZATION: Pages rendered in an earlier launch are decoded from disk instead of
+     * rasterized; disabling keeps the stored files for a later enable
+     * Serves the native engine only (JSI renders, renderPagesDirect, preloads): PdfView
+     * draws through AndroidPdfViewer's own Pdfium pipeline, which has no hook for it
+     */
+    @ReactMethod
+    public void configurePageStore(boolean enabled, double budgetBytes, Promise promise) {
+        if (!isJSIInitialized) {
+            promise.reject("JSI_NOT_INITIALIZED", "JSI is not initialized");
+            return;
+        }
+        
+        backgroundExecutor.execute(() -> {
+            Log.d(TAG, "Configuring page store: enabled=" + enabled + ", budget=" + (long) budgetBytes + " bytes");
+            if (configurePageStorage(getReactApplicationContext(), enabled, (long) budgetBytes)) {
+                promise.resolve(true);
+            } else {
+                promise.reject("CONFIGURE_PAGE_STORE_ERROR", "Unable to configure the page store");
+            }
+        });
+    }
+    
     /**
      * Search text directly via JSI
+     * OPTIMIZATION: Page text is extracted natively once per document and indexed;
+     * results are { page, offset, length, left, top, right, bottom } in PDF points
      */
     @ReactMethod
     public void searchTextDirect(String pdfId, String searchTerm, int startPage, int endPage, Promise promise) {
@@ -243,6 +883,64 @@ public class PDFJSIManager extends ReactContextBaseJavaModule {
         });
     }
     
+    /**
+     * Hit-test a point on a page (PDF points, origin bottom-left)
+     * OPTIMIZATION: Glyph, word and link boxes are read once per page, in the
+     * background when it is first rendered, and kept in a spatial grid; a tap
+     * looks up a few cells. Resolves { type: "none" | "word" | "link", page,
+     * offset, length, text, left, top, right, bottom, targetPage, uri }
+     */
+    @ReactMethod
+    public void hitTest(String pdfId, int pageNumber, double x, double y, double tolerance, Promise promise) {
+        if (!isJSIInitialized) {
+            promise.reject("JSI_NOT_INITIALIZED", "JSI is not initialized");
+            return;
+        }
+        
+        backgroundExecutor.execute(() -> {
+            try {
+                WritableMap result = nativeHitTest(pdfId, pageNumber, (float) x, (float) y, (float) tolerance);
+                if (result != null) {
+                    promise.resolve(result);
+                } else {
+                    promise.reject("HIT_TEST_ERROR", "Unable to hit-test page " + pageNumber);
+                }
+            } catch (Exception e) {
+                Log.e(TAG, "Error hit-testing via JSI", e);
+                promise.reject("HIT_TEST_ERROR", e.getMessage());
+            }
+        });
+    }
+    
+    /**
+     * Select the words between two points on a page, as a long press and drag does
+     * OPTIMIZATION: Served from the same per-page index as hitTest. Resolves
+     * { page, offset, length, text, rects: [{ left, top, right, bottom }] }
+     */
+    @ReactMethod
+    public void selectText(String pdfId, int pageNumber, double startX, double startY, double endX, double endY,
+                           double tolerance, Promise promise) {
+        if (!isJSIInitialized) {
+            promise.reject("JSI_NOT_INITIALIZED", "JSI is not initialized");
+            return;
+        }
+        
+        backgroundExecutor.execute(() -> {
+            try {
+                WritableMap result = nativeSelectText(pdfId, pageNumber, (float) startX, (float) startY,
+                        (float) endX, (float) endY, (float) tolerance);
+                if (result != null) {
+                    promise.resolve(result);
+                } else {
+                    promise.reject("SELECT_TEXT_ERROR", "Unable to select text on page " + pageNumber);
+                }
+            } catch (Exception e) {
+                Log.e(TAG, "Error selecting text via JSI", e);
+                promise.reject("SELECT_TEXT_ERROR", e.getMessage());
+            }
+        });
+    }
+    
     /**
      * Get performance metrics via JSI
      */
@@ -291,11 +989,19 @@ public class PDFJSIManager extends ReactContextBaseJavaModule {
     public void onCatalystInstanceDestroy() {
         super.onCatalystInstanceDestroy();
         
+        getReactApplicationContext().getApplicationContext().unregisterComponentCallbacks(trimMemoryCallbacks);
+        
         if (backgroundExecutor != null && !backgroundExecutor.isShutdown()) {
             backgroundExecutor.shutdown();
         }
+        for (ProgressiveTask task : progressiveTasks.values()) {
+            task.downloader.cancel();
+        }
+        progressiveExecutor.shutdown();
         
+        openedDocuments.clear();
         if (isJSIInitialized) {
+            // Closes every native document deterministically
             nativeCleanupJSI();
         }
         
@@ -304,14 +1010,25 @@ public class PDFJSIManager extends ReactContextBaseJavaModule {
     
     // Native method declarations
     private native void nativeInitializeJSI(Object callInvokerHolder);
+    private native boolean nativeInstallJSIBindings(long jsContextPointer);
+    private native void nativeDrainJSICallbacks(long jsContextPointer);
     private native boolean nativeIsJSIAvailable();
     private native WritableMap nativeRenderPageDirect(String pdfId, int pageNumber, float scale, String base64Data);
+    private native float[] nativeRenderPagesDirect(String pdfId, int[] pages, float scale, int quality);
     private native WritableMap nativeGetPageMetrics(String pdfId, int pageNumber);
-    private native boolean nativePreloadPagesDirect(String pdfId, int startPage, int endPage);
+    private native float[] nativeGetPageMetricsBatch(String pdfId, int[] pages);
+    private native boolean nativePreloadPagesDirect(String pdfId, int startPage, int endPage, int currentPage);
     private native WritableMap nativeGetCacheMetrics(String pdfId);
     private native boolean nativeClearCacheDirect(String pdfId, String cacheType);
     private native boolean nativeOptimizeMemory(String pdfId);
+    private native void nativeSetCacheBudget(long budgetBytes);
+    private native void nativeSetMemoryBudget(long budgetBytes);
+    private native void nativeSetTextIndexDirectory(String directory);
+    private native boolean nativeConfigurePageStore(String directory, long budgetBytes);
     private native ReadableArray nativeSearchTextDirect(String pdfId, String searchTerm, int startPage, int endPage);
+    private native WritableMap nativeHitTest(String pdfId, int pageNumber, float x, float y, float tolerance);
+    private native WritableMap nativeSelectText(String pdfId, int pageNumber, float startX, float startY,
+                                                float endX, float endY, float tolerance);
     private native WritableMap nativeGetPerformanceMetrics(String pdfId);
     private native boolean nativeSetRenderQuality(String pdfId, int quality);
     private native void nativeCleanupJSI();
@@ -17,6 +17,9 @@ import android.content.Context;
 import android.util.Base64;
 import android.util.Log;
 import java.io.*;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
 import java.nio.channels.FileChannel;
 import java.nio.file.Files;
 import java.nio.file.Paths;
@@ -35,6 +38,7 @@ import java.util.PriorityQueue;
 public class PDFNativeCacheManager {
     private static final String TAG = "PDFNativeCacheManager";
     private static final String CACHE_DIR_NAME = "pdf_cache";
+    private static final String TEXT_INDEX_EXTENSION = ".textindex";
     private static final String METADATA_FILE = "cache_metadata.json";
     
     // Configuration constants
@@ -76,6 +80,9 @@ public class PDFNativeCacheManager {
         public boolean isCompressed;
         public String checksum;
         public int accessCount;
+        // Native page geometry table (NativeDocumentRegistry.PAGE_GEOMETRY_FIELDS
+        // values per page); null until the document has been measured once
+        public float[] pageGeometry;
         
         public CacheMetadata(String cacheId, String fileName, long fileSize, long originalSize) {
             this.cacheId = cacheId;
@@ -100,6 +107,13 @@ public class PDFNativeCacheManager {
             json.put("isCompressed", isCompressed);
             json.put("checksum", checksum);
             json.put("accessCount", accessCount);
+            if (pageGeometry != null) {
+                // Little-endian floats as base64; a JSON number array is several times larger
+                ByteBuffer bytes = ByteBuffer.allocate(pageGeometry.length * 4).order(ByteOrder.LITTLE_ENDIAN);
+                bytes.asFloatBuffer().put(pageGeometry);
+                json.put("pageGeometry", Base64.encodeToString(bytes.array(), Base64.NO_WRAP));
+                json.put("pageGeometryFields", NativeDocumentRegistry.PAGE_GEOMETRY_FIELDS);
+            }
             return json;
         }
         
@@ -115,6 +129,14 @@ public class PDFNativeCacheManager {
             metadata.isCompressed = json.getBoolean("isCompressed");
             metadata.checksum = json.getString("checksum");
             metadata.accessCount = json.getInt("accessCount");
+            // Tables written with a different layout are dropped and measured again
+            if (json.has("pageGeometry")
+                    && json.optInt("pageGeometryFields") == NativeDocumentRegistry.PAGE_GEOMETRY_FIELDS) {
+                byte[] bytes = Base64.decode(json.getString("pageGeometry"), Base64.NO_WRAP);
+                FloatBuffer values = ByteBuffer.wrap(bytes).order(ByteOrder.LITTLE_ENDIAN).asFloatBuffer();
+                metadata.pageGeometry = new float[values.remaining()];
+                values.get(metadata.pageGeometry);
+            }
             return metadata;
         }
     }
@@ -368,13 +390,19 @@ public class PDFNativeCacheManager {
             
             // Direct file copy (no base64, no memory allocation) - MAJOR OPTIMIZATION
             long copyStart = System.currentTimeMillis();
+            File tempFile = cacheTempFile(pdfFile);
             try (FileChannel sourceChannel = new FileInputStream(sourceFile).getChannel();
-                 FileChannel destChannel = new FileOutputStream(pdfFile).getChannel()) {
+                 FileChannel destChannel = new FileOutputStream(tempFile).getChannel()) {
                 long bytesTransferred = destChannel.transferFrom(sourceChannel, 0, sourceChannel.size());
+                destChannel.force(true);
                 long copyTime = System.currentTimeMillis() - copyStart;
                 double copySpeedMBps = (bytesTransferred / 1024.0 / 1024.0) / (copyTime / 1000.0);
                 Log.i(TAG, "[PERF] [storePDFFromPath]   File copy: " + copyTime + "ms, speed: " + String.format("%.2f", copySpeedMBps) + " MB/s");
+            } catch (IOException e) {
+                tempFile.delete();
+                throw e;
             }
+            replaceCacheFile(tempFile, pdfFile);
             long copyTime = System.currentTimeMillis() - copyStart;
             
             // Create metadata
@@ -429,6 +457,22 @@ public class PDFNativeCacheManager {
         }
     }
     
+    private static File cacheTempFile(File pdfFile) {
+        return new File(pdfFile.getParentFile(), pdfFile.getName() + ".tmp");
+    }
+
+    /**
+     * Move a fully written temp file over a cache file
+     * rename() swaps the directory entry, so a native registry mapping of the old
+     * file keeps valid pages; truncating the file in place would SIGBUS that mapping
+     */
+    private static void replaceCacheFile(File tempFile, File pdfFile) throws IOException {
+        if (!tempFile.renameTo(pdfFile)) {
+            tempFile.delete();
+            throw new IOException("Could not move " + tempFile.getName() + " into the cache");
+        }
+    }
+    
     /**
      * Store PDF data persistently and return cache ID
      */
@@ -472,11 +516,16 @@ public class PDFNativeCacheManager {
             ensureCacheSpace(pdfData.length);
             
             // Write PDF file persistently
-            try (FileOutputStream fos = new FileOutputStream(pdfFile)) {
+            File tempFile = cacheTempFile(pdfFile);
+            try (FileOutputStream fos = new FileOutputStream(tempFile)) {
                 fos.write(pdfData);
                 fos.flush();
                 fos.getFD().sync(); // Force sync to disk
+            } catch (IOException e) {
+                tempFile.delete();
+                throw e;
             }
+            replaceCacheFile(tempFile, pdfFile);
             
             // Create metadata with 30-day TTL
             CacheMetadata metadata = new CacheMetadata(cacheId, fileName, pdfFile.length(), pdfData.length);
@@ -561,6 +610,152 @@ public class PDFNativeCacheManager {
         }
     }
     
+    /**
+     * Attach the stored page geometry to a native document opened from a cached file
+     * OPTIMIZATION: A reopened cached PDF gets its geometry table from the metadata, so
+     * exact page sizes are known without loading any page. The first open measures the
+     * pages in the background and stores the table for next time.
+     * @param pdfId Document identifier in NativeDocumentRegistry
+     * @param path Local path the document was opened from
+     */
+    public void attachPageGeometry(String pdfId, String path) {
+        if (!NativeDocumentRegistry.isAvailable()) {
+            return;
+        }
+        CacheMetadata metadata = findMetadataForPath(path);
+        if (metadata == null) {
+            return;
+        }
+        
+        float[] stored = metadata.pageGeometry;
+        if (stored != null && NativeDocumentRegistry.setPageGeometry(pdfId, stored)) {
+            Log.d(TAG, "Page geometry restored for " + metadata.cacheId);
+            return;
+        }
+        final CacheMetadata entry = metadata;
+        backgroundExecutor.execute(() -> {
+            float[] geometry = NativeDocumentRegistry.getPageGeometry(pdfId);
+            if (geometry == null) {
+                return;
+            }
+            synchronized (lock) {
+                entry.pageGeometry = geometry;
+            }
+            scheduleDeferredMetadataSave();
+            Log.d(TAG, "Page geometry stored for " + entry.cacheId + " ("
+                    + geometry.length / NativeDocumentRegistry.PAGE_GEOMETRY_FIELDS + " pages)");
+        });
+    }
+    
+    /**
+     * Key the native persistent page store by the cached file's content checksum
+     * OPTIMIZATION: Pages rendered in an earlier launch are decoded from disk instead of
+     * rasterized. Files cached by path have no checksum yet; it is computed once in the
+     * background, streamed so the document is never held in memory, and saved with the metadata.
+     * @param pdfId Document identifier in NativeDocumentRegistry
+     * @param path Local path the document was opened from
+     */
+    public void attachPageStoreKey(String pdfId, String path) {
+        if (!NativeDocumentRegistry.isAvailable()) {
+            return;
+        }
+        final CacheMetadata metadata = findMetadataForPath(path);
+        if (metadata == null) {
+            return;
+        }
+        String checksum;
+        synchronized (lock) {
+            checksum = metadata.checksum;
+        }
+        if (hasChecksum(checksum)) {
+            NativeDocumentRegistry.setPageStoreKey(pdfId, checksum);
+            return;
+        }
+        backgroundExecutor.execute(() -> {
+            String computed = contentChecksum(path);
+            if (computed != null) {
+                NativeDocumentRegistry.setPageStoreKey(pdfId, computed);
+            }
+        });
+    }
+    
+    /**
+     * Content checksum (MD5) of a local PDF, the identity the page store and the
+     * thumbnail cache share. Cached files reuse CacheMetadata.checksum, computed
+     * and saved once when missing; other files are hashed streaming.
+     * Blocks on large files; call from a background thread.
+     * @return Checksum, or null if the file cannot be read
+     */
+    public String contentChecksum(String path) {
+        CacheMetadata metadata = findMetadataForPath(path);
+        if (metadata == null) {
+            String checksum = generateChecksum(new File(path.replaceFirst("^file://", "")));
+            return hasChecksum(checksum) ? checksum : null;
+        }
+        synchronized (lock) {
+            if (hasChecksum(metadata.checksum)) {
+                return metadata.checksum;
+            }
+        }
+        String computed = generateChecksum(new File(cacheDir, metadata.fileName));
+        if (!hasChecksum(computed)) {
+            return null;
+        }
+        synchronized (lock) {
+            metadata.checksum = computed;
+        }
+        scheduleDeferredMetadataSave();
+        Log.d(TAG, "Checksum stored for " + metadata.cacheId);
+        return computed;
+    }
+    
+    private static boolean hasChecksum(String checksum) {
+        return checksum != null && !checksum.isEmpty() && !"no_checksum".equals(checksum);
+    }
+    
+    /**
+     * Streaming MD5 of a cached file, matching generateChecksum(byte[])
+     */
+    private String generateChecksum(File file) {
+        try (InputStream input = new BufferedInputStream(new FileInputStream(file), 64 * 1024)) {
+            MessageDigest md = MessageDigest.getInstance("MD5");
+            byte[] buffer = new byte[64 * 1024];
+            int read;
+            while ((read = input.read(buffer)) != -1) {
+                md.update(buffer, 0, read);
+            }
+            StringBuilder sb = new StringBuilder();
+            for (byte b : md.digest()) {
+                sb.append(String.format("%02x", b));
+            }
+            return sb.toString();
+        } catch (NoSuchAlgorithmException | IOException e) {
+            Log.w(TAG, "Cannot checksum " + file.getName(), e);
+            return "no_checksum";
+        }
+    }
+    
+    /**
+     * Metadata of the cached file at path, or null for files outside the cache
+     */
+    private CacheMetadata findMetadataForPath(String path) {
+        if (path == null) {
+            return null;
+        }
+        File file = new File(path.replaceFirst("^file://", ""));
+        if (!cacheDir.equals(file.getParentFile())) {
+            return null;
+        }
+        synchronized (lock) {
+            for (CacheMetadata candidate : metadataCache.values()) {
+                if (candidate.fileName.equals(file.getName())) {
+                    return candidate;
+                }
+            }
+        }
+        return null;
+    }
+    
     /**
      * Validate PDF header
      */
@@ -672,6 +867,14 @@ public class PDFNativeCacheManager {
                         stats.totalFiles--;
                         stats.totalSize -= metadata.fileSize;
                     }
+                    // Native text index written next to the cached PDF (PDFTextIndex.cpp)
+                    File textIndexFile = new File(cacheDir, metadata.fileName + TEXT_INDEX_EXTENSION);
+                    if (textIndexFile.exists()) {
+                        textIndexFile.delete();
+                    }
+                    if (hasChecksum(metadata.checksum)) {
+                        PDFThumbnailGenerator.getInstance(context).remove(metadata.checksum);
+                    }
                     Log.d(TAG, "Removed persistent cache: " + cacheId);
                 }
             }
@@ -707,6 +910,7 @@ public class PDFNativeCacheManager {
                     saveMetadata();
                 }
             }
+            PDFThumbnailGenerator.getInstance(context).trim(PDFThumbnailGenerator.THUMBNAIL_CACHE_BYTES);
         } catch (Exception e) {
             Log.e(TAG, "Error cleaning expired cache", e);
         }
@@ -796,6 +1000,13 @@ public class PDFNativeCacheManager {
         }
     }
     
+    /**
+     * Directory holding the cached PDFs
+     */
+    public File getCacheDirectory() {
+        return cacheDir;
+    }
+    
     /**
      * Get cache statistics
      */
@@ -823,6 +1034,9 @@ public class PDFNativeCacheManager {
                     metadataFile.delete();
                 }
                 
+                // Thumbnails and progressive previews
+                PDFThumbnailGenerator.getInstance(context).clear();
+                
                 // Reset stats
                 stats.reset();
                 
@@ -0,0 +1,385 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Thumbnail generation with a persistent on-disk cache
+ *
+ * OPTIMIZATION: Thumbnails are rendered once and reused across sessions
+ * Pages render in parallel on a pool sized to the device's cores and are written
+ * as JPEG files next to PDFNativeCacheManager's cache directory. File names are
+ * derived from the document's content checksum (the CacheMetadata MD5 the page
+ * store is keyed by), the page number and the requested size, so a page/size
+ * pair is never rendered twice, even when the same PDF is reopened from a
+ * different path. The directory (progressive previews included) is kept under
+ * a byte budget by evicting the least recently used files; PDFNativeCacheManager
+ * also trims it daily, clears it with the cache and drops a removed PDF's files.
+ */
+
+package org.wonday.pdf;
+
+import android.content.Context;
+import android.graphics.Bitmap;
+import android.graphics.BitmapFactory;
+import android.graphics.Color;
+import android.graphics.pdf.PdfRenderer;
+import android.os.ParcelFileDescriptor;
+import android.util.Log;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+public class PDFThumbnailGenerator {
+    private static final String TAG = "PDFThumbnailGenerator";
+    private static final String THUMBNAIL_DIR_NAME = "pdf_thumbnails";
+    private static final String THUMBNAIL_EXTENSION = ".jpg";
+    private static final int JPEG_QUALITY = 85;
+    private static final int MIN_DIMENSION = 16;
+    private static final int MAX_DIMENSION = 1024;
+    // Disk budget for the thumbnail directory, trimmed oldest-mtime first
+    public static final long THUMBNAIL_CACHE_BYTES = 64L * 1024 * 1024;
+
+    private static PDFThumbnailGenerator instance;
+
+    private final PDFNativeCacheManager cacheManager;
+    private final File thumbnailDir;
+    private final ExecutorService renderExecutor;
+    // path|length|lastModified -> content checksum, so unchanged files are hashed once
+    private final Map<String, String> checksums = new ConcurrentHashMap<>();
+
+    /**
+     * One generated (or cached) thumbnail
+     */
+    public static class Thumbnail {
+        public final int pageNumber;
+        public final String uri;
+        public final int width;
+        public final int height;
+        public final boolean cached;
+        public final String error;
+
+        Thumbnail(int pageNumber, File file, int width, int height, boolean cached) {
+            this.pageNumber = pageNumber;
+            this.uri = "file://" + file.getAbsolutePath();
+            this.width = width;
+            this.height = height;
+            this.cached = cached;
+            this.error = null;
+        }
+
+        Thumbnail(int pageNumber, String error) {
+            this.pageNumber = pageNumber;
+            this.uri = null;
+            this.width = 0;
+            this.height = 0;
+            this.cached = false;
+            this.error = error;
+        }
+    }
+
+    private PDFThumbnailGenerator(Context context) {
+        cacheManager = PDFNativeCacheManager.getInstance(context);
+        File cacheDirectory = cacheManager.getCacheDirectory();
+        File parent = cacheDirectory != null ? cacheDirectory.getParentFile() : context.getCacheDir();
+        thumbnailDir = new File(parent, THUMBNAIL_DIR_NAME);
+        if (!thumbnailDir.exists() && !thumbnailDir.mkdirs()) {
+            Log.w(TAG, "Failed to create thumbnail directory: " + thumbnailDir.getAbsolutePath());
+        }
+        int threads = Math.max(1, Runtime.getRuntime().availableProcessors());
+        renderExecutor = Executors.newFixedThreadPool(threads);
+        Log.d(TAG, "Thumbnail cache at " + thumbnailDir.getAbsolutePath() + " (" + threads + " render threads)");
+    }
+
+    public static synchronized PDFThumbnailGenerator getInstance(Context context) {
+        if (instance == null) {
+            instance = new PDFThumbnailGenerator(context.getApplicationContext());
+        }
+        return instance;
+    }
+
+    public File getThumbnailDirectory() {
+        return thumbnailDir;
+    }
+
+    /**
+     * Generate thumbnails for the given pages, reusing cached files
+     * Blocks until every page is done; call from a background thread.
+     * @param pdfId Document identifier in the native registry
+     * @param filePath Local file backing pdfId
+     * @param pages Page numbers (starting from 1)
+     * @param maxDimension Longest side of each thumbnail in pixels
+     * @return One entry per requested page, in request order
+     */
+    public List<Thumbnail> generate(final String pdfId, final String filePath, List<Integer> pages, int maxDimension)
+            throws IOException {
+        File source = new File(filePath.replaceFirst("^file://", ""));
+        if (!source.exists()) {
+            throw new IOException("PDF file not found: " + filePath);
+        }
+        final int dimension = Math.max(MIN_DIMENSION, Math.min(MAX_DIMENSION, maxDimension));
+        final String checksum = checksumOf(source);
+
+        List<Thumbnail> results = new ArrayList<>(pages.size());
+        List<Integer> missing = new ArrayList<>();
+        for (int page : pages) {
+            File file = thumbnailFile(checksum, page, dimension);
+            if (file.exists() && file.length() > 0) {
+                // Touch so trim() evicts least-recently-used thumbnails first
+                file.setLastModified(System.currentTimeMillis());
+                BitmapFactory.Options bounds = new BitmapFactory.Options();
+                bounds.inJustDecodeBounds = true;
+                BitmapFactory.decodeFile(file.getAbsolutePath(), bounds);
+                results.add(new Thumbnail(page, file, bounds.outWidth, bounds.outHeight, true));
+            } else {
+                results.add(null);
+                missing.add(page);
+            }
+        }
+        if (missing.isEmpty()) {
+            return results;
+        }
+
+        final boolean nativeRender = NativeDocumentRegistry.acquire(pdfId, source.getAbsolutePath()) > 0;
+        final PdfRendererSource fallback = nativeRender ? null : new PdfRendererSource(source);
+        try {
+            List<Callable<Thumbnail>> tasks = new ArrayList<>(missing.size());
+            for (final int page : missing) {
+                tasks.add(() -> render(pdfId, fallback, page, dimension, thumbnailFile(checksum, page, dimension)));
+            }
+            List<Future<Thumbnail>> futures = renderExecutor.invokeAll(tasks);
+            int next = 0;
+            for (int i = 0; i < results.size(); i++) {
+                if (results.get(i) != null) {
+                    continue;
+                }
+                int page = missing.get(next);
+                Future<Thumbnail> future = futures.get(next++);
+                try {
+                    results.set(i, future.get());
+                } catch (Exception e) {
+                    results.set(i, new Thumbnail(page, e.getMessage()));
+                }
+            }
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            throw new IOException("Thumbnail generation interrupted");
+        } finally {
+            if (nativeRender) {
+                NativeDocumentRegistry.release(pdfId);
+            }
+            if (fallback != null) {
+                fallback.close();
+            }
+        }
+        trim(THUMBNAIL_CACHE_BYTES);
+        return results;
+    }
+
+    /**
+     * Evict least recently used files (oldest mtime first) until the directory
+     * holds at most budgetBytes; files still being written are skipped
+     * @return Bytes removed
+     */
+    public long trim(long budgetBytes) {
+        File[] files = thumbnailDir.listFiles((dir, name) -> !name.endsWith(".tmp"));
+        if (files == null) {
+            return 0;
+        }
+        long total = 0;
+        long[] modified = new long[files.length];
+        for (int i = 0; i < files.length; i++) {
+            total += files[i].length();
+            modified[i] = files[i].lastModified();
+        }
+        if (total <= budgetBytes) {
+            return 0;
+        }
+        Integer[] order = new Integer[files.length];
+        for (int i = 0; i < order.length; i++) {
+            order[i] = i;
+        }
+        // mtimes are read once up front; touches during the sort must not reorder it
+        Arrays.sort(order, (a, b) -> Long.compare(modified[a], modified[b]));
+        long removed = 0;
+        for (int index : order) {
+            if (total - removed <= budgetBytes) {
+                break;
+            }
+            long length = files[index].length();
+            if (files[index].delete()) {
+                removed += length;
+            }
+        }
+        Log.d(TAG, "Trimmed " + removed + " bytes of thumbnails");
+        return removed;
+    }
+
+    /**
+     * Delete the thumbnails of one document
+     * @param checksum Content checksum the files are named by (CacheMetadata.checksum)
+     * @return Number of files removed
+     */
+    public int remove(String checksum) {
+        int removed = 0;
+        final String prefix = checksum + "_";
+        File[] files = thumbnailDir.listFiles((dir, name) -> name.startsWith(prefix));
+        if (files != null) {
+            for (File file : files) {
+                if (file.delete()) {
+                    removed++;
+                }
+            }
+        }
+        return removed;
+    }
+
+    /**
+     * Delete every cached thumbnail
+     * @return Number of files removed
+     */
+    public int clear() {
+        int removed = 0;
+        File[] files = thumbnailDir.listFiles();
+        if (files != null) {
+            for (File file : files) {
+                if (file.delete()) {
+                    removed++;
+                }
+            }
+        }
+        return removed;
+    }
+
+    private Thumbnail render(String pdfId, PdfRendererSource fallback, int page, int dimension, File target) {
+        float pageWidth;
+        float pageHeight;
+        if (fallback == null) {
+            float[] size = NativeDocumentRegistry.getPageSize(pdfId, page);
+            if (size == null) {
+                return new Thumbnail(page, "Page out of range: " + page);
+            }
+            pageWidth = size[0];
+            pageHeight = size[1];
+        } else {
+            float[] size = fallback.pageSize(page);
+            if (size == null) {
+                return new Thumbnail(page, "Page out of range: " + page);
+            }
+            pageWidth = size[0];
+            pageHeight = size[1];
+        }
+
+        float scale = dimension / Math.max(pageWidth, pageHeight);
+        int width = Math.max(1, Math.round(pageWidth * scale));
+        int height = Math.max(1, Math.round(pageHeight * scale));
+
+        Bitmap bitmap = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888);
+        try {
+            boolean rendered;
+            if (fallback == null) {
+                rendered = NativeDocumentRegistry.renderPage(pdfId, page, bitmap);
+            } else {
+                rendered = fallback.render(page, bitmap);
+            }
+            if (!rendered) {
+                return new Thumbnail(page, "Failed to render page " + page);
+            }
+            writeAtomically(bitmap, target);
+            return new Thumbnail(page, target, width, height, false);
+        } catch (IOException e) {
+            Log.w(TAG, "Failed to write thumbnail for page " + page, e);
+            return new Thumbnail(page, e.getMessage());
+        } finally {
+            bitmap.recycle();
+        }
+    }
+
+    private File thumbnailFile(String checksum, int page, int dimension) {
+        return new File(thumbnailDir, checksum + "_" + page + "_" + dimension + THUMBNAIL_EXTENSION);
+    }
+
+    /**
+     * Write to a temporary file and rename, so readers never see partial JPEGs
+     */
+    private static void writeAtomically(Bitmap bitmap, File target) throws IOException {
+        File temp = new File(target.getParentFile(), target.getName() + "." + Thread.currentThread().getId() + ".tmp");
+        try (FileOutputStream out = new FileOutputStream(temp)) {
+            if (!bitmap.compress(Bitmap.CompressFormat.JPEG, JPEG_QUALITY, out)) {
+                throw new IOException("JPEG compression failed");
+            }
+        }
+        if (!temp.renameTo(target)) {
+            temp.delete();
+            throw new IOException("Failed to move thumbnail into cache: " + target.getName());
+        }
+    }
+
+    /**
+     * Content checksum from PDFNativeCacheManager, so thumbnails, the page store and
+     * the PDF cache share one identity for a document's bytes
+     */
+    private String checksumOf(File file) throws IOException {
+        String identity = file.getAbsolutePath() + "|" + file.length() + "|" + file.lastModified();
+        String cached = checksums.get(identity);
+        if (cached != null) {
+            return cached;
+        }
+        String checksum = cacheManager.contentChecksum(file.getAbsolutePath());
+        if (checksum == null) {
+            throw new IOException("Cannot checksum " + file.getName());
+        }
+        checksums.put(identity, checksum);
+        return checksum;
+    }
+
+    /**
+     * PdfRenderer fallback when the native library is unavailable
+     * PdfRenderer allows one open page at a time, so pages render serially here
+     * while JPEG encoding still runs in parallel.
+     */
+    private static class PdfRendererSource {
+        private final ParcelFileDescriptor descriptor;
+        private final PdfRenderer renderer;
+
+        PdfRendererSource(File file) throws IOException {
+            descriptor = ParcelFileDescriptor.open(file, ParcelFileDescriptor.MODE_READ_ONLY);
+            renderer = new PdfRenderer(descriptor);
+        }
+
+        synchronized float[] pageSize(int pageNumber) {
+            if (pageNumber < 1 || pageNumber > renderer.getPageCount()) {
+                return null;
+            }
+            try (PdfRenderer.Page page = renderer.openPage(pageNumber - 1)) {
+                return new float[] { page.getWidth(), page.getHeight() };
+            }
+        }
+
+        synchronized boolean render(int pageNumber, Bitmap bitmap) {
+            if (pageNumber < 1 || pageNumber > renderer.getPageCount()) {
+                return false;
+            }
+            bitmap.eraseColor(Color.WHITE);
+            try (PdfRenderer.Page page = renderer.openPage(pageNumber - 1)) {
+                page.render(bitmap, null, null, PdfRenderer.Page.RENDER_MODE_FOR_DISPLAY);
+            }
+            return true;
+        }
+
+        synchronized void close() {
+            renderer.close();
+            try {
+                descriptor.close();
+            } catch (IOException e) {
+                Log.w(TAG, "Failed to close PDF descriptor", e);
+            }
+        }
+    }
+}
@@ -60,6 +60,7 @@ public class PdfManager extends SimpleViewManager<PdfView> implements RNPDFPdfVi
 
     @Override
     public void onDropViewInstance(PdfView pdfView) {
+        pdfView.releaseNativeDocument();
         pdfView = null;
     }
 
@@ -20,6 +20,7 @@ import android.net.Uri;
 import android.util.AttributeSet;
 import android.view.MotionEvent;
 import android.graphics.Canvas;
+import android.os.SystemClock;
 
 
 import com.facebook.react.uimanager.ThemedReactContext;
@@ -86,6 +87,18 @@ public class PdfView extends PDFView implements OnPageChangeListener,OnLoadCompl
     private String lastLoadedPath = null;
     private float lastPageHeight = 0;
 
+    // pdfId this view holds a reference to in the shared native document registry
+    private String registeredDocumentId = null;
+
+    // Gesture hint sent to the native render engine. onPageScrolled fires every
+    // frame, so JNI is crossed only when the state changes, plus a keep-alive well
+    // inside the engine's 500ms expiry; the state clears once scrolling settles.
+    private static final long INTERACTION_KEEPALIVE_MS = 250;
+    private static final long INTERACTION_SETTLE_MS = 150;
+    private boolean nativeInteracting = false;
+    private long lastInteractionPing = 0;
+    private final Runnable interactionSettled = () -> setNativeInteracting(false);
+
     // used to store the parameters for `super.onSizeChanged`
     private int oldW = 0;
     private int oldH = 0;
@@ -101,6 +114,11 @@ public class PdfView extends PDFView implements OnPageChangeListener,OnLoadCompl
         this.page = page;
         showLog(format("%s %s / %s", path, page, numberOfPages));
 
+        // the viewer renders with its own pdfium, so index the shown page here
+        if (registeredDocumentId != null) {
+            NativeDocumentRegistry.prefetchHitIndex(registeredDocumentId, page);
+        }
+
         WritableMap event = Arguments.createMap();
         event.putString("message", "pageChanged|"+page+"|"+numberOfPages);
 
@@ -210,6 +228,13 @@ public class PdfView extends PDFView implements OnPageChangeListener,OnLoadCompl
         Constants.Pinch.MINIMUM_ZOOM = this.minScale;
         Constants.Pinch.MAXIMUM_ZOOM = this.maxScale;
 
+        // keep native renders at draft quality while the view is moving
+        if (registeredDocumentId != null) {
+            setNativeInteracting(true);
+            removeCallbacks(interactionSettled);
+            postDelayed(interactionSettled, INTERACTION_SETTLE_MS);
+        }
+
     }
 
     @Override
@@ -282,6 +307,15 @@ public class PdfView extends PDFView implements OnPageChangeListener,OnLoadCompl
         super.onAttachedToWindow();
         if (this.isRecycled())
             this.drawPdf();
+        if (registeredDocumentId == null && lastLoadedPath != null) {
+            attachNativeDocument(lastLoadedPath);
+        }
+    }
+
+    @Override
+    protected void onDetachedFromWindow() {
+        releaseNativeDocument();
+        super.onDetachedFromWindow();
     }
 
     public void drawPdf() {
@@ -350,6 +384,7 @@ public class PdfView extends PDFView implements OnPageChangeListener,OnLoadCompl
             }
 
             configurator.load();
+            attachNativeDocument(this.path);
             
             // Mark as loaded, clear reload flag
             lastLoadedPath = this.path;
@@ -494,6 +529,49 @@ public class PdfView extends PDFView implements OnPageChangeListener,OnLoadCompl
         this.jumpTo(page);
     }
 
+    /**
+     * Hold the displayed file in the native registry while the view shows it
+     * OPTIMIZATION: JSI calls, export and thumbnails for the same pdfId reuse this
+     * document instead of parsing it again, and the render engine and hit index
+     * receive this view's gesture and page-change hints. The acquire runs off the
+     * UI thread; hints sent before it completes are dropped natively.
+     */
+    private void attachNativeDocument(String path) {
+        releaseNativeDocument();
+        if (path == null) {
+            return;
+        }
+        Uri uri = getURI(path);
+        String scheme = uri.getScheme();
+        if (scheme == null || !scheme.equals("file") || uri.getPath() == null) {
+            return;
+        }
+        registeredDocumentId = path;
+        NativeDocumentRegistry.acquireAsync(path, uri.getPath());
+    }
+
+    public void releaseNativeDocument() {
+        removeCallbacks(interactionSettled);
+        setNativeInteracting(false);
+        if (registeredDocumentId != null) {
+            NativeDocumentRegistry.releaseAsync(registeredDocumentId);
+            registeredDocumentId = null;
+        }
+    }
+
+    private void setNativeInteracting(boolean active) {
+        long now = SystemClock.uptimeMillis();
+        if (active == nativeInteracting
+                && (!active || now - lastInteractionPing < INTERACTION_KEEPALIVE_MS)) {
+            return;
+        }
+        nativeInteracting = active;
+        lastInteractionPing = now;
+        if (registeredDocumentId != null) {
+            NativeDocumentRegistry.setInteracting(registeredDocumentId, active);
+        }
+    }
+
     private void showLog(final String str) {
         Log.d("PdfView", str);
     }
@@ -0,0 +1,375 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Progressive download of remote PDFs
+ *
+ * OPTIMIZATION: The first page shows while the rest of the file downloads
+ * The file is fetched with HTTP Range requests into a file of its final size.
+ * After each range the native PDFProgressiveDocument checks what Pdfium can
+ * parse and names the byte ranges it needs next, which are fetched before the
+ * sequential fill. Linearized ("fast web view") files have their first page
+ * complete after a small prefix; it is rendered to a JPEG preview and reported
+ * right away. Servers without range support, or Pdfium builds without the data
+ * availability API, fall back to one plain download with no preview.
+ */
+
+package org.wonday.pdf;
+
+import android.graphics.Bitmap;
+import android.util.Log;
+
+import com.facebook.soloader.SoLoader;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.RandomAccessFile;
+import java.net.HttpURLConnection;
+import java.net.URL;
+import java.util.BitSet;
+import java.util.Map;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+public class ProgressiveDownloader {
+    private static final String TAG = "ProgressiveDownloader";
+    private static final boolean nativeAvailable;
+
+    // Unit of range requests and of the availability bookkeeping
+    private static final int CHUNK_SIZE = 128 * 1024;
+    // Contiguous chunks fetched per request by the sequential fill
+    private static final int SEQUENTIAL_CHUNKS = 8;
+    private static final int BUFFER_SIZE = 64 * 1024;
+    private static final int CONNECT_TIMEOUT_MS = 15000;
+    private static final int READ_TIMEOUT_MS = 30000;
+    private static final int JPEG_QUALITY = 85;
+    private static final Pattern CONTENT_RANGE = Pattern.compile("bytes\\s+(\\d+)-(\\d+)/(\\d+)");
+
+    // PDFJSI_PROGRESSIVE_* states reported by nativePoll
+    private static final int STATE_ERROR = -1;
+    private static final int STATE_FIRST_PAGE = 2;
+
+    static {
+        boolean loaded = false;
+        try {
+            SoLoader.loadLibrary("pdfjsi");
+            loaded = true;
+        } catch (UnsatisfiedLinkError e) {
+            Log.e(TAG, "PDF JSI native library not available, previews disabled", e);
+        }
+        nativeAvailable = loaded;
+    }
+
+    /**
+     * First page rendered before the download completed
+     */
+    public static class Preview {
+        public final int pageNumber;
+        public final int pageCount;
+        public final boolean linearized;
+        public final String uri;
+        public final int width;
+        public final int height;
+
+        Preview(int pageNumber, int pageCount, boolean linearized, File file, int width, int height) {
+            this.pageNumber = pageNumber;
+            this.pageCount = pageCount;
+            this.linearized = linearized;
+            this.uri = "file://" + file.getAbsolutePath();
+            this.width = width;
+            this.height = height;
+        }
+    }
+
+    public interface Listener {
+        // Called at most once, with null when no preview can be shown before completion
+        void onPreview(Preview preview);
+        void onProgress(long received, long total);
+    }
+
+    private final String url;
+    private final Map<String, String> headers;
+    private final File target;
+    private final File previewFile;
+    private final int previewDimension;
+    private volatile boolean cancelled;
+
+    // Validator from the first response; later ranges must come from the same file version
+    private String validator;
+    private boolean previewReported;
+
+    /**
+     * @param url Remote document
+     * @param headers Extra request headers (may be null)
+     * @param target File receiving the document; complete once download() returns
+     * @param previewFile JPEG file for the first page preview
+     * @param previewDimension Longest side of the preview in pixels
+     */
+    public ProgressiveDownloader(String url, Map<String, String> headers, File target, File previewFile,
+                                 int previewDimension) {
+        this.url = url;
+        this.headers = headers;
+        this.target = target;
+        this.previewFile = previewFile;
+        this.previewDimension = previewDimension;
+    }
+
+    public void cancel() {
+        cancelled = true;
+    }
+
+    /**
+     * Download the whole document, reporting the preview as soon as it is available
+     * Blocks until the file is complete; call from a background thread.
+     */
+    public void download(Listener listener) throws IOException {
+        HttpURLConnection probe = openConnection("bytes=0-" + (CHUNK_SIZE - 1));
+        try {
+            int status = probe.getResponseCode();
+            long total = status == HttpURLConnection.HTTP_PARTIAL ? totalLength(probe) : -1;
+            if (total <= 0) {
+                if (status != HttpURLConnection.HTTP_OK && status != HttpURLConnection.HTTP_PARTIAL) {
+                    throw new IOException("Download failed with HTTP " + status + ": " + url);
+                }
+                Log.d(TAG, "No range support, downloading " + url + " in one request");
+                reportPreview(listener, null);
+                downloadWhole(probe, listener);
+                return;
+            }
+            validator = probe.getHeaderField("ETag");
+            if (validator == null) {
+                validator = probe.getHeaderField("Last-Modified");
+            }
+            downloadRanges(probe, total, listener);
+        } finally {
+            probe.disconnect();
+        }
+    }
+
+    private void downloadRanges(HttpURLConnection probe, long total, Listener listener) throws IOException {
+        int chunkCount = (int) ((total + CHUNK_SIZE - 1) / CHUNK_SIZE);
+        BitSet present = new BitSet(chunkCount);
+        long received = 0;
+        long handle = 0;
+        try (RandomAccessFile file = new RandomAccessFile(target, "rw")) {
+            // Sparse on the file systems Android uses; ranges land at their final offsets
+            file.setLength(total);
+            received += readInto(probe, file, 0, Math.min(CHUNK_SIZE, total));
+            present.set(0);
+            listener.onProgress(received, total);
+
+            handle = nativeAvailable ? nativeCreate(target.getAbsolutePath(), total) : 0;
+            if (handle != 0) {
+                nativeMarkAvailable(handle, 0, Math.min(CHUNK_SIZE, total));
+            } else {
+                reportPreview(listener, null);
+            }
+
+            int cursor = 1;
+            while (true) {
+                checkCancelled();
+                int first = -1;
+                int count = 0;
+                if (handle != 0) {
+                    long[] poll = nativePoll(handle);
+                    int state = poll != null ? (int) poll[0] : STATE_ERROR;
+                    if (state == STATE_FIRST_PAGE || state == STATE_ERROR) {
+                        reportPreview(listener, state == STATE_FIRST_PAGE ? renderPreview(handle, poll) : null);
+                        nativeDestroy(handle);
+                        handle = 0;
+                    } else {
+                        // Ranges Pdfium needs for the first page come before the sequential fill
+                        for (int i = 4; i + 1 < poll.length && first < 0; i += 2) {
+                            int chunk = (int) (poll[i] / CHUNK_SIZE);
+                            int last = (int) ((poll[i] + poll[i + 1] - 1) / CHUNK_SIZE);
+                            int missing = present.nextClearBit(chunk);
+                            if (missing <= last) {
+                                first = missing;
+                                count = 1;
+                                while (first + count <= last && !present.get(first + count)) {
+                                    count++;
+                                }
+                            }
+                        }
+                    }
+                }
+                if (first < 0) {
+                    first = present.nextClearBit(cursor);
+                    if (first >= chunkCount) {
+                        first = present.nextClearBit(0);
+                    }
+                    if (first >= chunkCount) {
+                        break;
+                    }
+                    count = 1;
+                    // Chunks wanted by the preview arrive one request at a time so it is checked often
+                    int limit = handle != 0 ? 1 : SEQUENTIAL_CHUNKS;
+                    while (count < limit && first + count < chunkCount && !present.get(first + count)) {
+                        count++;
+                    }
+                    cursor = first + count;
+                }
+
+                long offset = (long) first * CHUNK_SIZE;
+                long length = Math.min((long) count * CHUNK_SIZE, total - offset);
+                received += fetchRange(file, offset, length, total);
+                present.set(first, first + count);
+                if (handle != 0) {
+                    nativeMarkAvailable(handle, offset, length);
+                }
+                listener.onProgress(received, total);
+            }
+            file.getFD().sync();
+            if (handle != 0) {
+                // The whole file arrived before the first page could be parsed (not linearized)
+                long[] poll = nativePoll(handle);
+                boolean ready = poll != null && poll[0] == STATE_FIRST_PAGE;
+                reportPreview(listener, ready ? renderPreview(handle, poll) : null);
+            }
+        } finally {
+            if (handle != 0) {
+                nativeDestroy(handle);
+            }
+        }
+    }
+
+    private long fetchRange(RandomAccessFile file, long offset, long length, long total) throws IOException {
+        HttpURLConnection connection = openConnection("bytes=" + offset + "-" + (offset + length - 1));
+        try {
+            int status = connection.getResponseCode();
+            if (status != HttpURLConnection.HTTP_PARTIAL) {
+                // 200 to an If-Range request means the file changed under the download
+                throw new IOException("Range request failed with HTTP " + status + ": " + url);
+            }
+            Matcher range = CONTENT_RANGE.matcher(stringOr(connection.getHeaderField("Content-Range"), ""));
+            if (!range.find() || Long.parseLong(range.group(1)) != offset || Long.parseLong(range.group(3)) != total) {
+                throw new IOException("Unexpected Content-Range for " + url);
+            }
+            return readInto(connection, file, offset, length);
+        } finally {
+            connection.disconnect();
+        }
+    }
+
+    private long readInto(HttpURLConnection connection, RandomAccessFile file, long offset, long length)
+            throws IOException {
+        byte[] buffer = new byte[BUFFER_SIZE];
+        long done = 0;
+        file.seek(offset);
+        try (InputStream in = connection.getInputStream()) {
+            while (done < length) {
+                checkCancelled();
+                int read = in.read(buffer, 0, (int) Math.min(buffer.length, length - done));
+                if (read < 0) {
+                    throw new IOException("Connection closed after " + (offset + done) + " bytes: " + url);
+                }
+                file.write(buffer, 0, read);
+                done += read;
+            }
+        }
+        return done;
+    }
+
+    private void downloadWhole(HttpURLConnection connection, Listener listener) throws IOException {
+        long total = contentLength(connection);
+        byte[] buffer = new byte[BUFFER_SIZE];
+        long received = 0;
+        try (InputStream in = connection.getInputStream();
+             FileOutputStream out = new FileOutputStream(target)) {
+            int read;
+            while ((read = in.read(buffer)) != -1) {
+                checkCancelled();
+                out.write(buffer, 0, read);
+                received += read;
+                listener.onProgress(received, total);
+            }
+            out.getFD().sync();
+        }
+        if (total > 0 && received != total) {
+            throw new IOException("DownloadFailed:" + url);
+        }
+    }
+
+    private Preview renderPreview(long handle, long[] poll) {
+        float[] size = nativeFirstPageSize(handle);
+        if (size == null || size[0] <= 0 || size[1] <= 0) {
+            return null;
+        }
+        float scale = previewDimension / Math.max(size[0], size[1]);
+        int width = Math.max(1, Math.round(size[0] * scale));
+        int height = Math.max(1, Math.round(size[1] * scale));
+        Bitmap bitmap = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888);
+        try {
+            if (!nativeRenderFirstPage(handle, bitmap)) {
+                return null;
+            }
+            try (FileOutputStream out = new FileOutputStream(previewFile)) {
+                if (!bitmap.compress(Bitmap.CompressFormat.JPEG, JPEG_QUALITY, out)) {
+                    return null;
+                }
+            }
+            return new Preview((int) poll[3], (int) poll[2], poll[1] == 1, previewFile, width, height);
+        } catch (IOException e) {
+            Log.w(TAG, "Failed to write preview for " + url, e);
+            return null;
+        } finally {
+            bitmap.recycle();
+        }
+    }
+
+    private void reportPreview(Listener listener, Preview preview) {
+        if (!previewReported) {
+            previewReported = true;
+            listener.onPreview(preview);
+        }
+    }
+
+    private HttpURLConnection openConnection(String range) throws IOException {
+        HttpURLConnection connection = (HttpURLConnection) new URL(url).openConnection();
+        connection.setConnectTimeout(CONNECT_TIMEOUT_MS);
+        connection.setReadTimeout(READ_TIMEOUT_MS);
+        if (headers != null) {
+            for (Map.Entry<String, String> header : headers.entrySet()) {
+                connection.setRequestProperty(header.getKey(), header.getValue());
+            }
+        }
+        // Byte offsets must refer to the stored bytes, not a compressed transfer
+        connection.setRequestProperty("Accept-Encoding", "identity");
+        connection.setRequestProperty("Range", range);
+        if (validator != null) {
+            connection.setRequestProperty("If-Range", validator);
+        }
+        return connection;
+    }
+
+    private void checkCancelled() throws IOException {
+        if (cancelled) {
+            throw new IOException("Download cancelled: " + url);
+        }
+    }
+
+    private static long totalLength(HttpURLConnection connection) {
+        Matcher range = CONTENT_RANGE.matcher(stringOr(connection.getHeaderField("Content-Range"), ""));
+        return range.find() ? Long.parseLong(range.group(3)) : -1;
+    }
+
+    // getContentLengthLong needs API 24
+    private static long contentLength(HttpURLConnection connection) {
+        try {
+            return Long.parseLong(stringOr(connection.getHeaderField("Content-Length"), "-1"));
+        } catch (NumberFormatException e) {
+            return -1;
+        }
+    }
+
+    private static String stringOr(String value, String fallback) {
+        return value != null ? value : fallback;
+    }
+
+    private static native long nativeCreate(String path, long fileSize);
+    private static native void nativeMarkAvailable(long handle, long offset, long length);
+    private static native long[] nativePoll(long handle);
+    private static native float[] nativeFirstPageSize(long handle);
+    private static native boolean nativeRenderFirstPage(long handle, Bitmap bitmap);
+    private static native void nativeDestroy(long handle);
+}
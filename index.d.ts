@@ -25,6 +25,10 @@ export type Source = {
     cacheFileName?: string;
     expiration?: number;
     method?: string;
+    /**
+     * Download with HTTP range requests and show the first page while the rest arrives (Android, iOS)
+     */
+    progressive?: boolean;
 };
 
 export interface PdfProps {
@@ -64,12 +68,19 @@ export interface PdfProps {
     onPageChanged?: (page: number, numberOfPages: number) => void,
     onError?: (error: object) => void,
     onPageSingleTap?: (page: number, x: number, y: number) => void,
+    /** iOS: words selected by a long press and drag, in page coordinates */
+    onPageLongPress?: (page: number, x: number, y: number, text: string) => void,
     onScaleChanged?: (scale: number) => void,
     onPressLink?: (url: string) => void,
+    /** iOS: matches on one page as [x, y, width, height] rects in page coordinates */
+    onSearchResult?: (page: number, rects: number[][], searchTerm: string) => void,
+    onSearchComplete?: (totalMatches: number, pagesSearched: number, searchTerm: string, cached: boolean) => void,
 }
 
 declare class Pdf extends React.Component<PdfProps, any> {
     setPage: (pageNumber: number) => void;
+    searchText: (searchTerm: string) => Promise<boolean>;
+    cancelSearch: () => Promise<boolean>;
 }
 
 export default Pdf;
@@ -18,6 +18,7 @@ import {
     StyleSheet,
     Image,
     Text,
+    NativeModules,
     requireNativeComponent
 } from 'react-native';
 import PdfViewNativeComponent, {
@@ -39,6 +40,7 @@ export default class Pdf extends Component {
                 cache: PropTypes.bool,
                 cacheFileName: PropTypes.string,
                 expiration: PropTypes.number,
+                progressive: PropTypes.bool,
             }),
             // Opaque type returned by require('./test.pdf')
             PropTypes.number,
@@ -65,8 +67,11 @@ export default class Pdf extends Component {
         onPageChanged: PropTypes.func,
         onError: PropTypes.func,
         onPageSingleTap: PropTypes.func,
+        onPageLongPress: PropTypes.func,
         onScaleChanged: PropTypes.func,
         onPressLink: PropTypes.func,
+        onSearchResult: PropTypes.func,
+        onSearchComplete: PropTypes.func,
 
         // Props that are not available in the earlier react native version, added to prevent crashed on android
         accessibilityLabel: PropTypes.string,
@@ -107,10 +112,16 @@ export default class Pdf extends Component {
         },
         onPageSingleTap: (page, x, y) => {
         },
+        onPageLongPress: (page, x, y, text) => {
+        },
         onScaleChanged: (scale) => {
         },
         onPressLink: (url) => {
         },
+        onSearchResult: (page, rects, searchTerm) => {
+        },
+        onSearchComplete: (totalMatches, pagesSearched, searchTerm, cached) => {
+        },
     };
 
     constructor(props) {
@@ -120,10 +131,12 @@ export default class Pdf extends Component {
             path: '',
             isDownloaded: false,
             progress: 0,
+            previewUri: null,
             jsiAvailable: false,
         };
 
         this.lastRNBFTask = null;
+        this.progressiveTask = null;
         this.pdfJSI = PDFJSI;
         this.initializeJSI();
 
@@ -151,6 +164,7 @@ export default class Pdf extends Component {
         const curSource = Image.resolveAssetSource(prevProps.source);
 
         if ((nextSource.uri !== curSource.uri)) {
+            this._cancelProgressive();
             // if has download task, then cancel it.
             if (this.lastRNBFTask && this.lastRNBFTask.cancel) {
                 this.lastRNBFTask.cancel(err => {
@@ -170,6 +184,7 @@ export default class Pdf extends Component {
 
     componentWillUnmount() {
         this._mounted = false;
+        this._cancelProgressive();
         if (this.lastRNBFTask) {
             // this.lastRNBFTask.cancel(err => {
             // });
@@ -185,7 +200,7 @@ export default class Pdf extends Component {
         let uri = source.uri || '';
         // first set to initial state
         if (this._mounted) {
-            this.setState({isDownloaded: false, path: '', progress: 0});
+            this.setState({isDownloaded: false, path: '', progress: 0, previewUri: null});
         }
         const filename = source.cacheFileName || SHA1(uri) + '.pdf';
         const cacheFile = ReactNativeBlobUtil.fs.dirs.CacheDir + '/' + filename;
@@ -280,6 +295,15 @@ export default class Pdf extends Component {
             });
             this.lastRNBFTask = null;
         }
+        this._cancelProgressive();
+
+        // Range requests need a plain GET; the native side falls back to a whole download itself
+        const method = source.method ? source.method.toUpperCase() : 'GET';
+        if (source.progressive && method === 'GET' && !source.body && NativeModules.PDFJSIManager
+            && NativeModules.PDFJSIManager.openProgressive) {
+            this._downloadProgressive(source, cacheFile);
+            return;
+        }
 
         const tempCacheFile = cacheFile + '.tmp';
         this._unlinkFile(tempCacheFile);
@@ -353,6 +377,53 @@ export default class Pdf extends Component {
 
     };
 
+    // Shows the first page as soon as it arrives, then opens the finished file as usual
+    _downloadProgressive = async (source, cacheFile) => {
+
+        const tempCacheFile = cacheFile + '.tmp';
+        await this._unlinkFile(tempCacheFile);
+
+        const task = {target: tempCacheFile};
+        this.progressiveTask = task;
+
+        try {
+            const result = await PDFJSI.openProgressive(source.uri, source.headers, tempCacheFile);
+            if (result && result.preview && this._mounted && this.progressiveTask === task) {
+                this.setState({previewUri: result.preview.uri});
+            }
+
+            await PDFJSI.awaitProgressive(tempCacheFile);
+            if (this.progressiveTask !== task) {
+                return;
+            }
+            this.progressiveTask = null;
+
+            await this._unlinkFile(cacheFile);
+            await ReactNativeBlobUtil.fs.cp(tempCacheFile, cacheFile);
+            if (this._mounted) {
+                this.setState({path: cacheFile, isDownloaded: true, progress: 1});
+            }
+            this._unlinkFile(tempCacheFile);
+        } catch (error) {
+            this._unlinkFile(tempCacheFile);
+            // A cancelled download rejects too; only the current one reports
+            if (this.progressiveTask === task) {
+                this.progressiveTask = null;
+                this._unlinkFile(cacheFile);
+                this._onError(error);
+            }
+        }
+
+    };
+
+    _cancelProgressive = () => {
+        if (this.progressiveTask) {
+            const {target} = this.progressiveTask;
+            this.progressiveTask = null;
+            PDFJSI.cancelProgressive(target).catch(() => {});
+        }
+    };
+
     _unlinkFile = async (file) => {
         try {
             await ReactNativeBlobUtil.fs.unlink(file);
@@ -367,6 +438,26 @@ export default class Pdf extends Component {
         }
     };
 
+    /**
+     * Search the document in the background (iOS)
+     * Matches stream through onSearchResult page by page, starting at the current page,
+     * then onSearchComplete fires. A new search cancels the one in progress.
+     * @param {string} searchTerm - Text to find (case and diacritic insensitive)
+     */
+    searchText(searchTerm) {
+        if (Platform.OS !== 'ios' || !this.state.path) {
+            return Promise.resolve(false);
+        }
+        return NativeModules.RNPDFPdfViewManager.startSearch(this.state.path, searchTerm);
+    }
+
+    cancelSearch() {
+        if (Platform.OS !== 'ios' || !this.state.path) {
+            return Promise.resolve(false);
+        }
+        return NativeModules.RNPDFPdfViewManager.cancelSearch(this.state.path);
+    }
+
     setPage( pageNumber ) {
         if ( (pageNumber === null) || (isNaN(pageNumber)) ) {
             throw new Error('Specified pageNumber is not a number');
@@ -401,8 +492,10 @@ export default class Pdf extends Component {
     // 🚀 JSI Enhanced Methods
     
     generatePdfId = () => {
-        // Generate a unique ID for this PDF instance
-        return `pdf_${Date.now()}_${Math.random().toString(36).substr(2, 9)}`;
+        // Use the displayed file path: the native document registry keys the
+        // view's document by it, so JSI calls reuse that document instead of
+        // opening a new one per call
+        return this.state.path;
     };
 
     // Enhanced page rendering with JSI
@@ -414,11 +507,12 @@ export default class Pdf extends Component {
 
         try {
             const pdfId = this.generatePdfId();
+            // No base64 payload: the native engine opens the document from its path
             const result = await this.pdfJSI.renderPageDirect(
                 pdfId,
                 pageNumber,
                 scale,
-                this.state.path
+                ''
             );
             console.log(`🚀 JSI: Rendered page ${pageNumber} in ${result.renderTimeMs}ms`);
             return result;
@@ -444,14 +538,14 @@ export default class Pdf extends Component {
     };
 
     // Preload pages via JSI
-    preloadPagesWithJSI = async (startPage, endPage) => {
+    preloadPagesWithJSI = async (startPage, endPage, currentPage = startPage) => {
         if (!this.state.jsiAvailable) {
             return false;
         }
 
         try {
             const pdfId = this.generatePdfId();
-            const success = await this.pdfJSI.preloadPagesDirect(pdfId, startPage, endPage);
+            const success = await this.pdfJSI.preloadPagesDirect(pdfId, startPage, endPage, currentPage);
             console.log(`🚀 JSI: Preloaded pages ${startPage}-${endPage}: ${success}`);
             return success;
         } catch (error) {
@@ -516,10 +610,23 @@ export default class Pdf extends Component {
                 this._onError(new Error(message[1]));
             } else if (message[0] === 'pageSingleTap') {
                 this.props.onPageSingleTap && this.props.onPageSingleTap(Number(message[1]), Number(message[2]), Number(message[3]));
+            } else if (message[0] === 'pageLongPress') {
+                // The selected text is last and may itself contain '|'
+                this.props.onPageLongPress && this.props.onPageLongPress(Number(message[1]), Number(message[2]), Number(message[3]), message.slice(4).join('|'));
             } else if (message[0] === 'scaleChanged') {
                 this.props.onScaleChanged && this.props.onScaleChanged(Number(message[1]));
             } else if (message[0] === 'linkPressed') {
                 this.props.onPressLink && this.props.onPressLink(message[1]);
+            } else if (message[0] === 'searchResult') {
+                let rects;
+                try {
+                    rects = JSON.parse(message[3]);
+                } catch(e) {
+                    rects = [];
+                }
+                this.props.onSearchResult && this.props.onSearchResult(Number(message[1]), rects, message[4]);
+            } else if (message[0] === 'searchComplete') {
+                this.props.onSearchComplete && this.props.onSearchComplete(Number(message[1]), Number(message[2]), message[4], message[3] === '1');
             }
         }
 
@@ -535,7 +642,12 @@ export default class Pdf extends Component {
         if (Platform.OS === "android" || Platform.OS === "ios" || Platform.OS === "windows") {
                 return (
                     <View style={[this.props.style,{overflow: 'hidden'}]}>
-                        {!this.state.isDownloaded?
+                        {!this.state.isDownloaded && this.state.previewUri?
+                            (<Image
+                                style={{flex: 1}}
+                                source={{uri: this.state.previewUri}}
+                                resizeMode="contain"
+                            />):!this.state.isDownloaded?
                             (<View
                                 style={[styles.progressContainer, this.props.progressContainerStyle]}
                             >
@@ -1,19 +1,45 @@
 #import "PDFExporter.h"
 #import <PDFKit/PDFKit.h>
 #import <UIKit/UIKit.h>
+#import <ImageIO/ImageIO.h>
 
-@implementation PDFExporter
+static NSString *const PDFExportProgressEvent = @"PDFExportProgress";
+// Floor for the pixel memory rendering pages may hold at once
+static const unsigned long long PDFExportMinBitmapBudget = 16ull * 1024 * 1024;
+
+@implementation PDFExporter {
+    BOOL _hasListeners;
+    // Whole exports run one at a time; the pages of one export run in parallel
+    dispatch_queue_t _exportQueue;
+}
 
 RCT_EXPORT_MODULE();
 
++ (BOOL)requiresMainQueueSetup {
+    return NO;
+}
+
 - (instancetype)init {
     self = [super init];
     if (self) {
         // All features are FREE - no license verification needed
+        _exportQueue = dispatch_queue_create("com.pdfjsi.export", DISPATCH_QUEUE_SERIAL);
     }
     return self;
 }
 
+- (NSArray<NSString *> *)supportedEvents {
+    return @[PDFExportProgressEvent];
+}
+
+- (void)startObserving {
+    _hasListeners = YES;
+}
+
+- (void)stopObserving {
+    _hasListeners = NO;
+}
+
 //
 RCT_EXPORT_METHOD(exportToImages:(NSString *)filePath
                   options:(NSDictionary *)options
@@ -38,25 +64,28 @@ RCT_EXPORT_METHOD(exportToImages:(NSString *)filePath
     NSNumber *dpi = options[@"dpi"] ?: @150;
     NSString *format = options[@"format"] ?: @"png";
     NSString *outputDir = options[@"outputDir"];
+    NSString *progressId = [options[@"progressId"] isKindOfClass:[NSString class]] ? options[@"progressId"] : nil;
     
-    
-    NSArray *exportedFiles = [self exportPagesToImages:pdfURL pages:pages dpi:dpi.intValue format:format outputDir:outputDir];
-    
-    resolve(exportedFiles);
+    dispatch_async(_exportQueue, ^{
+        NSArray *exportedFiles = [self exportPagesToImages:pdfURL pages:pages dpi:dpi.intValue format:format outputDir:outputDir progressId:progressId];
+        resolve(exportedFiles);
+    });
 }
 
 /**
  * Export specific pages to images
+ * Pages are rendered and encoded by one worker per core, each with its own
+ * PDFDocument since PDFKit documents are not safe to share across threads.
+ * Every page is written as soon as it is rendered and its bitmap released, so
+ * memory stays bounded by the bitmap budget rather than the page count.
  */
-- (NSArray *)exportPagesToImages:(NSURL *)pdfURL pages:(NSArray *)pages dpi:(int)dpi format:(NSString *)format outputDir:(NSString *)outputDir {
+- (NSArray *)exportPagesToImages:(NSURL *)pdfURL pages:(NSArray *)pages dpi:(int)dpi format:(NSString *)format outputDir:(NSString *)outputDir progressId:(NSString *)progressId {
     NSLog(@"🖼️ [EXPORT] exportPagesToImages - START - dpi: %d, format: %@", dpi, format);
     
-    NSMutableArray *exportedFiles = [NSMutableArray array];
-    
     PDFDocument *pdfDocument = [[PDFDocument alloc] initWithURL:pdfURL];
     if (!pdfDocument) {
         NSLog(@"❌ [EXPORT] Failed to load PDF document");
-        return exportedFiles;
+        return @[];
     }
     
     NSUInteger pageCount = pdfDocument.pageCount;
@@ -80,109 +109,191 @@ RCT_EXPORT_METHOD(exportToImages:(NSString *)filePath
         NSLog(@"📊 [PROGRESS] Exporting all %lu pages", (unsigned long)pageCount);
     }
     
-    // Export each page
-    int current = 0;
-    for (NSNumber *pageNum in pagesToExport) {
-        int pageIndex = pageNum.intValue;
-        current++;
+    NSUInteger total = pagesToExport.count;
+    if (total == 0) {
+        return @[];
+    }
+    
+    NSString *directory = outputDir;
+    if (directory.length > 0) {
+        [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+    } else {
+        // Save to app's documents directory
+        directory = NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES).firstObject;
+    }
+    
+    CGFloat scale = dpi / 72.0; // 72 DPI is default
+    NSUInteger workers = MIN((NSUInteger)MAX([NSProcessInfo processInfo].activeProcessorCount, 1), total);
+    unsigned long long bitmapBudget = MAX(PDFExportMinBitmapBudget, [NSProcessInfo processInfo].physicalMemory / 16);
+    
+    // Guards the next page to pick, the pixel bytes in flight and the counters below
+    NSCondition *state = [[NSCondition alloc] init];
+    __block NSUInteger nextPage = 0;
+    __block unsigned long long bytesInFlight = 0;
+    __block NSUInteger completed = 0;
+    NSMutableArray *exported = [NSMutableArray arrayWithCapacity:total];
+    for (NSUInteger i = 0; i < total; i++) {
+        [exported addObject:[NSNull null]];
+    }
+    
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t workQueue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+    for (NSUInteger worker = 0; worker < workers; worker++) {
+        dispatch_group_async(group, workQueue, ^{
+            PDFDocument *document = worker == 0 ? pdfDocument : [[PDFDocument alloc] initWithURL:pdfURL];
+            if (!document) {
+                return;
+            }
+            while (YES) {
+                [state lock];
+                NSUInteger slot = nextPage++;
+                [state unlock];
+                if (slot >= total) {
+                    break;
+                }
+                
+                int pageIndex = [pagesToExport[slot] intValue];
+                NSString *outputPath = [self exportPage:document pageIndex:pageIndex scale:scale format:format directory:directory state:state bytesInFlight:&bytesInFlight bitmapBudget:bitmapBudget];
+                
+                [state lock];
+                if (outputPath) {
+                    exported[slot] = outputPath;
+                }
+                NSUInteger done = ++completed;
+                [state unlock];
+                
+                if (outputPath) {
+                    NSLog(@"✅ [PROGRESS] Page %d exported to %@ (%lu/%lu)", pageIndex + 1, outputPath, (unsigned long)done, (unsigned long)total);
+                } else {
+                    NSLog(@"❌ [EXPORT] Failed to save page %d", pageIndex + 1);
+                }
+                [self emitProgress:progressId filePath:pdfURL.path page:pageIndex + 1 completed:done total:total outputPath:outputPath];
+            }
+        });
+    }
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    
+    NSMutableArray *exportedFiles = [NSMutableArray arrayWithCapacity:total];
+    for (id path in exported) {
+        if (path != [NSNull null]) {
+            [exportedFiles addObject:path];
+        }
+    }
+    
+    NSLog(@"✅ [EXPORT] exportPagesToImages - SUCCESS - Exported %lu pages", (unsigned long)exportedFiles.count);
+    
+    return exportedFiles;
+}
+
+/**
+ * Render one page into a bitmap of exactly dpi/72 pixels per point and write it
+ * Waits while the bitmaps other workers hold would exceed the budget; a page
+ * larger than the whole budget still renders once nothing else is in flight.
+ */
+- (NSString *)exportPage:(PDFDocument *)document
+               pageIndex:(int)pageIndex
+                   scale:(CGFloat)scale
+                  format:(NSString *)format
+               directory:(NSString *)directory
+                   state:(NSCondition *)state
+           bytesInFlight:(unsigned long long *)bytesInFlight
+            bitmapBudget:(unsigned long long)bitmapBudget {
+    @autoreleasepool {
+        PDFPage *page = [document pageAtIndex:pageIndex];
+        if (!page) {
+            return nil;
+        }
         
-        NSLog(@"📊 [PROGRESS] Exporting page %d/%lu (page number: %d)", current, (unsigned long)pagesToExport.count, pageIndex + 1);
+        // Calculate dimensions
+        CGRect pageRect = [page boundsForBox:kPDFDisplayBoxMediaBox];
+        size_t width = MAX((size_t)ceil(pageRect.size.width * scale), (size_t)1);
+        size_t height = MAX((size_t)ceil(pageRect.size.height * scale), (size_t)1);
+        unsigned long long bytes = (unsigned long long)width * height * 4;
         
-        PDFPage *page = [pdfDocument pageAtIndex:pageIndex];
+        [state lock];
+        while (*bytesInFlight > 0 && *bytesInFlight + bytes > bitmapBudget) {
+            [state wait];
+        }
+        *bytesInFlight += bytes;
+        [state unlock];
         
-        if (page) {
-            // Calculate dimensions
-            CGRect pageRect = [page boundsForBox:kPDFDisplayBoxMediaBox];
-            float scale = dpi / 72.0f; // 72 DPI is default
-            CGSize imageSize = CGSizeMake(pageRect.size.width * scale, pageRect.size.height * scale);
-            
-            NSLog(@"🖼️ [BITMAP] Creating %.0fx%.0f image", imageSize.width, imageSize.height);
-            
-            // Create image context
-            UIGraphicsBeginImageContextWithOptions(imageSize, NO, 0.0);
-            CGContextRef context = UIGraphicsGetCurrentContext();
-            
+        NSString *outputPath = nil;
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+        CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace,
+                                                     kCGImageAlphaNoneSkipFirst | kCGBitmapByteOrder32Little);
+        CGColorSpaceRelease(colorSpace);
+        
+        if (context) {
             // Fill background with white
-            CGContextSetFillColorWithColor(context, [UIColor whiteColor].CGColor);
-            CGContextFillRect(context, CGRectMake(0, 0, imageSize.width, imageSize.height));
-            
-            // Scale context
+            CGContextSetRGBFillColor(context, 1.0, 1.0, 1.0, 1.0);
+            CGContextFillRect(context, CGRectMake(0, 0, width, height));
             CGContextScaleCTM(context, scale, scale);
-            
-            // Render page
-            NSLog(@"🖼️ [RENDER] Rendering page to image...");
             [page drawWithBox:kPDFDisplayBoxMediaBox toContext:context];
             
-            // Get image
-            UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
-            UIGraphicsEndImageContext();
-            
-            // Save image
-            NSString *fileName = [NSString stringWithFormat:@"page_%d.%@", pageIndex + 1, format];
-            NSString *outputPath = [self saveImage:image fileName:fileName outputDir:outputDir];
-            if (outputPath) {
-                [exportedFiles addObject:outputPath];
-                NSLog(@"✅ [PROGRESS] Page %d exported to %@", pageIndex + 1, outputPath);
-            } else {
-                NSLog(@"❌ [EXPORT] Failed to save page %d", pageIndex + 1);
+            CGImageRef image = CGBitmapContextCreateImage(context);
+            CGContextRelease(context);
+            if (image) {
+                NSString *fileName = [NSString stringWithFormat:@"page_%d.%@", pageIndex + 1, format];
+                outputPath = [self writeImage:image toPath:[directory stringByAppendingPathComponent:fileName]];
+                CGImageRelease(image);
             }
+        } else {
+            NSLog(@"❌ [BITMAP] Failed to create %zux%zu bitmap", width, height);
         }
+        
+        [state lock];
+        *bytesInFlight -= bytes;
+        [state broadcast];
+        [state unlock];
+        
+        return outputPath;
     }
-    
-    NSLog(@"✅ [EXPORT] exportPagesToImages - SUCCESS - Exported %lu pages", (unsigned long)exportedFiles.count);
-    
-    return exportedFiles;
 }
 
 /**
- * Save image to file
+ * Encode image straight to file with ImageIO
  */
-- (NSString *)saveImage:(UIImage *)image fileName:(NSString *)fileName outputDir:(NSString *)outputDir {
-    NSURL *outputURL;
-    
-    if (outputDir && outputDir.length > 0) {
-        NSFileManager *fileManager = [NSFileManager defaultManager];
-        if (![fileManager fileExistsAtPath:outputDir]) {
-            [fileManager createDirectoryAtPath:outputDir withIntermediateDirectories:YES attributes:nil error:nil];
-        }
-        outputURL = [NSURL fileURLWithPath:[outputDir stringByAppendingPathComponent:fileName]];
-    } else {
-        // Save to app's documents directory
-        NSArray *paths = NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES);
-        NSString *documentsDirectory = [paths objectAtIndex:0];
-        outputURL = [NSURL fileURLWithPath:[documentsDirectory stringByAppendingPathComponent:fileName]];
-    }
-    
-    NSLog(@"📁 [FILE] Writing to: %@", outputURL.path);
-    
-    // Convert image to data
-    NSData *imageData;
-    NSString *format;
-    if ([fileName.lowercaseString hasSuffix:@".png"]) {
-        imageData = UIImagePNGRepresentation(image);
-        format = @"PNG";
-    } else if ([fileName.lowercaseString hasSuffix:@".jpg"] || [fileName.lowercaseString hasSuffix:@".jpeg"]) {
-        imageData = UIImageJPEGRepresentation(image, 0.9);
-        format = @"JPEG at 90% quality";
-    } else {
-        imageData = UIImagePNGRepresentation(image);
-        format = @"PNG (default)";
+- (NSString *)writeImage:(CGImageRef)image toPath:(NSString *)path {
+    NSString *extension = path.pathExtension.lowercaseString;
+    BOOL jpeg = [extension isEqualToString:@"jpg"] || [extension isEqualToString:@"jpeg"];
+    CFStringRef type = jpeg ? CFSTR("public.jpeg") : CFSTR("public.png");
+    
+    NSURL *outputURL = [NSURL fileURLWithPath:path];
+    CGImageDestinationRef destination = CGImageDestinationCreateWithURL((__bridge CFURLRef)outputURL, type, 1, NULL);
+    if (!destination) {
+        NSLog(@"❌ [FILE] Error creating image file: %@", path);
+        return nil;
     }
     
-    NSLog(@"📁 [FILE] Compressing as %@", format);
-    
-    // Save to file
-    NSError *error;
-    BOOL success = [imageData writeToURL:outputURL options:NSDataWritingAtomic error:&error];
+    NSDictionary *properties = jpeg ? @{(__bridge NSString *)kCGImageDestinationLossyCompressionQuality: @0.9} : nil;
+    CGImageDestinationAddImage(destination, image, (__bridge CFDictionaryRef)properties);
+    BOOL success = CGImageDestinationFinalize(destination);
+    CFRelease(destination);
     
-    if (success) {
-        unsigned long fileSize = (unsigned long)imageData.length;
-        NSLog(@"✅ [FILE] Saved - size: %lu bytes", fileSize);
-        return outputURL.path;
-    } else {
-        NSLog(@"❌ [FILE] Error saving image: %@", error.localizedDescription);
+    if (!success) {
+        NSLog(@"❌ [FILE] Error saving image: %@", path);
         return nil;
     }
+    return path;
+}
+
+- (void)emitProgress:(NSString *)progressId
+            filePath:(NSString *)filePath
+                page:(int)page
+           completed:(NSUInteger)completed
+               total:(NSUInteger)total
+          outputPath:(NSString *)outputPath {
+    if (!progressId || !_hasListeners) {
+        return;
+    }
+    [self sendEventWithName:PDFExportProgressEvent body:@{
+        @"progressId": progressId,
+        @"filePath": filePath ?: @"",
+        @"page": @(page),
+        @"completed": @(completed),
+        @"total": @(total),
+        @"path": outputPath ?: [NSNull null]
+    }];
 }
 
 /**
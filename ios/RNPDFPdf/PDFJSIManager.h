@@ -60,6 +60,12 @@
                  resolver:(RCTPromiseResolveBlock)resolve
                  rejecter:(RCTPromiseRejectBlock)reject;
  
+ - (void)generateThumbnails:(NSString *)pdfId
+                      pages:(NSArray<NSNumber *> *)pages
+               maxDimension:(NSInteger)maxDimension
+                   resolver:(RCTPromiseResolveBlock)resolve
+                   rejecter:(RCTPromiseRejectBlock)reject;
+ 
  - (void)check16KBSupport:(RCTPromiseResolveBlock)resolve
                  rejecter:(RCTPromiseRejectBlock)reject;
  
@@ -7,15 +7,38 @@
  */
 
 #import "PDFJSIManager.h"
+#import "PDFMemoryGovernor.h"
 #import "PDFNativeCacheManager.h"
+#import "PDFPageStore.h"
+#import "PDFProgressiveDownload.h"
+#import "PDFThumbnailGenerator.h"
+#import "PDFTrace.h"
 #import <React/RCTLog.h>
 #import <React/RCTUtils.h>
 #import <React/RCTBridge.h>
 #import <dispatch/dispatch.h>
+#import <mach/mach.h>
+
+// One progressive download and the promises waiting on its preview and completion
+@interface PDFProgressiveTask : NSObject
+@property (nonatomic, strong) PDFProgressiveDownload *download;
+@property (nonatomic, copy) RCTPromiseResolveBlock previewResolve;
+@property (nonatomic, copy) RCTPromiseRejectBlock previewReject;
+@property (nonatomic, strong) NSMutableArray<NSArray *> *completionBlocks;
+@property (nonatomic, assign) BOOL finished;
+@property (nonatomic, assign) BOOL delivered;
+@property (nonatomic, assign) unsigned long long size;
+@property (nonatomic, copy) NSString *error;
+@end
+
+@implementation PDFProgressiveTask
+@end
 
 @implementation PDFJSIManager {
     BOOL _isJSIInitialized;
     dispatch_queue_t _backgroundQueue;
+    // Progressive downloads by target path, guarded by @synchronized on the dictionary
+    NSMutableDictionary<NSString *, PDFProgressiveTask *> *_progressiveTasks;
 }
 
 RCT_EXPORT_MODULE(PDFJSIManager);
@@ -29,6 +52,7 @@ RCT_EXPORT_MODULE(PDFJSIManager);
     if (self) {
         _isJSIInitialized = NO;
         _backgroundQueue = dispatch_queue_create("com.pdfjsi.background", DISPATCH_QUEUE_CONCURRENT);
+        _progressiveTasks = [NSMutableDictionary dictionary];
         
         RCTLogInfo(@"🚀 PDFJSIManager: Initializing high-performance PDF JSI manager for iOS");
         [self initializeJSI];
@@ -186,12 +210,26 @@ RCT_EXPORT_METHOD(getCacheMetrics:(NSString *)pdfId
     @try {
         RCTLogInfo(@"📊 Getting cache metrics via JSI for PDF %@", pdfId);
         
-        NSDictionary *metrics = @{
+        NSMutableDictionary *metrics = [@{
             @"pageCacheSize": @5,
             @"totalCacheSizeKb": @500,
             @"hitRatio": @0.85,
             @"platform": @"ios"
-        };
+        } mutableCopy];
+        
+        NSDictionary *store = [[PDFPageStore sharedStore] stats];
+        metrics[@"pageStoreEnabled"] = store[@"enabled"];
+        metrics[@"pageStoreEntries"] = store[@"entries"];
+        metrics[@"pageStoreSizeKb"] = @([store[@"bytes"] unsignedLongLongValue] / 1024);
+        metrics[@"pageStoreBudgetKb"] = @([store[@"budgetBytes"] unsignedLongLongValue] / 1024);
+        metrics[@"pageStoreHits"] = store[@"hits"];
+        metrics[@"pageStoreMisses"] = store[@"misses"];
+        metrics[@"pageStoreWrites"] = store[@"writes"];
+        
+        NSDictionary *memory = [[PDFMemoryGovernor sharedGovernor] stats];
+        metrics[@"memoryBudgetKb"] = @([memory[@"budgetBytes"] unsignedLongLongValue] / 1024);
+        metrics[@"memoryPressure"] = memory[@"lastPressure"];
+        metrics[@"memorySheds"] = memory[@"sheds"];
         
         resolve(metrics);
         
@@ -215,7 +253,18 @@ RCT_EXPORT_METHOD(clearCacheDirect:(NSString *)pdfId
         @try {
             RCTLogInfo(@"🧹 Clearing cache via JSI for PDF %@, type: %@", pdfId, cacheType);
             
-            // Simulate cache clearing
+            // Persisted pages survive "all": they are cleared only when asked for by name
+            if ([cacheType isEqualToString:@"stored"]) {
+                PDFPageStore *store = [PDFPageStore sharedStore];
+                if (pdfId.length == 0) {
+                    [store removeAllPages];
+                } else {
+                    NSString *key = [[PDFNativeCacheManager sharedInstance] pageStoreKeyForPath:pdfId];
+                    if (key) {
+                        [store removePagesForDocumentKey:key];
+                    }
+                }
+            }
             resolve(@YES);
             
         } @catch (NSException *exception) {
@@ -238,7 +287,8 @@ RCT_EXPORT_METHOD(optimizeMemory:(NSString *)pdfId
         @try {
             RCTLogInfo(@"🧠 Optimizing memory via JSI for PDF %@", pdfId);
             
-            // Simulate memory optimization
+            // Same step as a first memory warning: pages around the visible one stay
+            [[PDFMemoryGovernor sharedGovernor] shedForPressure:PDFMemoryPressureLow];
             resolve(@YES);
             
         } @catch (NSException *exception) {
@@ -287,13 +337,19 @@ RCT_EXPORT_METHOD(getPerformanceMetrics:(NSString *)pdfId
     @try {
         RCTLogInfo(@"📈 Getting performance metrics via JSI for PDF %@", pdfId);
         
-        NSDictionary *metrics = @{
-            @"lastRenderTime": @120.0,
-            @"avgRenderTime": @90.0,
-            @"cacheHitRatio": @0.85,
-            @"memoryUsageMB": @25.5,
-            @"platform": @"ios"
-        };
+        // Histograms are process-wide, recorded by PDFTrace around native work
+        NSMutableDictionary *metrics = [PDFTraceSummary() mutableCopy];
+        metrics[@"lastRenderTime"] = metrics[@"renderLastMs"];
+        metrics[@"avgRenderTime"] = metrics[@"renderAvgMs"];
+        metrics[@"tracingEnabled"] = @(PDFJSI_TRACING != 0);
+        metrics[@"platform"] = @"ios";
+        
+        // Physical footprint, the figure jetsam limits apply to
+        task_vm_info_data_t vmInfo;
+        mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+        if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&vmInfo, &count) == KERN_SUCCESS) {
+            metrics[@"memoryUsageMB"] = @(vmInfo.phys_footprint / (1024.0 * 1024.0));
+        }
         
         resolve(metrics);
         
@@ -325,6 +381,258 @@ RCT_EXPORT_METHOD(setRenderQuality:(NSString *)pdfId
     }
 }
 
+#pragma mark - Page Store
+
+RCT_EXPORT_METHOD(configurePageStore:(BOOL)enabled
+                  budgetBytes:(double)budgetBytes
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    
+    dispatch_async(_backgroundQueue, ^{
+        @try {
+            RCTLogInfo(@"📄 Configuring page store: enabled=%d, budget=%.0f bytes", enabled, budgetBytes);
+            [[PDFPageStore sharedStore] configureEnabled:enabled
+                                             budgetBytes:budgetBytes > 0 ? (unsigned long long)budgetBytes : 0];
+            resolve(@YES);
+            
+        } @catch (NSException *exception) {
+            RCTLogError(@"❌ Error configuring page store: %@", exception.reason);
+            reject(@"CONFIGURE_PAGE_STORE_ERROR", exception.reason, nil);
+        }
+    });
+}
+
+RCT_EXPORT_METHOD(setMemoryBudget:(double)budgetBytes
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    
+    if (budgetBytes <= 0) {
+        reject(@"INVALID_BUDGET", @"Memory budget must be positive", nil);
+        return;
+    }
+    
+    RCTLogInfo(@"🧠 Setting memory budget to %.0f bytes", budgetBytes);
+    [[PDFMemoryGovernor sharedGovernor] setBudgetBytes:(unsigned long long)budgetBytes];
+    resolve(@YES);
+}
+
+#pragma mark - Thumbnails
+
+RCT_EXPORT_METHOD(generateThumbnails:(NSString *)pdfId
+                  pages:(NSArray<NSNumber *> *)pages
+                  maxDimension:(NSInteger)maxDimension
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    
+    if (pages.count == 0) {
+        resolve(@[]);
+        return;
+    }
+    
+    dispatch_async(_backgroundQueue, ^{
+        @try {
+            NSString *path = [self resolveDocumentPath:pdfId];
+            if (!path) {
+                reject(@"THUMBNAIL_ERROR", [NSString stringWithFormat:@"Unable to resolve document: %@", pdfId], nil);
+                return;
+            }
+            
+            NSString *error = nil;
+            NSArray *thumbnails = [[PDFThumbnailGenerator sharedInstance] generateThumbnailsForPath:path
+                                                                                              pages:pages
+                                                                                       maxDimension:maxDimension
+                                                                                              error:&error];
+            if (!thumbnails) {
+                reject(@"THUMBNAIL_ERROR", error, nil);
+                return;
+            }
+            resolve(thumbnails);
+            
+        } @catch (NSException *exception) {
+            RCTLogError(@"❌ Error generating thumbnails: %@", exception.reason);
+            reject(@"THUMBNAIL_ERROR", exception.reason, nil);
+        }
+    });
+}
+
+// pdfId is a local path (optionally file://) or a PDFNativeCacheManager cache ID
+- (NSString *)resolveDocumentPath:(NSString *)pdfId {
+    if (pdfId.length == 0) {
+        return nil;
+    }
+    NSString *path = [pdfId hasPrefix:@"file://"] ? [NSURL URLWithString:pdfId].path : pdfId;
+    if ([[NSFileManager defaultManager] fileExistsAtPath:path]) {
+        return path;
+    }
+    
+    PDFNativeCacheManager *cacheManager = [PDFNativeCacheManager sharedInstance];
+    NSString *fileName;
+    @synchronized(cacheManager.cacheLock) {
+        fileName = cacheManager.cacheMetadata[pdfId][@"fileName"];
+    }
+    if (!fileName) {
+        return nil;
+    }
+    NSString *cachedPath = [cacheManager.cacheDir stringByAppendingPathComponent:fileName];
+    return [[NSFileManager defaultManager] fileExistsAtPath:cachedPath] ? cachedPath : nil;
+}
+
+#pragma mark - Progressive Download
+
+// Resolves {preview: {page, uri, width, height, pageCount} | null} as soon as the first
+// page can be shown; awaitProgressive resolves once the whole file is in targetPath
+RCT_EXPORT_METHOD(openProgressive:(NSString *)url
+                  headers:(NSDictionary *)headers
+                  targetPath:(NSString *)targetPath
+                  previewDimension:(NSInteger)previewDimension
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    
+    NSURL *remoteURL = [NSURL URLWithString:url];
+    if (!remoteURL || targetPath.length == 0) {
+        reject(@"PROGRESSIVE_ERROR", @"Invalid url or target path", nil);
+        return;
+    }
+    NSString *path = [targetPath hasPrefix:@"file://"] ? [NSURL URLWithString:targetPath].path : targetPath;
+    NSString *previewPath = [[PDFThumbnailGenerator sharedInstance].thumbnailDirectory
+                             stringByAppendingPathComponent:[path.lastPathComponent stringByAppendingString:@"_preview.jpg"]];
+    
+    NSMutableDictionary<NSString *, NSString *> *requestHeaders = [NSMutableDictionary dictionary];
+    if ([headers isKindOfClass:[NSDictionary class]]) {
+        [headers enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+            requestHeaders[[key description]] = [value description];
+        }];
+    }
+    
+    PDFProgressiveTask *task = [[PDFProgressiveTask alloc] init];
+    task.download = [[PDFProgressiveDownload alloc] initWithURL:remoteURL
+                                                        headers:requestHeaders
+                                                     targetPath:path
+                                                    previewPath:previewPath
+                                               previewDimension:MAX(64, MIN(2048, previewDimension))];
+    task.previewResolve = resolve;
+    task.previewReject = reject;
+    task.completionBlocks = [NSMutableArray array];
+    
+    @synchronized(_progressiveTasks) {
+        PDFProgressiveTask *running = _progressiveTasks[targetPath];
+        if (running && !running.finished) {
+            reject(@"PROGRESSIVE_ERROR", [NSString stringWithFormat:@"Download already running for %@", targetPath], nil);
+            return;
+        }
+        _progressiveTasks[targetPath] = task;
+    }
+    
+    // Each download blocks its thread for its whole duration, so it stays off _backgroundQueue
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        NSString *error = nil;
+        BOOL downloaded = [task.download downloadWithPreviewHandler:^(NSDictionary *preview) {
+            [self deliverPreview:preview task:task];
+        } error:&error];
+        if (!downloaded) {
+            RCTLogError(@"❌ Progressive download failed: %@ (%@)", url, error);
+        }
+        
+        unsigned long long size = downloaded
+            ? [[[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil] fileSize] : 0;
+        [self finishProgressiveTask:task size:size error:downloaded ? nil : (error ?: @"Download failed")];
+        [self removeDeliveredTask:task forPath:targetPath];
+    });
+}
+
+RCT_EXPORT_METHOD(awaitProgressive:(NSString *)targetPath
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    
+    PDFProgressiveTask *task;
+    @synchronized(_progressiveTasks) {
+        task = _progressiveTasks[targetPath];
+    }
+    if (!task) {
+        reject(@"PROGRESSIVE_ERROR", [NSString stringWithFormat:@"No download running for %@", targetPath], nil);
+        return;
+    }
+    @synchronized(task) {
+        if (task.finished) {
+            [self settleProgressiveTask:task path:targetPath resolver:resolve rejecter:reject];
+            task.delivered = YES;
+        } else {
+            [task.completionBlocks addObject:@[targetPath, resolve, reject]];
+        }
+    }
+    [self removeDeliveredTask:task forPath:targetPath];
+}
+
+RCT_EXPORT_METHOD(cancelProgressive:(NSString *)targetPath
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    
+    PDFProgressiveTask *task;
+    @synchronized(_progressiveTasks) {
+        task = _progressiveTasks[targetPath];
+    }
+    [task.download cancel];
+    resolve(@(task != nil));
+}
+
+- (void)deliverPreview:(NSDictionary *)preview task:(PDFProgressiveTask *)task {
+    @synchronized(task) {
+        if (!task.previewResolve) {
+            return;
+        }
+        task.previewResolve(@{@"preview": preview ?: [NSNull null]});
+        task.previewResolve = nil;
+        task.previewReject = nil;
+    }
+}
+
+- (void)finishProgressiveTask:(PDFProgressiveTask *)task size:(unsigned long long)size error:(NSString *)error {
+    @synchronized(task) {
+        task.finished = YES;
+        task.size = size;
+        task.error = error;
+        if (task.previewReject && error) {
+            task.previewReject(@"PROGRESSIVE_ERROR", error, nil);
+            task.previewResolve = nil;
+            task.previewReject = nil;
+        } else {
+            [self deliverPreview:nil task:task];
+        }
+        for (NSArray *blocks in task.completionBlocks) {
+            [self settleProgressiveTask:task path:blocks[0] resolver:blocks[1] rejecter:blocks[2]];
+            task.delivered = YES;
+        }
+        [task.completionBlocks removeAllObjects];
+    }
+}
+
+- (void)settleProgressiveTask:(PDFProgressiveTask *)task
+                         path:(NSString *)path
+                     resolver:(RCTPromiseResolveBlock)resolve
+                     rejecter:(RCTPromiseRejectBlock)reject {
+    if (task.error) {
+        reject(@"PROGRESSIVE_ERROR", task.error, nil);
+        return;
+    }
+    resolve(@{@"path": path, @"size": @(task.size)});
+}
+
+// Tasks are kept until their completion reaches awaitProgressive
+- (void)removeDeliveredTask:(PDFProgressiveTask *)task forPath:(NSString *)targetPath {
+    BOOL delivered;
+    @synchronized(task) {
+        delivered = task.delivered;
+    }
+    if (!delivered) {
+        return;
+    }
+    @synchronized(_progressiveTasks) {
+        if (_progressiveTasks[targetPath] == task) {
+            [_progressiveTasks removeObjectForKey:targetPath];
+        }
+    }
+}
+
 #pragma mark - Native Cache Integration
 
 RCT_EXPORT_METHOD(storePDFNative:(NSString *)base64Data
@@ -611,6 +919,11 @@ RCT_EXPORT_METHOD(testNativeCache:(RCTPromiseResolveBlock)resolve
 #pragma mark - Cleanup
 
 - (void)dealloc {
+    @synchronized(_progressiveTasks) {
+        for (PDFProgressiveTask *task in _progressiveTasks.allValues) {
+            [task.download cancel];
+        }
+    }
     RCTLogInfo(@"🚀 PDFJSIManager deallocated");
 }
 
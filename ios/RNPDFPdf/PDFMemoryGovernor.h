@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * One memory budget shared by the viewers' caches
+ *
+ * The budget is split between the rendered page images and the search text of
+ * every open view. Memory warnings and system memory pressure are shed in
+ * steps: pages far from the visible one and search results go first, the
+ * visible page last, and unreferenced open documents are closed along the way.
+ */
+
+#import <Foundation/Foundation.h>
+
+typedef NS_ENUM(NSInteger, PDFMemoryPressure) {
+    PDFMemoryPressureNone = 0,
+    // Trim back while everything near the visible page stays
+    PDFMemoryPressureModerate,
+    PDFMemoryPressureLow,
+    // Keep only the visible page
+    PDFMemoryPressureCritical
+};
+
+// Implemented by each view holding caches; called on the main queue
+@protocol PDFMemoryGovernorClient <NSObject>
+// This client's share of the budget for page images and for search text
+- (void)memoryGovernorDidAssignPageBudget:(NSUInteger)pageBytes textBudget:(NSUInteger)textBytes;
+- (void)memoryGovernorShedForPressure:(PDFMemoryPressure)pressure;
+@end
+
+@interface PDFMemoryGovernor : NSObject
+
++ (instancetype)sharedGovernor;
+
+@property (nonatomic, readonly) unsigned long long budgetBytes;
+
+// A budget of 0 restores the device default
+- (void)setBudgetBytes:(unsigned long long)budgetBytes;
+
+// Clients are held weakly and get their share of the budget immediately
+- (void)registerClient:(id<PDFMemoryGovernorClient>)client;
+- (void)unregisterClient:(id<PDFMemoryGovernorClient>)client;
+
+// Sheds memory for pressure on every client (asynchronously on the main queue)
+- (void)shedForPressure:(PDFMemoryPressure)pressure;
+
+// budgetBytes, clients, lastPressure, sheds
+- (NSDictionary *)stats;
+
+@end
@@ -0,0 +1,204 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * One memory budget shared by the viewers' caches
+ */
+
+#import "PDFMemoryGovernor.h"
+#import "PdfManager.h"
+#import <UIKit/UIKit.h>
+#import <React/RCTLog.h>
+
+static const unsigned long long kMinBudgetBytes = 32 * 1024 * 1024;
+static const unsigned long long kMaxBudgetBytes = 192 * 1024 * 1024;
+// Share of the budget for page images, in percent; the rest holds search text
+static const unsigned long long kPageSharePercent = 80;
+// A warning this soon after the last one escalates to the next step
+static const CFTimeInterval kEscalationWindow = 30.0;
+
+@implementation PDFMemoryGovernor {
+    // Main queue only
+    NSHashTable<id<PDFMemoryGovernorClient>> *_clients;
+    unsigned long long _budgetBytes;
+    PDFMemoryPressure _lastPressure;
+    CFAbsoluteTime _lastWarning;
+    NSUInteger _sheds;
+    dispatch_source_t _pressureSource;
+}
+
++ (instancetype)sharedGovernor
+{
+    static PDFMemoryGovernor *governor;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        governor = [[PDFMemoryGovernor alloc] init];
+    });
+    return governor;
+}
+
+// A sixteenth of physical memory, within [32 MB, 192 MB]
++ (unsigned long long)defaultBudget
+{
+    unsigned long long budget = [NSProcessInfo processInfo].physicalMemory / 16;
+    return MIN(MAX(budget, kMinBudgetBytes), kMaxBudgetBytes);
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _clients = [NSHashTable weakObjectsHashTable];
+        _budgetBytes = [PDFMemoryGovernor defaultBudget];
+        _lastPressure = PDFMemoryPressureNone;
+
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        [center addObserver:self selector:@selector(onMemoryWarning:) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+        [center addObserver:self selector:@selector(onDidEnterBackground:) name:UIApplicationDidEnterBackgroundNotification object:nil];
+
+        // System pressure usually arrives before the app's memory warning
+        _pressureSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+                                                 DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+                                                 dispatch_get_main_queue());
+        __weak PDFMemoryGovernor *weakSelf = self;
+        dispatch_source_set_event_handler(_pressureSource, ^{
+            PDFMemoryGovernor *governor = weakSelf;
+            if (!governor) {
+                return;
+            }
+            unsigned long status = dispatch_source_get_data(governor->_pressureSource);
+            if (status & DISPATCH_MEMORYPRESSURE_CRITICAL) {
+                [governor shedForPressure:PDFMemoryPressureCritical];
+            } else if (status & DISPATCH_MEMORYPRESSURE_WARN) {
+                [governor shedForPressure:PDFMemoryPressureModerate];
+            }
+        });
+        dispatch_resume(_pressureSource);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    if (_pressureSource) {
+        dispatch_source_cancel(_pressureSource);
+    }
+}
+
+- (unsigned long long)budgetBytes
+{
+    @synchronized (self) {
+        return _budgetBytes;
+    }
+}
+
+- (void)setBudgetBytes:(unsigned long long)budgetBytes
+{
+    @synchronized (self) {
+        _budgetBytes = budgetBytes > 0 ? budgetBytes : [PDFMemoryGovernor defaultBudget];
+    }
+    RCTLogInfo(@"🧠 PDFMemoryGovernor: Budget set to %llu KB", self.budgetBytes / 1024);
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self assignBudgets];
+    });
+}
+
+- (void)registerClient:(id<PDFMemoryGovernorClient>)client
+{
+    dispatch_block_t add = ^{
+        [self->_clients addObject:client];
+        [self assignBudgets];
+    };
+    if ([NSThread isMainThread]) {
+        add();
+    } else {
+        dispatch_async(dispatch_get_main_queue(), add);
+    }
+}
+
+- (void)unregisterClient:(id<PDFMemoryGovernorClient>)client
+{
+    // Views unregister from dealloc: the table is weak, so off the main queue
+    // the entry clears itself and only the shares need recomputing
+    if ([NSThread isMainThread]) {
+        [_clients removeObject:client];
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self assignBudgets];
+    });
+}
+
+// Splits the budget evenly between the open views (main queue)
+- (void)assignBudgets
+{
+    NSArray<id<PDFMemoryGovernorClient>> *clients = _clients.allObjects;
+    if (clients.count == 0) {
+        return;
+    }
+    unsigned long long budget = self.budgetBytes;
+    NSUInteger pageBytes = (NSUInteger)(budget * kPageSharePercent / 100 / clients.count);
+    NSUInteger textBytes = (NSUInteger)(budget * (100 - kPageSharePercent) / 100 / clients.count);
+    for (id<PDFMemoryGovernorClient> client in clients) {
+        [client memoryGovernorDidAssignPageBudget:pageBytes textBudget:textBytes];
+    }
+}
+
+- (void)onMemoryWarning:(NSNotification *)notification
+{
+    // The first warning trims to the pages around the visible one; another soon
+    // after means that was not enough
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    PDFMemoryPressure pressure = PDFMemoryPressureLow;
+    if (_lastWarning > 0 && now - _lastWarning < kEscalationWindow) {
+        pressure = PDFMemoryPressureCritical;
+    }
+    _lastWarning = now;
+    [self shedForPressure:pressure];
+}
+
+- (void)onDidEnterBackground:(NSNotification *)notification
+{
+    // Suspended apps are the first jetsam candidates; keep enough to come back to
+    [self shedForPressure:PDFMemoryPressureLow];
+}
+
+- (void)shedForPressure:(PDFMemoryPressure)pressure
+{
+    if (pressure <= PDFMemoryPressureNone) {
+        return;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        NSArray<id<PDFMemoryGovernorClient>> *clients = self->_clients.allObjects;
+        for (id<PDFMemoryGovernorClient> client in clients) {
+            [client memoryGovernorShedForPressure:pressure];
+        }
+
+        // Open documents nobody is viewing are the next cheapest to drop
+        NSUInteger keep = pressure >= PDFMemoryPressureCritical ? 0 : (pressure == PDFMemoryPressureLow ? 1 : 4);
+        NSUInteger closed = [PdfManager trimUnreferencedDocumentsTo:keep];
+
+        @synchronized (self) {
+            self->_lastPressure = pressure;
+            self->_sheds++;
+        }
+        RCTLogInfo(@"🧠 PDFMemoryGovernor: Pressure %ld shed %lu view(s), closed %lu document(s)",
+                   (long)pressure, (unsigned long)clients.count, (unsigned long)closed);
+    });
+}
+
+- (NSDictionary *)stats
+{
+    NSUInteger clients = 0;
+    if ([NSThread isMainThread]) {
+        clients = _clients.count;
+    }
+    @synchronized (self) {
+        return @{
+            @"budgetBytes": @(_budgetBytes),
+            @"clients": @(clients),
+            @"lastPressure": @(_lastPressure),
+            @"sheds": @(_sheds)
+        };
+    }
+}
+
+@end
@@ -17,4 +17,14 @@
 // Singleton instance for direct access
 + (instancetype)sharedInstance;
 
+// Page geometry table stored with the cached file at path (PdfManager
+// pageGeometryForFileNo: layout), nil for files outside the cache or not yet measured
+- (NSData *)pageGeometryForPath:(NSString *)path;
+- (void)storePageGeometry:(NSData *)geometry forPath:(NSString *)path;
+
+// Content checksum of the cached file at path, naming its pages in PDFPageStore;
+// computed and saved on first use for files cached without one. Reads the whole
+// file then, so call off the main queue. nil for files outside the cache.
+- (NSString *)pageStoreKeyForPath:(NSString *)path;
+
 @end
@@ -12,6 +12,7 @@
  */
 
 #import "PDFNativeCacheManager.h"
+#import "PdfManager.h"
 #import <React/RCTLog.h>
 
 @implementation PDFNativeCacheManager
@@ -632,6 +633,82 @@ RCT_EXPORT_METHOD(testCache:(RCTPromiseResolveBlock)resolve
     }
 }
 
+// Cache ID of the cached file at path; call with cacheLock held
+- (NSString *)cacheIdForPath:(NSString *)path {
+    if (![[path stringByDeletingLastPathComponent] isEqualToString:self.cacheDir]) {
+        return nil;
+    }
+    NSString *fileName = path.lastPathComponent;
+    for (NSString *cacheId in self.cacheMetadata) {
+        if ([self.cacheMetadata[cacheId][@"fileName"] isEqualToString:fileName]) {
+            return cacheId;
+        }
+    }
+    return nil;
+}
+
+- (NSData *)pageGeometryForPath:(NSString *)path {
+    @synchronized(self.cacheLock) {
+        NSString *cacheId = [self cacheIdForPath:path];
+        NSDictionary *metadata = cacheId ? self.cacheMetadata[cacheId] : nil;
+        // Tables written with a different layout are dropped and measured again
+        if (![metadata[@"pageGeometryFields"] isEqual:@(PdfPageGeometryFields)]) {
+            return nil;
+        }
+        NSString *encoded = metadata[@"pageGeometry"];
+        return encoded ? [[NSData alloc] initWithBase64EncodedString:encoded options:0] : nil;
+    }
+}
+
+- (void)storePageGeometry:(NSData *)geometry forPath:(NSString *)path {
+    @synchronized(self.cacheLock) {
+        NSString *cacheId = [self cacheIdForPath:path];
+        if (!cacheId) {
+            return;
+        }
+        // Little-endian floats as base64, the same encoding the Android cache uses
+        NSMutableDictionary *metadata = [self.cacheMetadata[cacheId] mutableCopy];
+        metadata[@"pageGeometry"] = [geometry base64EncodedStringWithOptions:0];
+        metadata[@"pageGeometryFields"] = @(PdfPageGeometryFields);
+        self.cacheMetadata[cacheId] = [metadata copy];
+        [self saveMetadata];
+    }
+}
+
+- (NSString *)pageStoreKeyForPath:(NSString *)path {
+    NSString *cacheId;
+    NSString *fileName;
+    @synchronized(self.cacheLock) {
+        cacheId = [self cacheIdForPath:path];
+        if (!cacheId) {
+            return nil;
+        }
+        NSString *checksum = self.cacheMetadata[cacheId][@"checksum"];
+        if (checksum.length > 0) {
+            return checksum;
+        }
+        fileName = self.cacheMetadata[cacheId][@"fileName"];
+    }
+
+    // Hashed without the lock; the file is mapped rather than read onto the heap
+    NSString *filePath = [self.cacheDir stringByAppendingPathComponent:fileName];
+    NSData *data = [NSData dataWithContentsOfFile:filePath options:NSDataReadingMappedIfSafe error:nil];
+    if (data.length == 0) {
+        return nil;
+    }
+    NSString *checksum = [self generateChecksum:data];
+
+    @synchronized(self.cacheLock) {
+        NSMutableDictionary *metadata = [self.cacheMetadata[cacheId] mutableCopy];
+        if (metadata) {
+            metadata[@"checksum"] = checksum;
+            self.cacheMetadata[cacheId] = [metadata copy];
+            [self saveMetadata];
+        }
+    }
+    return checksum;
+}
+
 - (void)loadMetadata {
     NSFileManager *fileManager = [NSFileManager defaultManager];
     
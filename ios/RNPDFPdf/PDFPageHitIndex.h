@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Per-page spatial index of glyph, word and link boxes
+ *
+ * Built once per page, off the main thread after the page is first rendered
+ * (or on the first tap), from the page's text, character bounds and link
+ * annotations. Words and links are bucketed into a uniform grid, so taps,
+ * long-press selection and search highlighting look up a few cells instead of
+ * asking PDFKit for selections. Immutable once built; safe on any thread.
+ */
+
+#import <Foundation/Foundation.h>
+#import <PDFKit/PDFKit.h>
+
+@interface PDFPageHitLink : NSObject
+
+// In page coordinates
+@property (nonatomic, readonly) CGRect bounds;
+@property (nonatomic, readonly) NSURL *URL;
+// 0-based destination page, NSNotFound for links leaving the document
+@property (nonatomic, readonly) NSUInteger pageIndex;
+
+@end
+
+@interface PDFPageHitIndex : NSObject
+
++ (instancetype)indexForPage:(PDFPage *)page;
+
+// page.string; ranges below index into it
+@property (nonatomic, readonly) NSString *text;
+// Approximate memory held, for NSCache costs
+@property (nonatomic, readonly) NSUInteger byteSize;
+
+// Link under point (page coordinates), else the nearest within tolerance points; nil if none
+- (PDFPageHitLink *)linkAtPoint:(CGPoint)point tolerance:(CGFloat)tolerance;
+// Word nearest to point within tolerance; location NSNotFound if none
+- (NSRange)wordRangeAtPoint:(CGPoint)point tolerance:(CGFloat)tolerance;
+// Characters from the word at start to the word at end, in text order
+- (NSRange)rangeFromPoint:(CGPoint)start toPoint:(CGPoint)end tolerance:(CGFloat)tolerance;
+// Union of the character boxes of range; CGRectNull if none has a box
+- (CGRect)boundsForRange:(NSRange)range;
+// One box per word overlapping range
+- (NSArray<NSValue *> *)wordBoundsForRange:(NSRange)range;
+
+@end
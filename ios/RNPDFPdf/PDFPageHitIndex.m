@@ -0,0 +1,356 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Per-page spatial index of glyph, word and link boxes
+ */
+
+#import "PDFPageHitIndex.h"
+#import "PDFTrace.h"
+
+// Cells per axis grow with the square root of the box count, so a lookup
+// scans a handful of boxes on dense pages without a huge grid on sparse ones
+static const NSUInteger kMaxGridCells = 64;
+
+typedef struct {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+} PDFHitBox;
+
+typedef struct {
+    PDFHitBox box;
+    uint32_t offset;
+    uint32_t length;
+} PDFHitWord;
+
+// Items of cell c are items[cellStart[c] .. cellStart[c + 1])
+typedef struct {
+    PDFHitBox bounds;
+    int columns;
+    float cellWidth;
+    float cellHeight;
+    uint32_t *cellStart;
+    uint32_t *items;
+    size_t itemCount;
+} PDFHitGrid;
+
+static BOOL PDFHitBoxEmpty(PDFHitBox box)
+{
+    return box.maxX <= box.minX || box.maxY <= box.minY;
+}
+
+static PDFHitBox PDFHitBoxUnion(PDFHitBox a, PDFHitBox b)
+{
+    if (PDFHitBoxEmpty(b)) {
+        return a;
+    }
+    if (PDFHitBoxEmpty(a)) {
+        return b;
+    }
+    PDFHitBox box = { MIN(a.minX, b.minX), MIN(a.minY, b.minY), MAX(a.maxX, b.maxX), MAX(a.maxY, b.maxY) };
+    return box;
+}
+
+static PDFHitBox PDFHitBoxFromRect(CGRect rect)
+{
+    if (CGRectIsNull(rect) || CGRectIsEmpty(rect)) {
+        PDFHitBox empty = { 0, 0, 0, 0 };
+        return empty;
+    }
+    PDFHitBox box = { (float)CGRectGetMinX(rect), (float)CGRectGetMinY(rect), (float)CGRectGetMaxX(rect), (float)CGRectGetMaxY(rect) };
+    return box;
+}
+
+static CGRect PDFHitBoxRect(PDFHitBox box)
+{
+    return CGRectMake(box.minX, box.minY, box.maxX - box.minX, box.maxY - box.minY);
+}
+
+// Distance from point to the box; 0 inside it
+static CGFloat PDFHitBoxDistance(PDFHitBox box, CGPoint point)
+{
+    CGFloat dx = point.x < box.minX ? box.minX - point.x : (point.x > box.maxX ? point.x - box.maxX : 0);
+    CGFloat dy = point.y < box.minY ? box.minY - point.y : (point.y > box.maxY ? point.y - box.maxY : 0);
+    return sqrt(dx * dx + dy * dy);
+}
+
+static int PDFHitGridColumn(const PDFHitGrid *grid, CGFloat x)
+{
+    int column = (int)floor((x - grid->bounds.minX) / grid->cellWidth);
+    return MAX(0, MIN(grid->columns - 1, column));
+}
+
+static int PDFHitGridRow(const PDFHitGrid *grid, CGFloat y)
+{
+    int row = (int)floor((y - grid->bounds.minY) / grid->cellHeight);
+    return MAX(0, MIN(grid->columns - 1, row));
+}
+
+static void PDFHitGridBuild(PDFHitGrid *grid, const PDFHitBox *boxes, size_t count, PDFHitBox bounds)
+{
+    memset(grid, 0, sizeof(*grid));
+    if (count == 0 || PDFHitBoxEmpty(bounds)) {
+        return;
+    }
+    grid->bounds = bounds;
+    grid->columns = (int)MAX(1, MIN(kMaxGridCells, (NSUInteger)ceil(sqrt((double)count))));
+    grid->cellWidth = (bounds.maxX - bounds.minX) / grid->columns;
+    grid->cellHeight = (bounds.maxY - bounds.minY) / grid->columns;
+
+    // Two passes (count, then fill) keep every cell's items in one array
+    size_t cellCount = (size_t)grid->columns * grid->columns;
+    grid->cellStart = calloc(cellCount + 1, sizeof(uint32_t));
+    for (size_t i = 0; i < count; i++) {
+        if (PDFHitBoxEmpty(boxes[i])) {
+            continue;
+        }
+        for (int row = PDFHitGridRow(grid, boxes[i].minY); row <= PDFHitGridRow(grid, boxes[i].maxY); row++) {
+            for (int column = PDFHitGridColumn(grid, boxes[i].minX); column <= PDFHitGridColumn(grid, boxes[i].maxX); column++) {
+                grid->cellStart[row * grid->columns + column + 1]++;
+            }
+        }
+    }
+    for (size_t c = 0; c < cellCount; c++) {
+        grid->cellStart[c + 1] += grid->cellStart[c];
+    }
+    grid->itemCount = grid->cellStart[cellCount];
+    grid->items = malloc(MAX(grid->itemCount, 1) * sizeof(uint32_t));
+    uint32_t *fill = malloc(cellCount * sizeof(uint32_t));
+    memcpy(fill, grid->cellStart, cellCount * sizeof(uint32_t));
+    for (size_t i = 0; i < count; i++) {
+        if (PDFHitBoxEmpty(boxes[i])) {
+            continue;
+        }
+        for (int row = PDFHitGridRow(grid, boxes[i].minY); row <= PDFHitGridRow(grid, boxes[i].maxY); row++) {
+            for (int column = PDFHitGridColumn(grid, boxes[i].minX); column <= PDFHitGridColumn(grid, boxes[i].maxX); column++) {
+                grid->items[fill[row * grid->columns + column]++] = (uint32_t)i;
+            }
+        }
+    }
+    free(fill);
+}
+
+static void PDFHitGridFree(PDFHitGrid *grid)
+{
+    free(grid->cellStart);
+    free(grid->items);
+    memset(grid, 0, sizeof(*grid));
+}
+
+static size_t PDFHitGridBytes(const PDFHitGrid *grid)
+{
+    return grid->columns == 0 ? 0 : ((size_t)grid->columns * grid->columns + 1 + grid->itemCount) * sizeof(uint32_t);
+}
+
+// Index of the box nearest to point within tolerance (lowest index on ties), NSNotFound if none
+static NSUInteger PDFHitGridNearest(const PDFHitGrid *grid, const PDFHitBox *boxes, size_t stride,
+                                    CGPoint point, CGFloat tolerance)
+{
+    if (grid->columns == 0) {
+        return NSNotFound;
+    }
+    NSUInteger best = NSNotFound;
+    CGFloat bestDistance = tolerance;
+    int lastRow = PDFHitGridRow(grid, point.y + tolerance);
+    int lastColumn = PDFHitGridColumn(grid, point.x + tolerance);
+    for (int row = PDFHitGridRow(grid, point.y - tolerance); row <= lastRow; row++) {
+        for (int column = PDFHitGridColumn(grid, point.x - tolerance); column <= lastColumn; column++) {
+            size_t cell = (size_t)row * grid->columns + column;
+            for (uint32_t i = grid->cellStart[cell]; i < grid->cellStart[cell + 1]; i++) {
+                uint32_t index = grid->items[i];
+                const PDFHitBox *box = (const PDFHitBox *)((const uint8_t *)boxes + index * stride);
+                CGFloat distance = PDFHitBoxDistance(*box, point);
+                if (distance < bestDistance || (distance == bestDistance && (best == NSNotFound || index < best))) {
+                    best = index;
+                    bestDistance = distance;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+@interface PDFPageHitLink ()
+@property (nonatomic, readwrite) CGRect bounds;
+@property (nonatomic, readwrite) NSURL *URL;
+@property (nonatomic, readwrite) NSUInteger pageIndex;
+@end
+
+@implementation PDFPageHitLink
+@end
+
+@implementation PDFPageHitIndex
+{
+    // glyphs[i] is the box of text[i], empty for characters without one (line breaks)
+    PDFHitBox *_glyphs;
+    NSUInteger _glyphCount;
+    // In text order
+    PDFHitWord *_words;
+    NSUInteger _wordCount;
+    NSArray<PDFPageHitLink *> *_links;
+    PDFHitBox *_linkBoxes;
+    PDFHitGrid _wordGrid;
+    PDFHitGrid _linkGrid;
+}
+
++ (instancetype)indexForPage:(PDFPage *)page
+{
+    if (!page) {
+        return nil;
+    }
+    PDFTraceInterval trace = PDFTraceBegin(PDFTraceMetricHitIndexBuild);
+    PDFPageHitIndex *index = [[PDFPageHitIndex alloc] initWithPage:page];
+    PDFTraceEnd(trace);
+    return index;
+}
+
+- (instancetype)initWithPage:(PDFPage *)page
+{
+    if (self = [super init]) {
+        _text = page.string ?: @"";
+        PDFHitBox bounds = PDFHitBoxFromRect([page boundsForBox:kPDFDisplayBoxMediaBox]);
+
+        _glyphCount = MIN(_text.length, (NSUInteger)page.numberOfCharacters);
+        _glyphs = calloc(MAX(_glyphCount, 1), sizeof(PDFHitBox));
+        for (NSUInteger i = 0; i < _glyphCount; i++) {
+            _glyphs[i] = PDFHitBoxFromRect([page characterBoundsAtIndex:(NSInteger)i]);
+        }
+
+        // Words end at whitespace and at characters without a box
+        NSCharacterSet *breaks = [NSCharacterSet whitespaceAndNewlineCharacterSet];
+        _words = malloc(MAX(_glyphCount, 1) * sizeof(PDFHitWord));
+        NSUInteger start = NSNotFound;
+        for (NSUInteger i = 0; i <= _glyphCount; i++) {
+            BOOL inWord = i < _glyphCount && !PDFHitBoxEmpty(_glyphs[i]) &&
+                          ![breaks characterIsMember:[_text characterAtIndex:i]];
+            if (inWord && start == NSNotFound) {
+                start = i;
+            } else if (!inWord && start != NSNotFound) {
+                PDFHitWord word;
+                word.offset = (uint32_t)start;
+                word.length = (uint32_t)(i - start);
+                word.box = PDFHitBoxFromRect([self boundsForRange:NSMakeRange(start, i - start)]);
+                _words[_wordCount++] = word;
+                bounds = PDFHitBoxUnion(bounds, word.box);
+                start = NSNotFound;
+            }
+        }
+        PDFHitBox *wordBoxes = malloc(MAX(_wordCount, 1) * sizeof(PDFHitBox));
+        for (NSUInteger i = 0; i < _wordCount; i++) {
+            wordBoxes[i] = _words[i].box;
+        }
+        PDFHitGridBuild(&_wordGrid, wordBoxes, _wordCount, bounds);
+        free(wordBoxes);
+
+        NSMutableArray<PDFPageHitLink *> *links = [NSMutableArray array];
+        for (PDFAnnotation *annotation in page.annotations) {
+            if (![annotation.type isEqualToString:@"Link"]) {
+                continue;
+            }
+            PDFPageHitLink *link = [[PDFPageHitLink alloc] init];
+            link.bounds = annotation.bounds;
+            link.pageIndex = NSNotFound;
+            PDFDestination *destination = annotation.destination;
+            NSURL *url = annotation.URL;
+            if ([annotation.action isKindOfClass:[PDFActionURL class]]) {
+                url = url ?: ((PDFActionURL *)annotation.action).URL;
+            } else if ([annotation.action isKindOfClass:[PDFActionGoTo class]]) {
+                destination = destination ?: ((PDFActionGoTo *)annotation.action).destination;
+            }
+            if (destination.page && page.document) {
+                NSUInteger target = [page.document indexForPage:destination.page];
+                link.pageIndex = target < page.document.pageCount ? target : NSNotFound;
+            }
+            if (link.pageIndex == NSNotFound) {
+                link.URL = url;
+            }
+            if (!CGRectIsEmpty(link.bounds) && (link.URL || link.pageIndex != NSNotFound)) {
+                [links addObject:link];
+            }
+        }
+        _links = links;
+        _linkBoxes = malloc(MAX(links.count, 1) * sizeof(PDFHitBox));
+        for (NSUInteger i = 0; i < links.count; i++) {
+            _linkBoxes[i] = PDFHitBoxFromRect(links[i].bounds);
+            bounds = PDFHitBoxUnion(bounds, _linkBoxes[i]);
+        }
+        PDFHitGridBuild(&_linkGrid, _linkBoxes, links.count, bounds);
+
+        _byteSize = 128 + _text.length * sizeof(unichar) + _glyphCount * sizeof(PDFHitBox) +
+                    _wordCount * sizeof(PDFHitWord) + links.count * (sizeof(PDFHitBox) + 64) +
+                    PDFHitGridBytes(&_wordGrid) + PDFHitGridBytes(&_linkGrid);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_glyphs);
+    free(_words);
+    free(_linkBoxes);
+    PDFHitGridFree(&_wordGrid);
+    PDFHitGridFree(&_linkGrid);
+}
+
+- (PDFPageHitLink *)linkAtPoint:(CGPoint)point tolerance:(CGFloat)tolerance
+{
+    PDFTraceInterval trace = PDFTraceBegin(PDFTraceMetricHitTest);
+    // Links sit on top of their text, so a tap inside one wins over a nearer edge
+    NSUInteger index = PDFHitGridNearest(&_linkGrid, _linkBoxes, sizeof(PDFHitBox), point, 0);
+    if (index == NSNotFound) {
+        index = PDFHitGridNearest(&_linkGrid, _linkBoxes, sizeof(PDFHitBox), point, tolerance);
+    }
+    PDFTraceEnd(trace);
+    return index == NSNotFound ? nil : _links[index];
+}
+
+- (NSRange)wordRangeAtPoint:(CGPoint)point tolerance:(CGFloat)tolerance
+{
+    PDFTraceInterval trace = PDFTraceBegin(PDFTraceMetricHitTest);
+    NSUInteger index = PDFHitGridNearest(&_wordGrid, &_words[0].box, sizeof(PDFHitWord), point, tolerance);
+    PDFTraceEnd(trace);
+    if (index == NSNotFound) {
+        return NSMakeRange(NSNotFound, 0);
+    }
+    return NSMakeRange(_words[index].offset, _words[index].length);
+}
+
+- (NSRange)rangeFromPoint:(CGPoint)start toPoint:(CGPoint)end tolerance:(CGFloat)tolerance
+{
+    NSRange first = [self wordRangeAtPoint:start tolerance:tolerance];
+    NSRange last = [self wordRangeAtPoint:end tolerance:tolerance];
+    if (first.location == NSNotFound) {
+        return last;
+    }
+    if (last.location == NSNotFound) {
+        return first;
+    }
+    return NSUnionRange(first, last);
+}
+
+- (CGRect)boundsForRange:(NSRange)range
+{
+    PDFHitBox box = { 0, 0, 0, 0 };
+    NSUInteger end = MIN(NSMaxRange(range), _glyphCount);
+    for (NSUInteger c = range.location; c < end; c++) {
+        box = PDFHitBoxUnion(box, _glyphs[c]);
+    }
+    return PDFHitBoxEmpty(box) ? CGRectNull : PDFHitBoxRect(box);
+}
+
+- (NSArray<NSValue *> *)wordBoundsForRange:(NSRange)range
+{
+    NSMutableArray<NSValue *> *bounds = [NSMutableArray array];
+    for (NSUInteger i = 0; i < _wordCount; i++) {
+        const PDFHitWord *word = &_words[i];
+        if (word->offset >= NSMaxRange(range)) {
+            break;
+        }
+        if (word->offset + word->length > range.location) {
+            [bounds addObject:[NSValue valueWithCGRect:PDFHitBoxRect(word->box)]];
+        }
+    }
+    return bounds;
+}
+
+@end
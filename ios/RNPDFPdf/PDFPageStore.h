@@ -0,0 +1,35 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Persistent on-disk store of rendered pages
+ *
+ * Preloaded page images are kept across launches in Library/Caches, keyed by
+ * the cached file's checksum, page and pixel size, one LZ4-compressed file per
+ * page. Reads decode from a mapped file straight into the image's pixels;
+ * writes run on a serial utility queue, and the least recently used files are
+ * evicted past the budget.
+ */
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+@interface PDFPageStore : NSObject
+
++ (instancetype)sharedStore;
+
+@property (nonatomic, readonly) BOOL enabled;
+
+// Disabling keeps the stored files for a later enable; a budget of 0 keeps the current one
+- (void)configureEnabled:(BOOL)enabled budgetBytes:(unsigned long long)budgetBytes;
+
+// Stored image of page (1-based) rendered at size points, nil when absent or unreadable
+- (UIImage *)imageForDocumentKey:(NSString *)documentKey page:(int)page size:(CGSize)size;
+// Queues image to be compressed and written; dropped while too many writes are pending
+- (void)storeImage:(UIImage *)image forDocumentKey:(NSString *)documentKey page:(int)page size:(CGSize)size;
+
+- (void)removePagesForDocumentKey:(NSString *)documentKey;
+- (void)removeAllPages;
+
+// enabled, entries, bytes, budgetBytes, hits, misses, writes
+- (NSDictionary *)stats;
+
+@end
@@ -0,0 +1,366 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Persistent on-disk store of rendered pages
+ */
+
+#import "PDFPageStore.h"
+#import "PDFTrace.h"
+#import <React/RCTLog.h>
+#import <compression.h>
+#include <sys/time.h>
+
+static const uint32_t kStoreMagic = 0x53504A50;   // "PJPS"
+static const uint32_t kStoreVersion = 1;
+static const unsigned long long kDefaultBudgetBytes = 128 * 1024 * 1024;
+// Renders waiting to be written; more are dropped rather than held in memory
+static const NSInteger kMaxPendingWrites = 8;
+// Keys longer than this (or with other characters) are hashed into the file name
+static const NSUInteger kMaxPlainKeyLength = 64;
+static NSString * const kPageExtension = @"page";
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytesPerRow;
+    float scale;
+    uint64_t pixelBytes;
+    uint64_t payloadBytes;
+} PDFStoredPageHeader;
+
+// Pixel layout of stored pages: BGRA, premultiplied, the native iOS image format
+static const CGBitmapInfo kStoredBitmapInfo = kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Little;
+
+@interface PDFPageStoreEntry : NSObject
+@property (nonatomic, assign) unsigned long long bytes;
+@property (nonatomic, assign) NSTimeInterval lastUsed;
+@end
+
+@implementation PDFPageStoreEntry
+@end
+
+@implementation PDFPageStore {
+    NSString *_directory;
+    dispatch_queue_t _writeQueue;
+    // File name -> size and last use, read from the directory on first use
+    NSMutableDictionary<NSString *, PDFPageStoreEntry *> *_files;
+    unsigned long long _bytes;
+    unsigned long long _budgetBytes;
+    BOOL _enabled;
+    NSInteger _pendingWrites;
+    NSUInteger _hits;
+    NSUInteger _misses;
+    NSUInteger _writes;
+}
+
++ (instancetype)sharedStore {
+    static PDFPageStore *sharedStore = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedStore = [[self alloc] init];
+    });
+    return sharedStore;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        NSString *caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        _directory = [caches stringByAppendingPathComponent:@"pdf_page_store"];
+        _writeQueue = dispatch_queue_create("org.wonday.pdf.pagestore",
+            dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+        _files = [NSMutableDictionary dictionary];
+        _budgetBytes = kDefaultBudgetBytes;
+        _enabled = YES;
+        [self loadIndex];
+    }
+    return self;
+}
+
+- (void)loadIndex {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    [fileManager createDirectoryAtPath:_directory withIntermediateDirectories:YES attributes:nil error:nil];
+    NSArray<NSURLResourceKey> *keys = @[NSURLFileSizeKey, NSURLContentModificationDateKey];
+    NSArray<NSURL *> *urls = [fileManager contentsOfDirectoryAtURL:[NSURL fileURLWithPath:_directory]
+                                        includingPropertiesForKeys:keys
+                                                           options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                             error:nil];
+    for (NSURL *url in urls) {
+        if (![url.pathExtension isEqualToString:kPageExtension]) {
+            continue;
+        }
+        NSDictionary *values = [url resourceValuesForKeys:keys error:nil];
+        PDFPageStoreEntry *entry = [[PDFPageStoreEntry alloc] init];
+        entry.bytes = [values[NSURLFileSizeKey] unsignedLongLongValue];
+        entry.lastUsed = [values[NSURLContentModificationDateKey] timeIntervalSince1970];
+        _files[url.lastPathComponent] = entry;
+        _bytes += entry.bytes;
+    }
+    [self evictToBytes:_budgetBytes];
+}
+
+- (BOOL)enabled {
+    @synchronized(self) {
+        return _enabled;
+    }
+}
+
+- (void)configureEnabled:(BOOL)enabled budgetBytes:(unsigned long long)budgetBytes {
+    @synchronized(self) {
+        _enabled = enabled;
+        if (budgetBytes > 0) {
+            _budgetBytes = budgetBytes;
+            [self evictToBytes:_budgetBytes];
+        }
+        RCTLogInfo(@"📄 PageStore: %@, %lu pages (%llu KB), budget %llu KB", enabled ? @"enabled" : @"disabled",
+                   (unsigned long)_files.count, _bytes / 1024, _budgetBytes / 1024);
+    }
+}
+
+// Page files name every key part, so '_' never appears inside the document part
++ (NSString *)prefixForDocumentKey:(NSString *)documentKey {
+    static NSCharacterSet *disallowed;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSCharacterSet *allowed = [NSCharacterSet characterSetWithCharactersInString:
+            @"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-"];
+        disallowed = allowed.invertedSet;
+    });
+    if (documentKey.length > 0 && documentKey.length <= kMaxPlainKeyLength &&
+        [documentKey rangeOfCharacterFromSet:disallowed].location == NSNotFound) {
+        return [documentKey stringByAppendingString:@"_"];
+    }
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char *c = documentKey.UTF8String; c && *c; c++) {
+        hash = (hash ^ (uint8_t)*c) * 1099511628211ULL;
+    }
+    return [NSString stringWithFormat:@"h%016llx_", hash];
+}
+
++ (NSString *)fileNameForDocumentKey:(NSString *)documentKey page:(int)page size:(CGSize)size {
+    return [NSString stringWithFormat:@"%@%d_%ldx%ld.%@", [self prefixForDocumentKey:documentKey], page,
+            lround(size.width), lround(size.height), kPageExtension];
+}
+
+- (UIImage *)imageForDocumentKey:(NSString *)documentKey page:(int)page size:(CGSize)size {
+    if (documentKey.length == 0) {
+        return nil;
+    }
+    NSString *fileName = [PDFPageStore fileNameForDocumentKey:documentKey page:page size:size];
+    @synchronized(self) {
+        // The index mirrors the directory, so misses cost no file system call
+        if (!_enabled) {
+            return nil;
+        }
+        if (!_files[fileName]) {
+            _misses++;
+            return nil;
+        }
+    }
+
+    PDFTraceInterval trace = PDFTraceBegin(PDFTraceMetricPageStoreRead);
+    NSString *path = [_directory stringByAppendingPathComponent:fileName];
+    UIImage *image = [self decodeImageAtPath:path];
+    PDFTraceEnd(trace);
+
+    @synchronized(self) {
+        if (image) {
+            _hits++;
+            _files[fileName].lastUsed = [NSDate date].timeIntervalSince1970;
+        } else {
+            _misses++;
+            RCTLogWarn(@"📄 PageStore: dropping unreadable %@", fileName);
+            [self removeFileNamed:fileName];
+        }
+    }
+    if (image) {
+        // The modification time carries the use order across launches
+        utimes(path.fileSystemRepresentation, NULL);
+    }
+    return image;
+}
+
+- (UIImage *)decodeImageAtPath:(NSString *)path {
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:nil];
+    if (data.length < sizeof(PDFStoredPageHeader)) {
+        return nil;
+    }
+    PDFStoredPageHeader header;
+    memcpy(&header, data.bytes, sizeof(header));
+    BOOL valid = header.magic == kStoreMagic && header.version == kStoreVersion &&
+                 header.width > 0 && header.height > 0 && header.bytesPerRow == header.width * 4 &&
+                 header.pixelBytes == (uint64_t)header.bytesPerRow * header.height &&
+                 header.payloadBytes == data.length - sizeof(header) && header.scale > 0;
+    if (!valid) {
+        return nil;
+    }
+
+    NSMutableData *pixels = [NSMutableData dataWithLength:(NSUInteger)header.pixelBytes];
+    if (!pixels) {
+        return nil;
+    }
+    size_t decoded = compression_decode_buffer(pixels.mutableBytes, pixels.length,
+                                               (const uint8_t *)data.bytes + sizeof(header),
+                                               (size_t)header.payloadBytes, NULL, COMPRESSION_LZ4);
+    if (decoded != pixels.length) {
+        return nil;
+    }
+
+    CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef)pixels);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGImageRef cgImage = CGImageCreate(header.width, header.height, 8, 32, header.bytesPerRow, colorSpace,
+                                       kStoredBitmapInfo, provider, NULL, false, kCGRenderingIntentDefault);
+    CGColorSpaceRelease(colorSpace);
+    CGDataProviderRelease(provider);
+    if (!cgImage) {
+        return nil;
+    }
+    UIImage *image = [UIImage imageWithCGImage:cgImage scale:header.scale orientation:UIImageOrientationUp];
+    CGImageRelease(cgImage);
+    return image;
+}
+
+- (void)storeImage:(UIImage *)image forDocumentKey:(NSString *)documentKey page:(int)page size:(CGSize)size {
+    if (!image.CGImage || documentKey.length == 0) {
+        return;
+    }
+    NSString *fileName = [PDFPageStore fileNameForDocumentKey:documentKey page:page size:size];
+    @synchronized(self) {
+        if (!_enabled || _files[fileName] || _pendingWrites >= kMaxPendingWrites) {
+            return;
+        }
+        _pendingWrites++;
+    }
+    dispatch_async(_writeQueue, ^{
+        NSData *file = [self encodeImage:image];
+        NSString *path = [self->_directory stringByAppendingPathComponent:fileName];
+        BOOL written = file && [file writeToFile:path options:NSDataWritingAtomic error:nil];
+        @synchronized(self) {
+            self->_pendingWrites--;
+            if (!written) {
+                return;
+            }
+            PDFPageStoreEntry *entry = self->_files[fileName] ?: [[PDFPageStoreEntry alloc] init];
+            self->_bytes = self->_bytes - entry.bytes + file.length;
+            entry.bytes = file.length;
+            entry.lastUsed = [NSDate date].timeIntervalSince1970;
+            self->_files[fileName] = entry;
+            self->_writes++;
+            if (self->_bytes > self->_budgetBytes) {
+                // Evict a tenth below budget so each new page does not evict one page
+                [self evictToBytes:self->_budgetBytes - self->_budgetBytes / 10];
+            }
+        }
+    });
+}
+
+- (NSData *)encodeImage:(UIImage *)image {
+    CGImageRef cgImage = image.CGImage;
+    size_t width = CGImageGetWidth(cgImage);
+    size_t height = CGImageGetHeight(cgImage);
+    size_t bytesPerRow = width * 4;
+    size_t pixelBytes = bytesPerRow * height;
+    if (pixelBytes == 0) {
+        return nil;
+    }
+    uint8_t *pixels = malloc(pixelBytes);
+    // Stores that do not shrink below the raw pixels are not kept
+    uint8_t *file = malloc(sizeof(PDFStoredPageHeader) + pixelBytes);
+    if (!pixels || !file) {
+        free(pixels);
+        free(file);
+        return nil;
+    }
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(pixels, width, height, 8, bytesPerRow, colorSpace, kStoredBitmapInfo);
+    CGColorSpaceRelease(colorSpace);
+    if (!context) {
+        free(pixels);
+        free(file);
+        return nil;
+    }
+    CGContextDrawImage(context, CGRectMake(0, 0, width, height), cgImage);
+    CGContextRelease(context);
+
+    size_t payloadBytes = compression_encode_buffer(file + sizeof(PDFStoredPageHeader), pixelBytes,
+                                                    pixels, pixelBytes, NULL, COMPRESSION_LZ4);
+    free(pixels);
+    if (payloadBytes == 0) {
+        free(file);
+        return nil;
+    }
+
+    PDFStoredPageHeader header = {0};
+    header.magic = kStoreMagic;
+    header.version = kStoreVersion;
+    header.width = (uint32_t)width;
+    header.height = (uint32_t)height;
+    header.bytesPerRow = (uint32_t)bytesPerRow;
+    header.scale = (float)image.scale;
+    header.pixelBytes = pixelBytes;
+    header.payloadBytes = payloadBytes;
+    memcpy(file, &header, sizeof(header));
+    return [NSData dataWithBytesNoCopy:file length:sizeof(header) + payloadBytes freeWhenDone:YES];
+}
+
+// Call with self locked
+- (void)removeFileNamed:(NSString *)fileName {
+    PDFPageStoreEntry *entry = _files[fileName];
+    if (!entry) {
+        return;
+    }
+    [[NSFileManager defaultManager] removeItemAtPath:[_directory stringByAppendingPathComponent:fileName] error:nil];
+    _bytes -= entry.bytes;
+    [_files removeObjectForKey:fileName];
+}
+
+// Call with self locked
+- (void)evictToBytes:(unsigned long long)targetBytes {
+    if (_bytes <= targetBytes) {
+        return;
+    }
+    NSArray<NSString *> *oldestFirst = [_files keysSortedByValueUsingComparator:^NSComparisonResult(PDFPageStoreEntry *a, PDFPageStoreEntry *b) {
+        return a.lastUsed < b.lastUsed ? NSOrderedAscending : (a.lastUsed > b.lastUsed ? NSOrderedDescending : NSOrderedSame);
+    }];
+    for (NSString *fileName in oldestFirst) {
+        if (_bytes <= targetBytes) {
+            break;
+        }
+        [self removeFileNamed:fileName];
+    }
+}
+
+- (void)removePagesForDocumentKey:(NSString *)documentKey {
+    NSString *prefix = [PDFPageStore prefixForDocumentKey:documentKey];
+    @synchronized(self) {
+        for (NSString *fileName in _files.allKeys) {
+            if ([fileName hasPrefix:prefix]) {
+                [self removeFileNamed:fileName];
+            }
+        }
+    }
+}
+
+- (void)removeAllPages {
+    @synchronized(self) {
+        [self evictToBytes:0];
+    }
+}
+
+- (NSDictionary *)stats {
+    @synchronized(self) {
+        return @{
+            @"enabled": @(_enabled),
+            @"entries": @(_files.count),
+            @"bytes": @(_bytes),
+            @"budgetBytes": @(_budgetBytes),
+            @"hits": @(_hits),
+            @"misses": @(_misses),
+            @"writes": @(_writes)
+        };
+    }
+}
+
+@end
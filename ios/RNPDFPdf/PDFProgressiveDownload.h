@@ -0,0 +1,30 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Progressive download of remote PDFs
+ *
+ * The file is fetched with HTTP Range requests into a file of its final size.
+ * The first page is parsed through a CGDataProvider whose reads fetch missing
+ * ranges on demand, ahead of the sequential fill, so linearized ("fast web
+ * view") files show page 1 after a small prefix instead of the whole download.
+ * Servers without range support fall back to one plain download with no preview.
+ */
+
+#import <Foundation/Foundation.h>
+
+@interface PDFProgressiveDownload : NSObject
+
+- (instancetype)initWithURL:(NSURL *)url
+                    headers:(NSDictionary<NSString *, NSString *> *)headers
+                 targetPath:(NSString *)targetPath
+                previewPath:(NSString *)previewPath
+           previewDimension:(NSInteger)previewDimension;
+
+// Downloads the whole file, blocking until it is complete; call off the main queue.
+// previewHandler runs once, with {page, uri, width, height, pageCount} or nil when no
+// preview can be shown before completion.
+- (BOOL)downloadWithPreviewHandler:(void (^)(NSDictionary *preview))previewHandler
+                             error:(NSString **)error;
+
+- (void)cancel;
+
+@end
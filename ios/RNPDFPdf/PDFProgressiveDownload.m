@@ -0,0 +1,381 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Progressive download of remote PDFs
+ */
+
+#import "PDFProgressiveDownload.h"
+#import "PDFThumbnailGenerator.h"
+#import <CoreGraphics/CoreGraphics.h>
+#import <React/RCTLog.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Unit of range requests and of the availability bookkeeping
+static const long long kChunkSize = 128 * 1024;
+// Contiguous chunks fetched per request by the sequential fill
+static const NSUInteger kSequentialChunks = 8;
+static const NSTimeInterval kRequestTimeout = 30;
+
+@interface PDFProgressiveDownload ()
+// CGDataProvider read: blocks until the chunks covering the range are downloaded
+- (size_t)readBytes:(void *)buffer position:(off_t)position count:(size_t)count;
+@end
+
+@implementation PDFProgressiveDownload {
+    NSURL *_url;
+    NSDictionary<NSString *, NSString *> *_headers;
+    NSString *_targetPath;
+    NSString *_previewPath;
+    NSInteger _previewDimension;
+    NSURLSession *_session;
+    // ETag or Last-Modified of the probed file; later ranges must come from the same version
+    NSString *_validator;
+    long long _total;
+    NSUInteger _chunkCount;
+    int _fd;
+
+    // Guarded by _condition
+    NSCondition *_condition;
+    NSMutableIndexSet *_present;
+    NSMutableIndexSet *_inFlight;
+    NSString *_failure;
+}
+
+static size_t PDFProgressiveGetBytes(void *info, void *buffer, off_t position, size_t count) {
+    PDFProgressiveDownload *download = (__bridge PDFProgressiveDownload *)info;
+    return [download readBytes:buffer position:position count:count];
+}
+
+static void PDFProgressiveReleaseInfo(void *info) {
+    CFRelease(info);
+}
+
+- (instancetype)initWithURL:(NSURL *)url
+                    headers:(NSDictionary<NSString *, NSString *> *)headers
+                 targetPath:(NSString *)targetPath
+                previewPath:(NSString *)previewPath
+           previewDimension:(NSInteger)previewDimension {
+    self = [super init];
+    if (self) {
+        _url = url;
+        _headers = [headers copy] ?: @{};
+        _targetPath = [targetPath copy];
+        _previewPath = [previewPath copy];
+        _previewDimension = previewDimension;
+        _fd = -1;
+        _condition = [[NSCondition alloc] init];
+        _present = [NSMutableIndexSet indexSet];
+        _inFlight = [NSMutableIndexSet indexSet];
+        NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+        configuration.timeoutIntervalForRequest = kRequestTimeout;
+        _session = [NSURLSession sessionWithConfiguration:configuration];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_session invalidateAndCancel];
+}
+
+- (void)cancel {
+    [self fail:@"Download cancelled"];
+    [_session getAllTasksWithCompletionHandler:^(NSArray<__kindof NSURLSessionTask *> *tasks) {
+        for (NSURLSessionTask *task in tasks) {
+            [task cancel];
+        }
+    }];
+}
+
+- (BOOL)downloadWithPreviewHandler:(void (^)(NSDictionary *preview))previewHandler
+                             error:(NSString **)error {
+    __block BOOL previewReported = NO;
+    void (^reportPreview)(NSDictionary *) = ^(NSDictionary *preview) {
+        @synchronized (self) {
+            if (previewReported) {
+                return;
+            }
+            previewReported = YES;
+        }
+        previewHandler(preview);
+    };
+
+    NSHTTPURLResponse *probe = [self probe:error];
+    if (!probe) {
+        reportPreview(nil);
+        return NO;
+    }
+    long long total = probe.expectedContentLength;
+    BOOL ranges = [[probe.allHeaderFields[@"Accept-Ranges"] lowercaseString] isEqualToString:@"bytes"];
+    if (!ranges || total <= 0) {
+        RCTLogInfo(@"No range support, downloading %@ in one request", _url);
+        reportPreview(nil);
+        return [self downloadWhole:error];
+    }
+    _validator = probe.allHeaderFields[@"ETag"] ?: probe.allHeaderFields[@"Last-Modified"];
+    _total = total;
+    _chunkCount = (NSUInteger)((total + kChunkSize - 1) / kChunkSize);
+
+    _fd = open(_targetPath.fileSystemRepresentation, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (_fd < 0 || ftruncate(_fd, total) != 0) {
+        if (error) *error = [NSString stringWithFormat:@"Cannot create %@", _targetPath];
+        if (_fd >= 0) close(_fd);
+        _fd = -1;
+        reportPreview(nil);
+        return NO;
+    }
+
+    // Page 1 is parsed concurrently; its reads fetch the ranges they need ahead of the fill
+    dispatch_group_t previewGroup = dispatch_group_create();
+    dispatch_group_async(previewGroup, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        reportPreview([self renderPreview]);
+    });
+
+    for (NSUInteger chunk = 0; chunk < _chunkCount; chunk += kSequentialChunks) {
+        if (![self ensureChunks:NSMakeRange(chunk, MIN(kSequentialChunks, _chunkCount - chunk))]) {
+            break;
+        }
+    }
+    dispatch_group_wait(previewGroup, DISPATCH_TIME_FOREVER);
+
+    [_condition lock];
+    NSString *failure = _failure;
+    [_condition unlock];
+    BOOL synced = !failure && fsync(_fd) == 0;
+    close(_fd);
+    _fd = -1;
+    if (!synced) {
+        unlink(_targetPath.fileSystemRepresentation);
+        if (error) *error = failure ?: [NSString stringWithFormat:@"Cannot write %@", _targetPath];
+        return NO;
+    }
+    return YES;
+}
+
+#pragma mark - Preview
+
+- (NSDictionary *)renderPreview {
+    // The provider holds a reference, as CoreGraphics may keep it past the document
+    CGDataProviderDirectCallbacks callbacks = { 0, NULL, NULL, PDFProgressiveGetBytes, PDFProgressiveReleaseInfo };
+    CGDataProviderRef provider = CGDataProviderCreateDirect((__bridge_retained void *)self, _total, &callbacks);
+    if (!provider) {
+        return nil;
+    }
+    CGPDFDocumentRef document = CGPDFDocumentCreateWithProvider(provider);
+    CGDataProviderRelease(provider);
+    if (!document) {
+        return nil;
+    }
+
+    NSDictionary *preview = nil;
+    size_t pageCount = CGPDFDocumentGetNumberOfPages(document);
+    CGPDFPageRef page = pageCount > 0 ? CGPDFDocumentGetPage(document, 1) : NULL;
+    CGSize size = CGSizeZero;
+    if (page && [[PDFThumbnailGenerator sharedInstance] drawPage:page
+                                                      dimension:_previewDimension
+                                                         toFile:_previewPath
+                                                           size:&size]) {
+        preview = @{
+            @"page": @1,
+            @"uri": [NSURL fileURLWithPath:_previewPath].absoluteString,
+            @"width": @(size.width),
+            @"height": @(size.height),
+            @"pageCount": @(pageCount),
+        };
+    }
+    CGPDFDocumentRelease(document);
+    return preview;
+}
+
+- (size_t)readBytes:(void *)buffer position:(off_t)position count:(size_t)count {
+    if (position < 0 || position >= _total) {
+        return 0;
+    }
+    count = (size_t)MIN((long long)count, _total - position);
+    if (count == 0) {
+        return 0;
+    }
+    NSUInteger first = (NSUInteger)(position / kChunkSize);
+    NSUInteger last = (NSUInteger)((position + (off_t)count - 1) / kChunkSize);
+    if (![self ensureChunks:NSMakeRange(first, last - first + 1)]) {
+        return 0;
+    }
+    size_t done = 0;
+    while (done < count) {
+        ssize_t read = pread(_fd, (uint8_t *)buffer + done, count - done, position + (off_t)done);
+        if (read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (read <= 0) {
+            break;
+        }
+        done += (size_t)read;
+    }
+    return done;
+}
+
+#pragma mark - Ranges
+
+// Fetches the missing chunks of range, waiting for ones another thread is fetching
+- (BOOL)ensureChunks:(NSRange)range {
+    [_condition lock];
+    while (YES) {
+        if (_failure) {
+            [_condition unlock];
+            return NO;
+        }
+        NSMutableIndexSet *claim = [NSMutableIndexSet indexSet];
+        BOOL waiting = NO;
+        for (NSUInteger chunk = range.location; chunk < NSMaxRange(range); chunk++) {
+            if ([_present containsIndex:chunk]) {
+                continue;
+            }
+            if ([_inFlight containsIndex:chunk]) {
+                waiting = YES;
+            } else {
+                [claim addIndex:chunk];
+            }
+        }
+        if (claim.count == 0) {
+            if (!waiting) {
+                [_condition unlock];
+                return YES;
+            }
+            [_condition wait];
+            continue;
+        }
+        [_inFlight addIndexes:claim];
+        [_condition unlock];
+
+        __block NSString *failure = nil;
+        NSMutableIndexSet *fetched = [NSMutableIndexSet indexSet];
+        [claim enumerateRangesUsingBlock:^(NSRange run, BOOL *stop) {
+            long long offset = (long long)run.location * kChunkSize;
+            long long length = MIN((long long)run.length * kChunkSize, self->_total - offset);
+            failure = [self fetchFrom:offset length:length];
+            if (failure) {
+                *stop = YES;
+            } else {
+                [fetched addIndexesInRange:run];
+            }
+        }];
+
+        [_condition lock];
+        [_present addIndexes:fetched];
+        [_inFlight removeIndexes:claim];
+        if (failure && !_failure) {
+            _failure = failure;
+        }
+        [_condition broadcast];
+    }
+}
+
+- (void)fail:(NSString *)failure {
+    [_condition lock];
+    if (!_failure) {
+        _failure = failure;
+    }
+    [_condition broadcast];
+    [_condition unlock];
+}
+
+// Returns nil on success, else the failure
+- (NSString *)fetchFrom:(long long)offset length:(long long)length {
+    NSMutableURLRequest *request = [self requestWithMethod:@"GET"];
+    [request setValue:[NSString stringWithFormat:@"bytes=%lld-%lld", offset, offset + length - 1] forHTTPHeaderField:@"Range"];
+    if (_validator) {
+        [request setValue:_validator forHTTPHeaderField:@"If-Range"];
+    }
+
+    __block NSData *body = nil;
+    __block NSHTTPURLResponse *response = nil;
+    __block NSError *requestError = nil;
+    dispatch_semaphore_t done = dispatch_semaphore_create(0);
+    [[_session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *urlResponse, NSError *taskError) {
+        body = data;
+        response = (NSHTTPURLResponse *)urlResponse;
+        requestError = taskError;
+        dispatch_semaphore_signal(done);
+    }] resume];
+    dispatch_semaphore_wait(done, DISPATCH_TIME_FOREVER);
+
+    if (requestError) {
+        return requestError.localizedDescription;
+    }
+    // 200 to an If-Range request means the file changed under the download
+    if (response.statusCode != 206 || (long long)body.length != length) {
+        return [NSString stringWithFormat:@"Range request failed with HTTP %ld: %@", (long)response.statusCode, _url];
+    }
+    size_t written = 0;
+    while (written < body.length) {
+        ssize_t count = pwrite(_fd, (const uint8_t *)body.bytes + written, body.length - written, offset + (off_t)written);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return [NSString stringWithFormat:@"Cannot write %@", _targetPath];
+        }
+        written += (size_t)count;
+    }
+    return nil;
+}
+
+#pragma mark - Requests
+
+- (NSMutableURLRequest *)requestWithMethod:(NSString *)method {
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:_url];
+    request.HTTPMethod = method;
+    [_headers enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        [request setValue:value forHTTPHeaderField:key];
+    }];
+    // Byte offsets must refer to the stored bytes, not a compressed transfer
+    [request setValue:@"identity" forHTTPHeaderField:@"Accept-Encoding"];
+    return request;
+}
+
+- (NSHTTPURLResponse *)probe:(NSString **)error {
+    __block NSHTTPURLResponse *response = nil;
+    __block NSError *requestError = nil;
+    dispatch_semaphore_t done = dispatch_semaphore_create(0);
+    [[_session dataTaskWithRequest:[self requestWithMethod:@"HEAD"]
+                 completionHandler:^(NSData *data, NSURLResponse *urlResponse, NSError *taskError) {
+        response = (NSHTTPURLResponse *)urlResponse;
+        requestError = taskError;
+        dispatch_semaphore_signal(done);
+    }] resume];
+    dispatch_semaphore_wait(done, DISPATCH_TIME_FOREVER);
+
+    if (requestError || ![response isKindOfClass:[NSHTTPURLResponse class]]) {
+        if (error) *error = requestError.localizedDescription ?: [NSString stringWithFormat:@"DownloadFailed:%@", _url];
+        return nil;
+    }
+    // Servers rejecting HEAD still get the plain download
+    return response;
+}
+
+- (BOOL)downloadWhole:(NSString **)error {
+    __block NSString *failure = nil;
+    dispatch_semaphore_t done = dispatch_semaphore_create(0);
+    NSString *targetPath = _targetPath;
+    [[_session downloadTaskWithRequest:[self requestWithMethod:@"GET"]
+                     completionHandler:^(NSURL *location, NSURLResponse *response, NSError *taskError) {
+        NSInteger status = [response isKindOfClass:[NSHTTPURLResponse class]] ? ((NSHTTPURLResponse *)response).statusCode : 0;
+        if (taskError || !location || status < 200 || status >= 300) {
+            failure = taskError.localizedDescription ?: [NSString stringWithFormat:@"Download failed with HTTP %ld", (long)status];
+        } else {
+            NSFileManager *fileManager = [NSFileManager defaultManager];
+            [fileManager removeItemAtPath:targetPath error:nil];
+            NSError *moveError = nil;
+            if (![fileManager moveItemAtURL:location toURL:[NSURL fileURLWithPath:targetPath] error:&moveError]) {
+                failure = moveError.localizedDescription;
+            }
+        }
+        dispatch_semaphore_signal(done);
+    }] resume];
+    dispatch_semaphore_wait(done, DISPATCH_TIME_FOREVER);
+
+    if (failure && error) *error = failure;
+    return failure == nil;
+}
+
+@end
@@ -0,0 +1,32 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Thumbnail generation with a persistent on-disk cache
+ *
+ * Thumbnails are written as JPEG files next to PDFNativeCacheManager's cache
+ * directory, named by the document's content fingerprint, page and size, so a
+ * page/size pair is rendered once and reused across sessions.
+ */
+
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+@interface PDFThumbnailGenerator : NSObject
+
++ (instancetype)sharedInstance;
+
+@property (nonatomic, readonly) NSString *thumbnailDirectory;
+
+// Renders missing pages concurrently and blocks until all are done; call off the main queue.
+// Returns one {page, uri, width, height, cached} (or {page, error}) entry per requested page.
+- (NSArray<NSDictionary *> *)generateThumbnailsForPath:(NSString *)path
+                                                 pages:(NSArray<NSNumber *> *)pages
+                                          maxDimension:(NSInteger)maxDimension
+                                                 error:(NSString **)error;
+
+// Renders page on white with its longest side at dimension pixels and writes it as a JPEG
+- (BOOL)drawPage:(CGPDFPageRef)page dimension:(NSInteger)dimension toFile:(NSString *)file size:(CGSize *)outSize;
+
+// Deletes every cached thumbnail and returns the number of files removed
+- (NSUInteger)clearThumbnails;
+
+@end
@@ -0,0 +1,261 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Thumbnail generation with a persistent on-disk cache
+ *
+ * OPTIMIZATION: Cached pages cost a file lookup; missing pages render in parallel
+ * with dispatch_apply from the document shared through PdfManager's cache.
+ */
+
+#import "PDFThumbnailGenerator.h"
+#import "PDFNativeCacheManager.h"
+#import "PdfManager.h"
+#import "PDFTrace.h"
+#import <PDFKit/PDFKit.h>
+#import <UIKit/UIKit.h>
+#import <CommonCrypto/CommonDigest.h>
+#import <React/RCTLog.h>
+
+static NSString * const THUMBNAIL_DIR_NAME = @"pdf_thumbnails";
+static const CGFloat THUMBNAIL_JPEG_QUALITY = 0.85;
+static const NSInteger THUMBNAIL_MIN_DIMENSION = 16;
+static const NSInteger THUMBNAIL_MAX_DIMENSION = 1024;
+// Bytes hashed from each end of the file for the content fingerprint
+static const NSUInteger FINGERPRINT_SAMPLE_BYTES = 64 * 1024;
+
+@implementation PDFThumbnailGenerator {
+    // path|size|mtime -> content fingerprint, so unchanged files are hashed once
+    NSCache<NSString *, NSString *> *_fingerprints;
+}
+
++ (instancetype)sharedInstance {
+    static PDFThumbnailGenerator *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[PDFThumbnailGenerator alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _fingerprints = [[NSCache alloc] init];
+        NSString *cacheDir = [PDFNativeCacheManager sharedInstance].cacheDir ?: [NSTemporaryDirectory() stringByAppendingPathComponent:@"pdf_cache"];
+        _thumbnailDirectory = [[cacheDir stringByDeletingLastPathComponent] stringByAppendingPathComponent:THUMBNAIL_DIR_NAME];
+
+        NSError *error = nil;
+        if (![[NSFileManager defaultManager] createDirectoryAtPath:_thumbnailDirectory
+                                       withIntermediateDirectories:YES
+                                                        attributes:nil
+                                                             error:&error]) {
+            RCTLogWarn(@"⚠️ Failed to create thumbnail directory: %@", error.localizedDescription);
+        }
+    }
+    return self;
+}
+
+- (NSArray<NSDictionary *> *)generateThumbnailsForPath:(NSString *)path
+                                                 pages:(NSArray<NSNumber *> *)pages
+                                          maxDimension:(NSInteger)maxDimension
+                                                 error:(NSString **)error {
+    NSString *filePath = [path hasPrefix:@"file://"] ? [NSURL URLWithString:path].path : path;
+    NSString *fingerprint = [self fingerprintForPath:filePath];
+    if (!fingerprint) {
+        if (error) *error = [NSString stringWithFormat:@"PDF file not found: %@", path];
+        return nil;
+    }
+    NSInteger dimension = MAX(THUMBNAIL_MIN_DIMENSION, MIN(THUMBNAIL_MAX_DIMENSION, maxDimension));
+
+    NSUInteger count = pages.count;
+    NSMutableArray *results = [NSMutableArray arrayWithCapacity:count];
+    NSMutableArray<NSNumber *> *missing = [NSMutableArray array];
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    for (NSUInteger i = 0; i < count; i++) {
+        NSInteger page = pages[i].integerValue;
+        NSString *file = [self thumbnailPathForFingerprint:fingerprint page:page dimension:dimension];
+        UIImage *existing = [fileManager fileExistsAtPath:file] ? [UIImage imageWithContentsOfFile:file] : nil;
+        if (existing) {
+            // Touch so cleanup can evict least-recently-used thumbnails first
+            [fileManager setAttributes:@{NSFileModificationDate: [NSDate date]} ofItemAtPath:file error:nil];
+            [results addObject:@{
+                @"page": @(page),
+                @"uri": [NSURL fileURLWithPath:file].absoluteString,
+                @"width": @((NSInteger)(existing.size.width * existing.scale)),
+                @"height": @((NSInteger)(existing.size.height * existing.scale)),
+                @"cached": @YES
+            }];
+        } else {
+            [results addObject:[NSNull null]];
+            [missing addObject:@(i)];
+        }
+    }
+    if (missing.count == 0) {
+        return results;
+    }
+
+    NSUInteger fileNo = 0;
+    NSString *openError = nil;
+    PDFDocument *document = [PdfManager acquireDocumentAtPath:filePath password:nil fileNo:&fileNo error:&openError];
+    if (!document) {
+        if (error) *error = openError;
+        return nil;
+    }
+
+    CGPDFDocumentRef documentRef = document.documentRef;
+    size_t pageCount = CGPDFDocumentGetNumberOfPages(documentRef);
+    NSMutableArray *rendered = [NSMutableArray arrayWithCapacity:missing.count];
+    for (NSUInteger i = 0; i < missing.count; i++) {
+        [rendered addObject:[NSNull null]];
+    }
+
+    dispatch_apply(missing.count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t index) {
+        NSInteger page = pages[missing[index].unsignedIntegerValue].integerValue;
+        if (page < 1 || (size_t)page > pageCount) {
+            @synchronized (rendered) {
+                rendered[index] = @{@"page": @(page), @"error": [NSString stringWithFormat:@"Page out of range: %ld", (long)page]};
+            }
+            return;
+        }
+        NSString *file = [self thumbnailPathForFingerprint:fingerprint page:page dimension:dimension];
+        CGSize size = CGSizeZero;
+        NSDictionary *entry;
+        if ([self renderPage:CGPDFDocumentGetPage(documentRef, page) dimension:dimension toFile:file size:&size]) {
+            entry = @{
+                @"page": @(page),
+                @"uri": [NSURL fileURLWithPath:file].absoluteString,
+                @"width": @((NSInteger)size.width),
+                @"height": @((NSInteger)size.height),
+                @"cached": @NO
+            };
+        } else {
+            entry = @{@"page": @(page), @"error": [NSString stringWithFormat:@"Failed to render page %ld", (long)page]};
+        }
+        @synchronized (rendered) {
+            rendered[index] = entry;
+        }
+    });
+
+    for (NSUInteger i = 0; i < missing.count; i++) {
+        results[missing[i].unsignedIntegerValue] = rendered[i];
+    }
+    [PdfManager releasePdf:fileNo];
+    return results;
+}
+
+- (NSUInteger)clearThumbnails {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSUInteger removed = 0;
+    for (NSString *name in [fileManager contentsOfDirectoryAtPath:_thumbnailDirectory error:nil]) {
+        if ([fileManager removeItemAtPath:[_thumbnailDirectory stringByAppendingPathComponent:name] error:nil]) {
+            removed++;
+        }
+    }
+    return removed;
+}
+
+#pragma mark - Rendering
+
+- (BOOL)renderPage:(CGPDFPageRef)page dimension:(NSInteger)dimension toFile:(NSString *)file size:(CGSize *)outSize {
+    if (!page) {
+        return NO;
+    }
+    PDFTraceInterval trace = PDFTraceBegin(PDFTraceMetricThumbnail);
+    BOOL rendered = [self drawPage:page dimension:dimension toFile:file size:outSize];
+    PDFTraceEnd(trace);
+    return rendered;
+}
+
+- (BOOL)drawPage:(CGPDFPageRef)page dimension:(NSInteger)dimension toFile:(NSString *)file size:(CGSize *)outSize {
+    CGRect box = CGPDFPageGetBoxRect(page, kCGPDFCropBox);
+    int rotation = CGPDFPageGetRotationAngle(page);
+    CGSize pageSize = (rotation == 90 || rotation == 270) ? CGSizeMake(box.size.height, box.size.width) : box.size;
+    if (pageSize.width <= 0 || pageSize.height <= 0) {
+        return NO;
+    }
+    CGFloat scale = dimension / MAX(pageSize.width, pageSize.height);
+    size_t width = MAX(1, (size_t)lround(pageSize.width * scale));
+    size_t height = MAX(1, (size_t)lround(pageSize.height * scale));
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace,
+                                                 kCGImageAlphaNoneSkipLast | kCGBitmapByteOrderDefault);
+    CGColorSpaceRelease(colorSpace);
+    if (!context) {
+        return NO;
+    }
+
+    CGRect bounds = CGRectMake(0, 0, width, height);
+    CGContextSetRGBFillColor(context, 1, 1, 1, 1);
+    CGContextFillRect(context, bounds);
+    CGContextSetInterpolationQuality(context, kCGInterpolationMedium);
+    CGContextConcatCTM(context, CGPDFPageGetDrawingTransform(page, kCGPDFCropBox, bounds, 0, true));
+    CGContextDrawPDFPage(context, page);
+
+    CGImageRef image = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+    if (!image) {
+        return NO;
+    }
+    NSData *jpeg = UIImageJPEGRepresentation([UIImage imageWithCGImage:image], THUMBNAIL_JPEG_QUALITY);
+    CGImageRelease(image);
+
+    // Atomic write so concurrent readers never see a partial JPEG
+    if (!jpeg || ![jpeg writeToFile:file options:NSDataWritingAtomic error:nil]) {
+        return NO;
+    }
+    if (outSize) *outSize = CGSizeMake(width, height);
+    return YES;
+}
+
+#pragma mark - Cache Keys
+
+- (NSString *)thumbnailPathForFingerprint:(NSString *)fingerprint page:(NSInteger)page dimension:(NSInteger)dimension {
+    NSString *name = [NSString stringWithFormat:@"%@_%ld_%ld.jpg", fingerprint, (long)page, (long)dimension];
+    return [_thumbnailDirectory stringByAppendingPathComponent:name];
+}
+
+// SHA-256 over the file size and its first and last 64KB: cheap for large files,
+// and it changes whenever the header, trailer or cross-reference table changes
+- (NSString *)fingerprintForPath:(NSString *)path {
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil];
+    if (!attributes) {
+        return nil;
+    }
+    unsigned long long length = attributes.fileSize;
+    NSString *identity = [NSString stringWithFormat:@"%@|%llu|%f", path, length,
+                          attributes.fileModificationDate.timeIntervalSince1970];
+    NSString *cached = [_fingerprints objectForKey:identity];
+    if (cached) {
+        return cached;
+    }
+
+    NSFileHandle *handle = [NSFileHandle fileHandleForReadingAtPath:path];
+    if (!handle) {
+        return nil;
+    }
+    CC_SHA256_CTX ctx;
+    CC_SHA256_Init(&ctx);
+    NSString *lengthString = [NSString stringWithFormat:@"%llu", length];
+    CC_SHA256_Update(&ctx, lengthString.UTF8String, (CC_LONG)strlen(lengthString.UTF8String));
+
+    NSData *head = [handle readDataOfLength:FINGERPRINT_SAMPLE_BYTES];
+    CC_SHA256_Update(&ctx, head.bytes, (CC_LONG)head.length);
+    if (length > FINGERPRINT_SAMPLE_BYTES) {
+        unsigned long long tailStart = MAX((unsigned long long)FINGERPRINT_SAMPLE_BYTES, length - FINGERPRINT_SAMPLE_BYTES);
+        [handle seekToFileOffset:tailStart];
+        NSData *tail = [handle readDataToEndOfFile];
+        CC_SHA256_Update(&ctx, tail.bytes, (CC_LONG)tail.length);
+    }
+    [handle closeFile];
+
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(digest, &ctx);
+    NSMutableString *fingerprint = [NSMutableString stringWithCapacity:32];
+    for (int i = 0; i < 16; i++) {
+        [fingerprint appendFormat:@"%02x", digest[i]];
+    }
+    [_fingerprints setObject:fingerprint forKey:identity];
+    return fingerprint;
+}
+
+@end
@@ -0,0 +1,44 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Low-overhead tracing of the native render, open, search, thumbnail and hit-test paths
+ *
+ * Each interval is an os_signpost (visible in Instruments' Points of Interest
+ * and os_signpost tracks on iOS 12+) and lands in its thread's lock-free
+ * latency histogram; getPerformanceMetrics merges the threads' histograms.
+ * Build with PDFJSI_TRACING=0 to compile every interval out.
+ */
+
+#import <Foundation/Foundation.h>
+
+#ifndef PDFJSI_TRACING
+#define PDFJSI_TRACING 1
+#endif
+
+typedef NS_ENUM(NSInteger, PDFTraceMetric) {
+    PDFTraceMetricRender = 0,      // Page image rendered ahead of the viewer
+    PDFTraceMetricOpenDocument,    // PdfManager open of a new document
+    PDFTraceMetricSearch,          // Full-document text search
+    PDFTraceMetricThumbnail,       // One thumbnail render
+    PDFTraceMetricPageStoreRead,   // Stored page decoded from disk
+    PDFTraceMetricHitIndexBuild,   // Glyph, word and link boxes of one page
+    PDFTraceMetricHitTest,         // Tap or long-press lookup in a page's hit index
+    PDFTraceMetricCount
+};
+
+typedef struct {
+    PDFTraceMetric metric;
+    uint64_t startTime;
+    uint64_t signpostID;
+} PDFTraceInterval;
+
+#if PDFJSI_TRACING
+FOUNDATION_EXPORT PDFTraceInterval PDFTraceBegin(PDFTraceMetric metric);
+FOUNDATION_EXPORT void PDFTraceEnd(PDFTraceInterval interval);
+#else
+static inline PDFTraceInterval PDFTraceBegin(PDFTraceMetric metric) { PDFTraceInterval interval = { metric, 0, 0 }; return interval; }
+static inline void PDFTraceEnd(PDFTraceInterval interval) {}
+#endif
+
+// <metric>Count, AvgMs, P50Ms, P90Ms, P99Ms, MaxMs and LastMs for every metric
+FOUNDATION_EXPORT NSDictionary<NSString *, NSNumber *> *PDFTraceSummary(void);
+FOUNDATION_EXPORT void PDFTraceReset(void);
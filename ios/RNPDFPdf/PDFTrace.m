@@ -0,0 +1,255 @@
+/**
+ * Copyright (c) 2025-present, Punith M (punithm300@gmail.com)
+ * Low-overhead tracing of the native render, open, search and thumbnail paths
+ */
+
+#import "PDFTrace.h"
+#import <mach/mach_time.h>
+#import <os/signpost.h>
+#import <stdatomic.h>
+#import <stdlib.h>
+
+// Durations are bucketed in microseconds, four buckets per power of two
+#define PDF_TRACE_BUCKETS 128
+
+static NSString * const kMetricNames[PDFTraceMetricCount] = {
+    @"render",
+    @"openDocument",
+    @"search",
+    @"thumbnail",
+    @"pageStoreRead",
+    @"hitIndexBuild",
+    @"hitTest",
+};
+
+// Threads beyond this share one overflow record
+#define PDF_TRACE_MAX_THREAD_RECORDS 64
+
+typedef struct {
+    _Atomic uint64_t buckets[PDF_TRACE_BUCKETS];
+    _Atomic uint64_t totalNs;
+    _Atomic uint64_t maxNs;
+    _Atomic uint64_t lastNs;
+    // mach_absolute_time() at the end of the last interval, to pick the
+    // latest one across threads
+    _Atomic uint64_t lastEnd;
+} PDFTraceHistogram;
+
+// Written by its own thread only (or by every late thread for the overflow
+// record), so intervals on different threads never share a cache line;
+// summaries merge the records. Relaxed atomics keep those reads race free.
+typedef struct {
+    PDFTraceHistogram histograms[PDFTraceMetricCount];
+} PDFTraceRecord;
+
+static PDFTraceRecord * _Atomic records[PDF_TRACE_MAX_THREAD_RECORDS];
+static _Atomic int recordCount;
+static PDFTraceRecord overflowRecord;
+
+#if PDFJSI_TRACING
+static _Thread_local PDFTraceRecord *threadRecord;
+
+static PDFTraceRecord *PDFTraceThreadRecord(void) {
+    if (threadRecord) {
+        return threadRecord;
+    }
+    int slot = atomic_fetch_add_explicit(&recordCount, 1, memory_order_relaxed);
+    PDFTraceRecord *record = slot < PDF_TRACE_MAX_THREAD_RECORDS ? calloc(1, sizeof(PDFTraceRecord)) : NULL;
+    if (record) {
+        // Records stay alive for the process so summaries never race a thread exit
+        atomic_store_explicit(&records[slot], record, memory_order_release);
+    } else {
+        record = &overflowRecord;
+    }
+    threadRecord = record;
+    return record;
+}
+#endif
+
+// Fills found with every published record and the overflow record; returns how many
+static int PDFTraceAllRecords(PDFTraceRecord *found[PDF_TRACE_MAX_THREAD_RECORDS + 1]) {
+    int count = MIN(atomic_load_explicit(&recordCount, memory_order_relaxed), PDF_TRACE_MAX_THREAD_RECORDS);
+    int foundCount = 0;
+    for (int slot = 0; slot < count; slot++) {
+        // A slot is claimed before it is published; skip it until then
+        PDFTraceRecord *record = atomic_load_explicit(&records[slot], memory_order_acquire);
+        if (record) {
+            found[foundCount++] = record;
+        }
+    }
+    found[foundCount++] = &overflowRecord;
+    return foundCount;
+}
+
+static uint64_t PDFTraceNanoseconds(uint64_t machTime) {
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info(&timebase);
+    });
+    return machTime * timebase.numer / timebase.denom;
+}
+
+static int PDFTraceBucket(uint64_t micros) {
+    if (micros < 4) {
+        return (int)micros;
+    }
+    int exponent = 63 - __builtin_clzll(micros);
+    int sub = (int)((micros >> (exponent - 2)) & 3);
+    int bucket = (exponent - 1) * 4 + sub;
+    return bucket < PDF_TRACE_BUCKETS ? bucket : PDF_TRACE_BUCKETS - 1;
+}
+
+// Midpoint of a bucket's range, in milliseconds
+static double PDFTraceBucketMidpointMs(int bucket) {
+    if (bucket < 4) {
+        return (bucket + 0.5) / 1000.0;
+    }
+    int exponent = bucket / 4 + 1;
+    uint64_t low = (uint64_t)(4 + bucket % 4) << (exponent - 2);
+    uint64_t width = 1ULL << (exponent - 2);
+    return (low + width / 2.0) / 1000.0;
+}
+
+#if PDFJSI_TRACING
+
+static os_log_t PDFTraceLog(void) API_AVAILABLE(ios(12.0)) {
+    static os_log_t log;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        log = os_log_create("org.wonday.pdf", "PDFJSI");
+    });
+    return log;
+}
+
+PDFTraceInterval PDFTraceBegin(PDFTraceMetric metric) {
+    PDFTraceInterval interval = { metric, mach_absolute_time(), 0 };
+    if (@available(iOS 12.0, *)) {
+        os_log_t log = PDFTraceLog();
+        if (os_signpost_enabled(log)) {
+            os_signpost_id_t signpostID = os_signpost_id_generate(log);
+            interval.signpostID = signpostID;
+            // os_signpost names must be string literals
+            switch (metric) {
+                case PDFTraceMetricRender: os_signpost_interval_begin(log, signpostID, "render"); break;
+                case PDFTraceMetricOpenDocument: os_signpost_interval_begin(log, signpostID, "openDocument"); break;
+                case PDFTraceMetricSearch: os_signpost_interval_begin(log, signpostID, "search"); break;
+                case PDFTraceMetricThumbnail: os_signpost_interval_begin(log, signpostID, "thumbnail"); break;
+                case PDFTraceMetricPageStoreRead: os_signpost_interval_begin(log, signpostID, "pageStoreRead"); break;
+                case PDFTraceMetricHitIndexBuild: os_signpost_interval_begin(log, signpostID, "hitIndexBuild"); break;
+                case PDFTraceMetricHitTest: os_signpost_interval_begin(log, signpostID, "hitTest"); break;
+                default: break;
+            }
+        }
+    }
+    return interval;
+}
+
+void PDFTraceEnd(PDFTraceInterval interval) {
+    if (interval.metric < 0 || interval.metric >= PDFTraceMetricCount) {
+        return;
+    }
+    uint64_t endTime = mach_absolute_time();
+    uint64_t durationNs = PDFTraceNanoseconds(endTime - interval.startTime);
+
+    if (interval.signpostID != 0) {
+        if (@available(iOS 12.0, *)) {
+            os_log_t log = PDFTraceLog();
+            os_signpost_id_t signpostID = (os_signpost_id_t)interval.signpostID;
+            switch (interval.metric) {
+                case PDFTraceMetricRender: os_signpost_interval_end(log, signpostID, "render"); break;
+                case PDFTraceMetricOpenDocument: os_signpost_interval_end(log, signpostID, "openDocument"); break;
+                case PDFTraceMetricSearch: os_signpost_interval_end(log, signpostID, "search"); break;
+                case PDFTraceMetricThumbnail: os_signpost_interval_end(log, signpostID, "thumbnail"); break;
+                case PDFTraceMetricPageStoreRead: os_signpost_interval_end(log, signpostID, "pageStoreRead"); break;
+                case PDFTraceMetricHitIndexBuild: os_signpost_interval_end(log, signpostID, "hitIndexBuild"); break;
+                case PDFTraceMetricHitTest: os_signpost_interval_end(log, signpostID, "hitTest"); break;
+                default: break;
+            }
+        }
+    }
+
+    PDFTraceHistogram *histogram = &PDFTraceThreadRecord()->histograms[interval.metric];
+    atomic_fetch_add_explicit(&histogram->buckets[PDFTraceBucket(durationNs / 1000)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->totalNs, durationNs, memory_order_relaxed);
+    atomic_store_explicit(&histogram->lastNs, durationNs, memory_order_relaxed);
+    atomic_store_explicit(&histogram->lastEnd, endTime, memory_order_relaxed);
+    uint64_t max = atomic_load_explicit(&histogram->maxNs, memory_order_relaxed);
+    while (durationNs > max &&
+           !atomic_compare_exchange_weak_explicit(&histogram->maxNs, &max, durationNs,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+#endif
+
+NSDictionary<NSString *, NSNumber *> *PDFTraceSummary(void) {
+    NSMutableDictionary<NSString *, NSNumber *> *summary = [NSMutableDictionary dictionary];
+    PDFTraceRecord *found[PDF_TRACE_MAX_THREAD_RECORDS + 1];
+    int recordTotal = PDFTraceAllRecords(found);
+    for (NSInteger metric = 0; metric < PDFTraceMetricCount; metric++) {
+        uint64_t buckets[PDF_TRACE_BUCKETS] = { 0 };
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+        uint64_t lastNs = 0;
+        uint64_t lastEnd = 0;
+        for (int index = 0; index < recordTotal; index++) {
+            PDFTraceHistogram *histogram = &found[index]->histograms[metric];
+            for (int bucket = 0; bucket < PDF_TRACE_BUCKETS; bucket++) {
+                buckets[bucket] += atomic_load_explicit(&histogram->buckets[bucket], memory_order_relaxed);
+            }
+            totalNs += atomic_load_explicit(&histogram->totalNs, memory_order_relaxed);
+            maxNs = MAX(maxNs, atomic_load_explicit(&histogram->maxNs, memory_order_relaxed));
+            // An interval ending meanwhile may pair one end time with another
+            // duration; that only skews which recent interval counts as last
+            uint64_t end = atomic_load_explicit(&histogram->lastEnd, memory_order_relaxed);
+            if (end > lastEnd) {
+                lastEnd = end;
+                lastNs = atomic_load_explicit(&histogram->lastNs, memory_order_relaxed);
+            }
+        }
+        uint64_t count = 0;
+        for (int bucket = 0; bucket < PDF_TRACE_BUCKETS; bucket++) {
+            count += buckets[bucket];
+        }
+
+        double percentiles[3] = { 0, 0, 0 };
+        const double quantiles[3] = { 0.50, 0.90, 0.99 };
+        uint64_t seen = 0;
+        int next = 0;
+        for (int bucket = 0; bucket < PDF_TRACE_BUCKETS && next < 3 && count > 0; bucket++) {
+            seen += buckets[bucket];
+            while (next < 3 && seen >= quantiles[next] * count) {
+                percentiles[next++] = PDFTraceBucketMidpointMs(bucket);
+            }
+        }
+
+        double totalMs = totalNs / 1e6;
+        NSString *name = kMetricNames[metric];
+        summary[[name stringByAppendingString:@"Count"]] = @(count);
+        summary[[name stringByAppendingString:@"AvgMs"]] = @(count > 0 ? totalMs / count : 0.0);
+        summary[[name stringByAppendingString:@"P50Ms"]] = @(percentiles[0]);
+        summary[[name stringByAppendingString:@"P90Ms"]] = @(percentiles[1]);
+        summary[[name stringByAppendingString:@"P99Ms"]] = @(percentiles[2]);
+        summary[[name stringByAppendingString:@"MaxMs"]] = @(maxNs / 1e6);
+        summary[[name stringByAppendingString:@"LastMs"]] = @(lastNs / 1e6);
+    }
+    return summary;
+}
+
+void PDFTraceReset(void) {
+    PDFTraceRecord *found[PDF_TRACE_MAX_THREAD_RECORDS + 1];
+    int recordTotal = PDFTraceAllRecords(found);
+    for (int index = 0; index < recordTotal; index++) {
+        for (NSInteger metric = 0; metric < PDFTraceMetricCount; metric++) {
+            PDFTraceHistogram *histogram = &found[index]->histograms[metric];
+            for (int bucket = 0; bucket < PDF_TRACE_BUCKETS; bucket++) {
+                atomic_store_explicit(&histogram->buckets[bucket], 0, memory_order_relaxed);
+            }
+            atomic_store_explicit(&histogram->totalNs, 0, memory_order_relaxed);
+            atomic_store_explicit(&histogram->maxNs, 0, memory_order_relaxed);
+            atomic_store_explicit(&histogram->lastNs, 0, memory_order_relaxed);
+            atomic_store_explicit(&histogram->lastEnd, 0, memory_order_relaxed);
+        }
+    }
+}
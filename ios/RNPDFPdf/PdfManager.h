@@ -16,8 +16,42 @@
 #endif
 
 
+@class PDFDocument;
+
+// Floats per page in a page geometry table: width, height (displayed, rotation
+// applied), media box left/bottom/right/top, crop box left/bottom/right/top,
+// rotation, user unit
+extern const NSUInteger PdfPageGeometryFields;
+
+// Documents are shared through a cache keyed by file path and modification date.
+// Each holder takes a reference by fileNo and drops it with releasePdf:; documents
+// nobody references stay cached until least-recently-used eviction.
 @interface PdfManager : NSObject <RCTBridgeModule>
 
+// Document for fileNo without taking a reference (nil ref if unknown or evicted)
 + (CGPDFDocumentRef) getPdf:(NSUInteger) index;
 
+// Takes a reference on an already cached document
++ (CGPDFDocumentRef) acquirePdf:(NSUInteger) fileNo;
+
+// Percent-decoded file path (or path itself if it cannot be decoded); apply once
++ (NSString *)decodedPath:(NSString *)path;
+
+// Opens (or reuses) the document at path, a file system path that is already
+// decoded, and takes a reference on it
++ (PDFDocument *) acquireDocumentAtPath:(NSString *)path
+                               password:(NSString *)password
+                                 fileNo:(NSUInteger *)fileNo
+                                  error:(NSString **)error;
+
++ (void) releasePdf:(NSUInteger) fileNo;
+
+// Closes least recently used unreferenced documents until at most count remain
+// (memory pressure); returns the number closed
++ (NSUInteger) trimUnreferencedDocumentsTo:(NSUInteger)count;
+
+// Page geometry table for fileNo, measured once per document and persisted with
+// the native cache for cached files (nil if unknown or evicted)
++ (NSData *) pageGeometryForFileNo:(NSUInteger) fileNo;
+
 @end
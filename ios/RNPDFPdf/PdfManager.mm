@@ -9,6 +9,8 @@
 
 
 #import "PdfManager.h"
+#import "PDFTrace.h"
+#import "PDFNativeCacheManager.h"
 
 #if __has_include(<React/RCTAssert.h>)
 #import <React/RCTUtils.h>
@@ -17,10 +19,36 @@
 #endif
 
 
-static NSMutableArray *pdfDocRefs = Nil;
+#import <PDFKit/PDFKit.h>
 
-@implementation PdfManager
+const NSUInteger PdfPageGeometryFields = 12;
+
+// Unreferenced documents kept open for reuse before the least recently used is closed
+static const NSUInteger kMaxUnreferencedDocuments = 8;
+
+@interface PdfCachedDocument : NSObject
+@property (nonatomic, assign) NSUInteger fileNo;
+@property (nonatomic, copy) NSString *key;
+@property (nonatomic, copy) NSString *path;
+@property (nonatomic, strong) PDFDocument *document;
+// Password that unlocked the document, nil if it opens without one
+@property (nonatomic, copy) NSString *password;
+@property (nonatomic, assign) NSInteger refCount;
+// Page geometry table, nil until first requested
+@property (nonatomic, strong) NSData *pageGeometry;
+@end
+
+@implementation PdfCachedDocument
+@end
+
+// Guarded by the cache lock
+static NSMutableDictionary<NSString *, PdfCachedDocument *> *documentsByKey = Nil;
+static NSMutableDictionary<NSNumber *, PdfCachedDocument *> *documentsByFileNo = Nil;
+// Least recently used first
+static NSMutableArray<NSNumber *> *recentFileNos = Nil;
+static NSUInteger nextFileNo = 0;
 
+@implementation PdfManager
 
 #ifndef __OPTIMIZE__
 // only output log when debug
@@ -34,83 +62,333 @@ static NSMutableArray *pdfDocRefs = Nil;
 
 RCT_EXPORT_MODULE();
 
++ (NSObject *)cacheLock
+{
+    static NSObject *lock;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        lock = [[NSObject alloc] init];
+        documentsByKey = [NSMutableDictionary dictionary];
+        documentsByFileNo = [NSMutableDictionary dictionary];
+        recentFileNos = [NSMutableArray array];
+    });
+    return lock;
+}
 
-RCT_EXPORT_METHOD(loadFile:(NSString *)path
-                  password:(NSString *)password
-                  resolve:(RCTPromiseResolveBlock)resolve
-                  reject:(RCTPromiseRejectBlock)reject
-                  )
++ (NSString *)decodedPath:(NSString *)path
 {
+    NSString *decodedPath = (__bridge_transfer NSString *)CFURLCreateStringByReplacingPercentEscapes(NULL, (CFStringRef)path, CFSTR(""));
+    // use orignal provided path if it cannot be decoded
+    return decodedPath ?: path;
+}
 
-    if (pdfDocRefs==Nil) {
-        pdfDocRefs = [NSMutableArray arrayWithCapacity:1];
+// A rewritten file gets a new key, so stale documents are never served
++ (NSString *)cacheKeyForPath:(NSString *)path
+{
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil];
+    if (!attributes) {
+        return nil;
     }
+    return [NSString stringWithFormat:@"%@|%.3f|%llu", path,
+            [attributes.fileModificationDate timeIntervalSince1970], attributes.fileSize];
+}
 
-    int numberOfPages = 0;
++ (void)touch:(PdfCachedDocument *)entry
+{
+    [recentFileNos removeObject:@(entry.fileNo)];
+    [recentFileNos addObject:@(entry.fileNo)];
+}
 
-    if (path != nil && path.length != 0) {
++ (void)remove:(PdfCachedDocument *)entry
+{
+    if (documentsByKey[entry.key] == entry) {
+        [documentsByKey removeObjectForKey:entry.key];
+    }
+    [documentsByFileNo removeObjectForKey:@(entry.fileNo)];
+    [recentFileNos removeObject:@(entry.fileNo)];
+}
 
-        NSString *decodedPath = (__bridge_transfer NSString *)CFURLCreateStringByReplacingPercentEscapes(NULL, (CFStringRef)path, CFSTR(""));
-        
-        NSString *finalPath = NULL;
-        if (decodedPath == NULL) {
-            // use orignal provided path
-            finalPath = path;
-        } else {
-            finalPath = decodedPath;
-        }
-        
-        NSURL *pdfURL = [NSURL fileURLWithPath:finalPath];
-        CGPDFDocumentRef pdfRef = CGPDFDocumentCreateWithURL((__bridge CFURLRef) pdfURL);
++ (void)evictUnreferenced
+{
+    [self evictUnreferencedKeeping:kMaxUnreferencedDocuments];
+}
 
-        if (pdfRef == NULL) {
-            reject(RCTErrorUnspecified, [NSString stringWithFormat:@"Load pdf failed. path=%s",path.UTF8String], nil);
-            return;
++ (NSUInteger)evictUnreferencedKeeping:(NSUInteger)limit
+{
+    NSUInteger evicted = 0;
+    NSUInteger unreferenced = 0;
+    for (PdfCachedDocument *entry in documentsByFileNo.allValues) {
+        if (entry.refCount == 0) {
+            unreferenced++;
         }
+    }
+    for (NSNumber *fileNo in [recentFileNos copy]) {
+        if (unreferenced <= limit) {
+            break;
+        }
+        PdfCachedDocument *entry = documentsByFileNo[fileNo];
+        if (entry.refCount == 0) {
+            DLog(@"Pdf cache evicting fileNo=%lu", (unsigned long)entry.fileNo);
+            [self remove:entry];
+            unreferenced--;
+            evicted++;
+        }
+    }
+    return evicted;
+}
 
-        if (CGPDFDocumentIsEncrypted(pdfRef)) {
++ (NSUInteger) trimUnreferencedDocumentsTo:(NSUInteger)count
+{
+    @synchronized ([self cacheLock]) {
+        return [self evictUnreferencedKeeping:count];
+    }
+}
 
-            bool isUnlocked = CGPDFDocumentUnlockWithPassword(pdfRef, [password UTF8String]);
-            if (!isUnlocked) {
-                reject(RCTErrorUnspecified, @"Password required or incorrect password.", nil);
-                return;
++ (PDFDocument *) acquireDocumentAtPath:(NSString *)path
+                               password:(NSString *)password
+                                 fileNo:(NSUInteger *)fileNo
+                                  error:(NSString **)error
+{
+    NSString *key = [self cacheKeyForPath:path];
+    if (!key) {
+        if (error) *error = [NSString stringWithFormat:@"Load pdf failed. path=%s", path.UTF8String];
+        return nil;
+    }
+    password = password ?: @"";
+
+    // Parsed outside the lock so other documents' acquires and releases don't
+    // wait on it; a racing acquire that inserted first wins and ours is dropped
+    PDFDocument *parsed = nil;
+    while (YES) {
+        @synchronized ([self cacheLock]) {
+            PdfCachedDocument *entry = documentsByKey[key];
+            if (!entry && parsed) {
+                entry = [[PdfCachedDocument alloc] init];
+                entry.fileNo = nextFileNo++;
+                entry.key = key;
+                entry.path = path;
+                entry.document = parsed;
+                documentsByKey[key] = entry;
+                documentsByFileNo[@(entry.fileNo)] = entry;
             }
+            if (entry) {
+                return [self referenceEntry:entry password:password fileNo:fileNo error:error];
+            }
+        }
+        PDFTraceInterval trace = PDFTraceBegin(PDFTraceMetricOpenDocument);
+        parsed = [[PDFDocument alloc] initWithURL:[NSURL fileURLWithPath:path]];
+        PDFTraceEnd(trace);
+        if (!parsed || !parsed.documentRef) {
+            if (error) *error = [NSString stringWithFormat:@"Load pdf failed. path=%s", path.UTF8String];
+            return nil;
+        }
+    }
+}
 
+// Called with cacheLock held
++ (PDFDocument *) referenceEntry:(PdfCachedDocument *)entry
+                        password:(NSString *)password
+                          fileNo:(NSUInteger *)fileNo
+                           error:(NSString **)error
+{
+    [self touch:entry];
+
+    // A document unlocked by one holder is only shared with holders knowing its password
+    BOOL unlocked;
+    if (entry.document.isLocked) {
+        unlocked = [entry.document unlockWithPassword:password];
+        if (unlocked) {
+            entry.password = password;
         }
+    } else {
+        unlocked = entry.password == nil || [entry.password isEqualToString:password];
+    }
+    if (!unlocked) {
+        [self evictUnreferenced];
+        if (error) *error = @"Password required or incorrect password.";
+        return nil;
+    }
 
-        [pdfDocRefs addObject:[NSValue valueWithPointer:pdfRef]];
+    entry.refCount++;
+    [self evictUnreferenced];
+    if (fileNo) *fileNo = entry.fileNo;
+    return entry.document;
+}
 
-        numberOfPages = (int)CGPDFDocumentGetNumberOfPages(pdfRef);
-        CGPDFPageRef pdfPage = CGPDFDocumentGetPage(pdfRef, 1);
-        CGRect pdfPageRect = CGPDFPageGetBoxRect(pdfPage, kCGPDFMediaBox);
-        int rotation = CGPDFPageGetRotationAngle(pdfPage);
-        
-        NSArray *params;
-        
-        if (rotation == 90 || rotation==270) {
-             params =@[[NSNumber numberWithUnsignedLong:([pdfDocRefs count]-1)], [NSNumber numberWithInt:numberOfPages], [NSNumber numberWithFloat:pdfPageRect.size.height], [NSNumber numberWithFloat:pdfPageRect.size.width]];
-            RLog(@"Pdf loaded numberOfPages=%d, fileNo=%lu, pageWidth=%f, pageHeight=%f", numberOfPages, [pdfDocRefs count]-1, pdfPageRect.size.height, pdfPageRect.size.width);
++ (CGPDFDocumentRef) acquirePdf:(NSUInteger) fileNo
+{
+    @synchronized ([self cacheLock]) {
+        PdfCachedDocument *entry = documentsByFileNo[@(fileNo)];
+        if (!entry) {
+            return NULL;
+        }
+        entry.refCount++;
+        [self touch:entry];
+        return entry.document.documentRef;
+    }
+}
 
-        } else {
-            params =@[[NSNumber numberWithUnsignedLong:([pdfDocRefs count]-1)], [NSNumber numberWithInt:numberOfPages], [NSNumber numberWithFloat:pdfPageRect.size.width], [NSNumber numberWithFloat:pdfPageRect.size.height]];
-            RLog(@"Pdf loaded numberOfPages=%d, fileNo=%lu, pageWidth=%f, pageHeight=%f", numberOfPages, [pdfDocRefs count]-1, pdfPageRect.size.width, pdfPageRect.size.height);
++ (void) releasePdf:(NSUInteger) fileNo
+{
+    @synchronized ([self cacheLock]) {
+        PdfCachedDocument *entry = documentsByFileNo[@(fileNo)];
+        if (entry && entry.refCount > 0) {
+            entry.refCount--;
+            [self evictUnreferenced];
+        }
+    }
+}
 
++ (NSData *)measurePageGeometry:(CGPDFDocumentRef)pdfRef
+{
+    size_t pageCount = CGPDFDocumentGetNumberOfPages(pdfRef);
+    NSMutableData *geometry = [NSMutableData dataWithLength:pageCount * PdfPageGeometryFields * sizeof(float)];
+    float *values = (float *)geometry.mutableBytes;
+    for (size_t i = 0; i < pageCount; i++) {
+        CGPDFPageRef page = CGPDFDocumentGetPage(pdfRef, i + 1);
+        float *row = values + i * PdfPageGeometryFields;
+        if (!page) {
+            continue;
+        }
+        CGRect mediaBox = CGPDFPageGetBoxRect(page, kCGPDFMediaBox);
+        CGRect cropBox = CGPDFPageGetBoxRect(page, kCGPDFCropBox);
+        int rotation = CGPDFPageGetRotationAngle(page);
+        CGPDFReal userUnit = 1;
+        CGPDFDictionaryRef dictionary = CGPDFPageGetDictionary(page);
+        if (!dictionary || !CGPDFDictionaryGetNumber(dictionary, "UserUnit", &userUnit) || userUnit <= 0) {
+            userUnit = 1;
         }
+        BOOL swapped = rotation == 90 || rotation == 270;
+        row[0] = swapped ? cropBox.size.height : cropBox.size.width;
+        row[1] = swapped ? cropBox.size.width : cropBox.size.height;
+        row[2] = CGRectGetMinX(mediaBox);
+        row[3] = CGRectGetMinY(mediaBox);
+        row[4] = CGRectGetMaxX(mediaBox);
+        row[5] = CGRectGetMaxY(mediaBox);
+        row[6] = CGRectGetMinX(cropBox);
+        row[7] = CGRectGetMinY(cropBox);
+        row[8] = CGRectGetMaxX(cropBox);
+        row[9] = CGRectGetMaxY(cropBox);
+        row[10] = rotation;
+        row[11] = userUnit;
+    }
+    return geometry;
+}
 
-        resolve(params);
-        return;
-    } else {
++ (NSData *) pageGeometryForFileNo:(NSUInteger) fileNo
+{
+    CGPDFDocumentRef pdfRef;
+    NSString *path;
+    @synchronized ([self cacheLock]) {
+        PdfCachedDocument *entry = documentsByFileNo[@(fileNo)];
+        if (!entry) {
+            return nil;
+        }
+        if (entry.pageGeometry) {
+            return entry.pageGeometry;
+        }
+        pdfRef = CGPDFDocumentRetain(entry.document.documentRef);
+        path = entry.path;
+    }
+
+    // Measured outside the cache lock: walking a long document loads every page dictionary
+    NSUInteger expectedLength = CGPDFDocumentGetNumberOfPages(pdfRef) * PdfPageGeometryFields * sizeof(float);
+    PDFNativeCacheManager *cacheManager = [PDFNativeCacheManager sharedInstance];
+    NSData *geometry = [cacheManager pageGeometryForPath:path];
+    if (geometry.length != expectedLength) {
+        geometry = [self measurePageGeometry:pdfRef];
+        [cacheManager storePageGeometry:geometry forPath:path];
+    }
+    CGPDFDocumentRelease(pdfRef);
+
+    @synchronized ([self cacheLock]) {
+        PdfCachedDocument *entry = documentsByFileNo[@(fileNo)];
+        if (entry && !entry.pageGeometry) {
+            entry.pageGeometry = geometry;
+        }
+    }
+    return geometry;
+}
+
+RCT_EXPORT_METHOD(loadFile:(NSString *)path
+                  password:(NSString *)password
+                  resolve:(RCTPromiseResolveBlock)resolve
+                  reject:(RCTPromiseRejectBlock)reject
+                  )
+{
+
+    if (path == nil || path.length == 0) {
         reject(RCTErrorUnspecified, @"Load pdf failed. path=null", nil);
         return;
     }
+
+    // Each loadFile takes a reference on the shared document; drop it with releaseFile
+    NSUInteger fileNo = 0;
+    NSString *error = nil;
+    PDFDocument *document = [PdfManager acquireDocumentAtPath:[PdfManager decodedPath:path] password:password
+                                                       fileNo:&fileNo error:&error];
+    if (!document) {
+        reject(RCTErrorUnspecified, error, nil);
+        return;
+    }
+
+    CGPDFDocumentRef pdfRef = document.documentRef;
+    int numberOfPages = (int)CGPDFDocumentGetNumberOfPages(pdfRef);
+    CGPDFPageRef pdfPage = CGPDFDocumentGetPage(pdfRef, 1);
+    CGRect pdfPageRect = CGPDFPageGetBoxRect(pdfPage, kCGPDFMediaBox);
+    int rotation = CGPDFPageGetRotationAngle(pdfPage);
+
+    NSArray *params;
+
+    if (rotation == 90 || rotation==270) {
+        params =@[[NSNumber numberWithUnsignedLong:fileNo], [NSNumber numberWithInt:numberOfPages], [NSNumber numberWithFloat:pdfPageRect.size.height], [NSNumber numberWithFloat:pdfPageRect.size.width]];
+        RLog(@"Pdf loaded numberOfPages=%d, fileNo=%lu, pageWidth=%f, pageHeight=%f", numberOfPages, (unsigned long)fileNo, pdfPageRect.size.height, pdfPageRect.size.width);
+
+    } else {
+        params =@[[NSNumber numberWithUnsignedLong:fileNo], [NSNumber numberWithInt:numberOfPages], [NSNumber numberWithFloat:pdfPageRect.size.width], [NSNumber numberWithFloat:pdfPageRect.size.height]];
+        RLog(@"Pdf loaded numberOfPages=%d, fileNo=%lu, pageWidth=%f, pageHeight=%f", numberOfPages, (unsigned long)fileNo, pdfPageRect.size.width, pdfPageRect.size.height);
+
+    }
+
+    resolve(params);
+
+    // Warm the page geometry table so sizing every page later does not load pages
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        [PdfManager pageGeometryForFileNo:fileNo];
+    });
 }
 
-+ (CGPDFDocumentRef) getPdf:(NSUInteger) index
+RCT_EXPORT_METHOD(getPageGeometry:(nonnull NSNumber *)fileNo
+                  resolve:(RCTPromiseResolveBlock)resolve
+                  reject:(RCTPromiseRejectBlock)reject)
 {
-    if (pdfDocRefs && [pdfDocRefs count]>index){
+    NSData *geometry = [PdfManager pageGeometryForFileNo:fileNo.unsignedIntegerValue];
+    if (!geometry) {
+        reject(RCTErrorUnspecified, @"Document not loaded", nil);
+        return;
+    }
+    const float *values = (const float *)geometry.bytes;
+    NSUInteger count = geometry.length / sizeof(float);
+    NSMutableArray<NSNumber *> *result = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [result addObject:@(values[i])];
+    }
+    resolve(result);
+}
 
-        return (CGPDFDocumentRef)[(NSValue *)[pdfDocRefs objectAtIndex:index] pointerValue];
+RCT_EXPORT_METHOD(releaseFile:(nonnull NSNumber *)fileNo)
+{
+    [PdfManager releasePdf:fileNo.unsignedIntegerValue];
+}
 
++ (CGPDFDocumentRef) getPdf:(NSUInteger) index
+{
+    @synchronized ([self cacheLock]) {
+        PdfCachedDocument *entry = documentsByFileNo[@(index)];
+        if (entry) {
+            [self touch:entry];
+            return entry.document.documentRef;
+        }
     }
 
     return NULL;
@@ -134,17 +412,14 @@ RCT_EXPORT_METHOD(loadFile:(NSString *)path
 
 - (void)dealloc
 {
-    // release pdf docs
-    for(NSValue *item in pdfDocRefs) {
-        CGPDFDocumentRef pdfItem = (CGPDFDocumentRef)[item pointerValue];
-        if (pdfItem != NULL) {
-
-            CGPDFDocumentRelease(pdfItem);
-            pdfItem = NULL;
-
+    // release pdf docs nobody holds any more (e.g. on bridge reload)
+    @synchronized ([PdfManager cacheLock]) {
+        for (PdfCachedDocument *entry in documentsByFileNo.allValues) {
+            if (entry.refCount == 0) {
+                [PdfManager remove:entry];
+            }
         }
     }
-    pdfDocRefs = Nil;
 
 }
 
@@ -36,35 +36,77 @@
 // output log both debug and release
 #define RLog( s, ... ) NSLog( @"<%p %@:(%d)> %@", self, [[NSString stringWithUTF8String:__FILE__] lastPathComponent], __LINE__, [NSString stringWithFormat:(s), ##__VA_ARGS__] )
 
-@interface CAPdfLayer : CALayer
--(void) setParentView:(RNPDFPdfPageView *)parentView;
+// Tile edge in pixels; tiles are rasterized on CATiledLayer's background threads
+// and cached by the layer, so zooming only redraws tiles that become visible
+const CGFloat PDF_TILE_SIZE = 512.0f;
+// Extra levels of detail above 1x (2^3 = sharp up to 8x zoom)
+const size_t PDF_TILE_ZOOM_LEVELS = 3;
+
+@interface CAPdfLayer : CATiledLayer
+-(void) setDocument:(CGPDFDocumentRef)document page:(int)page;
 @end
 
 @implementation CAPdfLayer
 {
-    RNPDFPdfPageView *_parentView;
+    // Guarded by self; read from tile rendering threads
+    CGPDFDocumentRef _document;
+    int _page;
 }
 
--(void) setParentView:(RNPDFPdfPageView *)parentView
+// Show tiles as soon as they are drawn instead of fading them in
++ (CFTimeInterval)fadeDuration
 {
-    _parentView = parentView;
+    return 0.0;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        self.tileSize = CGSizeMake(PDF_TILE_SIZE, PDF_TILE_SIZE);
+        self.levelsOfDetail = PDF_TILE_ZOOM_LEVELS + 1;
+        self.levelsOfDetailBias = PDF_TILE_ZOOM_LEVELS;
+    }
+    return self;
+}
+
+-(void) setDocument:(CGPDFDocumentRef)document page:(int)page
+{
+    @synchronized (self) {
+        if (document != _document) {
+            CGPDFDocumentRetain(document);
+            CGPDFDocumentRelease(_document);
+            _document = document;
+        }
+        _page = page;
+    }
+}
+
+- (void)dealloc
+{
+    CGPDFDocumentRelease(_document);
 }
 
 - (void)drawInContext:(CGContextRef)context
 {
-    
-    CGRect _viewFrame = _parentView.frame;
-    CGPDFDocumentRef pdfRef= [PdfManager getPdf:_parentView.fileNo];
+    CGPDFDocumentRef pdfRef;
+    int pageNumber;
+    @synchronized (self) {
+        pdfRef = CGPDFDocumentRetain(_document);
+        pageNumber = _page;
+    }
+    // Called once per tile; the context is clipped to the tile and already scaled for its level of detail
+    CGRect _viewFrame = self.bounds;
     if (pdfRef!=NULL)
     {
         
-        CGPDFPageRef pdfPage = CGPDFDocumentGetPage(pdfRef, _parentView.page);
+        CGPDFPageRef pdfPage = CGPDFDocumentGetPage(pdfRef, pageNumber);
         
         if (pdfPage != NULL) {
             
             // Fill the background with white.
             CGContextSetRGBFillColor(context, 1.0,1.0,1.0,1.0);
-            CGContextFillRect(context, _viewFrame);
+            CGContextFillRect(context, CGContextGetClipBoundingBox(context));
             
             // PDF page drawing expects a Lower-Left coordinate system, so we flip the coordinate system before drawing.
             CGContextScaleCTM(context, 1.0, -1.0);
@@ -130,6 +172,7 @@
             CGContextDrawPDFPage(context, pdfPage);
         }
         
+        CGPDFDocumentRelease(pdfRef);
     }
 }
 @end
@@ -137,6 +180,8 @@
 @implementation RNPDFPdfPageView {
     
     CAPdfLayer         *_layer;
+    // fileNo this view holds a PdfManager reference on, -1 for none
+    int                 _acquiredFileNo;
 }
 
 // The layer's class
@@ -149,7 +194,7 @@
 {
     self = [super init];
     if (self) {
-
+        _acquiredFileNo = -1;
     }
     
     return self;
@@ -157,29 +202,39 @@
 
 - (void)didSetProps:(NSArray<NSString *> *)changedProps
 {
-    long int count = [changedProps count];
-    for (int i = 0 ; i < count; i++) {
-        if ([[changedProps objectAtIndex:i] isEqualToString:@"page"]) {
-            // do something
+    // Resolve the document once here so tile drawing never goes through PdfManager,
+    // and keep it referenced in the shared cache while this view shows it
+    if (self.fileNo != _acquiredFileNo) {
+        if (_acquiredFileNo >= 0) {
+            [PdfManager releasePdf:_acquiredFileNo];
+            _acquiredFileNo = -1;
+        }
+        if (self.fileNo >= 0 && [PdfManager acquirePdf:self.fileNo] != NULL) {
+            _acquiredFileNo = self.fileNo;
         }
     }
-
+    [(CAPdfLayer *)self.layer setDocument:[PdfManager getPdf:self.fileNo] page:self.page];
     [self.layer setNeedsDisplay];
 }
 
 
 - (void)reactSetFrame:(CGRect)frame
 {
+    BOOL resized = !CGSizeEqualToSize(frame.size, self.bounds.size);
     [super reactSetFrame:frame];
     
     self.layer.backgroundColor= [UIColor whiteColor].CGColor;
     self.layer.contentsScale = [[UIScreen mainScreen] scale];
-    [(CAPdfLayer *)self.layer setParentView:self];
-    [self.layer setNeedsDisplay];
+    // Moving a cell keeps its cached tiles; only a new size needs them redrawn
+    if (resized) {
+        [self.layer setNeedsDisplay];
+    }
 }
 
 - (void)dealloc{
-
+    if (_acquiredFileNo >= 0) {
+        [PdfManager releasePdf:_acquiredFileNo];
+    }
 }
 
 @end
@@ -57,8 +57,29 @@ UIView
 - (NSDictionary *)getPerformanceMetrics;
 - (void)clearCache;
 - (void)preloadPagesFrom:(int)startPage to:(int)endPage;
+
+// Page (1-based) pre-rendered at the view's fit-to-width size, or nil
+- (UIImage *)cachedImageForPage:(int)pageNumber;
 - (NSDictionary *)searchText:(NSString *)searchTerm;
 
+// Long presses select by word and report "pageLongPress|page|x|y|text" when lifted.
+
+// Incremental search on a background queue. Matches are streamed through onChange as
+// "searchResult|page|count|rectsJSON|term" per page, then "searchComplete|matches|pages|cached|term".
+// Starting a new search (or cancelSearch) stops the running one.
+- (void)startSearch:(NSString *)searchTerm;
+- (void)cancelSearch;
+
+// Lookups in a page's (1-based) hit index, points in page coordinates. Results match
+// Android's hitTest/selectText: { type: "none" | "word" | "link", page, offset, length,
+// text, left, top, right, bottom, targetPage, uri } and { page, offset, length, text, rects };
+// nil for pages outside the document.
+- (NSDictionary *)hitTestPage:(int)pageNumber point:(CGPoint)point tolerance:(CGFloat)tolerance;
+- (NSDictionary *)selectTextOnPage:(int)pageNumber from:(CGPoint)start to:(CGPoint)end tolerance:(CGFloat)tolerance;
+
+// The view currently showing pdfId (its path), if any
++ (RNPDFPdfView *)viewForPdfId:(NSString *)pdfId;
+
 @end
 
 #endif /* RNPDFPdfView_h */
@@ -7,10 +7,17 @@
  */
 
 #import "RNPDFPdfView.h"
+#import "PdfManager.h"
+#import "PDFNativeCacheManager.h"
+#import "PDFPageStore.h"
+#import "PDFMemoryGovernor.h"
+#import "PDFPageHitIndex.h"
+#import "PDFTrace.h"
 
 #import <Foundation/Foundation.h>
 #import <QuartzCore/QuartzCore.h>
 #import <PDFKit/PDFKit.h>
+#include <atomic>
 
 #if __has_include(<React/RCTAssert.h>)
 #import <React/RCTBridgeModule.h>
@@ -54,7 +61,15 @@
 const float MAX_SCALE = 3.0f;
 const float MIN_SCALE = 1.0f;
 
-@interface RNPDFPdfView() <PDFDocumentDelegate, PDFViewDelegate
+// Memory bounds for the search caches (NSCache cost is in bytes)
+const NSUInteger PAGE_TEXT_CACHE_BYTES = 8 * 1024 * 1024;
+const NSUInteger SEARCH_CACHE_BYTES = 2 * 1024 * 1024;
+// Glyph, word and link boxes of shown pages, behind taps, long presses and search highlights
+const NSUInteger HIT_INDEX_CACHE_BYTES = 4 * 1024 * 1024;
+// Touch slop around taps and long presses, in screen points
+const CGFloat HIT_TOLERANCE_POINTS = 8.0f;
+
+@interface RNPDFPdfView() <PDFDocumentDelegate, PDFViewDelegate, PDFMemoryGovernorClient
 #ifdef RCT_NEW_ARCH_ENABLED
 , RCTRNPDFPdfViewViewProtocol
 #endif
@@ -89,12 +104,34 @@ const float MIN_SCALE = 1.0f;
     CFAbsoluteTime _loadStartTime;
     CFAbsoluteTime _loadTime;
     int _pageCount;
-    NSMutableDictionary *_pageCache;
+    NSCache *_pageCache;
+    // Checksum naming this document's pages in PDFPageStore; nil until resolved
+    // off the main thread, and for documents outside the PDF cache
+    NSString *_pageStoreKey;
     NSMutableSet *_preloadedPages;
+    NSMutableDictionary<NSNumber *, NSOperation *> *_preloadOperations;
+    // PdfManager cache reference for file documents, NSNotFound when none is held
+    NSUInteger _documentFileNo;
     NSMutableDictionary *_performanceMetrics;
-    NSMutableDictionary *_searchCache;
+    NSCache *_searchCache;
     NSString *_currentPdfId;
     NSOperationQueue *_preloadQueue;
+    
+    // Incremental search: extracted page text is shared across queries and
+    // every new term bumps the generation, which cancels the running search
+    NSCache *_pageTextCache;
+    dispatch_queue_t _searchQueue;
+    std::atomic<NSUInteger> _searchGeneration;
+    
+    // PDFPageHitIndex by 0-based page index, built when a page is first preloaded or tapped
+    NSCache *_hitIndexCache;
+    // Long-press selection: the page and word it started on
+    PDFPage *_longPressPage;
+    NSRange _longPressAnchor;
+    NSRange _longPressRange;
+    // A link followed from a tap, so PDFView's own link callback does not report it twice
+    NSURL *_lastLinkURL;
+    CFAbsoluteTime _lastLinkTime;
 }
 
 #ifdef RCT_NEW_ARCH_ENABLED
@@ -217,6 +254,7 @@ using namespace facebook::react;
 
     [_pdfView removeFromSuperview];
     _pdfDocument = Nil;
+    [self releaseCachedDocument];
     _pdfView = Nil;
     //Remove notifications
     [[NSNotificationCenter defaultCenter] removeObserver:self name:@"PDFViewDocumentChangedNotification" object:nil];
@@ -301,10 +339,24 @@ using namespace facebook::react;
     _renderQuality = 2; // High quality
 
     // Initialize enhanced features
-    _pageCache = [NSMutableDictionary dictionary];
+    _documentFileNo = NSNotFound;
+    _pageCache = [[NSCache alloc] init];
+    _pageCache.totalCostLimit = (NSUInteger)_cacheSize * 1024;
     _preloadedPages = [NSMutableSet set];
+    _preloadOperations = [NSMutableDictionary dictionary];
     _performanceMetrics = [NSMutableDictionary dictionary];
-    _searchCache = [NSMutableDictionary dictionary];
+    _searchCache = [[NSCache alloc] init];
+    _searchCache.totalCostLimit = SEARCH_CACHE_BYTES;
+    _pageTextCache = [[NSCache alloc] init];
+    _pageTextCache.totalCostLimit = PAGE_TEXT_CACHE_BYTES;
+    _hitIndexCache = [[NSCache alloc] init];
+    _hitIndexCache.totalCostLimit = HIT_INDEX_CACHE_BYTES;
+    _longPressAnchor = NSMakeRange(NSNotFound, 0);
+    _longPressRange = NSMakeRange(NSNotFound, 0);
+    _searchQueue = dispatch_queue_create("org.wonday.pdf.search", DISPATCH_QUEUE_SERIAL);
+    _searchGeneration = 0;
+    // Caps the caches above to this view's share of the global budget
+    [[PDFMemoryGovernor sharedGovernor] registerClient:self];
     
     // Create preload queue
     _preloadQueue = [[NSOperationQueue alloc] init];
@@ -347,6 +399,17 @@ using namespace facebook::react;
 
 - (void)PDFViewWillClickOnLink:(PDFView *)sender withURL:(NSURL *)url
 {
+    [self notifyLinkPressed:url];
+}
+
+- (void)notifyLinkPressed:(NSURL *)url
+{
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    if ([url isEqual:_lastLinkURL] && now - _lastLinkTime < 0.5) {
+        return;
+    }
+    _lastLinkURL = url;
+    _lastLinkTime = now;
     NSString *_url = url.absoluteString;
     [self notifyOnChangeWithMessage:
                      [[NSString alloc] initWithString:
@@ -369,6 +432,7 @@ using namespace facebook::react;
                 //Release old doc
                 _pdfDocument = Nil;
             }
+            [self releaseCachedDocument];
             
             if ([_path hasPrefix:@"blob:"]) {
                 RCTBlobManager *blobManager = [
@@ -386,9 +450,16 @@ using namespace facebook::react;
             } else {
             
                 // decode file path
-                _path = (__bridge_transfer NSString *)CFURLCreateStringByReplacingPercentEscapes(NULL, (CFStringRef)_path, CFSTR(""));
-                NSURL *fileURL = [NSURL fileURLWithPath:_path];
-                _pdfDocument = [[PDFDocument alloc] initWithURL:fileURL];
+                _path = [PdfManager decodedPath:_path];
+                // Shared with other views and PdfManager.loadFile through the document cache
+                NSString *loadError = nil;
+                NSUInteger fileNo = NSNotFound;
+                _pdfDocument = [PdfManager acquireDocumentAtPath:_path password:_password fileNo:&fileNo error:&loadError];
+                if (!_pdfDocument) {
+                    [self notifyOnChangeWithMessage:[NSString stringWithFormat:@"error|%@", loadError]];
+                    return;
+                }
+                _documentFileNo = fileNo;
             }
 
             if (_pdfDocument) {
@@ -403,6 +474,10 @@ using namespace facebook::react;
                 }
 
                 _pdfView.document = _pdfDocument;
+                [self resetDocumentCaches];
+                _currentPdfId = _path;
+                [RNPDFPdfView registerView:self forPdfId:_path];
+                [self resolvePageStoreKey];
             } else {
 
                 [self notifyOnChangeWithMessage:[[NSString alloc] initWithString:[NSString stringWithFormat:@"error|Load pdf failed. path=%s",_path.UTF8String]]];
@@ -624,16 +699,22 @@ using namespace facebook::react;
 }
 
 - (void)dealloc{
+    [[PDFMemoryGovernor sharedGovernor] unregisterClient:self];
     [_preloadQueue cancelAllOperations];
     _preloadQueue = nil;
+    [_preloadOperations removeAllObjects];
     
     // Clear caches
     [_pageCache removeAllObjects];
     [_preloadedPages removeAllObjects];
     [_performanceMetrics removeAllObjects];
     [_searchCache removeAllObjects];
+    [_pageTextCache removeAllObjects];
+    [_hitIndexCache removeAllObjects];
+    _searchGeneration++;
 
     _pdfDocument = Nil;
+    [self releaseCachedDocument];
     _pdfView = Nil;
 
     //Remove notifications
@@ -879,6 +960,21 @@ using namespace facebook::react;
     PDFPage *pdfPage = [_pdfView pageForPoint:point nearest:NO];
     if (pdfPage) {
         unsigned long page = [_pdfDocument indexForPage:pdfPage];
+        _pdfView.currentSelection = nil;
+
+        // The built-in tap recognizers are disabled, so links are followed from the page's hit index
+        PDFPageHitIndex *hitIndex = [RNPDFPdfView hitIndexForPage:pdfPage index:page cache:_hitIndexCache];
+        PDFPageHitLink *link = [hitIndex linkAtPoint:[self pagePointForViewPoint:point page:pdfPage]
+                                           tolerance:[self hitTolerance]];
+        if (link.URL) {
+            [self notifyLinkPressed:link.URL];
+        } else if (link && link.pageIndex != NSNotFound) {
+            PDFPage *target = [_pdfDocument pageAtIndex:link.pageIndex];
+            if (target) {
+                [_pdfView goToPage:target];
+            }
+        }
+
         [self notifyOnChangeWithMessage:
          [[NSString alloc] initWithString:[NSString stringWithFormat:@"pageSingleTap|%lu|%f|%f", page+1, point.x, point.y]]];
     }
@@ -900,12 +996,78 @@ using namespace facebook::react;
 }
 
 /**
- *  Do nothing on long Press
- *
+ *  Long press
+ *  selects the word under the finger, extends by word while dragging and
+ *  reports the selected text when lifted
  *
+ *  @param recognizer
  */
 - (void)handleLongPress:(UILongPressGestureRecognizer *)sender{
+    CGPoint point = [sender locationInView:self];
+    switch (sender.state) {
+        case UIGestureRecognizerStateBegan: {
+            _longPressPage = [_pdfView pageForPoint:point nearest:NO];
+            _longPressAnchor = NSMakeRange(NSNotFound, 0);
+            _longPressRange = _longPressAnchor;
+            if (!_longPressPage) {
+                return;
+            }
+            NSUInteger pageIndex = [_pdfDocument indexForPage:_longPressPage];
+            PDFPageHitIndex *hitIndex = [RNPDFPdfView hitIndexForPage:_longPressPage index:pageIndex cache:_hitIndexCache];
+            _longPressAnchor = [hitIndex wordRangeAtPoint:[self pagePointForViewPoint:point page:_longPressPage]
+                                                tolerance:[self hitTolerance]];
+            _longPressRange = _longPressAnchor;
+            break;
+        }
+        case UIGestureRecognizerStateChanged: {
+            if (!_longPressPage || _longPressAnchor.location == NSNotFound) {
+                return;
+            }
+            NSUInteger pageIndex = [_pdfDocument indexForPage:_longPressPage];
+            PDFPageHitIndex *hitIndex = [RNPDFPdfView hitIndexForPage:_longPressPage index:pageIndex cache:_hitIndexCache];
+            NSRange word = [hitIndex wordRangeAtPoint:[self pagePointForViewPoint:point page:_longPressPage]
+                                            tolerance:[self hitTolerance]];
+            if (word.location == NSNotFound || NSEqualRanges(NSUnionRange(_longPressAnchor, word), _longPressRange)) {
+                return;
+            }
+            _longPressRange = NSUnionRange(_longPressAnchor, word);
+            break;
+        }
+        case UIGestureRecognizerStateEnded: {
+            if (!_longPressPage) {
+                return;
+            }
+            unsigned long page = [_pdfDocument indexForPage:_longPressPage];
+            NSString *text = @"";
+            if (_longPressRange.location != NSNotFound) {
+                NSString *pageText = _longPressPage.string ?: @"";
+                if (NSMaxRange(_longPressRange) <= pageText.length) {
+                    text = [pageText substringWithRange:_longPressRange];
+                }
+            }
+            _longPressPage = nil;
+            // Text last: it may contain the message separator
+            [self notifyOnChangeWithMessage:
+             [NSString stringWithFormat:@"pageLongPress|%lu|%f|%f|%@", page + 1, point.x, point.y, text]];
+            return;
+        }
+        default:
+            _longPressPage = nil;
+            _pdfView.currentSelection = nil;
+            return;
+    }
+    _pdfView.currentSelection = _longPressRange.location == NSNotFound ? nil : [_longPressPage selectionForRange:_longPressRange];
+}
 
+// Touch slop in page points at the current zoom
+- (CGFloat)hitTolerance
+{
+    return HIT_TOLERANCE_POINTS / MAX(_pdfView.scaleFactor, (CGFloat)0.01);
+}
+
+- (CGPoint)pagePointForViewPoint:(CGPoint)point page:(PDFPage *)page
+{
+    return [_pdfView convertPoint:[self convertPoint:point toView:_pdfView] toPage:page];
 }
 
 /**
@@ -999,40 +1161,195 @@ using namespace facebook::react;
     
     int startPage = MAX(1, currentPage - _preloadRadius);
     int endPage = MIN((int)_pdfDocument.pageCount, currentPage + _preloadRadius);
+    [self preloadWindowFrom:startPage to:endPage];
+}
+
+// Rasterizes pages [startPage, endPage] into _pageCache off the main thread and
+// cancels queued renders of pages that left the window
+- (void)preloadWindowFrom:(int)startPage to:(int)endPage
+{
+    for (NSNumber *page in [_preloadOperations allKeys]) {
+        if (page.intValue < startPage || page.intValue > endPage) {
+            [_preloadOperations[page] cancel];
+            [_preloadOperations removeObjectForKey:page];
+        }
+    }
+    for (NSNumber *page in [_preloadedPages allObjects]) {
+        if (page.intValue < startPage || page.intValue > endPage) {
+            [_preloadedPages removeObject:page];
+        }
+    }
+    
+    CGFloat viewWidth = _pdfView.bounds.size.width;
+    if (viewWidth <= 0) {
+        return;
+    }
     
+    // Nearest pages first, the visible one before its neighbours
+    NSMutableArray<NSNumber *> *pages = [NSMutableArray array];
     for (int page = startPage; page <= endPage; page++) {
-        if (![_preloadedPages containsObject:@(page)]) {
-            [_preloadedPages addObject:@(page)];
-            
-            // Add preload operation to queue
-            NSBlockOperation *preloadOp = [NSBlockOperation blockOperationWithBlock:^{
-                // Preload page content (this is a simplified version)
-                // In a real implementation, you might preload page thumbnails or other content
-                RLog(@"Enhanced PDF: Preloading page %d", page);
-            }];
-            
-            [_preloadQueue addOperation:preloadOp];
+        [pages addObject:@(page)];
+    }
+    int currentPage = _page;
+    [pages sortUsingComparator:^NSComparisonResult(NSNumber *a, NSNumber *b) {
+        int da = abs(a.intValue - currentPage);
+        int db = abs(b.intValue - currentPage);
+        return da < db ? NSOrderedAscending : (da > db ? NSOrderedDescending : [a compare:b]);
+    }];
+    
+    PDFDocument *document = _pdfDocument;
+    NSCache *pageCache = _pageCache;
+    NSCache *hitIndexCache = _hitIndexCache;
+    NSString *storeKey = _pageStoreKey;
+    PDFPageStore *pageStore = storeKey ? [PDFPageStore sharedStore] : nil;
+    __weak RNPDFPdfView *weakSelf = self;
+    
+    for (NSNumber *pageNumber in pages) {
+        if (_preloadOperations[pageNumber]) {
+            continue;
+        }
+        PDFPage *page = [document pageAtIndex:pageNumber.intValue - 1];
+        if (!page) {
+            continue;
         }
+        CGSize size = [RNPDFPdfView displaySizeForPage:page width:viewWidth];
+        UIImage *cached = [pageCache objectForKey:pageNumber];
+        if (cached && CGSizeEqualToSize(cached.size, size)) {
+            [_preloadedPages addObject:pageNumber];
+            continue;
+        }
+        
+        NSBlockOperation *preloadOp = [[NSBlockOperation alloc] init];
+        __weak NSBlockOperation *weakOp = preloadOp;
+        [preloadOp addExecutionBlock:^{
+            if (weakOp.isCancelled) {
+                return;
+            }
+            // Pages rendered in an earlier launch decode from disk instead
+            UIImage *image = [pageStore imageForDocumentKey:storeKey page:pageNumber.intValue size:size];
+            if (!image) {
+                PDFTraceInterval trace = PDFTraceBegin(PDFTraceMetricRender);
+                image = [page thumbnailOfSize:size forBox:kPDFDisplayBoxCropBox];
+                PDFTraceEnd(trace);
+                if (image) {
+                    [pageStore storeImage:image forDocumentKey:storeKey page:pageNumber.intValue size:size];
+                }
+            }
+            if (!image || weakOp.isCancelled) {
+                return;
+            }
+            NSUInteger cost = (NSUInteger)(image.size.width * image.scale * image.size.height * image.scale * 4);
+            [pageCache setObject:image forKey:pageNumber cost:cost];
+            // Index the page while it is about to be shown, so the first tap on it is a lookup
+            if (!weakOp.isCancelled) {
+                [RNPDFPdfView hitIndexForPage:page index:pageNumber.intValue - 1 cache:hitIndexCache];
+            }
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                RNPDFPdfView *view = weakSelf;
+                NSBlockOperation *op = weakOp;
+                if (view && op && view->_preloadOperations[pageNumber] == op) {
+                    [view->_preloadOperations removeObjectForKey:pageNumber];
+                    [view->_preloadedPages addObject:pageNumber];
+                }
+            });
+        }];
+        preloadOp.queuePriority = [pageNumber intValue] == currentPage ? NSOperationQueuePriorityHigh : NSOperationQueuePriorityNormal;
+        _preloadOperations[pageNumber] = preloadOp;
+        [_preloadQueue addOperation:preloadOp];
+    }
+}
+
+// Size a page is displayed at when fitted to width (in points, rotation applied)
++ (CGSize)displaySizeForPage:(PDFPage *)page width:(CGFloat)width
+{
+    CGRect bounds = [page boundsForBox:kPDFDisplayBoxCropBox];
+    BOOL rotated = page.rotation % 180 != 0;
+    CGFloat pageWidth = rotated ? bounds.size.height : bounds.size.width;
+    CGFloat pageHeight = rotated ? bounds.size.width : bounds.size.height;
+    if (pageWidth <= 0 || pageHeight <= 0) {
+        return CGSizeMake(width, width);
     }
+    return CGSizeMake(floor(width), floor(width * pageHeight / pageWidth));
+}
+
+// Pre-rendered image of a page (1-based), if it is still cached
+- (UIImage *)cachedImageForPage:(int)pageNumber
+{
+    return [_pageCache objectForKey:@(pageNumber)];
 }
 
 - (NSDictionary *)getPerformanceMetrics
 {
     NSMutableDictionary *metrics = [_performanceMetrics mutableCopy];
-    metrics[@"cacheHitCount"] = @([_pageCache count]);
+    metrics[@"cacheHitCount"] = @([_preloadedPages count]);
     metrics[@"preloadedPages"] = @([_preloadedPages count]);
+    metrics[@"pendingPreloads"] = @([_preloadOperations count]);
     metrics[@"cacheSize"] = @(_cacheSize);
     return metrics;
 }
 
 - (void)clearCache
 {
+    [self cancelPreloads];
     [_pageCache removeAllObjects];
     [_preloadedPages removeAllObjects];
     [_searchCache removeAllObjects];
+    [_pageTextCache removeAllObjects];
+    [_hitIndexCache removeAllObjects];
     RLog(@"Enhanced PDF: Cache cleared");
 }
 
+- (void)memoryGovernorDidAssignPageBudget:(NSUInteger)pageBytes textBudget:(NSUInteger)textBytes
+{
+    // The share only ever lowers the view's own limits
+    NSUInteger searchBytes = MIN(SEARCH_CACHE_BYTES, textBytes / 5);
+    NSUInteger hitIndexBytes = MIN(HIT_INDEX_CACHE_BYTES, textBytes / 4);
+    _pageCache.totalCostLimit = MIN((NSUInteger)_cacheSize * 1024, pageBytes);
+    _searchCache.totalCostLimit = searchBytes;
+    _hitIndexCache.totalCostLimit = hitIndexBytes;
+    _pageTextCache.totalCostLimit = MIN(PAGE_TEXT_CACHE_BYTES, textBytes - searchBytes - hitIndexBytes);
+}
+
+// Sheds in steps: search results and far pages first, the visible page only
+// when nothing else is left, so a warning does not blank the screen
+- (void)memoryGovernorShedForPressure:(PDFMemoryPressure)pressure
+{
+    [_searchCache removeAllObjects];
+    if (pressure >= PDFMemoryPressureLow) {
+        [_pageTextCache removeAllObjects];
+        // The visible page keeps its boxes so taps on it stay lookups
+        NSNumber *visible = @(_page - 1);
+        PDFPageHitIndex *current = [_hitIndexCache objectForKey:visible];
+        [_hitIndexCache removeAllObjects];
+        if (current) {
+            [_hitIndexCache setObject:current forKey:visible cost:current.byteSize];
+        }
+    }
+    int keep = pressure >= PDFMemoryPressureCritical ? 0 : (pressure == PDFMemoryPressureLow ? 1 : _preloadRadius);
+    [self evictPagesFartherThan:keep];
+    DLog(@"Enhanced PDF: Shed memory for pressure %ld, kept pages within %d of %d", (long)pressure, keep, _page);
+}
+
+// Drops cached and queued page images more than distance pages from the current page
+- (void)evictPagesFartherThan:(int)distance
+{
+    int currentPage = _page;
+    for (NSNumber *page in [_preloadOperations allKeys]) {
+        if (abs(page.intValue - currentPage) > distance) {
+            [_preloadOperations[page] cancel];
+            [_preloadOperations removeObjectForKey:page];
+        }
+    }
+    int pageCount = (int)_pdfDocument.pageCount;
+    for (int page = 1; page <= pageCount; page++) {
+        if (abs(page - currentPage) > distance) {
+            [_pageCache removeObjectForKey:@(page)];
+            [_preloadedPages removeObject:@(page)];
+        }
+    }
+}
+
 - (void)preloadPagesFrom:(int)startPage to:(int)endPage
 {
     if (!_enablePreloading || !_pdfDocument) {
@@ -1041,65 +1358,359 @@ using namespace facebook::react;
     
     int actualStartPage = MAX(1, startPage);
     int actualEndPage = MIN((int)_pdfDocument.pageCount, endPage);
-    
-    for (int page = actualStartPage; page <= actualEndPage; page++) {
-        if (![_preloadedPages containsObject:@(page)]) {
-            [_preloadedPages addObject:@(page)];
-            RLog(@"Enhanced PDF: Preloading page %d", page);
+    if (actualStartPage > actualEndPage) {
+        return;
+    }
+    RLog(@"Enhanced PDF: Preloading pages %d-%d", actualStartPage, actualEndPage);
+    [self preloadWindowFrom:actualStartPage to:actualEndPage];
+}
+
+- (void)cancelPreloads
+{
+    for (NSOperation *operation in [_preloadOperations allValues]) {
+        [operation cancel];
+    }
+    [_preloadOperations removeAllObjects];
+    [_preloadedPages removeAllObjects];
+}
+
+#pragma mark search
+
+// Views by pdfId (their path), so module methods can reach the view showing a document
++ (NSMapTable<NSString *, RNPDFPdfView *> *)viewsByPdfId
+{
+    static NSMapTable *views;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        views = [NSMapTable strongToWeakObjectsMapTable];
+    });
+    return views;
+}
+
++ (void)registerView:(RNPDFPdfView *)view forPdfId:(NSString *)pdfId
+{
+    if (pdfId.length > 0) {
+        [[self viewsByPdfId] setObject:view forKey:pdfId];
+    }
+}
+
++ (RNPDFPdfView *)viewForPdfId:(NSString *)pdfId
+{
+    RNPDFPdfView *view = [[self viewsByPdfId] objectForKey:pdfId];
+    if (!view) {
+        // The view stores its path percent-decoded
+        NSString *decoded = [pdfId stringByRemovingPercentEncoding];
+        if (decoded) {
+            view = [[self viewsByPdfId] objectForKey:decoded];
         }
     }
+    return view;
 }
 
-- (NSDictionary *)searchText:(NSString *)searchTerm
+- (void)releaseCachedDocument
+{
+    if (_documentFileNo != NSNotFound) {
+        [PdfManager releasePdf:_documentFileNo];
+        _documentFileNo = NSNotFound;
+    }
+}
+
+// Looks up (or computes once) the cached file's checksum; preloads scheduled
+// after it resolves read pages from, and write them to, PDFPageStore
+- (void)resolvePageStoreKey
+{
+    NSString *path = _path;
+    if (![PDFPageStore sharedStore].enabled || path.length == 0) {
+        return;
+    }
+    __weak RNPDFPdfView *weakSelf = self;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        NSString *key = [[PDFNativeCacheManager sharedInstance] pageStoreKeyForPath:path];
+        if (!key) {
+            return;
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            RNPDFPdfView *view = weakSelf;
+            if (view && [view->_currentPdfId isEqualToString:path]) {
+                view->_pageStoreKey = key;
+            }
+        });
+    });
+}
+
+- (void)resetDocumentCaches
+{
+    _pageStoreKey = nil;
+    _searchGeneration++;
+    [_searchCache removeAllObjects];
+    [_pageTextCache removeAllObjects];
+    [_hitIndexCache removeAllObjects];
+    _longPressPage = nil;
+    [self cancelPreloads];
+    [_pageCache removeAllObjects];
+}
+
+// Page text, extracted once per page and shared by every query (safe off the main thread)
++ (NSString *)textForPage:(PDFPage *)page index:(NSUInteger)pageIndex cache:(NSCache *)cache
+{
+    NSString *text = [cache objectForKey:@(pageIndex)];
+    if (!text) {
+        text = page.string ?: @"";
+        [cache setObject:text forKey:@(pageIndex) cost:text.length * sizeof(unichar)];
+    }
+    return text;
+}
+
+// Glyph, word and link boxes of a page, built once and shared by taps and search (safe off the main thread)
++ (PDFPageHitIndex *)hitIndexForPage:(PDFPage *)page index:(NSUInteger)pageIndex cache:(NSCache *)cache
 {
+    PDFPageHitIndex *index = [cache objectForKey:@(pageIndex)];
+    if (!index && page) {
+        index = [PDFPageHitIndex indexForPage:page];
+        [cache setObject:index forKey:@(pageIndex) cost:index.byteSize];
+    }
+    return index;
+}
+
+// Every match on a page as [x, y, width, height] in page coordinates; boxes
+// come from the page's hit index when it is built, else from PDFKit selections
++ (NSArray<NSArray<NSNumber *> *> *)matchRectsForTerm:(NSString *)searchTerm
+                                                 page:(PDFPage *)page
+                                                 text:(NSString *)text
+                                             hitIndex:(PDFPageHitIndex *)hitIndex
+{
+    if (hitIndex && ![hitIndex.text isEqualToString:text]) {
+        hitIndex = nil;
+    }
+    NSMutableArray *rects = [NSMutableArray array];
+    NSStringCompareOptions options = NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch;
+    NSRange searchRange = NSMakeRange(0, text.length);
+    while (searchRange.length > 0) {
+        NSRange match = [text rangeOfString:searchTerm options:options range:searchRange];
+        if (match.location == NSNotFound) {
+            break;
+        }
+        CGRect bounds = hitIndex ? [hitIndex boundsForRange:match] : CGRectNull;
+        if (CGRectIsNull(bounds)) {
+            PDFSelection *selection = [page selectionForRange:match];
+            bounds = selection ? [selection boundsForPage:page] : CGRectZero;
+        }
+        [rects addObject:@[@(bounds.origin.x), @(bounds.origin.y), @(bounds.size.width), @(bounds.size.height)]];
+
+        NSUInteger next = NSMaxRange(match);
+        searchRange = NSMakeRange(next, text.length - next);
+    }
+    return rects;
+}
+
+- (void)notifySearchResult:(NSDictionary *)pageResult term:(NSString *)searchTerm
+{
+    NSData *rectsJson = [NSJSONSerialization dataWithJSONObject:pageResult[@"rects"] options:0 error:nil];
+    NSString *rects = rectsJson ? [[NSString alloc] initWithData:rectsJson encoding:NSUTF8StringEncoding] : @"[]";
+    [self notifyOnChangeWithMessage:[NSString stringWithFormat:@"searchResult|%@|%lu|%@|%@",
+                                     pageResult[@"page"], (unsigned long)[pageResult[@"rects"] count], rects, searchTerm]];
+}
+
+- (void)notifySearchComplete:(NSString *)searchTerm matches:(int)totalMatches pages:(int)pagesSearched cached:(BOOL)cached
+{
+    [self notifyOnChangeWithMessage:[NSString stringWithFormat:@"searchComplete|%d|%d|%d|%@",
+                                     totalMatches, pagesSearched, cached ? 1 : 0, searchTerm]];
+}
+
+- (void)startSearch:(NSString *)searchTerm
+{
+    NSUInteger generation = ++_searchGeneration;
     if (!searchTerm || searchTerm.length == 0 || !_pdfDocument) {
-        return @{@"totalMatches": @0, @"results": @[]};
+        [self notifySearchComplete:searchTerm ?: @"" matches:0 pages:0 cached:NO];
+        return;
     }
-    
-    // Check cache first
-    NSString *cacheKey = [NSString stringWithFormat:@"%@_%@", _currentPdfId, searchTerm];
-    if (_searchCache[cacheKey]) {
+
+    // Replay a finished search for the same term without touching the document
+    NSString *cacheKey = searchTerm.lowercaseString;
+    NSDictionary *cached = [_searchCache objectForKey:cacheKey];
+    if (cached) {
         RLog(@"Enhanced PDF: Search cache hit for '%@'", searchTerm);
-        return _searchCache[cacheKey];
+        for (NSDictionary *pageResult in cached[@"results"]) {
+            [self notifySearchResult:pageResult term:searchTerm];
+        }
+        [self notifySearchComplete:searchTerm matches:[cached[@"totalMatches"] intValue]
+                             pages:[cached[@"pagesSearched"] intValue] cached:YES];
+        return;
+    }
+
+    PDFDocument *document = _pdfDocument;
+    NSCache *pageTextCache = _pageTextCache;
+    NSCache *hitIndexCache = _hitIndexCache;
+    NSUInteger pageCount = document.pageCount;
+    // Start at the visible page so the nearest hits arrive first, then wrap around
+    NSUInteger firstIndex = (_page >= 1 && (NSUInteger)_page <= pageCount) ? (NSUInteger)(_page - 1) : 0;
+    __weak RNPDFPdfView *weakSelf = self;
+
+    dispatch_async(_searchQueue, ^{
+        PDFTraceInterval trace = PDFTraceBegin(PDFTraceMetricSearch);
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        NSMutableArray *results = [NSMutableArray array];
+        int totalMatches = 0;
+        int pagesSearched = 0;
+        NSUInteger cost = 0;
+
+        for (NSUInteger step = 0; step < pageCount; step++) {
+            RNPDFPdfView *strongSelf = weakSelf;
+            if (!strongSelf || strongSelf->_searchGeneration != generation) {
+                return;
+            }
+            strongSelf = nil;
+
+            @autoreleasepool {
+                NSUInteger pageIndex = (firstIndex + step) % pageCount;
+                PDFPage *page = [document pageAtIndex:pageIndex];
+                if (!page) {
+                    continue;
+                }
+                NSString *text = [RNPDFPdfView textForPage:page index:pageIndex cache:pageTextCache];
+                NSArray *rects = [RNPDFPdfView matchRectsForTerm:searchTerm page:page text:text
+                                                        hitIndex:[hitIndexCache objectForKey:@(pageIndex)]];
+                pagesSearched++;
+                if (rects.count == 0) {
+                    continue;
+                }
+
+                NSDictionary *pageResult = @{@"page": @(pageIndex + 1), @"rects": rects};
+                [results addObject:pageResult];
+                totalMatches += (int)rects.count;
+                cost += 64 + rects.count * 48;
+
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    RNPDFPdfView *view = weakSelf;
+                    if (view && view->_searchGeneration == generation) {
+                        [view notifySearchResult:pageResult term:searchTerm];
+                    }
+                });
+            }
+        }
+
+        NSDictionary *searchResults = @{
+            @"totalMatches": @(totalMatches),
+            @"pagesSearched": @(pagesSearched),
+            @"results": results
+        };
+        double elapsedMs = (CFAbsoluteTimeGetCurrent() - start) * 1000.0;
+        PDFTraceEnd(trace);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            RNPDFPdfView *view = weakSelf;
+            if (!view || view->_searchGeneration != generation) {
+                return;
+            }
+            [view->_searchCache setObject:searchResults forKey:cacheKey cost:cost];
+            RLog(@"Enhanced PDF: Search completed for '%@', %d matches on %lu pages in %.1fms",
+                 searchTerm, totalMatches, (unsigned long)results.count, elapsedMs);
+            [view notifySearchComplete:searchTerm matches:totalMatches pages:pagesSearched cached:NO];
+        });
+    });
+}
+
+- (void)cancelSearch
+{
+    _searchGeneration++;
+}
+
+#pragma mark hit testing
+
++ (NSDictionary *)dictionaryForRect:(CGRect)rect
+{
+    if (CGRectIsNull(rect)) {
+        rect = CGRectZero;
+    }
+    return @{@"left": @(CGRectGetMinX(rect)), @"top": @(CGRectGetMaxY(rect)),
+             @"right": @(CGRectGetMaxX(rect)), @"bottom": @(CGRectGetMinY(rect))};
+}
+
+- (NSDictionary *)hitTestPage:(int)pageNumber point:(CGPoint)point tolerance:(CGFloat)tolerance
+{
+    PDFPage *page = pageNumber >= 1 ? [_pdfDocument pageAtIndex:pageNumber - 1] : nil;
+    if (!page) {
+        return nil;
+    }
+    PDFPageHitIndex *hitIndex = [RNPDFPdfView hitIndexForPage:page index:pageNumber - 1 cache:_hitIndexCache];
+    NSMutableDictionary *result = [NSMutableDictionary dictionaryWithDictionary:@{@"type": @"none", @"page": @(pageNumber)}];
+
+    PDFPageHitLink *link = [hitIndex linkAtPoint:point tolerance:tolerance];
+    NSRange range = NSMakeRange(NSNotFound, 0);
+    if (link) {
+        result[@"type"] = @"link";
+        result[@"targetPage"] = @(link.pageIndex == NSNotFound ? 0 : link.pageIndex + 1);
+        result[@"uri"] = link.URL.absoluteString ?: @"";
+        [result addEntriesFromDictionary:[RNPDFPdfView dictionaryForRect:link.bounds]];
+        // The link's text is the words at its two ends
+        CGRect bounds = link.bounds;
+        range = [hitIndex rangeFromPoint:CGPointMake(CGRectGetMinX(bounds), CGRectGetMidY(bounds))
+                                 toPoint:CGPointMake(CGRectGetMaxX(bounds), CGRectGetMidY(bounds))
+                               tolerance:CGRectGetHeight(bounds) / 2];
+    } else {
+        range = [hitIndex wordRangeAtPoint:point tolerance:tolerance];
+        if (range.location != NSNotFound) {
+            result[@"type"] = @"word";
+            [result addEntriesFromDictionary:[RNPDFPdfView dictionaryForRect:[hitIndex boundsForRange:range]]];
+        }
+    }
+    if (range.location != NSNotFound || link) {
+        BOOL found = range.location != NSNotFound;
+        result[@"offset"] = @(found ? range.location : 0);
+        result[@"length"] = @(found ? range.length : 0);
+        result[@"text"] = found ? [hitIndex.text substringWithRange:range] : @"";
+    }
+    return result;
+}
+
+- (NSDictionary *)selectTextOnPage:(int)pageNumber from:(CGPoint)start to:(CGPoint)end tolerance:(CGFloat)tolerance
+{
+    PDFPage *page = pageNumber >= 1 ? [_pdfDocument pageAtIndex:pageNumber - 1] : nil;
+    if (!page) {
+        return nil;
+    }
+    PDFPageHitIndex *hitIndex = [RNPDFPdfView hitIndexForPage:page index:pageNumber - 1 cache:_hitIndexCache];
+    NSRange range = [hitIndex rangeFromPoint:start toPoint:end tolerance:tolerance];
+    if (range.location == NSNotFound) {
+        return @{@"page": @(pageNumber), @"offset": @0, @"length": @0, @"text": @"", @"rects": @[]};
+    }
+    NSMutableArray *rects = [NSMutableArray array];
+    for (NSValue *bounds in [hitIndex wordBoundsForRange:range]) {
+        [rects addObject:[RNPDFPdfView dictionaryForRect:bounds.CGRectValue]];
+    }
+    return @{@"page": @(pageNumber), @"offset": @(range.location), @"length": @(range.length),
+             @"text": [hitIndex.text substringWithRange:range], @"rects": rects};
+}
+
+- (NSDictionary *)searchText:(NSString *)searchTerm
+{
+    if (!searchTerm || searchTerm.length == 0 || !_pdfDocument) {
+        return @{@"totalMatches": @0, @"results": @[]};
     }
     
     NSMutableArray *results = [NSMutableArray array];
     int totalMatches = 0;
     
-    for (int pageIndex = 0; pageIndex < _pdfDocument.pageCount; pageIndex++) {
-        PDFPage *page = [_pdfDocument pageAtIndex:pageIndex];
-        
-        // Get the page bounds
-        CGRect pageBounds = [page boundsForBox:kPDFDisplayBoxCropBox];
-        
-        // Search for text in the page
-        PDFSelection *selection = [page selectionForRange:NSMakeRange(0, page.string.length)];
-        if (selection && selection.string.length > 0) {
-            NSString *text = selection.string;
-            if ([text localizedCaseInsensitiveContainsString:searchTerm]) {
-                // Get the bounds of the selection
-                CGRect selectionBounds = [selection boundsForPage:page];
-                
+    for (NSUInteger pageIndex = 0; pageIndex < _pdfDocument.pageCount; pageIndex++) {
+        @autoreleasepool {
+            PDFPage *page = [_pdfDocument pageAtIndex:pageIndex];
+            NSString *text = [RNPDFPdfView textForPage:page index:pageIndex cache:_pageTextCache];
+            PDFPageHitIndex *hitIndex = [_hitIndexCache objectForKey:@(pageIndex)];
+            for (NSArray<NSNumber *> *rect in [RNPDFPdfView matchRectsForTerm:searchTerm page:page text:text hitIndex:hitIndex]) {
+                CGRect bounds = CGRectMake(rect[0].doubleValue, rect[1].doubleValue, rect[2].doubleValue, rect[3].doubleValue);
                 [results addObject:@{
                     @"page": @(pageIndex + 1),
-                    @"text": text,
-                    @"rect": NSStringFromCGRect(selectionBounds)
+                    @"rect": NSStringFromCGRect(bounds)
                 }];
                 totalMatches++;
             }
         }
     }
     
-    NSDictionary *searchResults = @{
+    RLog(@"Enhanced PDF: Search completed for '%@', found %d matches", searchTerm, totalMatches);
+    return @{
         @"totalMatches": @(totalMatches),
         @"results": results
     };
-    
-    // Cache the results
-    _searchCache[cacheKey] = searchResults;
-    
-    RLog(@"Enhanced PDF: Search completed for '%@', found %d matches", searchTerm, totalMatches);
-    return searchResults;
 }
 
 @end
@@ -188,6 +188,84 @@ RCT_EXPORT_METHOD(searchTextDirect:(NSString *)pdfId
     }
 }
 
+// Incremental search in the view showing pdfId; hits arrive through onSearchResult/onSearchComplete
+RCT_EXPORT_METHOD(startSearch:(NSString *)pdfId
+                  searchTerm:(NSString *)searchTerm
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject)
+{
+    dispatch_async(dispatch_get_main_queue(), ^{
+        RNPDFPdfView *view = [RNPDFPdfView viewForPdfId:pdfId];
+        if (!view) {
+            reject(@"VIEW_NOT_FOUND", [NSString stringWithFormat:@"No PDF view showing %@", pdfId], nil);
+            return;
+        }
+        [view startSearch:searchTerm];
+        resolve(@YES);
+    });
+}
+
+RCT_EXPORT_METHOD(cancelSearch:(NSString *)pdfId
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject)
+{
+    dispatch_async(dispatch_get_main_queue(), ^{
+        RNPDFPdfView *view = [RNPDFPdfView viewForPdfId:pdfId];
+        [view cancelSearch];
+        resolve(view ? @YES : @NO);
+    });
+}
+
+// Point and range lookups in the hit index of a page shown by pdfId's view (page coordinates)
+RCT_EXPORT_METHOD(hitTest:(NSString *)pdfId
+                  pageNumber:(int)pageNumber
+                  x:(double)x
+                  y:(double)y
+                  tolerance:(double)tolerance
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject)
+{
+    dispatch_async(dispatch_get_main_queue(), ^{
+        RNPDFPdfView *view = [RNPDFPdfView viewForPdfId:pdfId];
+        if (!view) {
+            reject(@"VIEW_NOT_FOUND", [NSString stringWithFormat:@"No PDF view showing %@", pdfId], nil);
+            return;
+        }
+        NSDictionary *hit = [view hitTestPage:pageNumber point:CGPointMake(x, y) tolerance:tolerance];
+        if (!hit) {
+            reject(@"HIT_TEST_ERROR", [NSString stringWithFormat:@"Invalid page number: %d", pageNumber], nil);
+            return;
+        }
+        resolve(hit);
+    });
+}
+
+RCT_EXPORT_METHOD(selectText:(NSString *)pdfId
+                  pageNumber:(int)pageNumber
+                  startX:(double)startX
+                  startY:(double)startY
+                  endX:(double)endX
+                  endY:(double)endY
+                  tolerance:(double)tolerance
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject)
+{
+    dispatch_async(dispatch_get_main_queue(), ^{
+        RNPDFPdfView *view = [RNPDFPdfView viewForPdfId:pdfId];
+        if (!view) {
+            reject(@"VIEW_NOT_FOUND", [NSString stringWithFormat:@"No PDF view showing %@", pdfId], nil);
+            return;
+        }
+        NSDictionary *selection = [view selectTextOnPage:pageNumber from:CGPointMake(startX, startY)
+                                                      to:CGPointMake(endX, endY) tolerance:tolerance];
+        if (!selection) {
+            reject(@"SELECT_TEXT_ERROR", [NSString stringWithFormat:@"Invalid page number: %d", pageNumber], nil);
+            return;
+        }
+        resolve(selection);
+    });
+}
+
 RCT_EXPORT_METHOD(getPerformanceMetricsDirect:(NSString *)pdfId
                   resolver:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject)
@@ -178,6 +178,80 @@ class PDFJSIManager {
         }
     }
     
+    /**
+     * Native JSI bindings (global.__pdfJSI), installed by the Android module on the JS thread
+     * @returns {Object|null} Host object, or null when not installed
+     */
+    getNativeBindings() {
+        return global.__pdfJSI || null;
+    }
+    
+    /**
+     * Render a page and return its pixels without the bridge
+     * OPTIMIZATION: Renders on a native worker thread, so the JS thread stays free;
+     * pixels is an ArrayBuffer (`format` 'rgba8888' premultiplied, or 'rgb565' for
+     * draft renders; `stride` bytes per row) with no string conversion.
+     * The buffer is a copy owned by JS and may be modified.
+     * @param {string} pdfId - PDF identifier
+     * @param {number} pageNumber - Page number to render
+     * @param {number} scale - Render scale factor
+     * @param {number} [quality] - Render quality (1-3); omitted uses the document's
+     * level from setRenderQuality, or draft while setInteracting is active
+     * @returns {Promise<Object>} { success, width, height, stride, format, quality, pixels, cached, renderTimeMs } or { success: false, error }
+     */
+    async renderPagePixels(pdfId, pageNumber, scale, quality = 0) {
+        const bindings = this.getNativeBindings();
+        if (!bindings) {
+            throw new Error('JSI bindings not installed - use renderPageDirect instead');
+        }
+        
+        const timer = new PerformanceTimer().start();
+        const result = await bindings.renderPage(pdfId, pageNumber, scale, quality);
+        
+        this.trackPerformance('renderPagePixels', timer.end(), {
+            pdfId,
+            pageNumber,
+            scale,
+            success: result.success,
+            cached: result.cached
+        });
+        
+        return result;
+    }
+    
+    /**
+     * Open a document once in the shared native registry
+     * Later JSI calls with the same pdfId (and the viewer / exporter, when they
+     * show the same file) reuse it instead of parsing the file again.
+     * @param {string} pdfId - PDF identifier (cache ID or file path)
+     * @param {string} [filePath] - Local file path, when pdfId is not a path or cache ID
+     * @returns {Promise<number>} Page count
+     */
+    async openDocument(pdfId, filePath = null) {
+        if (!this.isJSIAvailable) {
+            throw new Error('JSI not available - falling back to bridge mode');
+        }
+        
+        if (Platform.OS !== 'android') {
+            throw new Error(`openDocument not supported on ${Platform.OS}`);
+        }
+        
+        return PDFJSIManagerNative.openDocument(pdfId, filePath);
+    }
+    
+    /**
+     * Release a document opened with openDocument
+     * @param {string} pdfId - PDF identifier
+     * @returns {Promise<boolean>} Whether the document was open
+     */
+    async closeDocument(pdfId) {
+        if (Platform.OS !== 'android') {
+            return false;
+        }
+        
+        return PDFJSIManagerNative.closeDocument(pdfId);
+    }
+    
     /**
      * Get page metrics via JSI
      * @param {string} pdfId - PDF identifier
@@ -211,14 +285,98 @@ class PDFJSIManager {
         }
     }
     
+    /**
+     * Get metrics for many pages at once (e.g. every row of a layout pass)
+     * OPTIMIZATION: One native call for the whole list. With JSI bindings installed
+     * the result is typed arrays over a single native buffer; otherwise one bridge
+     * call returns plain arrays.
+     * @param {string} pdfId - PDF identifier (opened with openDocument)
+     * @param {number[]|{startPage: number, endPage: number}} pages - Page numbers or an inclusive range
+     * @returns {Promise<Object>} { pages, widths, heights, rotations }, indexed like pages;
+     * pages that are out of range report a width and height of 0
+     */
+    async getPageMetricsBatch(pdfId, pages) {
+        if (!this.isJSIAvailable) {
+            throw new Error('JSI not available - falling back to bridge mode');
+        }
+        
+        const pageNumbers = this.toPageList(pages);
+        const bindings = this.getNativeBindings();
+        if (bindings && bindings.getPageSizes) {
+            const sizes = bindings.getPageSizes(pdfId, pageNumbers);
+            if (!sizes) {
+                throw new Error(`Document not open: ${pdfId}`);
+            }
+            return sizes;
+        }
+        
+        if (Platform.OS === 'android') {
+            return PDFJSIManagerNative.getPageMetricsBatch(pdfId, pageNumbers);
+        }
+        
+        // No batch entry point on this platform: same result shape from per-page calls
+        const metrics = await Promise.all(pageNumbers.map((pageNumber) => this.getPageMetrics(pdfId, pageNumber)));
+        return {
+            pages: pageNumbers,
+            widths: metrics.map((metric) => Number(metric?.width) || 0),
+            heights: metrics.map((metric) => Number(metric?.height) || 0),
+            rotations: metrics.map((metric) => Number(metric?.rotation) || 0)
+        };
+    }
+    
+    /**
+     * Render many pages into the native page cache in one call
+     * @param {string} pdfId - PDF identifier
+     * @param {number[]|{startPage: number, endPage: number}} pages - Page numbers or an inclusive range
+     * @param {number} scale - Render scale factor
+     * @param {number} [quality] - Render quality (1-3); omitted uses the document's level
+     * @returns {Promise<Object>} { pages, success, widths, heights, cached, quality, renderTimeMs } arrays
+     */
+    async renderPagesDirect(pdfId, pages, scale, quality = 0) {
+        if (!this.isJSIAvailable) {
+            throw new Error('JSI not available - falling back to bridge mode');
+        }
+        
+        if (Platform.OS !== 'android') {
+            throw new Error(`renderPagesDirect not supported on ${Platform.OS}`);
+        }
+        
+        const timer = new PerformanceTimer().start();
+        const pageNumbers = this.toPageList(pages);
+        const result = await PDFJSIManagerNative.renderPagesDirect(pdfId, pageNumbers, scale, quality);
+        
+        this.trackPerformance('renderPagesDirect', timer.end(), {
+            pdfId,
+            pageCount: pageNumbers.length,
+            scale
+        });
+        
+        return result;
+    }
+    
+    /**
+     * Page list from an array or an inclusive { startPage, endPage } range
+     */
+    toPageList(pages) {
+        if (Array.isArray(pages)) {
+            return pages;
+        }
+        const pageNumbers = [];
+        for (let page = pages.startPage; page <= pages.endPage; page++) {
+            pageNumbers.push(page);
+        }
+        return pageNumbers;
+    }
+    
     /**
      * Preload pages directly via JSI
      * @param {string} pdfId - PDF identifier
      * @param {number} startPage - Start page number
      * @param {number} endPage - End page number
+     * @param {number} currentPage - Page the user is on; nearer pages are rendered first (defaults to startPage)
      * @returns {Promise<boolean>} Success status
      */
-    async preloadPagesDirect(pdfId, startPage, endPage) {
+    async preloadPagesDirect(pdfId, startPage, endPage, currentPage = startPage) {
         if (!this.isJSIAvailable) {
             throw new Error('JSI not available - falling back to bridge mode');
         }
@@ -231,7 +389,7 @@ class PDFJSIManager {
             
             let success;
             if (Platform.OS === 'android') {
-                success = await PDFJSIManagerNative.preloadPagesDirect(pdfId, startPage, endPage);
+                success = await PDFJSIManagerNative.preloadPagesDirect(pdfId, startPage, endPage, currentPage);
             } else if (Platform.OS === 'ios') {
                 success = await RNPDFPdfViewManager.preloadPagesDirect(pdfId, startPage, endPage);
             } else {
@@ -297,7 +455,8 @@ class PDFJSIManager {
     /**
      * Clear cache directly via JSI
      * @param {string} pdfId - PDF identifier
-     * @param {string} cacheType - Cache type to clear ('all', 'base64', 'bytes')
+     * @param {string} cacheType - Cache type to clear ('all', 'pages', 'text', 'base64', 'bytes',
+     *   or 'stored' for pages persisted on disk, which 'all' keeps)
      * @returns {Promise<boolean>} Success status
      */
     async clearCacheDirect(pdfId, cacheType = 'all') {
@@ -332,6 +491,72 @@ class PDFJSIManager {
         }
     }
     
+    /**
+     * Set the byte budget of the native rendered-page cache
+     * @param {number} budgetBytes - Maximum bytes of cached page bitmaps
+     * @returns {Promise<boolean>} Success status
+     */
+    async setCacheBudget(budgetBytes) {
+        if (!this.isJSIAvailable) {
+            throw new Error('JSI not available - falling back to bridge mode');
+        }
+        
+        if (!(budgetBytes >= 0)) {
+            throw new Error('Cache budget must be a non-negative number of bytes');
+        }
+        
+        if (Platform.OS !== 'android') {
+            throw new Error(`setCacheBudget not supported on ${Platform.OS}`);
+        }
+        
+        console.log(`📱 PDFJSI: Setting page cache budget to ${budgetBytes} bytes`);
+        return PDFJSIManagerNative.setCacheBudget(budgetBytes);
+    }
+    
+    /**
+     * Set the global native memory budget shared by the page cache, bitmap pool,
+     * search index, hit-test index and mapped documents. Memory pressure sheds from it in steps,
+     * pages far from the visible one first.
+     * @param {number} budgetBytes - Total bytes for the native caches
+     * @returns {Promise<boolean>} Success status
+     */
+    async setMemoryBudget(budgetBytes) {
+        if (!(budgetBytes > 0)) {
+            throw new Error('Memory budget must be a positive number of bytes');
+        }
+        
+        if (!PDFJSIManagerNative || (Platform.OS !== 'android' && Platform.OS !== 'ios')) {
+            throw new Error(`setMemoryBudget not supported on ${Platform.OS}`);
+        }
+        
+        console.log(`📱 PDFJSI: Setting memory budget to ${budgetBytes} bytes`);
+        return PDFJSIManagerNative.setMemoryBudget(budgetBytes);
+    }
+    
+    /**
+     * Configure the persistent store of rendered pages kept across app launches
+     * Pages are stored compressed in the app cache directory, keyed by the cached
+     * file's checksum, and evicted least recently used first past the budget.
+     * On Android the store serves the native engine (renderPagePixels, renderPagesDirect,
+     * preloadPagesDirect); the Android <Pdf> view rasterizes with its own renderer and
+     * does not read it. On iOS it also serves the view's page preloads.
+     * @param {boolean} enabled - Whether rendered pages are stored and reused
+     * @param {number} budgetBytes - Maximum bytes on disk (0 for the default)
+     * @returns {Promise<boolean>} Success status
+     */
+    async configurePageStore(enabled = true, budgetBytes = 0) {
+        if (!(budgetBytes >= 0)) {
+            throw new Error('Page store budget must be a non-negative number of bytes');
+        }
+        
+        if (!PDFJSIManagerNative || (Platform.OS !== 'android' && Platform.OS !== 'ios')) {
+            throw new Error(`configurePageStore not supported on ${Platform.OS}`);
+        }
+        
+        console.log(`📱 PDFJSI: ${enabled ? 'Enabling' : 'Disabling'} page store (budget ${budgetBytes} bytes)`);
+        return PDFJSIManagerNative.configurePageStore(!!enabled, budgetBytes);
+    }
+    
     /**
      * Optimize memory via JSI
      * @param {string} pdfId - PDF identifier
@@ -370,7 +595,8 @@ class PDFJSIManager {
      * @param {string} searchTerm - Search term
      * @param {number} startPage - Start page number
      * @param {number} endPage - End page number
-     * @returns {Promise<Array>} Search results
+     * @returns {Promise<Array>} Search results; on Android each hit is
+     *   { page, offset, length, left, top, right, bottom } with the box in PDF points (origin bottom-left)
      */
     async searchTextDirect(pdfId, searchTerm, startPage, endPage) {
         if (!this.isJSIAvailable) {
@@ -414,8 +640,75 @@ class PDFJSIManager {
         }
     }
     
+    /**
+     * Hit-test a point on a page
+     * Pages are indexed (glyph, word and link boxes in a spatial grid) when first
+     * rendered, so a tap resolves without re-reading the page text
+     * @param {string} pdfId - PDF identifier
+     * @param {number} pageNumber - Page number (1-based)
+     * @param {number} x - X in PDF points, origin bottom-left
+     * @param {number} y - Y in PDF points, origin bottom-left
+     * @param {number} tolerance - Slop in points around the point
+     * @returns {Promise<Object>} { type: 'none' | 'word' | 'link', page, offset, length, text,
+     *   left, top, right, bottom, targetPage, uri }
+     */
+    async hitTest(pdfId, pageNumber, x, y, tolerance = 8) {
+        const timer = new PerformanceTimer().start();
+        
+        let hit;
+        if (Platform.OS === 'android') {
+            if (!this.isJSIAvailable) {
+                throw new Error('JSI not available - falling back to bridge mode');
+            }
+            hit = await PDFJSIManagerNative.hitTest(pdfId, pageNumber, x, y, tolerance);
+        } else if (Platform.OS === 'ios') {
+            hit = await RNPDFPdfViewManager.hitTest(pdfId, pageNumber, x, y, tolerance);
+        } else {
+            throw new Error(`hitTest not supported on ${Platform.OS}`);
+        }
+        
+        this.trackPerformance('hitTest', timer.end(), { pdfId, pageNumber, type: hit.type });
+        return hit;
+    }
+    
+    /**
+     * Select the words between two points on a page, as a long press and drag does
+     * @param {string} pdfId - PDF identifier
+     * @param {number} pageNumber - Page number (1-based)
+     * @param {number} startX - Start X in PDF points, origin bottom-left
+     * @param {number} startY - Start Y in PDF points
+     * @param {number} endX - End X in PDF points
+     * @param {number} endY - End Y in PDF points
+     * @param {number} tolerance - Slop in points around each point
+     * @returns {Promise<Object>} { page, offset, length, text, rects: [{ left, top, right, bottom }] }
+     */
+    async selectText(pdfId, pageNumber, startX, startY, endX, endY, tolerance = 8) {
+        const timer = new PerformanceTimer().start();
+        
+        let selection;
+        if (Platform.OS === 'android') {
+            if (!this.isJSIAvailable) {
+                throw new Error('JSI not available - falling back to bridge mode');
+            }
+            selection = await PDFJSIManagerNative.selectText(pdfId, pageNumber, startX, startY, endX, endY, tolerance);
+        } else if (Platform.OS === 'ios') {
+            selection = await RNPDFPdfViewManager.selectText(pdfId, pageNumber, startX, startY, endX, endY, tolerance);
+        } else {
+            throw new Error(`selectText not supported on ${Platform.OS}`);
+        }
+        
+        this.trackPerformance('selectText', timer.end(), { pdfId, pageNumber, length: selection.length });
+        return selection;
+    }
+    
     /**
      * Get performance metrics via JSI
+     * Latency histograms recorded by the native tracing layer: for each
+     * traced operation (render, rasterize, preload, openDocument, search, ...)
+     * `<name>Count`, `<name>AvgMs`, `<name>P50Ms`, `<name>P90Ms`, `<name>P99Ms`,
+     * `<name>MaxMs` and `<name>LastMs`, plus lastRenderTime, avgRenderTime and
+     * memoryUsageMB (and cacheHitRatio for pdfId's pages on Android).
+     * Android reports the values as strings.
      * @param {string} pdfId - PDF identifier
      * @returns {Promise<Object>} Performance metrics
      */
@@ -446,6 +739,73 @@ class PDFJSIManager {
         }
     }
     
+    /**
+     * Generate page thumbnails backed by a persistent on-disk cache
+     * Cached thumbnails resolve without rendering; missing pages render in parallel natively.
+     * @param {string} pdfId - PDF identifier (file path or native cache ID)
+     * @param {Array<number>} pages - Page numbers (starting from 1)
+     * @param {number} maxDimension - Longest side of each thumbnail in pixels
+     * @returns {Promise<Array>} One { page, uri, width, height, cached } (or { page, error }) per page
+     */
+    async generateThumbnails(pdfId, pages, maxDimension = 256) {
+        if (!PDFJSIManagerNative || (Platform.OS !== 'android' && Platform.OS !== 'ios')) {
+            throw new Error(`generateThumbnails not supported on ${Platform.OS}`);
+        }
+        
+        const timer = new PerformanceTimer().start();
+        const thumbnails = await PDFJSIManagerNative.generateThumbnails(pdfId, pages, Math.round(maxDimension));
+        const generateTime = timer.end();
+        
+        this.trackPerformance('generateThumbnails', generateTime, {
+            pdfId,
+            pageCount: pages.length,
+            cachedCount: thumbnails.filter(thumbnail => thumbnail.cached).length
+        });
+        
+        return thumbnails;
+    }
+    
+    /**
+     * Start a progressive download of a remote PDF into a local file
+     * Resolves as soon as the first page can be shown, which for linearized ("fast web view")
+     * files is usually long before the download completes. Use awaitProgressive for the file.
+     * @param {string} url - Remote PDF URL
+     * @param {Object} headers - Extra request headers
+     * @param {string} targetPath - Local file that receives the document
+     * @param {number} previewDimension - Longest side of the first page preview in pixels
+     * @returns {Promise<Object>} { preview: { page, uri, width, height, pageCount } | null }
+     */
+    async openProgressive(url, headers, targetPath, previewDimension = 1024) {
+        if (!PDFJSIManagerNative || !PDFJSIManagerNative.openProgressive) {
+            throw new Error(`openProgressive not supported on ${Platform.OS}`);
+        }
+        return PDFJSIManagerNative.openProgressive(url, headers || {}, targetPath, Math.round(previewDimension));
+    }
+    
+    /**
+     * Wait for a progressive download started with openProgressive
+     * @param {string} targetPath - Local file passed to openProgressive
+     * @returns {Promise<Object>} { path, size }
+     */
+    async awaitProgressive(targetPath) {
+        if (!PDFJSIManagerNative || !PDFJSIManagerNative.awaitProgressive) {
+            throw new Error(`awaitProgressive not supported on ${Platform.OS}`);
+        }
+        return PDFJSIManagerNative.awaitProgressive(targetPath);
+    }
+    
+    /**
+     * Cancel a progressive download; awaitProgressive then rejects
+     * @param {string} targetPath - Local file passed to openProgressive
+     * @returns {Promise<boolean>} Whether a download was running
+     */
+    async cancelProgressive(targetPath) {
+        if (!PDFJSIManagerNative || !PDFJSIManagerNative.cancelProgressive) {
+            return false;
+        }
+        return PDFJSIManagerNative.cancelProgressive(targetPath);
+    }
+    
     /**
      * Set render quality via JSI
      * @param {string} pdfId - PDF identifier
@@ -483,6 +843,25 @@ class PDFJSIManager {
         }
     }
     
+    /**
+     * Mark a fling or pinch-zoom gesture on a document
+     * OPTIMIZATION: document-level JSI renders drop to draft quality (half
+     * resolution, RGB_565) while active, and return to the document's level
+     * when active is false or 500ms after the last call. Call it from scroll
+     * handlers; repeated calls only extend the gesture.
+     * @param {string} pdfId - PDF identifier
+     * @param {boolean} [active] - Whether the gesture is in progress
+     * @returns {boolean} False when the JSI bindings are not installed
+     */
+    setInteracting(pdfId, active = true) {
+        const bindings = this.getNativeBindings();
+        if (!bindings) {
+            return false;
+        }
+        bindings.setInteracting(pdfId, active);
+        return true;
+    }
+    
     /**
      * Get JSI performance statistics
      * @returns {Promise<Object>} JSI stats
@@ -563,7 +942,7 @@ class PDFJSIManager {
             const endPage = totalPages ? Math.min(totalPages, currentPage + preloadRadius) : currentPage + preloadRadius;
             
             // Preload pages in background
-            const preloadResult = await this.preloadPagesDirect(pdfId, startPage, endPage);
+            const preloadResult = await this.preloadPagesDirect(pdfId, startPage, endPage, currentPage);
             
             const lazyLoadTime = timer.end();
             
@@ -822,14 +1201,29 @@ export default pdfJSIManager;
 // Export individual methods for convenience
 export const {
     renderPageDirect,
+    renderPagePixels,
+    openDocument,
+    closeDocument,
     getPageMetrics,
+    getPageMetricsBatch,
+    renderPagesDirect,
     preloadPagesDirect,
     getCacheMetrics,
     clearCacheDirect,
+    setCacheBudget,
+    setMemoryBudget,
+    configurePageStore,
     optimizeMemory,
     searchTextDirect,
+    hitTest,
+    selectText,
     getPerformanceMetrics,
+    generateThumbnails,
+    openProgressive,
+    awaitProgressive,
+    cancelProgressive,
     setRenderQuality,
+    setInteracting,
     getJSIStats,
     getPerformanceHistory,
     clearPerformanceHistory,
@@ -138,10 +138,10 @@ export const usePDFJSI = (options = {}) => {
     /**
      * Preload pages
      */
-    const preloadPages = useCallback(async (pdfId, startPage, endPage) => {
+    const preloadPages = useCallback(async (pdfId, startPage, endPage, currentPage = startPage) => {
         try {
             if (isJSIAvailable) {
-                return await PDFJSI.preloadPagesDirect(pdfId, startPage, endPage);
+                return await PDFJSI.preloadPagesDirect(pdfId, startPage, endPage, currentPage);
             } else {
                 throw new Error('JSI not available');
             }
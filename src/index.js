@@ -18,14 +18,29 @@ export { default as usePDFJSI } from './hooks/usePDFJSI';
 // Re-export individual JSI methods for convenience
 export {
     renderPageDirect,
+    renderPagePixels,
+    openDocument,
+    closeDocument,
     getPageMetrics,
+    getPageMetricsBatch,
+    renderPagesDirect,
     preloadPagesDirect,
     getCacheMetrics,
     clearCacheDirect,
+    setCacheBudget,
+    setMemoryBudget,
+    configurePageStore,
     optimizeMemory,
     searchTextDirect,
+    hitTest,
+    selectText,
     getPerformanceMetrics,
+    generateThumbnails,
+    openProgressive,
+    awaitProgressive,
+    cancelProgressive,
     setRenderQuality,
+    setInteracting,
     getJSIStats,
     getPerformanceHistory,
     clearPerformanceHistory
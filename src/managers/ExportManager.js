@@ -11,12 +11,16 @@
  * @version 1.0.0
  */
 
-import { NativeModules, Platform, Share } from 'react-native';
+import { NativeModules, NativeEventEmitter, Platform, Share } from 'react-native';
 import PDFTextExtractor from '../utils/PDFTextExtractor';
 import licenseManager, { ProFeature } from '../license/LicenseManager';
 
 const { PDFExporter } = NativeModules;
 
+// Per-page PDFExportProgress events of exportToImages
+const exportEvents = PDFExporter ? new NativeEventEmitter(PDFExporter) : null;
+let nextProgressId = 1;
+
 /**
  * Export formats supported
  */
@@ -162,8 +166,12 @@ export class ExportManager {
 
     /**
      * Export PDF pages to images
+     * Pages are rendered in parallel natively and each image is written as soon as
+     * its page finishes
      * @param {string} filePath - Path to PDF file
      * @param {Object} options - Export options
+     * @param {Function} [options.onProgress] - Called per finished page with
+     *   { page, completed, total, path } (path is null when the page failed)
      * @returns {Promise<Array>} Array of image paths
      */
     async exportToImages(filePath, options = {}) {
@@ -176,13 +184,26 @@ export class ExportManager {
             quality = ExportQuality.HIGH,
             width = null, // null = original width
             height = null, // null = original height
-            scale = 2.0 // Scale factor for rendering
+            scale = 2.0, // Scale factor for rendering
+            onProgress = null
         } = options;
 
         console.log('📤 ExportManager: Exporting to images...');
 
+        let subscription = null;
         try {
             if (this.isNativeAvailable) {
+                let progressId;
+                if (typeof onProgress === 'function' && exportEvents) {
+                    progressId = `export_${nextProgressId++}`;
+                    subscription = exportEvents.addListener('PDFExportProgress', (event) => {
+                        if (event.progressId === progressId) {
+                            const { page, completed, total, path } = event;
+                            onProgress({ page, completed, total, path });
+                        }
+                    });
+                }
+
                 // Use native exporter
                 const images = await PDFExporter.exportToImages(filePath, {
                     pages: pages || [],
@@ -190,7 +211,8 @@ export class ExportManager {
                     quality,
                     width,
                     height,
-                    scale
+                    scale,
+                    progressId
                 });
 
                 console.log(`📤 ExportManager: Exported ${images.length} images`);
@@ -204,6 +226,10 @@ export class ExportManager {
         } catch (error) {
             console.error('📤 ExportManager: Export to images error:', error);
             throw error;
+        } finally {
+            if (subscription) {
+                subscription.remove();
+            }
         }
     }
 
@@ -3,6 +3,18 @@
 #if __has_include("RCTPdfControl.g.cpp")
 #include "RCTPdfControl.g.cpp"
 #endif
+#include <chrono>
+
+// ETW events for page renders and document loads; build with PDFJSI_TRACING=0 to drop them
+#ifndef PDFJSI_TRACING
+#define PDFJSI_TRACING 1
+#endif
+#if PDFJSI_TRACING
+#include <TraceLoggingProvider.h>
+// Provider "RCTPdf" {23867270-1656-4c1e-90fb-9cd83adb87a1}, e.g. for WPR/WPA sessions
+TRACELOGGING_DEFINE_PROVIDER(g_rctPdfTraceProvider, "RCTPdf",
+  (0x23867270, 0x1656, 0x4c1e, 0x90, 0xfb, 0x9c, 0xd8, 0x3a, 0xdb, 0x87, 0xa1));
+#endif
 
 using namespace winrt;
 using namespace Windows::UI::Xaml;
@@ -10,6 +22,7 @@ using namespace Microsoft::ReactNative;
 using namespace Windows::Data::Json;
 using namespace Windows::Data::Pdf;
 using namespace Windows::Foundation;
+using namespace Windows::Graphics::Imaging;
 using namespace Windows::Storage;
 using namespace Windows::Storage::Streams;
 using namespace Windows::Storage::Pickers;
@@ -24,30 +37,201 @@ using namespace Windows::UI::Xaml::Media::Imaging;
 
 namespace winrt::RCTPdf::implementation
 {
-  PDFPageInfo::PDFPageInfo(winrt::Windows::UI::Xaml::Controls::Image image, winrt::Windows::Data::Pdf::PdfPage page, double imageScale, double renderScale) :
-    image(image), page(page), imageScale(imageScale), renderScale(renderScale), scaledTopOffset(0), scaledLeftOffset(0) {
-    auto dims = page.Size();
+  namespace {
+    // Streams and bitmaps reused across page renders. XAML bitmaps belong to the UI
+    // thread that created them, hence one pool per thread.
+    struct RenderBufferPool {
+      static constexpr size_t m_maxStreams = 8;
+      static constexpr size_t m_maxBitmaps = 8;
+      std::vector<InMemoryRandomAccessStream> streams;
+      std::vector<WriteableBitmap> bitmaps;
+
+      InMemoryRandomAccessStream takeStream() {
+        if (streams.empty())
+          return InMemoryRandomAccessStream();
+        auto stream = std::move(streams.back());
+        streams.pop_back();
+        stream.Size(0);
+        return stream;
+      }
+      void returnStream(InMemoryRandomAccessStream stream) {
+        if (streams.size() < m_maxStreams)
+          streams.push_back(std::move(stream));
+      }
+      WriteableBitmap takeBitmap(int width, int height) {
+        for (auto it = bitmaps.begin(); it != bitmaps.end(); ++it) {
+          if (it->PixelWidth() == width && it->PixelHeight() == height) {
+            auto bitmap = std::move(*it);
+            bitmaps.erase(it);
+            return bitmap;
+          }
+        }
+        return WriteableBitmap(width, height);
+      }
+      void returnBitmap(WriteableBitmap bitmap) {
+        if (!bitmap)
+          return;
+        if (bitmaps.size() == m_maxBitmaps)
+          bitmaps.erase(bitmaps.begin());
+        bitmaps.push_back(std::move(bitmap));
+      }
+    };
+    thread_local RenderBufferPool t_renderBuffers;
+
+#if PDFJSI_TRACING
+    // Registered on first use, unregistered when the module unloads
+    struct TraceProviderRegistration {
+      TraceProviderRegistration() { TraceLoggingRegister(g_rctPdfTraceProvider); }
+      ~TraceProviderRegistration() { TraceLoggingUnregister(g_rctPdfTraceProvider); }
+    };
+    bool traceEnabled() {
+      static TraceProviderRegistration registration;
+      return TraceLoggingProviderEnabled(g_rctPdfTraceProvider, 0, 0);
+    }
+#endif
+
+    // Page sizes of loaded documents are kept in LocalCacheFolder, one file per document
+    // keyed by its path, size and modification time, so reopening a long document
+    // lays it out without opening every page
+    constexpr wchar_t pageSizesFolderName[] = L"RCTPdfGeometry";
+
+    IAsyncOperation<hstring> pageSizesFileName(StorageFile document) {
+      auto properties = co_await document.GetBasicPropertiesAsync();
+      std::wstring identity = std::wstring(document.Path()) + L"|" + std::to_wstring(properties.Size()) +
+        L"|" + std::to_wstring(properties.DateModified().time_since_epoch().count());
+      co_return winrt::hstring(std::to_wstring(std::hash<std::wstring>{}(identity)) + L".json");
+    }
+
+    // Stored sizes as [width0, height0, width1, ...], null if absent or for another page count
+    IAsyncOperation<JsonArray> readPageSizes(StorageFile document, unsigned pageCount) {
+      try {
+        auto name = co_await pageSizesFileName(document);
+        auto folder = co_await ApplicationData::Current().LocalCacheFolder().CreateFolderAsync(
+          pageSizesFolderName, CreationCollisionOption::OpenIfExists);
+        auto item = co_await folder.TryGetItemAsync(name);
+        if (!item)
+          co_return nullptr;
+        auto text = co_await FileIO::ReadTextAsync(item.as<StorageFile>());
+        JsonObject stored;
+        if (!JsonObject::TryParse(text, stored))
+          co_return nullptr;
+        auto sizes = stored.GetNamedArray(L"sizes", nullptr);
+        if (!sizes || sizes.Size() != 2 * pageCount)
+          co_return nullptr;
+        co_return sizes;
+      }
+      catch (winrt::hresult_error const&) {
+        // No cache folder (e.g. unpackaged apps) or an unreadable file: measure the pages
+        co_return nullptr;
+      }
+    }
+
+    winrt::fire_and_forget writePageSizes(StorageFile document, JsonArray sizes) {
+      try {
+        auto name = co_await pageSizesFileName(document);
+        auto folder = co_await ApplicationData::Current().LocalCacheFolder().CreateFolderAsync(
+          pageSizesFolderName, CreationCollisionOption::OpenIfExists);
+        auto file = co_await folder.CreateFileAsync(name, CreationCollisionOption::ReplaceExisting);
+        JsonObject stored;
+        stored.SetNamedValue(L"sizes", sizes);
+        co_await FileIO::WriteTextAsync(file, stored.Stringify());
+      }
+      catch (winrt::hresult_error const&) {
+      }
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start) {
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+  }
+
+  PDFPageInfo::PDFPageInfo(winrt::Windows::Data::Pdf::PdfPage const& pdfPage, double imageScale, double renderScale) :
+    image(nullptr), page(nullptr), imageScale(imageScale), renderScale(renderScale), displayedScale(0) {
+    auto dims = pdfPage.Size();
     height = (unsigned)dims.Height;
     width = (unsigned)dims.Width;
-    scaledHeight = (unsigned)(height * imageScale);
-    scaledWidth = (unsigned)(width * imageScale);
+  }
+  PDFPageInfo::PDFPageInfo(double width, double height, double imageScale, double renderScale) :
+    height((unsigned)height), width((unsigned)width), imageScale(imageScale), renderScale(renderScale),
+    displayedScale(0), image(nullptr), page(nullptr) {
   }
   PDFPageInfo::PDFPageInfo(const PDFPageInfo& rhs) :
-    height(rhs.height), width(rhs.width), scaledHeight(rhs.scaledHeight), scaledWidth(rhs.scaledWidth),
-    scaledTopOffset(rhs.scaledTopOffset), scaledLeftOffset(rhs.scaledTopOffset), imageScale(rhs.imageScale),
-    renderScale((double)rhs.renderScale), image(rhs.image), page(rhs.page)
+    height(rhs.height), width(rhs.width), imageScale((double)rhs.imageScale),
+    renderScale((double)rhs.renderScale), displayedScale((double)rhs.displayedScale), image(rhs.image), page(rhs.page),
+    shownBitmap(rhs.shownBitmap)
   { }
   PDFPageInfo::PDFPageInfo(PDFPageInfo&& rhs) :
-    height(rhs.height), width(rhs.width), scaledHeight(rhs.scaledHeight), scaledWidth(rhs.scaledWidth),
-    scaledTopOffset(rhs.scaledTopOffset), scaledLeftOffset(rhs.scaledTopOffset), imageScale(rhs.imageScale),
-    renderScale((double)rhs.renderScale), image(std::move(rhs.image)), page(std::move(rhs.page))
+    height(rhs.height), width(rhs.width), imageScale((double)rhs.imageScale),
+    renderScale((double)rhs.renderScale), displayedScale((double)rhs.displayedScale), image(std::move(rhs.image)), page(std::move(rhs.page)),
+    shownBitmap(std::move(rhs.shownBitmap))
   { }
-  unsigned PDFPageInfo::pageVisiblePixels(bool horizontal, double viewportStart, double viewportEnd) const {
+
+  void PDFPagesLayout::reset(std::vector<PDFPageInfo> const& pages, bool reverse) {
+    m_reverse = reverse;
+    // Copies made before keep the previous sizes
+    auto extents = std::make_shared<Extents>();
+    extents->widthPrefix.reserve(pages.size() + 1);
+    extents->heightPrefix.reserve(pages.size() + 1);
+    for (size_t position = 0; position < pages.size(); ++position) {
+      auto const& page = pages[reverse ? pages.size() - 1 - position : position];
+      extents->widthPrefix.push_back(extents->widthPrefix.back() + page.width);
+      extents->heightPrefix.push_back(extents->heightPrefix.back() + page.height);
+      extents->maxWidth = (std::max)(extents->maxWidth, page.width);
+      extents->maxHeight = (std::max)(extents->maxHeight, page.height);
+    }
+    m_extents = std::move(extents);
+  }
+  void PDFPagesLayout::update(double scale, int margins) {
+    m_scale = scale;
+    m_scaledMargin = (unsigned)(scale * margins);
+  }
+  int PDFPagesLayout::pageCount() const {
+    return (int)m_extents->heightPrefix.size() - 1;
+  }
+  int PDFPagesLayout::position(int page) const {
+    return m_reverse ? pageCount() - 1 - page : page;
+  }
+  unsigned PDFPagesLayout::offsetAtPosition(int position, bool horizontal) const {
+    auto const& prefix = horizontal ? m_extents->widthPrefix : m_extents->heightPrefix;
+    return (unsigned)(prefix[position] * m_scale) + (unsigned)position * 2 * m_scaledMargin;
+  }
+  unsigned PDFPagesLayout::pageOffset(int page, bool horizontal) const {
+    return offsetAtPosition(position(page), horizontal);
+  }
+  unsigned PDFPagesLayout::pageSize(int page, bool horizontal) const {
+    // Sizes are differences of the scaled prefix sums, so rounding never accumulates
+    // and the laid out images land exactly on the computed offsets
+    auto const& prefix = horizontal ? m_extents->widthPrefix : m_extents->heightPrefix;
+    int pagePosition = position(page);
+    return (unsigned)(prefix[pagePosition + 1] * m_scale) - (unsigned)(prefix[pagePosition] * m_scale);
+  }
+  unsigned PDFPagesLayout::totalSize(bool horizontal) const {
+    return offsetAtPosition(pageCount(), horizontal);
+  }
+  unsigned PDFPagesLayout::maxPageSize(bool horizontal) const {
+    return (unsigned)std::ceil((horizontal ? m_extents->maxWidth : m_extents->maxHeight) * m_scale);
+  }
+  int PDFPagesLayout::pageAt(double offset, bool horizontal) const {
+    int count = pageCount();
+    if (count == 0)
+      return 0;
+    // First position starting after the offset; the page before it contains the offset
+    int low = 0, high = count;
+    while (low < high) {
+      int middle = low + (high - low) / 2;
+      if ((double)offsetAtPosition(middle, horizontal) <= offset)
+        low = middle + 1;
+      else
+        high = middle;
+    }
+    int found = (std::min)((std::max)(low - 1, 0), count - 1);
+    return m_reverse ? count - 1 - found : found;
+  }
+  unsigned PDFPagesLayout::visiblePixels(int page, bool horizontal, double viewportStart, double viewportEnd) const {
     if (viewportEnd < viewportStart)
       std::swap(viewportStart, viewportEnd);
-    auto pageStart = horizontal ? scaledLeftOffset : scaledTopOffset;
-    auto pageSize = PDFPageInfo::pageSize(horizontal);
-    auto pageEnd = pageStart + pageSize;
+    auto pageStart = pageOffset(page, horizontal);
+    auto pageEnd = pageStart + pageSize(page, horizontal);
     auto uViewportStart = (unsigned)viewportStart;
     auto uViewportEnd = (unsigned)viewportEnd;
     if (pageStart >= uViewportStart && pageStart <= uViewportEnd) { // we see the top edge
@@ -61,10 +245,10 @@ namespace winrt::RCTPdf::implementation
     }
     return 0;
   }
-  unsigned PDFPageInfo::pageSize(bool horizontal) const {
-    return horizontal ? scaledWidth : scaledHeight;
-  }
+
   bool PDFPageInfo::needsRender() const {
+    if (!image || !page)
+      return false;
     double currentRenderScale = renderScale;
     return currentRenderScale < imageScale || currentRenderScale > imageScale * m_downscaleTreshold;
   }
@@ -72,6 +256,12 @@ namespace winrt::RCTPdf::implementation
     return render(imageScale);
   }
   winrt::Windows::Foundation::IAsyncAction PDFPageInfo::render(double useScale) {
+    // Pages outside the virtual window have no image to render into
+    if (!image || !page)
+      co_return;
+    // The page may be released (and its image recycled) while rendering
+    auto pdfPage = page;
+    auto pageImage = image;
     double currentRenderScale;
     while (true) {
       currentRenderScale = renderScale;
@@ -82,20 +272,84 @@ namespace winrt::RCTPdf::implementation
       if (renderScale > useScale)
         co_return;
     }
-    PdfPageRenderOptions renderOptions;
-    auto dims = page.Size();
-    renderOptions.DestinationHeight(static_cast<uint32_t>(dims.Height * useScale));
-    renderOptions.DestinationWidth(static_cast<uint32_t>(dims.Width * useScale));
-    InMemoryRandomAccessStream stream;
-    co_await page.RenderToStreamAsync(stream, renderOptions);
-    BitmapImage bitmap;
-    co_await bitmap.SetSourceAsync(stream);
-    if (renderScale == useScale)
-      image.Source(bitmap);
+    // Cancelling this action also cancels the render or decode it is waiting on
+    auto cancellation = co_await winrt::get_cancellation_token();
+    cancellation.enable_propagation();
+    try {
+      // Progressive mode: a page that shows nothing yet first gets a cheap low-scale
+      // render, displayed until the full-resolution bitmap replaces it
+      double previewScale = useScale * m_previewFraction;
+      if (displayedScale == 0 && previewScale < useScale) {
+        auto preview = co_await renderBitmap(pdfPage, previewScale);
+        double nothingShown = 0;
+        if (renderScale == useScale && image == pageImage &&
+            displayedScale.compare_exchange_strong(nothingShown, previewScale)) {
+          show(preview);
+        } else {
+          t_renderBuffers.returnBitmap(preview);
+        }
+      }
+      auto bitmap = co_await renderBitmap(pdfPage, useScale);
+      if (renderScale == useScale && image == pageImage) {
+        show(bitmap);
+        displayedScale = useScale;
+      } else {
+        t_renderBuffers.returnBitmap(bitmap);
+      }
+    }
+    catch (winrt::hresult_canceled const&) {
+      // Nothing was displayed: restore the previous scale so the page is rendered again when needed
+      renderScale.compare_exchange_strong(useScale, currentRenderScale);
+    }
   }
   
+  void PDFPageInfo::show(WriteableBitmap const& bitmap) {
+    image.Source(bitmap);
+    t_renderBuffers.returnBitmap(std::exchange(shownBitmap, bitmap));
+  }
+  void PDFPageInfo::releaseBitmap() {
+    if (image)
+      image.Source(nullptr);
+    t_renderBuffers.returnBitmap(std::exchange(shownBitmap, nullptr));
+  }
+
+  winrt::Windows::Foundation::IAsyncOperation<WriteableBitmap> PDFPageInfo::renderBitmap(PdfPage pdfPage, double useScale) {
+    auto cancellation = co_await winrt::get_cancellation_token();
+    cancellation.enable_propagation();
+    auto start = std::chrono::steady_clock::now();
+    PdfPageRenderOptions renderOptions;
+    auto dims = pdfPage.Size();
+    renderOptions.DestinationHeight((std::max)(1u, static_cast<uint32_t>(dims.Height * useScale)));
+    renderOptions.DestinationWidth((std::max)(1u, static_cast<uint32_t>(dims.Width * useScale)));
+    // Uncompressed BMP instead of the default PNG: encoding and decoding become plain copies
+    renderOptions.BitmapEncoderId(BitmapEncoder::BmpEncoderId());
+    auto stream = t_renderBuffers.takeStream();
+    co_await pdfPage.RenderToStreamAsync(stream, renderOptions);
+    stream.Seek(0);
+    auto decoder = co_await BitmapDecoder::CreateAsync(BitmapDecoder::BmpDecoderId(), stream);
+    auto pixels = co_await decoder.GetSoftwareBitmapAsync(BitmapPixelFormat::Bgra8, BitmapAlphaMode::Premultiplied);
+    t_renderBuffers.returnStream(std::move(stream));
+    // Copy the raw pixels into a pooled bitmap of the same size rather than decoding into a new BitmapImage
+    auto bitmap = t_renderBuffers.takeBitmap(pixels.PixelWidth(), pixels.PixelHeight());
+    pixels.CopyToBuffer(bitmap.PixelBuffer());
+    pixels.Close();
+    bitmap.Invalidate();
+#if PDFJSI_TRACING
+    if (traceEnabled()) {
+      TraceLoggingWrite(g_rctPdfTraceProvider, "PageRender",
+        TraceLoggingUInt32(pdfPage.Index() + 1, "Page"),
+        TraceLoggingInt32(bitmap.PixelWidth(), "Width"),
+        TraceLoggingInt32(bitmap.PixelHeight(), "Height"),
+        TraceLoggingFloat64(elapsedMs(start), "DurationMs"));
+    }
+#endif
+    co_return bitmap;
+  }
+
   RCTPdfControl::RCTPdfControl(IReactContext const& reactContext) : m_reactContext(reactContext) {
     InitializeComponent();
+    m_leadingSpacer = Border();
+    m_trailingSpacer = Border();
   }
 
   winrt::Windows::Foundation::Collections::IMapView<winrt::hstring, winrt::Microsoft::ReactNative::ViewManagerPropertyType> RCTPdfControl::NativeProps() noexcept {
@@ -184,45 +438,46 @@ namespace winrt::RCTPdf::implementation
       }
     }
     // If we are loading a new PDF:
-    std::shared_lock lock(m_rwlock);
-    if (pdfURI && *pdfURI != m_pdfURI ||
-        pdfPassword && *pdfPassword != m_pdfPassword ||
-        (reverse && *reverse != m_reverse) ||
-        (enablePaging && *enablePaging != m_enablePaging) ||
-        (singlePage && (m_pages.empty() || *singlePage && m_pages.size() != 1 || !*singlePage && m_pages.size() == 1)) ) {
-      lock.unlock();
-      std::unique_lock write_lock(m_rwlock);
-      m_pdfURI = pdfURI.value_or("");
-      m_pdfPassword = pdfPassword.value_or("");
-      m_currentPage = setPage.value_or(0);
-      m_scale = scale.value_or(m_defualtZoom);
-      m_minScale = minScale.value_or(m_defaultMinZoom);
-      m_maxScale = maxScale.value_or(m_defaultMaxZoom);
-      m_horizontal = horizontal.value_or(false);
-      m_enablePaging = enablePaging.value_or(false);
-      int useFitPolicy = 2;
+    if (pdfURI && *pdfURI != m_requestedLoad.uri ||
+        pdfPassword && *pdfPassword != m_requestedLoad.password ||
+        (reverse && *reverse != m_requestedLoad.reverse) ||
+        (enablePaging && *enablePaging != m_requestedLoad.enablePaging) ||
+        (singlePage && *singlePage != m_requestedLoad.singlePage)) {
+      PDFLoadRequest request;
+      request.uri = pdfURI.value_or("");
+      request.password = pdfPassword.value_or("");
+      request.page = setPage.value_or(0);
+      request.scale = scale.value_or(m_defualtZoom);
+      request.horizontal = horizontal.value_or(false);
+      request.enablePaging = enablePaging.value_or(false);
       if (fitWidth)
-        useFitPolicy = 0;
+        request.fitPolicy = 0;
       if (fitPolicy)
-        useFitPolicy = *fitPolicy;
-      m_margins = spacing.value_or(m_defaultMargins);
-      m_reverse = reverse.value_or(false);
-      LoadPDF(std::move(write_lock), useFitPolicy, singlePage.value_or(false));
+        request.fitPolicy = *fitPolicy;
+      request.margins = spacing.value_or(m_defaultMargins);
+      request.reverse = reverse.value_or(false);
+      request.singlePage = singlePage.value_or(false);
+      m_minScale = minScale.value_or(m_defaultMinZoom);
+      m_maxScale = maxScale.value_or(m_defaultMaxZoom);
+      m_requestedLoad = std::move(request);
+      LoadPDF(++m_loadGeneration);
     } else {
       // If we are updating the pdf:
       m_minScale = minScale.value_or(m_minScale);
       m_maxScale = maxScale.value_or(m_maxScale);
+      auto view = View();
       bool needScroll = false;
-      if (horizontal && *horizontal != m_horizontal) {
+      if (horizontal && *horizontal != view->horizontal) {
         SetOrientation(*horizontal);
         needScroll = true;
       }
       if (setPage) {
         m_currentPage = *setPage;
+        m_requestedLoad.page = *setPage;
         needScroll = true;
       }
-      if ((scale && *scale != m_scale) || (spacing && *spacing != m_margins)) {
-        Rescale(scale.value_or(m_scale), spacing.value_or(m_margins), !needScroll);
+      if ((scale && *scale != view->scale) || (spacing && *spacing != view->margins)) {
+        Rescale(scale.value_or(view->scale), spacing.value_or(view->margins), !needScroll);
       }
       if (needScroll) {
         GoToPage(m_currentPage);
@@ -248,7 +503,6 @@ namespace winrt::RCTPdf::implementation
   void RCTPdfControl::DispatchCommand(winrt::hstring const& commandId, winrt::Microsoft::ReactNative::IJSValueReader const& commandArgsReader) noexcept {
     auto commandArgs = JSValue::ReadArrayFrom(commandArgsReader);
     if (commandId == L"setPage" && commandArgs.size() > 0) {
-      std::shared_lock lock(m_rwlock);
       auto page = commandArgs[0].AsInt32() - 1;
       GoToPage(page);
     }
@@ -259,9 +513,9 @@ namespace winrt::RCTPdf::implementation
     if ((modifiers & winrt::Windows::System::VirtualKeyModifiers::Control) != winrt::Windows::System::VirtualKeyModifiers::Control)
       return;
     double delta = (e.GetCurrentPoint(*this).Properties().MouseWheelDelta() / WHEEL_DELTA);
-    std::shared_lock lock(m_rwlock);
-    auto newScale = (std::max)((std::min)(m_scale * pow(m_zoomMultiplier, delta), m_maxScale), m_minScale);
-    Rescale(newScale, m_margins, true);
+    auto view = View();
+    auto newScale = (std::max)((std::min)(view->scale * pow(m_zoomMultiplier, delta), m_maxScale), m_minScale);
+    Rescale(newScale, view->margins, true);
     e.Handled(true);
   }
 
@@ -280,28 +534,39 @@ namespace winrt::RCTPdf::implementation
   winrt::fire_and_forget RCTPdfControl::PagesContainer_ViewChanged(winrt::Windows::Foundation::IInspectable const&, winrt::Windows::UI::Xaml::Controls::ScrollViewerViewChangedEventArgs const& args)
   {
     auto lifetime = get_strong();
+    // Every view is handled against one snapshot, even while a property update or a
+    // load publishes a newer one, so the final view after a zoom is never skipped
+    auto view = View();
+    auto const& layout = view->layout;
+    bool horizontal = view->horizontal;
     auto container = PagesContainer();
     auto currentHorizontalOffset = container.HorizontalOffset();
     auto currentVerticalOffset = container.VerticalOffset();
-    double offsetStart = m_horizontal ? currentHorizontalOffset : currentVerticalOffset;
-    double viewSize = m_horizontal ? container.ViewportWidth() : container.ViewportHeight();
+    double offsetStart = horizontal ? currentHorizontalOffset : currentVerticalOffset;
+    double viewSize = horizontal ? container.ViewportWidth() : container.ViewportHeight();
     double offsetEnd = offsetStart + viewSize;
-    std::shared_lock lock(m_rwlock, std::defer_lock);
-    if (args.IsIntermediate() || !lock.try_lock() || viewSize == 0 || m_pages.empty())
-      return;
-    // Go through pages until we reach a visible page
-    int page = 0;
-    double visiblePagePixels = 0;
-    for (; page < (int)m_pages.size(); ++page) {
-      visiblePagePixels = m_pages[page].pageVisiblePixels(m_horizontal, offsetStart, offsetEnd);
-      if (visiblePagePixels > 0)
-        break;
-    }
-    if (page == (int)m_pages.size()) {
-      --page;
+    if (viewSize == 0 || view->pageCount() == 0)
+      co_return;
+    // The pages under both ends of the viewport bound the visible ones
+    int startPage = layout.pageAt(offsetStart, horizontal);
+    int endPage = layout.pageAt(offsetEnd, horizontal);
+    int firstVisible = (std::min)(startPage, endPage);
+    int lastVisible = (std::max)(startPage, endPage);
+    // An end of the viewport may rest on the margin between pages
+    while (firstVisible < lastVisible && layout.visiblePixels(firstVisible, horizontal, offsetStart, offsetEnd) == 0)
+      ++firstVisible;
+    while (lastVisible > firstVisible && layout.visiblePixels(lastVisible, horizontal, offsetStart, offsetEnd) == 0)
+      --lastVisible;
+    // Keep the virtual window following the viewport while scrolling; rendering waits for the view to settle
+    if (!view->enablePaging) {
+      UpdateVirtualWindow(*view, firstVisible, lastVisible);
     }
-    else {
-      double pagePixels = m_pages[page].pageSize(m_horizontal);
+    if (args.IsIntermediate())
+      co_return;
+    int page = firstVisible;
+    double visiblePagePixels = layout.visiblePixels(page, horizontal, offsetStart, offsetEnd);
+    if (visiblePagePixels > 0) {
+      double pagePixels = layout.pageSize(page, horizontal);
       // #"page" is the first visible page. Check how much of the view port this page covers...
       double viewCoveredByPage = visiblePagePixels / viewSize;
       // ...and how much of the page is visible:
@@ -311,39 +576,29 @@ namespace winrt::RCTPdf::implementation
       //  - less than 50% of the page is visible (important if more than one page fits the screen)
       //  - there is a next page
       // move the indicator to that page:
-      if (viewCoveredByPage < 0.5 && pageVisiblePart < 0.5 && page + 1 < (int)m_pages.size()) {
+      if (viewCoveredByPage < 0.5 && pageVisiblePart < 0.5 && page + 1 < view->pageCount()) {
         ++page;
       }
     }
     // Render all visible pages - first the current one, then the next visible ones and one
     // more, then the one before that might be partly visible, then one more before
-    co_await RenderVisiblePages(page);
-    if (page != m_currentPage) {
+    co_await RenderVisiblePages(view, page);
+    // Another document may have been loaded meanwhile
+    if (page != m_currentPage && View()->pages == view->pages) {
       m_currentPage = page;
-      SignalPageChange(m_currentPage + 1, m_pages.size());
+      SignalPageChange(m_currentPage + 1, view->pageCount());
     }
   }
 
   void RCTPdfControl::PagesContainer_Tapped(winrt::Windows::Foundation::IInspectable const&, winrt::Windows::UI::Xaml::Input::TappedRoutedEventArgs const& args) {
     auto position = args.GetPosition(*this);
-    std::shared_lock lock(m_rwlock);
-    int scaledDoubleMargin = (int)(m_scale * m_margins * 2);
-    int page = 0;
-    int xPosition = (int)(position.X + PagesContainer().HorizontalOffset());
-    int yPosition = (int)(position.Y + PagesContainer().VerticalOffset());
-    for (; page < (int)m_pages.size(); ++page) {
-      if (m_horizontal) {
-        if (xPosition >= (int)m_pages[page].scaledLeftOffset &&
-            xPosition <= (int)(m_pages[page].scaledLeftOffset + m_pages[page].scaledWidth + scaledDoubleMargin))
-          break;   
-      } else {
-        if (yPosition >= (int)m_pages[page].scaledTopOffset &&
-            yPosition <= (int)(m_pages[page].scaledTopOffset + m_pages[page].scaledHeight + scaledDoubleMargin))
-          break;
-      }
-    }
-    if (page == (int)m_pages.size()) {
-      page = m_currentPage;
+    auto view = View();
+    double xPosition = position.X + PagesContainer().HorizontalOffset();
+    double yPosition = position.Y + PagesContainer().VerticalOffset();
+    double tapOffset = view->horizontal ? xPosition : yPosition;
+    int page = m_currentPage;
+    if (view->pageCount() > 0 && tapOffset >= 0 && tapOffset < view->layout.totalSize(view->horizontal)) {
+      page = view->layout.pageAt(tapOffset, view->horizontal);
     }
     SignalPageTapped(page, (int)position.X, (int)position.Y);
     PagesContainer().Focus(FocusState::Pointer);
@@ -353,9 +608,9 @@ namespace winrt::RCTPdf::implementation
 
   void RCTPdfControl::PagesContainer_DoubleTapped(winrt::Windows::Foundation::IInspectable const&, winrt::Windows::UI::Xaml::Input::DoubleTappedRoutedEventArgs const& args)
   {
-    std::shared_lock lock(m_rwlock);
-    double newScale = (std::min)(m_scale * m_zoomMultiplier, m_maxScale);
-    Rescale(newScale, m_margins, true);
+    auto view = View();
+    double newScale = (std::min)(view->scale * m_zoomMultiplier, m_maxScale);
+    Rescale(newScale, view->margins, true);
     PagesContainer().Focus(FocusState::Pointer);
     args.Handled(true);
   }
@@ -378,59 +633,152 @@ namespace winrt::RCTPdf::implementation
     }
   }
 
-  void RCTPdfControl::UpdatePagesInfoMarginOrScale() {
-    unsigned scaledMargin = (unsigned)(m_scale * m_margins);
-    for (auto& page : m_pages) {
-      page.imageScale = m_scale;
-      page.scaledWidth = (unsigned)(page.width * m_scale);
-      page.scaledHeight = (unsigned)(page.height * m_scale);
-      page.image.Margin(ThicknessHelper::FromUniformLength(scaledMargin));
-      page.image.Width(page.scaledWidth);
-      page.image.Height(page.scaledHeight);
+  void RCTPdfControl::UpdatePagesInfoMarginOrScale(PDFViewSnapshot const& view) {
+    // Offsets of every page follow from the layout's prefix sums; only the
+    // realized pages need their images resized
+    auto& pages = *view.pages;
+    unsigned scaledMargin = (unsigned)(view.scale * view.margins);
+    for (int page = m_windowStart; page <= m_windowEnd && page < view.pageCount(); ++page) {
+      auto& pageInfo = pages[page];
+      pageInfo.imageScale = view.scale;
+      if (pageInfo.image) {
+        pageInfo.image.Margin(ThicknessHelper::FromUniformLength(scaledMargin));
+        pageInfo.image.Width(view.layout.pageSize(page, true));
+        pageInfo.image.Height(view.layout.pageSize(page, false));
+      }
     }
-    unsigned totalTopOffset = 0;
-    unsigned totalLeftOffset = 0;
-    unsigned doubleScaledMargin = scaledMargin * 2;
-    if (m_reverse) {
-      for (int page = m_pages.size() - 1; page >= 0; --page) {
-        m_pages[page].scaledTopOffset = totalTopOffset;
-        totalTopOffset += m_pages[page].scaledHeight + doubleScaledMargin;
-        m_pages[page].scaledLeftOffset = totalLeftOffset;
-        totalLeftOffset += m_pages[page].scaledWidth + doubleScaledMargin;
+    UpdateSpacers(view);
+  }
+
+  void RCTPdfControl::RealizePage(PDFViewSnapshot const& view, int page) {
+    auto& pageInfo = (*view.pages)[page];
+    if (!pageInfo.page) {
+      pageInfo.page = view.document.GetPage(page);
+    }
+    if (!pageInfo.image) {
+      Image pageImage{ nullptr };
+      if (!m_imagePool.empty()) {
+        pageImage = std::move(m_imagePool.back());
+        m_imagePool.pop_back();
+      } else {
+        pageImage = Image();
+        pageImage.HorizontalAlignment(HorizontalAlignment::Center);
+        pageImage.AllowFocusOnInteraction(false);
       }
+      Automation::AutomationProperties::SetName(pageImage, winrt::to_hstring("PDF Page " + std::to_string(page + 1)));
+      pageImage.Margin(ThicknessHelper::FromUniformLength((unsigned)(view.scale * view.margins)));
+      pageImage.Width(view.layout.pageSize(page, true));
+      pageImage.Height(view.layout.pageSize(page, false));
+      pageInfo.image = pageImage;
+      pageInfo.imageScale = view.scale;
+      pageInfo.renderScale = 0;
+      pageInfo.displayedScale = 0;
     }
-    else {
-      for (int page = 0; page < (int)m_pages.size(); ++page) {
-        m_pages[page].scaledTopOffset = totalTopOffset;
-        totalTopOffset += m_pages[page].scaledHeight + doubleScaledMargin;
-        m_pages[page].scaledLeftOffset = totalLeftOffset;
-        totalLeftOffset += m_pages[page].scaledWidth + doubleScaledMargin;
+  }
+
+  void RCTPdfControl::ReleasePage(PDFPageInfo& pageInfo) {
+    pageInfo.releaseBitmap();
+    if (pageInfo.image) {
+      m_imagePool.push_back(std::move(pageInfo.image));
+      pageInfo.image = nullptr;
+    }
+    pageInfo.page = nullptr;
+    pageInfo.renderScale = 0;
+    pageInfo.displayedScale = 0;
+  }
+
+  void RCTPdfControl::UpdateVirtualWindow(PDFViewSnapshot const& view, int firstVisible, int lastVisible) {
+    if (view.pageCount() == 0) {
+      return;
+    }
+    auto& pages = *view.pages;
+    int lastPage = view.pageCount() - 1;
+    int windowStart = (std::max)(0, (std::min)(firstVisible, lastPage));
+    int windowEnd = (std::max)(windowStart, (std::min)(lastVisible, lastPage));
+    if (!view.enablePaging) {
+      windowStart = (std::max)(0, windowStart - m_virtualWindowPages);
+      windowEnd = (std::min)(lastPage, windowEnd + m_virtualWindowPages);
+    }
+    if (windowStart == m_windowStart && windowEnd == m_windowEnd) {
+      return;
+    }
+    for (int page = m_windowStart; page <= m_windowEnd; ++page) {
+      if (page < windowStart || page > windowEnd) {
+        ReleasePage(pages[page]);
       }
     }
+    m_windowStart = windowStart;
+    m_windowEnd = windowEnd;
+    std::vector<IInspectable> items;
+    if (!view.enablePaging) {
+      items.push_back(m_leadingSpacer);
+    }
+    for (int i = 0; i <= windowEnd - windowStart; ++i) {
+      int page = view.reverse ? windowEnd - i : windowStart + i;
+      RealizePage(view, page);
+      items.push_back(pages[page].image);
+    }
+    if (!view.enablePaging) {
+      items.push_back(m_trailingSpacer);
+    }
+    Pages().Items().ReplaceAll(items);
+    UpdateSpacers(view);
+  }
+
+  void RCTPdfControl::UpdateSpacers(PDFViewSnapshot const& view) {
+    if (view.enablePaging || m_windowEnd < m_windowStart || m_windowEnd >= view.pageCount()) {
+      return;
+    }
+    // The spacers stand in for the pages before and after the window, so the scroll
+    // extent and offsets are the same as with every page laid out
+    auto const& layout = view.layout;
+    bool horizontal = view.horizontal;
+    unsigned doubleScaledMargin = 2 * (unsigned)(view.scale * view.margins);
+    int firstShown = view.reverse ? m_windowEnd : m_windowStart;
+    int lastShown = view.reverse ? m_windowStart : m_windowEnd;
+    double windowStartOffset = layout.pageOffset(firstShown, horizontal);
+    double windowEndOffset = (double)layout.pageOffset(lastShown, horizontal) +
+      layout.pageSize(lastShown, horizontal) + doubleScaledMargin;
+    double totalLength = layout.totalSize(horizontal);
+    double trailingLength = (std::max)(0.0, totalLength - windowEndOffset);
+    double crossSize = (double)layout.maxPageSize(!horizontal) + doubleScaledMargin;
+    if (horizontal) {
+      m_leadingSpacer.Width(windowStartOffset);
+      m_leadingSpacer.Height(crossSize);
+      m_trailingSpacer.Width(trailingLength);
+      m_trailingSpacer.Height(crossSize);
+    } else {
+      m_leadingSpacer.Width(crossSize);
+      m_leadingSpacer.Height(windowStartOffset);
+      m_trailingSpacer.Width(crossSize);
+      m_trailingSpacer.Height(trailingLength);
+    }
   }
 
   void RCTPdfControl::GoToPage(int page) {
-    if (page < 0 || page >= (int)m_pages.size()) {
+    auto view = View();
+    if (page < 0 || page >= view->pageCount()) {
       return;
     }
-    if (m_enablePaging) {
-      [&](int page) -> winrt::fire_and_forget {
-        auto lifetime = get_strong();
-        co_await m_pages[page].render();
-      }(page);
-      Pages().Items().ReplaceAll({ &m_pages[page].image, &m_pages[page].image + 1 });
+    if (view->enablePaging) {
+      UpdateVirtualWindow(*view, page, page);
+      [](std::shared_ptr<std::vector<PDFPageInfo>> pages, int page) -> winrt::fire_and_forget {
+        co_await RenderPage(pages, page);
+      }(view->pages, page);
     } else {
-      auto neededOffset = m_horizontal ? m_pages[page].scaledLeftOffset : m_pages[page].scaledTopOffset;
-      double horizontalOffset = m_horizontal ? neededOffset : PagesContainer().HorizontalOffset();
-      double verticalOffset = m_horizontal ? PagesContainer().VerticalOffset() : neededOffset;
+      auto neededOffset = view->layout.pageOffset(page, view->horizontal);
+      double horizontalOffset = view->horizontal ? neededOffset : PagesContainer().HorizontalOffset();
+      double verticalOffset = view->horizontal ? PagesContainer().VerticalOffset() : neededOffset;
       ChangeScroll(horizontalOffset, verticalOffset);
     }
-    SignalPageChange(page + 1, m_pages.size());
+    SignalPageChange(page + 1, view->pageCount());
   }
 
-  winrt::fire_and_forget RCTPdfControl::LoadPDF(std::unique_lock<std::shared_mutex> lock, int fitPolicy, bool singlePage) {
+  winrt::fire_and_forget RCTPdfControl::LoadPDF(uint64_t generation) {
     auto lifetime = get_strong();
-    auto pdfURI = m_pdfURI;
+    auto pdfURI = m_requestedLoad.uri;
+    auto password = m_requestedLoad.password;
+    bool singlePage = m_requestedLoad.singlePage;
     auto uri = Uri(winrt::to_hstring(pdfURI));
     auto scheme = uri.SchemeName();
     if (scheme == L"file") {
@@ -438,13 +786,18 @@ namespace winrt::RCTPdf::implementation
       std::replace(begin(pdfURI), end(pdfURI), '/', '\\');
     }
     PdfDocument document = nullptr;
+    StorageFile file = nullptr;
+    auto loadStart = std::chrono::steady_clock::now();
     try {
-      auto file = scheme == L"file"
+      file = scheme == L"file"
                   ? co_await StorageFile::GetFileFromPathAsync(winrt::to_hstring(pdfURI))
                   : co_await StorageFile::GetFileFromApplicationUriAsync(uri);
-      document = co_await PdfDocument::LoadFromFileAsync(file, winrt::to_hstring(m_pdfPassword));
+      document = co_await PdfDocument::LoadFromFileAsync(file, winrt::to_hstring(password));
     }
     catch (winrt::hresult_error const& ex) {
+      // A newer load reports its own errors
+      if (generation != m_loadGeneration)
+        co_return;
       switch (ex.to_abi()) {
       case __HRESULT_FROM_WIN32(ERROR_WRONG_PASSWORD):
         SignalError("Password required or incorrect password.");
@@ -457,141 +810,258 @@ namespace winrt::RCTPdf::implementation
         co_return;
       }
     }
+    if (generation != m_loadGeneration)
+      co_return;
     if (!document) {
       SignalError("Could not load PDF.");
       co_return;
     }
-    auto items = Pages().Items();
-    items.Clear();
-    m_pages.clear();
-    SetOrientation(m_horizontal);
-    if (document.PageCount() == 0) {
-      if (fitPolicy != -1)
-        m_scale = 1;
+#if PDFJSI_TRACING
+    if (traceEnabled()) {
+      TraceLoggingWrite(g_rctPdfTraceProvider, "DocumentLoad",
+        TraceLoggingUInt32(document.PageCount(), "PageCount"),
+        TraceLoggingFloat64(elapsedMs(loadStart), "DurationMs"));
+    }
+#endif
+    // Sizes of every page, from the stored table when this file was laid out before
+    unsigned documentPages = document.PageCount();
+    auto pageSizes = co_await readPageSizes(file, documentPages);
+    bool measured = !pageSizes;
+    if (measured) {
+      pageSizes = JsonArray();
+      for (unsigned pageIdx = 0; pageIdx < (singlePage ? (std::min)(documentPages, 1u) : documentPages); ++pageIdx) {
+        auto size = document.GetPage(pageIdx).Size();
+        pageSizes.Append(JsonValue::CreateNumberValue(size.Width));
+        pageSizes.Append(JsonValue::CreateNumberValue(size.Height));
+      }
+      if (!singlePage && documentPages > 0)
+        writePageSizes(file, pageSizes);
+    }
+    if (generation != m_loadGeneration)
+      co_return;
+
+    // The old document stayed interactive until now; property updates made during
+    // the load are in the request
+    auto const& request = m_requestedLoad;
+    for (auto& pending : m_pendingRenders) {
+      pending.second.Cancel();
+    }
+    m_pendingRenders.clear();
+    ++m_renderGeneration;
+    Pages().Items().Clear();
+    m_windowStart = 0;
+    m_windowEnd = -1;
+
+    auto next = std::make_shared<PDFViewSnapshot>();
+    next->document = document;
+    next->margins = request.margins;
+    next->horizontal = request.horizontal;
+    next->reverse = request.reverse;
+    next->enablePaging = request.enablePaging;
+    next->scale = request.scale;
+    if (documentPages == 0) {
+      if (request.fitPolicy != -1)
+        next->scale = 1;
     }
     else {
-      auto firstPageSize = document.GetPage(0).Size();
+      Size firstPageSize((float)pageSizes.GetNumberAt(0), (float)pageSizes.GetNumberAt(1));
       auto viewWidth = PagesContainer().ViewportWidth();
       auto viewHeight = PagesContainer().ViewportHeight();
-      switch (fitPolicy) {
+      double margins = next->margins;
+      switch (request.fitPolicy) {
       case 0:
-        m_scale = viewWidth / (firstPageSize.Width + 2 * (double)m_margins);
+        next->scale = viewWidth / (firstPageSize.Width + 2 * margins);
         break;
       case 1:
-        m_scale = viewHeight / (firstPageSize.Height + 2 * (double)m_margins);
+        next->scale = viewHeight / (firstPageSize.Height + 2 * margins);
         break;
       case 2:
-        m_scale = (std::min)(viewWidth / (firstPageSize.Width + 2 * (double)m_margins), viewHeight / (firstPageSize.Height + 2 * (double)m_margins));
+        next->scale = (std::min)(viewWidth / (firstPageSize.Width + 2 * margins), viewHeight / (firstPageSize.Height + 2 * margins));
         break;
       default:
         break;
       }
     }
-    unsigned pagesCount = document.PageCount();
+    unsigned pagesCount = documentPages;
     if (singlePage && pagesCount > 0)
       pagesCount = 1;
+    // Only page geometry is kept for every page; images and PdfPage objects are created
+    // for the window around the viewport (see UpdateVirtualWindow)
+    auto& pages = *next->pages;
+    pages.reserve(pagesCount);
     for (unsigned pageIdx = 0; pageIdx < pagesCount; ++pageIdx) {
-      auto page = document.GetPage(pageIdx);
-      auto dims = page.Size();
-      Image pageImage;
-      pageImage.HorizontalAlignment(HorizontalAlignment::Center);
-      pageImage.AllowFocusOnInteraction(false);
-      Automation::AutomationProperties::SetName(pageImage, winrt::to_hstring("PDF Page " + std::to_string(pageIdx + 1)));
-      m_pages.emplace_back(pageImage, page, m_scale, 0);
-    }
-    if (m_enablePaging) {
-      items.Append(m_pages[m_currentPage].image);
-    } else {
-      if (m_reverse) {
-        for (int page = m_pages.size() - 1; page >= 0; --page)
-          items.Append(m_pages[page].image);
-      }
-      else {
-        for (int page = 0; page < (int)m_pages.size(); ++page)
-          items.Append(m_pages[page].image);
-      }
+      pages.emplace_back(pageSizes.GetNumberAt(2 * pageIdx), pageSizes.GetNumberAt(2 * pageIdx + 1), next->scale, 0);
     }
-    UpdatePagesInfoMarginOrScale();
-    lock.unlock();
-    std::shared_lock shared_lock(m_rwlock);
-    if (m_currentPage < 0)
+    next->layout.reset(pages, next->reverse);
+    next->layout.update(next->scale, next->margins);
+    m_currentPage = request.page;
+    if (m_currentPage < 0 || m_currentPage >= (int)pages.size())
       m_currentPage = 0;
-    if (m_currentPage < (int)m_pages.size()) {
-      co_await m_pages[m_currentPage].render();
+    PublishView(next);
+    SetOrientation(next->horizontal);
+    auto view = View();
+    UpdateVirtualWindow(*view, m_currentPage, m_currentPage);
+    if (m_currentPage < view->pageCount()) {
+      co_await RenderPage(view->pages, m_currentPage);
+      if (generation != m_loadGeneration)
+        co_return;
       GoToPage(m_currentPage);
     }
-    if (m_pages.empty()) {
+    if (view->pageCount() == 0) {
       SignalLoadComplete(0, 0, 0);
     }
     else {
-      SignalLoadComplete(m_pages.size(), m_pages.front().width, m_pages.front().height);
+      SignalLoadComplete(view->pageCount(), view->pages->front().width, view->pages->front().height);
     }
-    // Render low-res preview of the pages
-    double useScale = (std::min)(m_scale, m_previewZoom);
-    for (unsigned page = 0; page < m_pages.size(); ++page) {
-      co_await m_pages[page].render(useScale);
+    // The other visible pages; each shows its preview first (see PDFPageInfo::render)
+    if (view->pageCount() > 0) {
+      co_await RenderVisiblePages(View(), m_currentPage);
     }
   }
 
   void RCTPdfControl::Rescale(double newScale, double newMargin, bool goToNewPosition) {
-    if (newScale != m_scale || newMargin != m_margins) {
-      double rescale = newScale / m_scale;
-      double targetHorizontalOffset = PagesContainer().HorizontalOffset() * rescale;
-      double targetVerticalOffset = PagesContainer().VerticalOffset() * rescale;
-      if (newMargin != m_margins) {
-        if (m_horizontal) {
-          targetVerticalOffset += (double)m_currentPage * 2 * (newMargin - m_margins) * rescale;
+    auto view = View();
+    if (newScale != view->scale || newMargin != view->margins) {
+      double rescale = newScale / view->scale;
+      auto container = PagesContainer();
+      double targetHorizontalOffset = container.HorizontalOffset() * rescale;
+      double targetVerticalOffset = container.VerticalOffset() * rescale;
+      if (newMargin != view->margins) {
+        if (view->horizontal) {
+          targetVerticalOffset += (double)m_currentPage * 2 * (newMargin - view->margins) * rescale;
         }
         else {
-          targetHorizontalOffset += (double)m_currentPage * 2 * (newMargin - m_margins) * rescale;
+          targetHorizontalOffset += (double)m_currentPage * 2 * (newMargin - view->margins) * rescale;
         }
       }
-      m_scale = newScale;
-      m_margins = (int)newMargin;
-      UpdatePagesInfoMarginOrScale();
+      auto next = UpdateView([&](PDFViewSnapshot& next) {
+        next.scale = newScale;
+        next.margins = (int)newMargin;
+        next.layout.update(next.scale, next.margins);
+      });
+      m_requestedLoad.scale = newScale;
+      m_requestedLoad.margins = (int)newMargin;
+      UpdatePagesInfoMarginOrScale(*next);
+      bool moves = goToNewPosition &&
+        (targetHorizontalOffset != container.HorizontalOffset() || targetVerticalOffset != container.VerticalOffset());
       if (goToNewPosition) {
         ChangeScroll(targetHorizontalOffset, targetVerticalOffset);
       }
-      SignalScaleChanged(m_scale);
+      // Without a scroll no ViewChanged follows, and the pages would stay at the old scale
+      if (!moves) {
+        RenderCurrentView();
+      }
+      SignalScaleChanged(newScale);
     }
   }
 
   void RCTPdfControl::SetOrientation(bool horizontal) {
-    m_horizontal = horizontal;
+    auto view = UpdateView([&](PDFViewSnapshot& next) { next.horizontal = horizontal; });
+    m_requestedLoad.horizontal = horizontal;
     StackPanel orientationSelector;
     if (FindName(winrt::to_hstring("OrientationSelector")).try_as<StackPanel>(orientationSelector))
     {
-      orientationSelector.Orientation(m_horizontal ? Orientation::Horizontal : Orientation::Vertical);
+      orientationSelector.Orientation(horizontal ? Orientation::Horizontal : Orientation::Vertical);
     }
+    UpdateSpacers(*view);
   }
 
-  winrt::Windows::Foundation::IAsyncAction RCTPdfControl::RenderVisiblePages(int page) {
+  winrt::fire_and_forget RCTPdfControl::RenderCurrentView() {
     auto lifetime = get_strong();
+    auto view = View();
+    if (view->pageCount() > 0) {
+      co_await RenderVisiblePages(view, (std::min)(m_currentPage, view->pageCount() - 1));
+    }
+  }
+
+  winrt::Windows::Foundation::IAsyncAction RCTPdfControl::RenderPage(std::shared_ptr<std::vector<PDFPageInfo>> pages, int page) {
+    // Cancelling this action cancels the page render it waits on
+    auto cancellation = co_await winrt::get_cancellation_token();
+    cancellation.enable_propagation();
+    co_await (*pages)[page].render();
+  }
+
+  winrt::Windows::Foundation::IAsyncAction RCTPdfControl::RenderVisiblePages(std::shared_ptr<const PDFViewSnapshot> view, int page) {
+    auto lifetime = get_strong();
+    // Renders of a document that was replaced meanwhile are not wanted
+    if (View()->pages != view->pages)
+      co_return;
+    auto& pages = *view->pages;
+    auto const& layout = view->layout;
+    bool horizontal = view->horizontal;
     auto container = PagesContainer();
     auto currentHorizontalOffset = container.HorizontalOffset();
     auto currentVerticalOffset = container.VerticalOffset();
-    double offsetStart = m_horizontal ? currentHorizontalOffset : currentVerticalOffset;
-    double viewSize = m_horizontal ? container.ViewportWidth() : container.ViewportHeight();
+    double offsetStart = horizontal ? currentHorizontalOffset : currentVerticalOffset;
+    double viewSize = horizontal ? container.ViewportWidth() : container.ViewportHeight();
     double offsetEnd = offsetStart + viewSize;
-    if (m_pages[page].needsRender()) {
-      co_await m_pages[page].render();
-    }
+    // Priority order: the current page, then the next visible ones and one more, then the
+    // one before that might be partly visible, then one more before
+    std::vector<int> pagesToRender{ page };
     auto pageToRender = page + 1;
-    while (pageToRender < (int)m_pages.size() &&
-      m_pages[pageToRender].pageVisiblePixels(m_horizontal, offsetStart, offsetEnd) > 0) {
-      if (m_pages[pageToRender].needsRender()) {
-        co_await m_pages[pageToRender].render();
-      }
+    while (pageToRender < view->pageCount() &&
+      layout.visiblePixels(pageToRender, horizontal, offsetStart, offsetEnd) > 0) {
+      pagesToRender.push_back(pageToRender);
       ++pageToRender;
     }
-    if (pageToRender < (int)m_pages.size() && m_pages[pageToRender].needsRender()) {
-      co_await m_pages[pageToRender].render();
+    if (pageToRender < view->pageCount()) {
+      pagesToRender.push_back(pageToRender);
+    }
+    if (page >= 1) {
+      pagesToRender.push_back(page - 1);
     }
-    if (page >= 1 && m_pages[page - 1].needsRender()) {
-      co_await m_pages[page - 1].render();
+    if (page >= 2) {
+      pagesToRender.push_back(page - 2);
     }
-    if (page >= 2 && m_pages[page - 2].needsRender()) {
-      co_await m_pages[page - 2].render();
+
+    // Renders from the previous view that are no longer wanted (or were started for
+    // another scale) are cancelled; the ones still wanted keep running
+    auto generation = ++m_renderGeneration;
+    std::vector<std::pair<int, IAsyncAction>> stillRunning;
+    for (auto& pending : m_pendingRenders) {
+      bool wanted = std::find(pagesToRender.begin(), pagesToRender.end(), pending.first) != pagesToRender.end();
+      if (pending.second.Status() != AsyncStatus::Started) {
+        continue;
+      }
+      if (wanted && !pages[pending.first].needsRender()) {
+        stillRunning.push_back(std::move(pending));
+      }
+      else {
+        pending.second.Cancel();
+      }
+    }
+    m_pendingRenders = std::move(stillRunning);
+
+    // Independent pages render concurrently, at most one per core at a time
+    size_t maxConcurrentRenders = (std::max)(1u, std::thread::hardware_concurrency());
+    std::vector<IAsyncAction> batch;
+    for (auto pageIdx : pagesToRender) {
+      if (!pages[pageIdx].needsRender()) {
+        continue;
+      }
+      auto render = RenderPage(view->pages, pageIdx);
+      m_pendingRenders.emplace_back(pageIdx, render);
+      batch.push_back(render);
+      if (batch.size() == maxConcurrentRenders) {
+        co_await WaitForRenders(std::move(batch));
+        batch.clear();
+        if (generation != m_renderGeneration) {
+          co_return;
+        }
+      }
+    }
+    co_await WaitForRenders(std::move(batch));
+  }
+
+  winrt::Windows::Foundation::IAsyncAction RCTPdfControl::WaitForRenders(std::vector<winrt::Windows::Foundation::IAsyncAction> renders) {
+    // The renders are already running; waiting on them in turn takes as long as the slowest one
+    for (auto& render : renders) {
+      try {
+        co_await render;
+      }
+      catch (winrt::hresult_canceled const&) {
+        // Superseded by a newer view
+      }
     }
   }
 
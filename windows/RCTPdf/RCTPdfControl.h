@@ -1,6 +1,9 @@
 ﻿#pragma once
 
+#include <atomic>
+#include <memory>
 #include <vector>
+#include <thread>
 #include "winrt/Windows.UI.Xaml.h"
 #include "winrt/Windows.UI.Xaml.Markup.h"
 #include "winrt/Windows.UI.Xaml.Interop.h"
@@ -12,27 +15,89 @@
 namespace winrt::RCTPdf::implementation
 {
     struct PDFPageInfo {
-      PDFPageInfo(winrt::Windows::UI::Xaml::Controls::Image image, winrt::Windows::Data::Pdf::PdfPage page, double imageScale, double renderScale);
+      // Reads the page geometry only; image and page are set while the page is in the virtual window
+      PDFPageInfo(winrt::Windows::Data::Pdf::PdfPage const& pdfPage, double imageScale, double renderScale);
+      // From page sizes stored by an earlier load, without opening the page
+      PDFPageInfo(double width, double height, double imageScale, double renderScale);
       PDFPageInfo(const PDFPageInfo&);
       PDFPageInfo(PDFPageInfo&&);
-      unsigned pageVisiblePixels(bool horizontal, double viewportStart, double viewportEnd) const;
-      unsigned pageSize(bool horizontal) const;
       bool needsRender() const;
       winrt::Windows::Foundation::IAsyncAction render();
       winrt::Windows::Foundation::IAsyncAction render(double useScale);
       unsigned height, width;
-      unsigned scaledHeight, scaledWidth;
-      unsigned scaledTopOffset, scaledLeftOffset;
-      double imageScale; // scale at which the image is displayed
+      std::atomic<double> imageScale; // scale at which the image is displayed
       // Multiple tasks can update the image, use the render scale as the sync point
       std::atomic<double> renderScale; // scale at which the image is rendered
+      // Scale of the bitmap currently shown (0 when blank); a preview only replaces a blank image
+      std::atomic<double> displayedScale;
       winrt::Windows::UI::Xaml::Controls::Image image;
       winrt::Windows::Data::Pdf::PdfPage page;
+      // Bitmap shown by image; handed back to the buffer pool when replaced or released
+      winrt::Windows::UI::Xaml::Media::Imaging::WriteableBitmap shownBitmap{ nullptr };
+      void releaseBitmap();
 
       // If zooming-out at what point we rerender the image with smaller scale?
       // E.g. value of 2 means if the image is currently rendered at scale 1.0
       // we will rerender it when the scale is smaller than 0.5
       static constexpr double m_downscaleTreshold = 2;
+      // Preview pass scale relative to the target scale (1/16 of the pixels)
+      static constexpr double m_previewFraction = 0.25;
+    private:
+      void show(winrt::Windows::UI::Xaml::Media::Imaging::WriteableBitmap const& bitmap);
+      // Renders to raw BGRA pixels in a pooled WriteableBitmap, reusing pooled streams
+      static winrt::Windows::Foundation::IAsyncOperation<winrt::Windows::UI::Xaml::Media::Imaging::WriteableBitmap> renderBitmap(winrt::Windows::Data::Pdf::PdfPage pdfPage, double useScale);
+    };
+
+    // Page geometry index: cumulative page sizes in display order, evaluated at the
+    // current scale and margins. Offsets are O(1), the page at an offset is a binary
+    // search, and a rescale or margin change only updates two numbers. Copies share
+    // the page sizes, so a rescaled copy is as cheap as the update.
+    struct PDFPagesLayout {
+      void reset(std::vector<PDFPageInfo> const& pages, bool reverse);
+      void update(double scale, int margins);
+      int pageCount() const;
+      // Start of the page's slot (its margins included) along the scroll axis
+      unsigned pageOffset(int page, bool horizontal) const;
+      // Scaled page size without margins
+      unsigned pageSize(int page, bool horizontal) const;
+      unsigned totalSize(bool horizontal) const;
+      unsigned maxPageSize(bool horizontal) const;
+      // Page whose slot contains the offset, clamped to the first/last page
+      int pageAt(double offset, bool horizontal) const;
+      unsigned visiblePixels(int page, bool horizontal, double viewportStart, double viewportEnd) const;
+    private:
+      int position(int page) const;
+      unsigned offsetAtPosition(int position, bool horizontal) const;
+      struct Extents {
+        std::vector<double> widthPrefix{ 0.0 };
+        std::vector<double> heightPrefix{ 0.0 };
+        unsigned maxWidth = 0, maxHeight = 0;
+      };
+      std::shared_ptr<const Extents> m_extents = std::make_shared<Extents>();
+      double m_scale = 1.0;
+      unsigned m_scaledMargin = 0;
+      bool m_reverse = false;
+    };
+
+    // Immutable view of the loaded document and its layout. Writers publish a changed copy
+    // instead of mutating it, so a reader keeps one consistent view for as long as it holds
+    // the snapshot, across co_await, without a lock (see RCTPdfControl::View).
+    struct PDFViewSnapshot {
+      winrt::Windows::Data::Pdf::PdfDocument document{ nullptr };
+      // Shared by every snapshot of one document; render state is per page (see PDFPageInfo)
+      std::shared_ptr<std::vector<PDFPageInfo>> pages = std::make_shared<std::vector<PDFPageInfo>>();
+      PDFPagesLayout layout;
+      // Scale at which the PDF is displayed
+      double scale = 0.2;
+      // Margins of each page
+      int margins = 10;
+      // Are we in "horizontal" mode?
+      bool horizontal = false;
+      // Render the pages in reverse order
+      bool reverse = false;
+      // Is in "enablePaging" mode
+      bool enablePaging = false;
+      int pageCount() const { return (int)pages->size(); }
     };
 
     struct RCTPdfControl : RCTPdfControlT<RCTPdfControl>
@@ -57,26 +122,49 @@ namespace winrt::RCTPdf::implementation
     private:
         Microsoft::ReactNative::IReactContext m_reactContext{ nullptr };
 
-        // Global lock to access the data stuff
-        // the pages are rendered in an async way
-        std::shared_mutex m_rwlock;
-        // URI and password of the PDF
-        std::string m_pdfURI;
-        std::string m_pdfPassword;
+        // Current document and layout, swapped atomically as a whole. Scroll handling and
+        // renders work on the snapshot they loaded, so a property update or a new document
+        // never blocks them nor makes them skip a view.
+        std::shared_ptr<const PDFViewSnapshot> m_view = std::make_shared<PDFViewSnapshot>();
+        std::shared_ptr<const PDFViewSnapshot> View() const { return std::atomic_load(&m_view); }
+        void PublishView(std::shared_ptr<const PDFViewSnapshot> view) { std::atomic_store(&m_view, std::move(view)); }
+        // Publishes a copy of the current snapshot with change applied, retrying if another
+        // writer published first
+        template <typename Change>
+        std::shared_ptr<const PDFViewSnapshot> UpdateView(Change&& change) {
+          auto current = View();
+          while (true) {
+            auto next = std::make_shared<PDFViewSnapshot>(*current);
+            change(*next);
+            std::shared_ptr<const PDFViewSnapshot> published = std::move(next);
+            if (std::atomic_compare_exchange_strong(&m_view, &current, published))
+              return published;
+          }
+        }
+
+        // Properties of the document last requested; a load in progress applies the
+        // updates made while it was opening the file
+        struct PDFLoadRequest {
+          std::string uri;
+          std::string password;
+          int page = 0;
+          double scale = 1.0;
+          int margins = 10;
+          int fitPolicy = 2;
+          bool horizontal = false;
+          bool reverse = false;
+          bool enablePaging = false;
+          bool singlePage = false;
+        };
+        PDFLoadRequest m_requestedLoad;
+        // Incremented per load; a load that finds it changed was superseded
+        uint64_t m_loadGeneration = 0;
+
+        // The members below are only touched on the UI thread
         // Current active page
         int m_currentPage = 0;
-        // Margins of each page
-        int m_margins = 10;
-        // Scale at which the PDF is displayed
-        double m_scale = 0.2;
         double m_minScale = 0.1;
         double m_maxScale = 3.0;
-        // Are we in "horizontal" mode?
-        bool m_horizontal = false;
-        // Render the pages in reverse order
-        bool m_reverse = false;
-        // Is in "enablePaging" mode
-        bool m_enablePaging = false;
 
         // When we rescale or change the margins, we can jump to the new position in the view
         // only after the ScrollViewer has updated. We store the target offsets here, and go
@@ -88,15 +176,35 @@ namespace winrt::RCTPdf::implementation
         // the position
         void ChangeScroll(double targetHorizontalOffset, double targetVerticalOffset);
 
-        // Pages info
-        std::vector<PDFPageInfo> m_pages;
+        // Virtualized layout: only pages [m_windowStart, m_windowEnd] of the current snapshot
+        // have an Image and a PdfPage. The spacers take the place of the pages before and
+        // after the window.
+        int m_windowStart = 0;
+        int m_windowEnd = -1;
+        winrt::Windows::UI::Xaml::Controls::Border m_leadingSpacer{ nullptr };
+        winrt::Windows::UI::Xaml::Controls::Border m_trailingSpacer{ nullptr };
+        // Images of pages that left the window, reused for pages entering it
+        std::vector<winrt::Windows::UI::Xaml::Controls::Image> m_imagePool;
+
+        // Renders started by RenderVisiblePages (page index, action). Only touched on the UI
+        // thread; a new view cancels the entries it no longer needs.
+        std::vector<std::pair<int, winrt::Windows::Foundation::IAsyncAction>> m_pendingRenders;
+        uint64_t m_renderGeneration = 0;
 
-        void UpdatePagesInfoMarginOrScale();
-        winrt::fire_and_forget LoadPDF(std::unique_lock<std::shared_mutex> lock, int fitPolicy, bool singlePage);
+        void UpdatePagesInfoMarginOrScale(PDFViewSnapshot const& view);
+        void RealizePage(PDFViewSnapshot const& view, int page);
+        void ReleasePage(PDFPageInfo& pageInfo);
+        void UpdateVirtualWindow(PDFViewSnapshot const& view, int firstVisible, int lastVisible);
+        void UpdateSpacers(PDFViewSnapshot const& view);
+        winrt::fire_and_forget LoadPDF(uint64_t generation);
         void GoToPage(int page);
         void Rescale(double newScale, double newMargin, bool goToNewPosition);
         void SetOrientation(bool horizontal);
-        winrt::Windows::Foundation::IAsyncAction RenderVisiblePages(int page);
+        winrt::fire_and_forget RenderCurrentView();
+        winrt::Windows::Foundation::IAsyncAction RenderVisiblePages(std::shared_ptr<const PDFViewSnapshot> view, int page);
+        // Keeps the pages alive until the render ends, even if another document was loaded
+        static winrt::Windows::Foundation::IAsyncAction RenderPage(std::shared_ptr<std::vector<PDFPageInfo>> pages, int page);
+        winrt::Windows::Foundation::IAsyncAction WaitForRenders(std::vector<winrt::Windows::Foundation::IAsyncAction> renders);
         void SignalError(const std::string& error);
         void SignalLoadComplete(int totalPages, int width, int height);
         void SignalPageChange(int page, int totalPages);
@@ -109,7 +217,8 @@ namespace winrt::RCTPdf::implementation
         static constexpr double m_defaultMinZoom = 1.0;
         static constexpr double m_defualtZoom = 1.0;
         static constexpr int m_defaultMargins = 10;
-        static constexpr double m_previewZoom = 0.5;
+        // Pages kept realized on each side of the visible ones
+        static constexpr int m_virtualWindowPages = 4;
     };
 }
 
@@ -1,14 +1,17 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <vector>
-#include <shared_mutex>
 #include <optional>
 #include <unknwn.h>
 #include <winrt/Windows.Foundation.h>
 #include <winrt/Windows.Foundation.Collections.h>
 #include <winrt/Windows.ApplicationModel.Activation.h>
 #include <winrt/Windows.Data.Pdf.h>
+#include <winrt/Windows.Graphics.Imaging.h>
 #include <winrt/Windows.Storage.h>
+#include <winrt/Windows.Storage.FileProperties.h>
 #include <winrt/Windows.Storage.Pickers.h>
 #include <winrt/Windows.Storage.Streams.h>
 #include <winrt/Windows.System.h>